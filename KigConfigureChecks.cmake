@@ -3,6 +3,7 @@ include(CheckIncludeFiles)
 include(CheckFunctionExists)
 
 check_include_files(ieeefp.h HAVE_IEEEFP_H)
+check_include_files(immintrin.h HAVE_IMMINTRIN_H)
 
 set(CMAKE_REQUIRED_INCLUDES "math.h")
 set(CMAKE_REQUIRED_LIBRARIES m)
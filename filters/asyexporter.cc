@@ -6,6 +6,8 @@
 #include "asyexporterimpvisitor.h"
 #include "asyexporteroptions.h"
 
+#include "../kig/kig_part.h"
+#include "../kig/kig_view.h"
 #include "../misc/kigfiledialog.h"
 
 #include <QFile>
@@ -39,6 +41,11 @@ QString AsyExporter::menuIcon() const
     return QStringLiteral("text-plain");
 }
 
+bool AsyExporter::supportsFormat(const QString &format) const
+{
+    return format == QLatin1String("asy");
+}
+
 void AsyExporter::run(const KigPart &doc, KigWidget &w)
 {
     KigFileDialog *kfd = new KigFileDialog(QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation),
@@ -57,30 +64,39 @@ void AsyExporter::run(const KigPart &doc, KigWidget &w)
     }
 
     QString file_name = kfd->selectedFile();
-    bool showgrid = opts->showGrid();
-    bool showaxes = opts->showAxes();
-    bool showframe = opts->showExtraFrame();
+    KigExportOptions eopts;
+    eopts.showGrid = opts->showGrid();
+    eopts.showAxes = opts->showAxes();
+    eopts.extraFrame = opts->showExtraFrame();
+    eopts.resolution = opts->resolution();
 
     delete opts;
     delete kfd;
 
-    QFile file(file_name);
-    if (!file.open(QIODevice::WriteOnly)) {
+    if (!exportDocument(doc.document(), w.screenInfo(), file_name, eopts)) {
         KMessageBox::error(&w,
                            i18n("The file \"%1\" could not be opened. Please "
                                 "check if the file permissions are set correctly.",
                                 file_name));
-        return;
-    };
+    }
+}
 
-    const double bottom = w.showingRect().bottom();
-    const double left = w.showingRect().left();
-    const double height = w.showingRect().height();
-    const double width = w.showingRect().width();
+bool AsyExporter::exportDocument(const KigDocument &doc, const ScreenInfo &si, const QString &file_name, const KigExportOptions &opts) const
+{
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
 
-    std::vector<ObjectHolder *> os = doc.document().objects();
+    const double bottom = si.shownRect().bottom();
+    const double left = si.shownRect().left();
+    const double height = si.shownRect().height();
+    const double width = si.shownRect().width();
+
+    std::vector<ObjectHolder *> os = doc.objects();
     QTextStream stream(&file);
-    AsyExporterImpVisitor visitor(stream, w);
+    AsyExporterImpVisitor visitor(stream, doc, si);
+    // the picture is 25 * width bp wide, see its size() below
+    visitor.tolerance = opts.simplifyTolerance(width, 25 * width / 72);
 
     // Start building the output stream containing the asymptote script commands
 
@@ -96,7 +112,7 @@ void AsyExporter::run(const KigPart &doc, KigWidget &w)
     stream << "\n";
 
     // Grid
-    if (showgrid) {
+    if (opts.showGrid) {
         // TODO: Polar grid
         // Vertical lines
         double startingpoint = static_cast<double>(KDE_TRUNC(left));
@@ -111,25 +127,27 @@ void AsyExporter::run(const KigPart &doc, KigWidget &w)
     }
 
     // Axes
-    if (showaxes) {
+    if (opts.showAxes) {
         stream << "draw((" << left << ",0)--(" << left + width << ",0), black, Arrow);\n";
         stream << "draw((0," << bottom << ")--(0," << bottom + height << "), black, Arrow);\n";
     }
 
     // Visit all the objects
-    for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i) {
-        visitor.visit(*i);
-    }
+    exportObjects(stream, os, [&visitor](QTextStream &s, ObjectHolder *o) {
+        AsyExporterImpVisitor v(visitor, s);
+        v.visit(o);
+    });
 
     stream << "path frame = (" << left << "," << bottom << ")--(" << left << "," << bottom + height << ")--(" << left + width << "," << bottom + height
            << ")--(" << left + width << "," << bottom << ")--cycle;\n";
 
     // Extra frame
-    if (showframe) {
+    if (opts.extraFrame) {
         stream << "draw(frame, black);\n";
     }
     stream << "clip(frame);\n";
 
     // And close the output file
     file.close();
+    return true;
 }
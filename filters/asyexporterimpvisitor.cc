@@ -4,6 +4,8 @@
 
 #include "asyexporterimpvisitor.h"
 
+#include "exporter.h"
+
 #include "../misc/goniometry.h"
 #include "../objects/bezier_imp.h"
 #include "../objects/circle_imp.h"
@@ -98,7 +100,7 @@ void AsyExporterImpVisitor::emitLine(const Coordinate &a, const Coordinate &b, c
 double AsyExporterImpVisitor::dimRealToCoord(int dim)
 {
     QRect qr(0, 0, dim, dim);
-    Rect r = mw.screenInfo().fromScreen(qr);
+    Rect r = msi.fromScreen(qr);
     return fabs(r.width());
 }
 
@@ -112,52 +114,31 @@ void AsyExporterImpVisitor::visit(ObjectHolder *obj)
 
 void AsyExporterImpVisitor::plotGenericCurve(const CurveImp *imp)
 {
-    std::vector<std::vector<Coordinate>> coordlist;
-    coordlist.push_back(std::vector<Coordinate>());
-    uint curid = 0;
-
-    Coordinate c;
-    Coordinate prev = Coordinate::invalidCoord();
-    for (double i = 0.0; i <= 1.0; i += 0.0001) {
-        c = imp->getPoint(i, mw.document());
-        if (!c.valid()) {
-            if (coordlist[curid].size() > 0) {
-                coordlist.push_back(std::vector<Coordinate>());
-                ++curid;
-                prev = Coordinate::invalidCoord();
+    // the pieces are written while the curve is sampled, so we don't
+    // know which point is the last one: write the "--" in front of all
+    // the others instead
+    uint linelength = 0;
+    bool firstpoint = true;
+    sampleCurve(
+        imp,
+        mdoc,
+        0.0001,
+        10000,
+        50.0,
+        true,
+        tolerance,
+        [this, &linelength, &firstpoint]() {
+            mstream << "path curve = ";
+            linelength = 13;
+            firstpoint = true;
+        },
+        [this, &linelength, &firstpoint](const Coordinate &c) {
+            if (!firstpoint) {
+                linelength += 2;
+                mstream << "--";
             }
-            continue;
-        }
-        if (!((fabs(c.x) <= 10000) && (fabs(c.y) <= 10000)))
-            continue;
-        // if there's too much distance between this coordinate and the previous
-        // one, then it's another piece of curve not joined with the rest
-        if (prev.valid() && (c.distance(prev) > 50.0)) {
-            coordlist.push_back(std::vector<Coordinate>());
-            ++curid;
-        }
-        coordlist[curid].push_back(c);
-        prev = c;
-    }
-    // special case for ellipse
-    if (const ConicImp *conic = dynamic_cast<const ConicImp *>(imp)) {
-        // if ellipse, close its path
-        // THIS IS WRONG, think of ellipse arcs!!
-        if (conic->conicType() == 1 && coordlist.size() == 1 && coordlist[0].size() > 1) {
-            coordlist[0].push_back(coordlist[0][0]);
-        }
-    }
-    for (uint i = 0; i < coordlist.size(); ++i) {
-        uint s = coordlist[i].size();
-        // there's no point in draw curves empty or with only one point
-        if (s <= 1)
-            continue;
-
-        uint linelength = 13;
-        QString tmp;
-        mstream << "path curve = ";
-        for (uint j = 0; j < s; ++j) {
-            tmp = emitCoord(coordlist[i][j]);
+            firstpoint = false;
+            const QString tmp = emitCoord(c);
             // Avoid too long lines in the output file
             if (linelength + tmp.length() > maxlinelength) {
                 linelength = tmp.length();
@@ -166,18 +147,13 @@ void AsyExporterImpVisitor::plotGenericCurve(const CurveImp *imp)
                 linelength += tmp.length();
             }
             mstream << tmp;
-            if (j < s - 1) {
-                linelength += 2;
-                mstream << "--";
-            } else {
-                mstream << ";";
-                newLine();
-                linelength = 0;
-            }
-        }
-        mstream << "draw(curve, " << emitPen(mcurobj->drawer()->color(), mcurobj->drawer()->width(), mcurobj->drawer()->style()) << " );";
-        newLine();
-    }
+        },
+        [this]() {
+            mstream << ";";
+            newLine();
+            mstream << "draw(curve, " << emitPen(mcurobj->drawer()->color(), mcurobj->drawer()->width(), mcurobj->drawer()->style()) << " );";
+            newLine();
+        });
 }
 
 void AsyExporterImpVisitor::visit(const LineImp *imp)
@@ -8,6 +8,7 @@
 
 #include <QCheckBox>
 #include <QLayout>
+#include <QSpinBox>
 
 AsyExporterOptions::AsyExporterOptions(QWidget *parent)
     : QWidget(parent)
@@ -53,4 +54,14 @@ bool AsyExporterOptions::showExtraFrame() const
     return expwidget->showFrameCheckBox->isChecked();
 }
 
+void AsyExporterOptions::setResolution(int dpi)
+{
+    expwidget->resolutionSpinBox->setValue(dpi);
+}
+
+int AsyExporterOptions::resolution() const
+{
+    return expwidget->resolutionSpinBox->value();
+}
+
 #include "moc_asyexporteroptions.cpp"
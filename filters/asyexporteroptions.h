@@ -26,4 +26,10 @@ public:
 
     void setExtraFrame(bool frame);
     bool showExtraFrame() const;
+    /**
+     * the resolution, in dots per inch, to simplify the curves to, or 0
+     * to not simplify them.  \see KigExportOptions::resolution
+     */
+    void setResolution(int dpi);
+    int resolution() const;
 };
@@ -9,6 +9,7 @@
 #include "cabri-filter.h"
 
 #include "cabri-utils.h"
+#include "filters-common.h"
 
 #include "../kig/kig_document.h"
 #include "../misc/coordinate.h"
@@ -608,7 +609,7 @@ KigDocument *KigFilterCabri::load(const QString &file)
     delete axes;
     delete reader;
 
-    ret->addObjects(holders);
+    filtersAddObjects(*ret, holders);
     ret->setGrid(havegrid);
     ret->setAxes(haveaxes);
     return ret;
@@ -10,6 +10,7 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QMutex>
 #include <QRegularExpressionMatch>
 
 #include <KLocalizedString>
@@ -148,6 +149,9 @@ CabriReader::~CabriReader()
 
 void CabriReader::initColorMap()
 {
+    // the batch converter can load several cabri files at once
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
     static bool colors_initialized = false;
     if (!colors_initialized) {
         colors_initialized = true;
@@ -442,6 +446,8 @@ CabriReader_v12::~CabriReader_v12()
 
 void CabriReader_v12::initColorMap()
 {
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
     static bool colors_initialized = false;
     if (!colors_initialized) {
         colors_initialized = true;
@@ -8,7 +8,6 @@
 #include "filters-common.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_part.h"
 #include "../misc/common.h"
 #include "../misc/coordinate.h"
 #include "../objects/angle_type.h"
@@ -39,7 +38,6 @@
 
 #include <QDomDocument>
 #include <QFile>
-#include <QInputDialog>
 
 #undef DRGEO_DEBUG
 //#define DRGEO_DEBUG
@@ -104,18 +102,13 @@ KigDocument *KigFilterDrgeo::load(const QString &file)
 
     QString myfig = figures.at(0);
 
-    if (nfig > 1) {
+    if (nfig > 1 && canAskUser()) {
         // Dr. Geo file has more than 1 figure, let the user choose one.
-        bool ok = true;
-        myfig = QInputDialog::getItem(nullptr,
-                                      i18n("Dr. Geo Filter"),
-                                      i18n("The current Dr. Geo file contains more than one figure.\n"
-                                           "Please select which to import:"),
-                                      figures,
-                                      0,
-                                      false,
-                                      &ok);
-        if (!ok)
+        if (!chooseItem(i18n("Dr. Geo Filter"),
+                        i18n("The current Dr. Geo file contains more than one figure.\n"
+                             "Please select which to import:"),
+                        figures,
+                        myfig))
             return nullptr;
     }
 
@@ -722,7 +715,7 @@ KigDocument *KigFilterDrgeo::importFigure(const QDomNode &f, const bool grid)
         oc = nullptr;
 
         if (oc2 != nullptr) {
-            oc2->calc(*ret);
+            // the ObjectFactory has calculated the label already
             ObjectDrawer *d2 = new ObjectDrawer(co);
             ObjectHolder *o2 = new ObjectHolder(oc2, d2);
             holders2.push_back(o2);
@@ -730,7 +723,9 @@ KigDocument *KigFilterDrgeo::importFigure(const QDomNode &f, const bool grid)
         }
     }
 
-    ret->addObjects(holders);
+    filtersAddObjects(*ret, holders);
+    // the angle labels show numbers in the precision of the document
+    // with the objects in it, so we do calculate them again
     ret->addObjects(holders2);
     ret->setGrid(grid);
     ret->setAxes(grid);
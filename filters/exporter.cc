@@ -14,12 +14,22 @@
 #include "../kig/kig_part.h"
 #include "../kig/kig_view.h"
 #include "../misc/common.h"
+#include "../misc/coordinate.h"
+#include "../misc/coordinate_buffer.h"
 #include "../misc/kigfiledialog.h"
 #include "../misc/kigpainter.h"
+#include "../misc/tiled_renderer.h"
+#include "../objects/conic_imp.h"
+#include "../objects/curve_imp.h"
 
+#include <QFileInfo>
+#include <QImage>
 #include <QImageWriter>
 #include <QMimeDatabase>
+#include <QSemaphore>
 #include <QStandardPaths>
+#include <QTextStream>
+#include <QThreadPool>
 
 #include <KActionCollection>
 #include <KActionMenu>
@@ -27,6 +37,9 @@
 #include <KIconLoader>
 #include <KMessageBox>
 
+#include <cmath>
+#include <memory>
+
 ExporterAction::ExporterAction(const KigPart *doc, KigWidget *w, KActionCollection *parent, KigExporter *exp)
     : QAction(exp->menuEntryName(), parent)
     , mexp(exp)
@@ -46,6 +59,148 @@ void ExporterAction::slotActivated()
     mexp->run(*mdoc, *mw);
 }
 
+void sampleCurve(const CurveImp *curve,
+                 const KigDocument &doc,
+                 double step,
+                 double bound,
+                 double maxjump,
+                 bool closeellipse,
+                 double tolerance,
+                 const std::function<void()> &begin,
+                 const std::function<void(const Coordinate &)> &point,
+                 const std::function<void()> &end)
+{
+    // when simplifying, we collect the points of a piece, and hand them
+    // out once it is complete.  A piece has at most 1 / step + 2 points,
+    // so this doesn't take more memory for bigger documents
+    CoordinateBuffer piece;
+    auto beginPiece = [&]() {
+        if (tolerance > 0.)
+            piece.clear();
+        else
+            begin();
+    };
+    auto addPoint = [&](const Coordinate &c) {
+        if (tolerance > 0.)
+            piece.push_back(c);
+        else
+            point(c);
+    };
+    auto endPiece = [&]() {
+        if (tolerance > 0.) {
+            piece.simplify(tolerance);
+            begin();
+            for (std::size_t i = 0; i < piece.size(); ++i)
+                point(piece[i]);
+        }
+        end();
+    };
+
+    // the first point of the current piece, which we only hand out once
+    // we know that the piece has a second one, and the last one, which
+    // is invalid while the current piece is still empty
+    Coordinate first = Coordinate::invalidCoord();
+    Coordinate prev = Coordinate::invalidCoord();
+    bool begun = false;
+    bool split = false;
+    for (double i = 0.0; i <= 1.0; i += step) {
+        const Coordinate c = curve->getPoint(i, doc);
+        if (!c.valid()) {
+            if (prev.valid()) {
+                if (begun)
+                    endPiece();
+                begun = false;
+                split = true;
+                prev = Coordinate::invalidCoord();
+            }
+            continue;
+        }
+        if (!((fabs(c.x) <= bound) && (fabs(c.y) <= bound)))
+            continue;
+        // if there's too much distance between this coordinate and the previous
+        // one, then it's another piece of curve not joined with the rest
+        if (prev.valid() && (c.distance(prev) > maxjump)) {
+            if (begun)
+                endPiece();
+            begun = false;
+            split = true;
+            prev = Coordinate::invalidCoord();
+        }
+        if (!prev.valid())
+            first = c;
+        else {
+            if (!begun) {
+                beginPiece();
+                addPoint(first);
+                begun = true;
+            }
+            addPoint(c);
+        }
+        prev = c;
+    }
+    if (!begun)
+        return;
+    // special case for ellipse
+    if (const ConicImp *conic = dynamic_cast<const ConicImp *>(curve)) {
+        // if ellipse, close its path
+        // THIS IS WRONG, think of ellipse arcs!!
+        if (closeellipse && conic->conicType() == 1 && !split)
+            addPoint(first);
+    }
+    endPiece();
+}
+
+void exportObjects(QTextStream &stream, const std::vector<ObjectHolder *> &os, const std::function<void(QTextStream &, ObjectHolder *)> &visit)
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int threads = pool->maxThreadCount();
+    if (threads <= 1 || os.size() <= 1) {
+        for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i)
+            visit(stream, *i);
+        return;
+    }
+
+    // object i is visited into outputs[ i % window ], and done[ i % window ]
+    // is released when it is
+    const uint window = 4 * threads;
+    std::vector<QString> outputs(window);
+    std::unique_ptr<QSemaphore[]> done(new QSemaphore[window]);
+    uint next = 0;
+    for (uint i = 0; i < os.size(); ++i) {
+        for (; next < os.size() && next < i + window; ++next) {
+            QString *output = &outputs[next % window];
+            QSemaphore *sem = &done[next % window];
+            ObjectHolder *o = os[next];
+            pool->start([output, sem, o, &visit]() {
+                QTextStream s(output);
+                visit(s, o);
+                s.flush();
+                sem->release();
+            });
+        }
+        done[i % window].acquire();
+        stream << outputs[i % window];
+        outputs[i % window].clear();
+    }
+}
+
+KigExportOptions::KigExportOptions()
+    : showGrid(true)
+    , showAxes(true)
+    , extraFrame(false)
+    , standalone(true)
+    , latexFormat(0)
+    , resolution(0)
+{
+}
+
+double KigExportOptions::simplifyTolerance(double docwidth, double inches) const
+{
+    if (resolution <= 0 || inches <= 0.)
+        return 0.;
+    return docwidth / (inches * resolution) / 2;
+}
+
 KigExporter::~KigExporter()
 {
 }
@@ -89,8 +244,10 @@ void ImageExporter::run(const KigPart &doc, KigWidget &w)
         return;
 
     QString filename = kfd->selectedFile();
-    bool showgrid = opts->showGrid();
-    bool showaxes = opts->showAxes();
+    KigExportOptions eopts;
+    eopts.showGrid = opts->showGrid();
+    eopts.showAxes = opts->showAxes();
+    eopts.resolution = opts->resolution();
     QSize imgsize = opts->imageSize();
 
     delete opts;
@@ -109,22 +266,39 @@ void ImageExporter::run(const KigPart &doc, KigWidget &w)
         KMessageBox::error(&w, i18n("The file \"%1\" could not be opened. Please check if the file permissions are set correctly.", filename));
         return;
     };
+    file.close();
 
-    QPixmap img(imgsize);
-    img.fill(Qt::white);
-    KigPainter p(ScreenInfo(w.screenInfo().shownRect(), img.rect()), &img, doc.document());
-    p.setWholeWinOverlay();
-    p.drawGrid(doc.document().coordinateSystem(), showgrid, showaxes);
-    // FIXME: show the selections ?
-    p.drawObjects(doc.document().objects(), false);
-    const QStringList types = mimeType.suffixes();
-    if (types.isEmpty())
-        return; // TODO error dialog?
-    if (!img.save(filename, types.at(0).toLatin1())) {
+    if (!exportDocument(doc.document(), ScreenInfo(w.screenInfo().shownRect(), QRect(QPoint(0, 0), imgsize)), filename, eopts)) {
         KMessageBox::error(&w, i18n("Sorry, something went wrong while saving to image \"%1\"", filename));
     }
 }
 
+bool ImageExporter::supportsFormat(const QString &format) const
+{
+    // Qt can read SVG images, but SVGExporter writes them
+    return format != QLatin1String("svg") && QImageWriter::supportedImageFormats().contains(format.toLatin1());
+}
+
+bool ImageExporter::exportDocument(const KigDocument &doc, const ScreenInfo &si, const QString &file, const KigExportOptions &opts) const
+{
+    // a QImage and not a QPixmap, because we can be called from other
+    // threads than the GUI thread..
+    QImage img(si.viewRect().size(), QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::white);
+    const ScreenInfo isi(si.shownRect(), img.rect());
+    {
+        KigPainter p(isi, &img, doc, false);
+        p.drawGrid(doc.coordinateSystem(), opts.showGrid, opts.showAxes);
+    }
+    // FIXME: show the selections ?
+    const double inches = img.width() / (img.dotsPerMeterX() * 0.0254);
+    drawObjectsTiled(img, isi, doc, std::vector<ObjectHolder *>(), doc.objects(), opts.simplifyTolerance(si.shownRect().width(), inches));
+    QMimeDatabase db;
+    const QStringList types = db.mimeTypeForFile(file, QMimeDatabase::MatchExtension).suffixes();
+    const QByteArray format = types.isEmpty() ? QFileInfo(file).suffix().toLatin1() : types.at(0).toLatin1();
+    return img.save(file, format.constData());
+}
+
 KigExportManager::KigExportManager()
 {
     mexporters.push_back(new ImageExporter);
@@ -150,6 +324,14 @@ void KigExportManager::addMenuAction(const KigPart *doc, KigWidget *w, KActionCo
         coll->addAction(QStringLiteral("file_export"), m);
 }
 
+KigExporter *KigExportManager::exporterFor(const QString &format) const
+{
+    for (uint i = 0; i < mexporters.size(); ++i)
+        if (mexporters[i]->supportsFormat(format))
+            return mexporters[i];
+    return nullptr;
+}
+
 KigExportManager *KigExportManager::instance()
 {
     static KigExportManager m;
@@ -6,15 +6,93 @@
 
 #include <QAction>
 
+#include <functional>
 #include <vector>
 
 class QString;
+class QTextStream;
+class Coordinate;
+class CurveImp;
+class KigDocument;
+class ObjectHolder;
 class KigPart;
 class KigWidget;
 class KActionCollection;
+class ScreenInfo;
 
 class KigExporter;
 
+/**
+ * The options of an export that the exporters ask the user for.  Not
+ * every exporter uses all of them.
+ */
+class KigExportOptions
+{
+public:
+    KigExportOptions();
+
+    bool showGrid;
+    bool showAxes;
+    bool extraFrame;
+    /**
+     * for the Latex exporter: whether to write a complete document, and
+     * which LatexExporterOptions::LatexOutputFormat to use.
+     */
+    bool standalone;
+    int latexFormat;
+    /**
+     * the resolution, in dots per inch, that the curves are simplified
+     * to: points that are less than half a dot away from the polyline
+     * without them are left out.  0 means that the curves are not
+     * simplified.
+     */
+    int resolution;
+
+    /**
+     * the tolerance, in document coordinates, to simplify the curves
+     * with for resolution, in an export in which \p docwidth document
+     * units are \p inches wide.  0 if the curves are not simplified.
+     */
+    double simplifyTolerance(double docwidth, double inches) const;
+};
+
+/**
+ * Samples \p curve at the parameters 0, \p step, 2 * \p step ... 1,
+ * and hands the points to the exporter as they are calculated, without
+ * collecting them first.  The curve is split into pieces where it is
+ * not defined, and where two points are more than \p maxjump apart,
+ * and points with a coordinate bigger than \p bound are left out.  For
+ * every piece of at least two points, \p begin is called, then \p point
+ * for each of its points, and then \p end .  If \p closeellipse is
+ * true and \p curve is an ellipse that was sampled in one piece, its
+ * first point is repeated at the end to close it.  If \p tolerance is
+ * bigger than 0, every piece is simplified to within \p tolerance of
+ * the points sampled before it is handed out.  \see
+ * CoordinateBuffer::simplify
+ */
+void sampleCurve(const CurveImp *curve,
+                 const KigDocument &doc,
+                 double step,
+                 double bound,
+                 double maxjump,
+                 bool closeellipse,
+                 double tolerance,
+                 const std::function<void()> &begin,
+                 const std::function<void(const Coordinate &)> &point,
+                 const std::function<void()> &end);
+
+/**
+ * Calls \p visit for all objects in \p os , and writes what it wrote to
+ * the stream that it got to \p stream , in the order of \p os .  When
+ * there is more than one thread, the objects are visited in parallel by
+ * the threads of the global QThreadPool, each with a stream of its own,
+ * but only a few objects ahead of the one that is written next, so that
+ * the output of the objects never has to be kept in memory all at once.
+ * \p visit must therefore not change anything that the visit of another
+ * object uses.
+ */
+void exportObjects(QTextStream &stream, const std::vector<ObjectHolder *> &os, const std::function<void(QTextStream &, ObjectHolder *)> &visit);
+
 class KigExportManager
 {
     std::vector<KigExporter *> mexporters;
@@ -24,6 +102,12 @@ class KigExportManager
 public:
     static KigExportManager *instance();
     void addMenuAction(const KigPart *doc, KigWidget *w, KActionCollection *coll);
+
+    /**
+     * the exporter for files with the extension \p format, or 0 if
+     * there is none.
+     */
+    KigExporter *exporterFor(const QString &format) const;
 };
 
 class ExporterAction : public QAction
@@ -69,6 +153,22 @@ public:
      * do a much better job at that.
      */
     virtual void run(const KigPart &doc, KigWidget &w) = 0;
+
+    /**
+     * Returns true if this exporter writes files with the extension
+     * \p format, like "png" or "tex".
+     */
+    virtual bool supportsFormat(const QString &format) const = 0;
+
+    /**
+     * Export the part si.shownRect() of \p doc to \p file without
+     * asking the user anything.  si.viewRect() is the size of the
+     * result, for the formats that have one.  run() calls this once it
+     * knows the file and the options, and the batch mode of the kig
+     * application calls it directly, possibly from more than one thread
+     * at once.  Returns false if the file could not be written.
+     */
+    virtual bool exportDocument(const KigDocument &doc, const ScreenInfo &si, const QString &file, const KigExportOptions &opts) const = 0;
 };
 
 /**
@@ -82,4 +182,6 @@ public:
     QString menuEntryName() const override;
     QString menuIcon() const override;
     void run(const KigPart &doc, KigWidget &w) override;
+    bool supportsFormat(const QString &format) const override;
+    bool exportDocument(const KigDocument &doc, const ScreenInfo &si, const QString &file, const KigExportOptions &opts) const override;
 };
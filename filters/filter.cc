@@ -9,18 +9,23 @@
 
 #include "cabri-filter.h"
 #include "drgeo-filter.h"
+#include "geogebra-filter.h"
 #include "kgeo-filter.h"
 #include "kseg-filter.h"
 #include "native-filter.h"
-#ifdef WITH_GEOGEBRA
-#include "geogebra-filter.h"
-#endif // WITH_GEOGEBRA
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QThread>
 
 #include <KLocalizedString>
-#include <KMessageBox>
+
+#include <assert.h>
 
 KigFilters *KigFilters::sThis;
 
+static KigFilterUi *filterui = nullptr;
+
 KigFilter *KigFilters::find(const QString &mime)
 {
     for (vect::iterator i = mFilters.begin(); i != mFilters.end(); ++i) {
@@ -37,9 +42,7 @@ KigFilters::KigFilters()
     mFilters.push_back(KigFilterCabri::instance());
     mFilters.push_back(KigFilterNative::instance());
     mFilters.push_back(KigFilterDrgeo::instance());
-#ifdef WITH_GEOGEBRA
     mFilters.push_back(KigFilterGeogebra::instance());
-#endif // WITH_GEOGEBRA
 }
 
 KigFilters *KigFilters::instance()
@@ -47,6 +50,10 @@ KigFilters *KigFilters::instance()
     return sThis ? sThis : (sThis = new KigFilters());
 }
 
+KigFilterUi::~KigFilterUi()
+{
+}
+
 KigFilter::KigFilter()
 {
 }
@@ -55,42 +62,79 @@ KigFilter::~KigFilter()
 {
 }
 
+void KigFilter::setUi(KigFilterUi *ui)
+{
+    filterui = ui;
+}
+
 bool KigFilter::supportMime(const QString &)
 {
     return false;
 }
 
+/**
+ * filters are also used from the worker threads of the batch
+ * converter, where we cannot show any message boxes..
+ */
+static bool inGuiThread()
+{
+    return filterui && qApp && QThread::currentThread() == qApp->thread();
+}
+
+bool KigFilter::canAskUser()
+{
+    return inGuiThread();
+}
+
+bool KigFilter::chooseItem(const QString &title, const QString &label, const QStringList &items, QString &choice)
+{
+    assert(inGuiThread());
+    return filterui->chooseItem(title, label, items, choice);
+}
+
 void KigFilter::fileNotFound(const QString &file) const
 {
-    KMessageBox::error(nullptr,
-                       i18n("The file \"%1\" could not be opened.  "
-                            "This probably means that it does not "
-                            "exist, or that it cannot be opened due to "
-                            "its permissions",
-                            file));
+    if (!inGuiThread()) {
+        qCritical() << "The file" << file << "could not be opened.";
+        return;
+    }
+    filterui->error(i18n("The file \"%1\" could not be opened.  "
+                         "This probably means that it does not "
+                         "exist, or that it cannot be opened due to "
+                         "its permissions",
+                         file),
+                    QString(),
+                    QString());
 }
 
 void KigFilter::parseError(const QString &explanation) const
 {
-    const QString text = i18n(
-        "An error was encountered while parsing this file.  It "
-        "cannot be opened.");
-    const QString title = i18n("Parse Error");
-
-    if (explanation.isEmpty())
-        KMessageBox::error(nullptr, text, title);
-    else
-        KMessageBox::detailedError(nullptr, text, explanation, title);
+    if (!inGuiThread()) {
+        qCritical() << "Parse error:" << explanation;
+        return;
+    }
+    filterui->error(i18n("An error was encountered while parsing this file.  It "
+                         "cannot be opened."),
+                    explanation,
+                    i18n("Parse Error"));
 }
 
 void KigFilter::notSupported(const QString &explanation) const
 {
-    KMessageBox::detailedError(nullptr, i18n("Kig cannot open this file."), explanation, i18n("Not Supported"));
+    if (!inGuiThread()) {
+        qCritical() << "Not supported:" << explanation;
+        return;
+    }
+    filterui->error(i18n("Kig cannot open this file."), explanation, i18n("Not Supported"));
 }
 
 void KigFilter::warning(const QString &explanation) const
 {
-    KMessageBox::information(nullptr, explanation);
+    if (!inGuiThread()) {
+        qWarning() << explanation;
+        return;
+    }
+    filterui->information(explanation);
 }
 
 bool KigFilters::save(const KigDocument &data, const QString &tofile)
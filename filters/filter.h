@@ -6,12 +6,37 @@
 #pragma once
 
 #include <QString>
+#include <QStringList>
 
 #include <vector>
 
 class KigFilter;
 class KigDocument;
 
+/**
+ * The filters are part of kigcore, which doesn't use widgets, so they
+ * can't show message boxes themselves.  kigpart installs a KigFilterUi
+ * that does, see KigFilter::setUi().  Without one, the filters log
+ * their messages, and never ask the user anything.
+ */
+class KigFilterUi
+{
+public:
+    virtual ~KigFilterUi();
+
+    /**
+     * show the error \p text , with the details in \p explanation ,
+     * which may be empty.
+     */
+    virtual void error(const QString &text, const QString &explanation, const QString &title) = 0;
+    virtual void information(const QString &text) = 0;
+    /**
+     * let the user choose one of \p items , and put it in \p choice .
+     * Returns false if they cancelled.
+     */
+    virtual bool chooseItem(const QString &title, const QString &label, const QStringList &items, QString &choice) = 0;
+};
+
 /**
  * This singleton class handles all the input filters.
  */
@@ -61,11 +86,22 @@ protected:
     void parseError(const QString &explanation = QString()) const;
     void notSupported(const QString &explanation) const;
     void warning(const QString &explanation) const;
+    // whether we may pop up a dialog: only in the GUI thread, when a
+    // KigFilterUi has been installed, and not in batch mode.
+    static bool canAskUser();
+    // see KigFilterUi::chooseItem(), only call this if canAskUser().
+    static bool chooseItem(const QString &title, const QString &label, const QStringList &items, QString &choice);
 
 public:
     KigFilter();
     virtual ~KigFilter();
 
+    /**
+     * make the filters show their messages and questions with \p ui ,
+     * which stays owned by the caller.
+     */
+    static void setUi(KigFilterUi *ui);
+
     /**
      * can the filter handle the mimetype \p mime ?
      */
@@ -9,8 +9,11 @@
 #include <QByteArray>
 #include <QString>
 
+#include "../kig/kig_document.h"
+#include "../misc/calcpaths.h"
 #include "../objects/object_calcer.h"
 #include "../objects/object_factory.h"
+#include "../objects/object_holder.h"
 
 ObjectTypeCalcer *filtersConstructTextObject(const Coordinate &c, ObjectCalcer *o, const QByteArray &arg, const KigDocument &doc, bool needframe)
 {
@@ -21,3 +24,22 @@ ObjectTypeCalcer *filtersConstructTextObject(const Coordinate &c, ObjectCalcer *
     args.push_back(propo);
     return fact->labelCalcer(QStringLiteral("%1"), c, needframe, args, doc);
 }
+
+void filtersAddObjects(KigDocument &doc, const std::vector<ObjectHolder *> &os)
+{
+    std::vector<ObjectCalcer *> uncalced;
+    for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i)
+        if (!(*i)->calcer()->imp())
+            uncalced.push_back((*i)->calcer());
+
+    if (!uncalced.empty()) {
+        // an object that has been calculated can't depend on one that
+        // hasn't, so this only leaves the part of the document that we
+        // still need to calculate..
+        const std::vector<ObjectCalcer *> path = calcPath(getAllParents(uncalced));
+        for (std::vector<ObjectCalcer *>::const_iterator i = path.begin(); i != path.end(); ++i)
+            if (!(*i)->imp())
+                (*i)->calc(doc);
+    }
+    doc.addCalculatedObjects(os);
+}
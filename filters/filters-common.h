@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <vector>
+
 class ObjectTypeCalcer;
 class Coordinate;
 class ObjectCalcer;
+class ObjectHolder;
 class QByteArray;
 class KigDocument;
 
@@ -15,3 +18,17 @@ class KigDocument;
  * parts given by the argument \p arg of obj \p o.
  */
 ObjectTypeCalcer *filtersConstructTextObject(const Coordinate &c, ObjectCalcer *o, const QByteArray &arg, const KigDocument &doc, bool needframe);
+
+/**
+ * add the objects \p os that an import filter has built to \p doc .
+ *
+ * The filters have to calculate most objects while they build them,
+ * since they need to know what the parents of the next objects are.
+ * They do that in \p doc, before anything is added to it, so those
+ * objects would come out exactly the same if we calculated them again
+ * here.  So we only calculate the objects that haven't been yet, e.g.
+ * labels that nothing depends on, together with the objects they depend
+ * on that haven't been either, in one pass, parents before children.
+ * This way, every object of an imported file is calculated once.
+ */
+void filtersAddObjects(KigDocument &doc, const std::vector<ObjectHolder *> &os);
@@ -8,7 +8,7 @@
 
 #include "geogebra-filter.h"
 
-#include <geogebra/geogebratransformer.h>
+#include <geogebra/geogebrareader.h>
 #include <kig/kig_document.h>
 #include <objects/bogus_imp.h>
 #include <objects/object_calcer.h>
@@ -19,8 +19,9 @@
 #include <KZip>
 #include <QDebug>
 
-#include <QFile>
-#include <QXmlQuery>
+#include <QIODevice>
+
+#include <memory>
 
 #include <algorithm>
 
@@ -49,21 +50,18 @@ KigDocument *KigFilterGeogebra::load(const QString &sFrom)
         const KZipFileEntry *geogebraXMLEntry = dynamic_cast<const KZipFileEntry *>(geogebraFile.directory()->entry(QStringLiteral("geogebra.xml")));
 
         if (geogebraXMLEntry) {
-            QXmlNamePool np;
-            QXmlQuery geogebraXSLT(QXmlQuery::XSLT20, np);
-            const QString encodedData = QString::fromUtf8(geogebraXMLEntry->data().constData());
-            QFile queryDevice(QStringLiteral(":/kig/geogebra/geogebra.xsl"));
-            GeogebraTransformer ggbtransform(document, np);
-
-            queryDevice.open(QFile::ReadOnly);
-            geogebraXSLT.setFocus(encodedData);
-            geogebraXSLT.setQuery(&queryDevice);
-            geogebraXSLT.evaluateTo(&ggbtransform);
-            queryDevice.close();
-
-            assert(ggbtransform.getNumberOfSections() == 1);
-
-            const GeogebraSection &gs = ggbtransform.getSection(0);
+            // read the XML straight from the archive, without unpacking
+            // it into memory first
+            std::unique_ptr<QIODevice> xmlDevice(geogebraXMLEntry->createDevice());
+            GeogebraReader ggbreader(document);
+
+            if (!ggbreader.read(xmlDevice.get()) || ggbreader.getNumberOfSections() != 1) {
+                delete document;
+                parseError();
+                return nullptr;
+            }
+
+            const GeogebraSection &gs = ggbreader.getSection(0);
             const std::vector<ObjectCalcer *> &f = gs.getOutputObjects();
             const std::vector<ObjectDrawer *> &d = gs.getDrawers();
             std::vector<ObjectHolder *> holders(f.size());
@@ -11,6 +11,7 @@
 #include <QLayout>
 #include <QScreen>
 #include <QSize>
+#include <QSpinBox>
 
 ImageExporterOptions::ImageExporterOptions(QWidget *parent)
     : QWidget(parent)
@@ -117,4 +118,14 @@ void ImageExporterOptions::slotUnitChanged(int index)
     minternallysettingstuff = false;
 }
 
+void ImageExporterOptions::setResolution(int dpi)
+{
+    expwidget->resolutionSpinBox->setValue(dpi);
+}
+
+int ImageExporterOptions::resolution() const
+{
+    return expwidget->resolutionSpinBox->value();
+}
+
 #include "moc_imageexporteroptions.cpp"
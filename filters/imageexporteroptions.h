@@ -38,6 +38,12 @@ public:
 
     void setImageSize(const QSize &size);
     QSize imageSize() const;
+    /**
+     * the resolution, in dots per inch, to simplify the curves to, or 0
+     * to not simplify them.  \see KigExportOptions::resolution
+     */
+    void setResolution(int dpi);
+    int resolution() const;
 
 protected Q_SLOTS:
     void slotWidthChanged(double);
@@ -11,7 +11,6 @@
 #include "kgeo-resource.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_part.h"
 #include "../objects/angle_type.h"
 #include "../objects/bogus_imp.h"
 #include "../objects/circle_imp.h"
@@ -42,6 +41,10 @@ bool KigFilterKGeo::supportMime(const QString &mime)
 
 KigDocument *KigFilterKGeo::load(const QString &sFrom)
 {
+    // loadMetrics stores the metrics in our members, so only one
+    // file can be loaded at a time..
+    QMutexLocker locker(&mmutex);
+
     // kgeo uses a KConfig to save its contents...
     KConfig config(sFrom, KConfig::SimpleConfig);
 
@@ -315,7 +318,7 @@ KigDocument *KigFilterKGeo::loadObjects(KConfig *c)
         os[i]->calc(*ret);
     }; // for loop (creating KGeoHierarchyElements..
 
-    ret->addObjects(os);
+    filtersAddObjects(*ret, os);
     ret->setGrid(grid);
     ret->setAxes(axes);
     return ret;
@@ -7,6 +7,8 @@
 
 #include "filter.h"
 
+#include <QMutex>
+
 class KConfig;
 
 /**
@@ -36,4 +38,6 @@ protected:
     int yMax;
     bool grid;
     bool axes;
+
+    QMutex mmutex;
 };
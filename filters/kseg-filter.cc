@@ -8,7 +8,6 @@
 #include "kseg-defs.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_part.h"
 #include "../misc/coordinate.h"
 #include "../objects/angle_type.h"
 #include "../objects/arc_type.h"
@@ -646,7 +645,6 @@ KigDocument *KigFilterKSeg::load(const QString &file)
                                                           false,
                                                           args2,
                                                           *retdoc);
-            oc2->calc(*retdoc);
             ObjectDrawer *d2 = new ObjectDrawer(style.pen.color());
             ObjectHolder *o2 = new ObjectHolder(oc2, d2);
             ret2.push_back(o2);
@@ -670,8 +668,8 @@ KigDocument *KigFilterKSeg::load(const QString &file)
     };
 
     // no more data in the file.
-    retdoc->addObjects(ret);
-    retdoc->addObjects(ret2);
+    filtersAddObjects(*retdoc, ret);
+    filtersAddObjects(*retdoc, ret2);
     retdoc->setAxes(false);
     retdoc->setGrid(false);
     return retdoc;
@@ -49,6 +49,10 @@
 #define KDE_TRUNC(a) rint(a)
 #endif
 
+// the Asymptote picture is as wide as the lines of the document, which
+// we take to be those of an a4 article: 345pt
+static const double asyLineWidth = 345 / 72.27;
+
 struct ColorMap {
     QColor color;
     QString name;
@@ -77,7 +81,8 @@ class PSTricksExportImpVisitor : public ObjectImpVisitor
 {
     QTextStream &mstream;
     ObjectHolder *mcurobj;
-    const KigWidget &mw;
+    const KigDocument &mdoc;
+    const ScreenInfo msi;
     Rect msr;
     std::vector<ColorMap> mcolors;
     QString mcurcolorid;
@@ -86,10 +91,27 @@ public:
     void visit(ObjectHolder *obj);
     void mapColor(const QColor &color);
 
-    PSTricksExportImpVisitor(QTextStream &s, const KigWidget &w)
+    PSTricksExportImpVisitor(QTextStream &s, const KigDocument &doc, const ScreenInfo &si)
+        : mstream(s)
+        , mdoc(doc)
+        , msi(si)
+        , msr(si.shownRect())
+        , tolerance(0.)
+    {
+    }
+    /**
+     * a copy of \p other , with the colors it mapped, that writes to
+     * \p s .
+     */
+    PSTricksExportImpVisitor(const PSTricksExportImpVisitor &other, QTextStream &s)
         : mstream(s)
-        , mw(w)
-        , msr(mw.showingRect())
+        , mcurobj(nullptr)
+        , mdoc(other.mdoc)
+        , msi(other.msi)
+        , msr(other.msr)
+        , mcolors(other.mcolors)
+        , unit(other.unit)
+        , tolerance(other.tolerance)
     {
     }
     using ObjectImpVisitor::visit;
@@ -112,6 +134,10 @@ public:
     void visit(const RationalBezierImp *imp) override;
 
     double unit;
+    /**
+     * the tolerance to simplify the curves with, \see sampleCurve
+     */
+    double tolerance;
 
 private:
     /**
@@ -195,7 +221,7 @@ void PSTricksExportImpVisitor::mapColor(const QColor &color)
 double PSTricksExportImpVisitor::dimRealToCoord(int dim)
 {
     QRect qr(0, 0, dim, dim);
-    Rect r = mw.screenInfo().fromScreen(qr);
+    Rect r = msi.fromScreen(qr);
     return fabs(r.width());
 }
 
@@ -219,51 +245,23 @@ void PSTricksExportImpVisitor::plotGenericCurve(const CurveImp *imp)
 
     QString prefix = QStringLiteral("\\pscurve[linecolor=%1,linewidth=%2,%3]").arg(mcurcolorid).arg(width / 100.0).arg(writeStyle(mcurobj->drawer()->style()));
 
-    std::vector<std::vector<Coordinate>> coordlist;
-    coordlist.push_back(std::vector<Coordinate>());
-    uint curid = 0;
-
-    Coordinate c;
-    Coordinate prev = Coordinate::invalidCoord();
-    for (double i = 0.0; i <= 1.0; i += 0.005) {
-        c = imp->getPoint(i, mw.document());
-        if (!c.valid()) {
-            if (coordlist[curid].size() > 0) {
-                coordlist.push_back(std::vector<Coordinate>());
-                ++curid;
-                prev = Coordinate::invalidCoord();
-            }
-            continue;
-        }
-        if (!((fabs(c.x) <= 1000) && (fabs(c.y) <= 1000)))
-            continue;
-        // if there's too much distance between this coordinate and the previous
-        // one, then it's another piece of curve not joined with the rest
-        if (prev.valid() && (c.distance(prev) > 4.0)) {
-            coordlist.push_back(std::vector<Coordinate>());
-            ++curid;
-        }
-        coordlist[curid].push_back(c);
-        prev = c;
-    }
-    // special case for ellipse
-    if (const ConicImp *conic = dynamic_cast<const ConicImp *>(imp)) {
-        // if ellipse, close its path
-        if (conic->conicType() == 1 && coordlist.size() == 1 && coordlist[0].size() > 1) {
-            coordlist[0].push_back(coordlist[0][0]);
-        }
-    }
-    for (uint i = 0; i < coordlist.size(); ++i) {
-        uint s = coordlist[i].size();
-        // there's no point in draw curves empty or with only one point
-        if (s <= 1)
-            continue;
-
-        mstream << prefix;
-        for (uint j = 0; j < s; ++j)
-            emitCoord(coordlist[i][j]);
-        newLine();
-    }
+    sampleCurve(
+        imp,
+        mdoc,
+        0.005,
+        1000,
+        4.0,
+        true,
+        tolerance,
+        [this, &prefix]() {
+            mstream << prefix;
+        },
+        [this](const Coordinate &c) {
+            emitCoord(c);
+        },
+        [this]() {
+            newLine();
+        });
 }
 
 void PSTricksExportImpVisitor::visit(ObjectHolder *obj)
@@ -505,6 +503,11 @@ void PSTricksExportImpVisitor::visit(const RationalBezierImp *imp)
     plotGenericCurve(imp);
 }
 
+bool LatexExporter::supportsFormat(const QString &format) const
+{
+    return format == QLatin1String("tex");
+}
+
 void LatexExporter::run(const KigPart &doc, KigWidget &w)
 {
     KigFileDialog *kfd =
@@ -524,37 +527,46 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
         opts->setFormat((LatexExporterOptions::LatexOutputFormat)fmt);
     }
     opts->setStandalone(cg.readEntry("Standalone", true));
+    opts->setResolution(cg.readEntry("CurveResolution", opts->resolution()));
 
     if (!kfd->exec())
         return;
 
     QString file_name = kfd->selectedFile();
-    bool showgrid = opts->showGrid();
-    bool showaxes = opts->showAxes();
-    bool showframe = opts->showExtraFrame();
-    LatexExporterOptions::LatexOutputFormat format = opts->format();
-    bool standalone = opts->standalone();
+    KigExportOptions eopts;
+    eopts.showGrid = opts->showGrid();
+    eopts.showAxes = opts->showAxes();
+    eopts.extraFrame = opts->showExtraFrame();
+    eopts.latexFormat = opts->format();
+    eopts.standalone = opts->standalone();
+    eopts.resolution = opts->resolution();
 
     delete opts;
     delete kfd;
 
-    cg.writeEntry("OutputFormat", (int)format);
-    cg.writeEntry("Standalone", standalone);
+    cg.writeEntry("OutputFormat", eopts.latexFormat);
+    cg.writeEntry("Standalone", eopts.standalone);
+    cg.writeEntry("CurveResolution", eopts.resolution);
 
-    QFile file(file_name);
-    if (!file.open(QIODevice::WriteOnly)) {
+    if (!exportDocument(doc.document(), w.screenInfo(), file_name, eopts)) {
         KMessageBox::error(&w,
                            i18n("The file \"%1\" could not be opened. Please "
                                 "check if the file permissions are set correctly.",
                                 file_name));
-        return;
-    };
+    }
+}
+
+bool LatexExporter::exportDocument(const KigDocument &doc, const ScreenInfo &si, const QString &file_name, const KigExportOptions &opts) const
+{
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
 
     QTextStream stream(&file);
-    std::vector<ObjectHolder *> os = doc.document().objects();
+    std::vector<ObjectHolder *> os = doc.objects();
 
-    if (format == LatexExporterOptions::PSTricks) {
-        if (standalone) {
+    if (opts.latexFormat == LatexExporterOptions::PSTricks) {
+        if (opts.standalone) {
             stream << "\\documentclass[a4paper]{minimal}\n";
             //  stream << "\\usepackage[latin1]{inputenc}\n";
             stream << "\\usepackage{pstricks}\n";
@@ -563,10 +575,10 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
             stream << "\\begin{document}\n";
         }
 
-        const double bottom = w.showingRect().bottom();
-        const double left = w.showingRect().left();
-        const double height = w.showingRect().height();
-        const double width = w.showingRect().width();
+        const double bottom = si.shownRect().bottom();
+        const double left = si.shownRect().left();
+        const double height = si.shownRect().height();
+        const double width = si.shownRect().width();
 
         /*
           // TODO: calculating aspect ratio...
@@ -583,8 +595,10 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
         stream << "\\psset{xunit=" << xunit << "}\n";
         stream << "\\psset{yunit=" << yunit << "}\n";
 
-        PSTricksExportImpVisitor visitor(stream, w);
+        PSTricksExportImpVisitor visitor(stream, doc, si);
         visitor.unit = xunit;
+        // the picture is tmpwidth cm wide
+        visitor.tolerance = opts.simplifyTolerance(width, tmpwidth / 2.54);
 
         for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i) {
             if (!(*i)->shown())
@@ -597,7 +611,7 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
         visitor.mapColor(QColor(192, 192, 192)); // c0c0c0 - grid color
 
         // extra frame
-        if (showframe) {
+        if (opts.extraFrame) {
             stream << "\\psframe[linecolor=black,linewidth=0.02]"
                    << "(0,0)"
                    << "(" << width << "," << height << ")"
@@ -605,7 +619,7 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
         }
 
         // grid
-        if (showgrid) {
+        if (opts.showGrid) {
             // vertical lines...
             double startingpoint = -left - 1 + static_cast<int>(KDE_TRUNC(left));
             for (double i = startingpoint; i < width; ++i) {
@@ -626,7 +640,7 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
         }
 
         // axes
-        if (showaxes) {
+        if (opts.showAxes) {
             stream << "\\psaxes[linecolor=a0a0a4,linewidth=0.03,ticks=none,arrowinset=0]{->}"
                    << "(" << -left << "," << -bottom << ")"
                    << "(0,0)"
@@ -634,28 +648,31 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
                    << "\n";
         }
 
-        for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i) {
-            visitor.visit(*i);
-        };
+        exportObjects(stream, os, [&visitor](QTextStream &s, ObjectHolder *o) {
+            PSTricksExportImpVisitor v(visitor, s);
+            v.visit(o);
+        });
 
         stream << "\\end{pspicture*}\n";
-        if (standalone) {
+        if (opts.standalone) {
             stream << "\\end{document}\n";
         }
-    } else if (format == LatexExporterOptions::TikZ) {
-        if (standalone) {
+    } else if (opts.latexFormat == LatexExporterOptions::TikZ) {
+        if (opts.standalone) {
             stream << "\\documentclass[a4paper]{minimal}\n";
             stream << "\\usepackage{tikz}\n";
             stream << "\\usetikzlibrary{calc}\n";
             stream << "\\usepgflibrary{fpu}\n";
             stream << "\\begin{document}\n";
         }
-        PGFExporterImpVisitor visitor(stream, w);
+        PGFExporterImpVisitor visitor(stream, doc, si);
 
-        Rect frameRect = w.showingRect();
+        Rect frameRect = si.shownRect();
 
         double size = qMax(frameRect.height(), frameRect.width());
         double scale = (size == 0) ? 1 : 10 / size;
+        // a unit is scale cm
+        visitor.tolerance = opts.simplifyTolerance(frameRect.width(), frameRect.width() * scale / 2.54);
 
         // Start a figure and set its global options
         stream << "\\begin{tikzpicture}"
@@ -671,7 +688,7 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
         // extra frame for clipping
         stream << "\\clip (" << gLeft << ',' << gBottom << ") rectangle (" << gRight << ',' << gTop << ");\n";
 
-        if (showgrid) {
+        if (opts.showGrid) {
             stream << "\\draw [help lines] (" << floor(qMin(0.0, gRight)) << ',' << floor(qMin(0.0, gTop)) << ") grid (" << ceil(qMax(0.0, gRight)) << ','
                    << ceil(qMax(0.0, gTop)) << ");\n";
             stream << "\\draw [help lines] (" << floor(qMin(0.0, gLeft)) << ',' << floor(qMin(0.0, gTop)) << ") grid (" << ceil(qMax(0.0, gLeft)) << ','
@@ -681,7 +698,7 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
             stream << "\\draw [help lines] (" << floor(qMin(0.0, gLeft)) << ',' << floor(qMin(0.0, gBottom)) << ") grid (" << ceil(qMax(0.0, gLeft)) << ','
                    << ceil(qMax(0.0, gBottom)) << ");\n";
         }
-        if (showaxes) {
+        if (opts.showAxes) {
             if (gBottom < 0 && gTop > 0) {
                 stream << "\\draw [color=black,->] (" << gLeft << ",0) -- (" << gRight << ",0);\n";
             }
@@ -689,29 +706,30 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
                 stream << "\\draw [color=black,->] (0," << gBottom << ") -- (0," << gTop << ");\n";
             }
         }
-        if (showframe) {
+        if (opts.extraFrame) {
             stream << "\\draw [color=black] (" << gLeft << ',' << gBottom << ") rectangle (" << gRight << ',' << gTop << ");\n";
         }
 
         // Visit all the objects
-        for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i) {
-            visitor.visit(*i);
-        };
+        exportObjects(stream, os, [&visitor](QTextStream &s, ObjectHolder *o) {
+            PGFExporterImpVisitor v(visitor, s);
+            v.visit(o);
+        });
 
         stream << "\\end{tikzpicture}\n";
 
         // The file footer in case we embed into full latex document
-        if (standalone) {
+        if (opts.standalone) {
             stream << "\\end{document}\n";
         }
 
-    } else if (format == LatexExporterOptions::Asymptote) {
-        const double bottom = w.showingRect().bottom();
-        const double left = w.showingRect().left();
-        const double height = w.showingRect().height();
-        const double width = w.showingRect().width();
+    } else if (opts.latexFormat == LatexExporterOptions::Asymptote) {
+        const double bottom = si.shownRect().bottom();
+        const double left = si.shownRect().left();
+        const double height = si.shownRect().height();
+        const double width = si.shownRect().width();
 
-        if (standalone) {
+        if (opts.standalone) {
             // The header if we embed into latex
             stream << "\\documentclass[a4paper,10pt]{article}\n";
             stream << "\\usepackage{asymptote}\n";
@@ -730,7 +748,7 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
         stream << "\n";
 
         // grid
-        if (showgrid) {
+        if (opts.showGrid) {
             // TODO: Polar grid
             // vertical lines...
             double startingpoint = static_cast<double>(KDE_TRUNC(left));
@@ -745,23 +763,25 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
         }
 
         // axes
-        if (showaxes) {
+        if (opts.showAxes) {
             stream << "draw((" << left << ",0)--(" << left + width << ",0), black, Arrow);\n";
             stream << "draw((0," << bottom << ")--(0," << bottom + height << "), black, Arrow);\n";
         }
 
         // Visit all the objects
-        AsyExporterImpVisitor visitor(stream, w);
+        AsyExporterImpVisitor visitor(stream, doc, si);
+        visitor.tolerance = opts.simplifyTolerance(width, asyLineWidth);
 
-        for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i) {
-            visitor.visit(*i);
-        }
+        exportObjects(stream, os, [&visitor](QTextStream &s, ObjectHolder *o) {
+            AsyExporterImpVisitor v(visitor, s);
+            v.visit(o);
+        });
 
         // extra frame for clipping
         stream << "path frame = (" << left << "," << bottom << ")--(" << left << "," << bottom + height << ")--(" << left + width << "," << bottom + height
                << ")--(" << left + width << "," << bottom << ")--cycle;\n";
 
-        if (showframe) {
+        if (opts.extraFrame) {
             stream << "draw(frame, black);\n";
         }
         stream << "clip(frame);\n";
@@ -769,11 +789,12 @@ void LatexExporter::run(const KigPart &doc, KigWidget &w)
         stream << "\\end{asy}\n";
 
         // The file footer in case we embed into latex
-        if (standalone) {
+        if (opts.standalone) {
             stream << "\\end{document}\n";
         }
     }
 
     // And close the output file
     file.close();
+    return true;
 }
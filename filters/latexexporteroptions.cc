@@ -8,6 +8,7 @@
 
 #include <QCheckBox>
 #include <QLayout>
+#include <QSpinBox>
 
 LatexExporterOptions::LatexExporterOptions(QWidget *parent)
     : QWidget(parent)
@@ -96,4 +97,14 @@ bool LatexExporterOptions::showExtraFrame() const
     return expwidget->showFrameCheckBox->isChecked();
 }
 
+void LatexExporterOptions::setResolution(int dpi)
+{
+    expwidget->resolutionSpinBox->setValue(dpi);
+}
+
+int LatexExporterOptions::resolution() const
+{
+    return expwidget->resolutionSpinBox->value();
+}
+
 #include "moc_latexexporteroptions.cpp"
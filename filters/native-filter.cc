@@ -5,7 +5,7 @@
 #include "native-filter.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_part.h"
+#include "../misc/binary_stream.h"
 #include "../misc/calcpaths.h"
 #include "../misc/coordinate_system.h"
 #include "../objects/bogus_imp.h"
@@ -22,18 +22,29 @@
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <QDebug>
 #include <QDomElement>
 #include <QFile>
 #include <QFont>
+#include <QHash>
 #include <QStandardPaths>
 #include <QTextStream>
+#include <QtEndian>
 
 #include <KTar>
 #include <KLazyLocalizedString>
 
+// the first bytes of a file in the binary format
+static const char binaryMagic[] = "KIGB";
+// the version of the binary format.  Increment this when the format
+// changes, loadBinary() refuses files with a newer version.  Version 1,
+// which wrote the number of parents of a calcer as a single byte, was
+// only ever written by development versions, and isn't read.
+static const quint32 binaryVersion = 2;
+
 struct HierElem {
     int id;
     std::vector<int> parents;
@@ -77,9 +88,14 @@ KigFilterNative::~KigFilterNative()
 {
 }
 
+const char *KigFilterNative::binaryMimeType()
+{
+    return "application/x-kig-binary";
+}
+
 bool KigFilterNative::supportMime(const QString &mime)
 {
-    return mime == QLatin1String("application/x-kig");
+    return mime == QLatin1String("application/x-kig") || mime == QLatin1String(binaryMimeType());
 }
 
 KigDocument *KigFilterNative::load(const QString &file)
@@ -90,6 +106,19 @@ KigDocument *KigFilterNative::load(const QString &file)
         return nullptr;
     };
 
+    if (ffile.peek(4) == binaryMagic) {
+        const qint64 size = ffile.size();
+        uchar *map = ffile.map(0, size);
+        if (map) {
+            KigDocument *ret = loadBinary(reinterpret_cast<const char *>(map), size);
+            ffile.unmap(map);
+            return ret;
+        }
+        // not every file can be mapped, read those the usual way
+        const QByteArray data = ffile.readAll();
+        return loadBinary(data.constData(), data.size());
+    }
+
     QFile kigdoc(file);
     bool iscompressed = false;
     if (!file.endsWith(QLatin1String(".kig"), Qt::CaseInsensitive)) {
@@ -671,6 +700,8 @@ bool KigFilterNative::save07(const KigDocument &kdoc, QTextStream &stream)
 
 bool KigFilterNative::save(const KigDocument &data, const QString &file)
 {
+    if (file.endsWith(QLatin1String(".kigb"), Qt::CaseInsensitive))
+        return saveBinary(data, file);
     return save07(data, file);
 }
 
@@ -729,3 +760,288 @@ bool KigFilterNative::save07(const KigDocument &data, const QString &outfile)
     // we should never reach this point...
     return false;
 }
+
+#define KIG_BINARY_PARSE_ERROR                                                                                                                                 \
+    {                                                                                                                                                          \
+        parseError(i18n("An error was encountered at line %1 in file %2.", __LINE__, __FILE__));                                                               \
+        return false;                                                                                                                                          \
+    }
+
+KigDocument *KigFilterNative::loadBinary(const char *data, qint64 size, std::vector<ObjectCalcer::shared_ptr> *calcersout)
+{
+    if (size < 4 || qstrncmp(data, binaryMagic, 4) != 0)
+        KIG_FILTER_PARSE_ERROR;
+    KigBinaryReader r(data + 4, size - 4);
+
+    const quint32 version = r.readUInt32();
+    const quint32 kigversion = r.readUInt32();
+    if (!r.ok())
+        KIG_FILTER_PARSE_ERROR;
+    if (version < binaryVersion)
+        KIG_FILTER_PARSE_ERROR;
+    if (version > binaryVersion) {
+        notSupported(
+            i18n("This file was created by Kig version \"%1\", "
+                 "which this version cannot open.",
+                 QStringLiteral("%1.%2.%3").arg(kigversion >> 16).arg((kigversion >> 8) & 0xff).arg(kigversion & 0xff)));
+        return nullptr;
+    }
+    if (!r.readStringTable())
+        KIG_FILTER_PARSE_ERROR;
+
+    std::unique_ptr<KigDocument> ret(new KigDocument());
+    const quint8 flags = r.readUInt8();
+    ret->setGrid(flags & 1);
+    ret->setAxes(flags & 2);
+    const QByteArray cstype = r.readString();
+    if (!r.ok())
+        KIG_FILTER_PARSE_ERROR;
+    CoordinateSystem *s = CoordinateSystemFactory::build(cstype.constData());
+    if (!s) {
+        warning(
+            i18n("This Kig file has a coordinate system "
+                 "that this Kig version does not support.\n"
+                 "A standard coordinate system will be used "
+                 "instead."));
+    } else
+        ret->setCoordinateSystem(s);
+
+    std::vector<ObjectCalcer::shared_ptr> calcers;
+    std::vector<ObjectHolder *> holders;
+    if (!loadBinaryCalcers(r, *ret, calcers))
+        return nullptr;
+    if (!loadBinaryHolders(r, calcers, holders)) {
+        delete_all(holders.begin(), holders.end());
+        return nullptr;
+    }
+    if (!r.atEnd()) {
+        delete_all(holders.begin(), holders.end());
+        KIG_FILTER_PARSE_ERROR;
+    }
+
+    // we calculated the calcers in loadBinaryCalcers() already
+    ret->addCalculatedObjects(holders);
+    if (calcersout)
+        calcersout->swap(calcers);
+    return ret.release();
+}
+
+bool KigFilterNative::loadBinaryCalcers(KigBinaryReader &r, const KigDocument &doc, std::vector<ObjectCalcer::shared_ptr> &calcers)
+{
+    // the names in the string table are looked up once, not for every
+    // calcer that uses them
+    QHash<quint32, const ObjectType *> types;
+
+    const quint32 count = r.readUInt32();
+    // every calcer takes at least 6 bytes
+    if (!r.ok() || count > r.bytesLeft() / 6)
+        KIG_BINARY_PARSE_ERROR;
+    calcers.reserve(calcers.size() + count);
+    std::vector<ObjectCalcer *> parents;
+    for (quint32 i = 0; i < count; ++i) {
+        const quint8 kind = r.readUInt8();
+        // polygons and labels can have any number of parents
+        const quint32 parentcount = r.readUInt32();
+        if (!r.ok() || parentcount > r.bytesLeft() / 4)
+            KIG_BINARY_PARSE_ERROR;
+        parents.clear();
+        for (quint32 j = 0; j < parentcount; ++j) {
+            const quint32 parentid = r.readUInt32();
+            if (!r.ok() || parentid >= calcers.size())
+                KIG_BINARY_PARSE_ERROR;
+            parents.push_back(calcers[parentid].get());
+        }
+
+        ObjectCalcer *o = nullptr;
+        if (kind == 0) {
+            if (!parents.empty())
+                KIG_BINARY_PARSE_ERROR;
+            QString error;
+            ObjectImp *imp = ObjectImpFactory::instance()->deserialize(r, error);
+            if (!imp) {
+                parseError(error);
+                return false;
+            }
+            o = new ObjectConstCalcer(imp);
+        } else if (kind == 1) {
+            const QByteArray &propname = r.readString();
+            if (!r.ok() || parents.size() != 1)
+                KIG_BINARY_PARSE_ERROR;
+            if (parents[0]->imp()->propertiesInternalNames().indexOf(propname) == -1)
+                KIG_BINARY_PARSE_ERROR;
+            o = new ObjectPropertyCalcer(parents[0], propname.constData());
+        } else if (kind == 2) {
+            const quint32 typenameid = r.readStringId();
+            QHash<quint32, const ObjectType *>::const_iterator t = types.constFind(typenameid);
+            if (t == types.constEnd()) {
+                const QByteArray &tname = r.string(typenameid);
+                if (!r.ok())
+                    KIG_BINARY_PARSE_ERROR;
+                const ObjectType *type = ObjectTypeFactory::instance()->find(tname.constData());
+                if (!type) {
+                    notSupported(
+                        i18n("This Kig file uses an object of type \"%1\", "
+                             "which this Kig version does not support."
+                             "Perhaps you have compiled Kig without support "
+                             "for this object type,"
+                             "or perhaps you are using an older Kig version.",
+                             QString::fromLatin1(tname)));
+                    return false;
+                }
+                t = types.insert(typenameid, type);
+            }
+            // don't sort the parents, see load07()
+            o = new ObjectTypeCalcer(t.value(), parents, false);
+        } else
+            KIG_BINARY_PARSE_ERROR;
+
+        o->calc(doc);
+        calcers.push_back(o);
+    }
+    return true;
+}
+
+bool KigFilterNative::loadBinaryHolders(KigBinaryReader &r, const std::vector<ObjectCalcer::shared_ptr> &calcers, std::vector<ObjectHolder *> &holders)
+{
+    QHash<quint32, QFont> fonts;
+    const quint32 count = r.readUInt32();
+    if (!r.ok() || count > r.bytesLeft() / 20)
+        KIG_BINARY_PARSE_ERROR;
+    holders.reserve(holders.size() + count);
+    for (quint32 i = 0; i < count; ++i) {
+        const quint32 id = r.readUInt32();
+        const quint32 ncid = r.readUInt32();
+        const QRgb color = r.readUInt32();
+        const bool shown = r.readUInt8();
+        const int width = r.readInt32();
+        const quint8 style = r.readUInt8();
+        const quint8 pointstyle = r.readUInt8();
+        const quint32 fontid = r.readStringId();
+        if (!r.ok() || id >= calcers.size() || ncid > calcers.size())
+            KIG_BINARY_PARSE_ERROR;
+        if (style > Qt::DashDotDotLine || pointstyle >= Kig::NumberOfPointStyles)
+            KIG_BINARY_PARSE_ERROR;
+
+        ObjectConstCalcer *namecalcer = nullptr;
+        // 0 means no name, the calcers are counted from 1 here
+        if (ncid > 0) {
+            namecalcer = dynamic_cast<ObjectConstCalcer *>(calcers[ncid - 1].get());
+            if (!namecalcer)
+                KIG_BINARY_PARSE_ERROR;
+        }
+
+        QHash<quint32, QFont>::const_iterator f = fonts.constFind(fontid);
+        if (f == fonts.constEnd()) {
+            QFont font;
+            const QByteArray &fontname = r.string(fontid);
+            if (!r.ok())
+                KIG_BINARY_PARSE_ERROR;
+            if (!fontname.isEmpty())
+                font.fromString(QString::fromUtf8(fontname));
+            f = fonts.insert(fontid, font);
+        }
+
+        ObjectDrawer *drawer =
+            new ObjectDrawer(QColor::fromRgba(color), width, shown, static_cast<Qt::PenStyle>(style), static_cast<Kig::PointStyle>(pointstyle), f.value());
+        holders.push_back(new ObjectHolder(calcers[id].get(), drawer, namecalcer));
+    }
+    return true;
+}
+
+QByteArray KigFilterNative::saveBinary(const KigDocument &kdoc, std::vector<ObjectCalcer *> *calcersout)
+{
+    KigBinaryWriter w;
+    w.writeUInt8((kdoc.grid() ? 1 : 0) | (kdoc.axes() ? 2 : 0));
+    w.writeString(kdoc.coordinateSystem().type());
+
+    std::vector<ObjectHolder *> holders = kdoc.objects();
+    std::vector<ObjectCalcer *> calcers = getAllParents(getAllCalcers(holders));
+    calcers = calcPath(calcers);
+
+    std::map<const ObjectCalcer *, int> idmap;
+    if (!saveBinaryCalcers(calcers, idmap, w))
+        return QByteArray();
+    saveBinaryHolders(holders, idmap, w);
+
+    const quint32 header[2] = {qToLittleEndian(binaryVersion), qToLittleEndian<quint32>(KIG_VERSION)};
+    if (calcersout)
+        calcersout->swap(calcers);
+    return QByteArray(binaryMagic, 4) + QByteArray(reinterpret_cast<const char *>(header), sizeof(header)) + w.finish();
+}
+
+bool KigFilterNative::saveBinaryCalcers(const std::vector<ObjectCalcer *> &calcers, std::map<const ObjectCalcer *, int> &idmap, KigBinaryWriter &w)
+{
+    w.writeUInt32(calcers.size());
+    for (std::vector<ObjectCalcer *>::const_iterator i = calcers.begin(); i != calcers.end(); ++i) {
+        quint8 kind = 0;
+        if (dynamic_cast<const ObjectPropertyCalcer *>(*i))
+            kind = 1;
+        else if (dynamic_cast<const ObjectTypeCalcer *>(*i))
+            kind = 2;
+        else
+            assert(dynamic_cast<const ObjectConstCalcer *>(*i));
+        w.writeUInt8(kind);
+
+        const std::vector<ObjectCalcer *> parents = (*i)->parents();
+        w.writeUInt32(parents.size());
+        for (std::vector<ObjectCalcer *>::const_iterator j = parents.begin(); j != parents.end(); ++j) {
+            std::map<const ObjectCalcer *, int>::const_iterator idp = idmap.find(*j);
+            assert(idp != idmap.end());
+            w.writeUInt32(idp->second);
+        }
+
+        if (kind == 0) {
+            if (!ObjectImpFactory::instance()->serialize(*(*i)->imp(), w))
+                return false;
+        } else if (kind == 1) {
+            const ObjectPropertyCalcer *o = static_cast<const ObjectPropertyCalcer *>(*i);
+            w.writeString(o->parent()->imp()->getPropName(o->propGid()));
+        } else
+            w.writeString(static_cast<const ObjectTypeCalcer *>(*i)->type()->fullName());
+
+        const int id = idmap.size();
+        idmap[*i] = id;
+    }
+    return true;
+}
+
+void KigFilterNative::saveBinaryHolders(const std::vector<ObjectHolder *> &holders, const std::map<const ObjectCalcer *, int> &idmap, KigBinaryWriter &w)
+{
+    w.writeUInt32(holders.size());
+    for (std::vector<ObjectHolder *>::const_iterator i = holders.begin(); i != holders.end(); ++i) {
+        std::map<const ObjectCalcer *, int>::const_iterator idp = idmap.find((*i)->calcer());
+        assert(idp != idmap.end());
+        w.writeUInt32(idp->second);
+
+        ObjectCalcer *namecalcer = (*i)->nameCalcer();
+        if (namecalcer) {
+            std::map<const ObjectCalcer *, int>::const_iterator ncp = idmap.find(namecalcer);
+            assert(ncp != idmap.end());
+            w.writeUInt32(ncp->second + 1);
+        } else
+            w.writeUInt32(0);
+
+        const ObjectDrawer *d = (*i)->drawer();
+        w.writeUInt32(d->color().rgba());
+        w.writeUInt8(d->shown());
+        w.writeInt32(d->width());
+        w.writeUInt8(d->style());
+        w.writeUInt8(d->pointStyle());
+        w.writeString(d->font().toString().toUtf8());
+    }
+}
+
+bool KigFilterNative::saveBinary(const KigDocument &data, const QString &outfile)
+{
+    const QByteArray contents = saveBinary(data);
+    if (contents.isNull()) {
+        notSupported(i18n("This document contains objects that cannot be saved in the binary format. Please save it as a .kig file instead."));
+        return false;
+    }
+    QFile file(outfile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        fileNotFound(outfile);
+        return false;
+    }
+    return file.write(contents) == contents.size();
+}
@@ -6,6 +6,14 @@
 
 #include "filter.h"
 
+#include "../objects/object_calcer.h"
+
+#include <map>
+#include <vector>
+
+class KigBinaryReader;
+class KigBinaryWriter;
+class ObjectHolder;
 class QDomElement;
 class QDomDocument;
 class KigDocument;
@@ -37,16 +45,72 @@ private:
     bool save07(const KigDocument &data, const QString &outfile);
     bool save07(const KigDocument &data, QTextStream &file);
 
+    bool saveBinary(const KigDocument &data, const QString &outfile);
+
     KigFilterNative();
     ~KigFilterNative();
 
 public:
     static KigFilterNative *instance();
 
+    /**
+     * the mime type of the binary format, see loadBinary()
+     */
+    static const char *binaryMimeType();
+
     bool supportMime(const QString &mime) override;
     KigDocument *load(const QString &file) override;
     KigDocument *load(const QDomDocument &doc);
 
     bool save(const KigDocument &data, const QString &file);
+
+    /**
+     * Kig's binary format ( .kigb ) has the same contents as the XML
+     * format, but is much faster to read: it is memory mapped, the
+     * numbers are stored as they are in memory and the type and property
+     * names are stored once, in a string table, and referred to by
+     * their index.  It is:
+     *
+     * - the magic "KIGB", the format version and the version of Kig that
+     *   wrote it,
+     * - the string table ( see KigBinaryWriter ),
+     * - the document settings: grid, axes and coordinate system,
+     * - the calcers, see saveBinaryCalcers(),
+     * - the objects, see saveBinaryHolders().
+     *
+     * If \p calcers is not null, it is set to the calcers of the
+     * document, in the order in which the file refers to them.
+     */
+    KigDocument *loadBinary(const char *data, qint64 size, std::vector<ObjectCalcer::shared_ptr> *calcers = nullptr);
+    /**
+     * \p data in the binary format, or a null QByteArray if it contains
+     * data that the binary format can't express.
+     */
+    QByteArray saveBinary(const KigDocument &data, std::vector<ObjectCalcer *> *calcers = nullptr);
+
+    /**
+     * write \p calcers , sorted so that every calcer comes after its
+     * parents, to \p w .  A calcer refers to its parents by their id in
+     * \p idmap , and gets the next id itself, i.e. the size of \p idmap .
+     * Returns false if the imp of one of the const calcers can't be
+     * written, see ObjectImpFactory::serialize().
+     */
+    static bool saveBinaryCalcers(const std::vector<ObjectCalcer *> &calcers, std::map<const ObjectCalcer *, int> &idmap, KigBinaryWriter &w);
+    /**
+     * write \p holders , which refer to their calcer and name calcer by
+     * their id in \p idmap , and their drawer to \p w .
+     */
+    static void saveBinaryHolders(const std::vector<ObjectHolder *> &holders, const std::map<const ObjectCalcer *, int> &idmap, KigBinaryWriter &w);
+    /**
+     * read what saveBinaryCalcers() wrote, and append the calcers to
+     * \p calcers , whose positions are the ids.  The calcers are
+     * calculated for \p doc .
+     */
+    bool loadBinaryCalcers(KigBinaryReader &r, const KigDocument &doc, std::vector<ObjectCalcer::shared_ptr> &calcers);
+    /**
+     * read what saveBinaryHolders() wrote, and append the new holders
+     * to \p holders .
+     */
+    bool loadBinaryHolders(KigBinaryReader &r, const std::vector<ObjectCalcer::shared_ptr> &calcers, std::vector<ObjectHolder *> &holders);
     //  bool save( const KigDocument& data, QTextStream& stream );
 };
@@ -5,6 +5,8 @@
 
 #include "pgfexporterimpvisitor.h"
 
+#include "exporter.h"
+
 #include "../misc/goniometry.h"
 #include "../objects/bezier_imp.h"
 #include "../objects/circle_imp.h"
@@ -107,47 +109,32 @@ void PGFExporterImpVisitor::emitLine(const Coordinate &a, const Coordinate &b, c
 
 void PGFExporterImpVisitor::plotGenericCurve(const CurveImp *imp)
 {
-    std::vector<std::vector<Coordinate>> coordlist;
-    coordlist.push_back(std::vector<Coordinate>());
-    uint curid = 0;
-
-    Coordinate c;
-    Coordinate prev = Coordinate::invalidCoord();
-    for (double i = 0.0; i <= 1.0; i += 0.0001) {
-        c = imp->getPoint(i, mw.document());
-        if (!c.valid()) {
-            if (coordlist[curid].size() > 0) {
-                coordlist.push_back(std::vector<Coordinate>());
-                ++curid;
-                prev = Coordinate::invalidCoord();
+    const QString prefix = "\\draw [" + emitStyle(mcurobj->drawer()) + ", /pgf/fpu,/pgf/fpu/output format=fixed ] ";
+    // the pieces are written while the curve is sampled, so we don't
+    // know which point is the last one: write the " -- " in front of all
+    // the others instead
+    uint linelength = 0;
+    bool firstpoint = true;
+    sampleCurve(
+        imp,
+        mdoc,
+        0.0001,
+        10000,
+        50.0,
+        false,
+        tolerance,
+        [this, &prefix, &linelength, &firstpoint]() {
+            mstream << prefix;
+            linelength = prefix.length();
+            firstpoint = true;
+        },
+        [this, &linelength, &firstpoint](const Coordinate &c) {
+            if (!firstpoint) {
+                linelength += 4;
+                mstream << " -- ";
             }
-            continue;
-        }
-        if (!((fabs(c.x) <= 10000) && (fabs(c.y) <= 10000)))
-            continue;
-        // if there's too much distance between this coordinate and the previous
-        // one, then it's another piece of curve not joined with the rest
-        if (prev.valid() && (c.distance(prev) > 50.0)) {
-            coordlist.push_back(std::vector<Coordinate>());
-            ++curid;
-        }
-        coordlist[curid].push_back(c);
-        prev = c;
-    }
-
-    for (uint i = 0; i < coordlist.size(); ++i) {
-        uint s = coordlist[i].size();
-        // there's no point in draw curves empty or with only one point
-        if (s <= 1)
-            continue;
-
-        QString tmp = "\\draw [" + emitStyle(mcurobj->drawer()) + ", /pgf/fpu,/pgf/fpu/output format=fixed ] ";
-        mstream << tmp;
-
-        uint linelength = tmp.length();
-
-        for (uint j = 0; j < s; ++j) {
-            tmp = emitCoord(coordlist[i][j]);
+            firstpoint = false;
+            const QString tmp = emitCoord(c);
             // Avoid too long lines in the output file
             if (linelength + tmp.length() > maxlinelength) {
                 linelength = tmp.length();
@@ -156,17 +143,11 @@ void PGFExporterImpVisitor::plotGenericCurve(const CurveImp *imp)
                 linelength += tmp.length();
             }
             mstream << tmp;
-
-            if (j < s - 1) {
-                linelength += 4;
-                mstream << " -- ";
-            } else {
-                newLine();
-                linelength = 0;
-            }
-        }
-        newLine();
-    }
+        },
+        [this]() {
+            newLine();
+            newLine();
+        });
 }
 
 void PGFExporterImpVisitor::visit(ObjectHolder *obj)
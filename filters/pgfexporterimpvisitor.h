@@ -6,8 +6,7 @@
 #pragma once
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_part.h"
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 
 #include "../objects/bezier_imp.h"
 #include "../objects/circle_imp.h"
@@ -23,20 +22,37 @@
 #include "../objects/polygon_imp.h"
 #include "../objects/text_imp.h"
 
+#include <QTextStream>
+
 class PGFExporterImpVisitor : public ObjectImpVisitor
 {
     QTextStream &mstream;
     ObjectHolder *mcurobj;
-    const KigWidget &mw;
+    const KigDocument &mdoc;
+    const ScreenInfo msi;
     Rect msr;
 
 public:
     void visit(ObjectHolder *obj);
 
-    PGFExporterImpVisitor(QTextStream &s, const KigWidget &w)
+    PGFExporterImpVisitor(QTextStream &s, const KigDocument &doc, const ScreenInfo &si)
+        : mstream(s)
+        , mdoc(doc)
+        , msi(si)
+        , msr(si.shownRect())
+        , tolerance(0.)
+    {
+    }
+    /**
+     * a copy of \p other that writes to \p s .
+     */
+    PGFExporterImpVisitor(const PGFExporterImpVisitor &other, QTextStream &s)
         : mstream(s)
-        , mw(w)
-        , msr(mw.showingRect())
+        , mcurobj(nullptr)
+        , mdoc(other.mdoc)
+        , msi(other.msi)
+        , msr(other.msr)
+        , tolerance(other.tolerance)
     {
     }
     using ObjectImpVisitor::visit;
@@ -59,6 +75,10 @@ public:
     void visit(const RationalBezierImp *imp) override;
 
     double unit;
+    /**
+     * the tolerance to simplify the curves with, \see sampleCurve
+     */
+    double tolerance;
 
 private:
     /** Maximal line length in the output file. To avoid too long line which
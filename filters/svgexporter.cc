@@ -55,8 +55,10 @@ void SVGExporter::run(const KigPart &part, KigWidget &w)
         return;
 
     QString file_name = kfd->selectedFile();
-    bool showgrid = opts->showGrid();
-    bool showaxes = opts->showAxes();
+    KigExportOptions eopts;
+    eopts.showGrid = opts->showGrid();
+    eopts.showAxes = opts->showAxes();
+    eopts.resolution = opts->resolution();
 
     delete opts;
     delete kfd;
@@ -69,8 +71,25 @@ void SVGExporter::run(const KigPart &part, KigWidget &w)
                                 file_name));
         return;
     };
+    file.close();
 
-    QRect viewrect(w.screenInfo().viewRect());
+    if (!exportDocument(part.document(), w.screenInfo(), file_name, eopts)) {
+        KMessageBox::error(&w, i18n("Sorry, something went wrong while saving to SVG file \"%1\"", file_name));
+    }
+}
+
+bool SVGExporter::supportsFormat(const QString &format) const
+{
+    return format == QLatin1String("svg");
+}
+
+bool SVGExporter::exportDocument(const KigDocument &doc, const ScreenInfo &si, const QString &file_name, const KigExportOptions &opts) const
+{
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QRect viewrect(si.viewRect());
     QRect r(0, 0, viewrect.width(), viewrect.height());
 
     // workaround for QSvgGenerator bug not checking for already open device
@@ -78,20 +97,20 @@ void SVGExporter::run(const KigPart &part, KigWidget &w)
     QSvgGenerator pic;
     pic.setOutputDevice(&file);
     pic.setSize(r.size());
-    KigPainter *p = new KigPainter(ScreenInfo(w.screenInfo().shownRect(), viewrect), &pic, part.document());
+    KigPainter *p = new KigPainter(ScreenInfo(si.shownRect(), viewrect), &pic, doc);
+    p->setSimplifyTolerance(opts.simplifyTolerance(si.shownRect().width(), r.width() / double(pic.resolution())));
     //  p->setWholeWinOverlay();
     //  p->setBrushColor( Qt::white );
     //  p->setBrushStyle( Qt::SolidPattern );
     //  p->drawRect( r );
     //  p->setBrushStyle( Qt::NoBrush );
     //  p->setWholeWinOverlay();
-    p->drawGrid(part.document().coordinateSystem(), showgrid, showaxes);
-    p->drawObjects(part.document().objects(), false);
+    p->drawGrid(doc.coordinateSystem(), opts.showGrid, opts.showAxes);
+    p->drawObjects(doc.objects(), false);
 
     delete p;
 
-    if (!file.flush()) {
-        KMessageBox::error(&w, i18n("Sorry, something went wrong while saving to SVG file \"%1\"", file_name));
-    }
+    const bool ok = file.flush();
     file.close();
+    return ok;
 }
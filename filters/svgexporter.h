@@ -21,4 +21,6 @@ public:
     QString menuEntryName() const override;
     QString menuIcon() const override;
     void run(const KigPart &part, KigWidget &w) override;
+    bool supportsFormat(const QString &format) const override;
+    bool exportDocument(const KigDocument &doc, const ScreenInfo &si, const QString &file, const KigExportOptions &opts) const override;
 };
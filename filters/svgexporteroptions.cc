@@ -8,6 +8,7 @@
 
 #include <QCheckBox>
 #include <QLayout>
+#include <QSpinBox>
 
 SVGExporterOptions::SVGExporterOptions(QWidget *parent)
     : QWidget(parent)
@@ -43,4 +44,14 @@ bool SVGExporterOptions::showAxes() const
     return expwidget->showAxesCheckBox->isChecked();
 }
 
+void SVGExporterOptions::setResolution(int dpi)
+{
+    expwidget->resolutionSpinBox->setValue(dpi);
+}
+
+int SVGExporterOptions::resolution() const
+{
+    return expwidget->resolutionSpinBox->value();
+}
+
 #include "moc_svgexporteroptions.cpp"
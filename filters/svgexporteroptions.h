@@ -22,4 +22,10 @@ public:
     bool showGrid() const;
     void setAxes(bool axes);
     bool showAxes() const;
+    /**
+     * the resolution, in dots per inch, to simplify the curves to, or 0
+     * to not simplify them.  \see KigExportOptions::resolution
+     */
+    void setResolution(int dpi);
+    int resolution() const;
 };
@@ -10,8 +10,10 @@
 #include "../kig/kig_part.h"
 #include "../kig/kig_view.h"
 #include "../misc/common.h"
+#include "../misc/coordinate_buffer.h"
 #include "../misc/kigfiledialog.h"
 #include "../misc/kigpainter.h"
+#include "../misc/kigtransform.h"
 #include "../objects/circle_imp.h"
 #include "../objects/line_imp.h"
 #include "../objects/object_drawer.h"
@@ -60,7 +62,8 @@ class XFigExportImpVisitor : public ObjectImpVisitor
 {
     QTextStream &mstream;
     ObjectHolder *mcurobj;
-    const KigWidget &mw;
+    const KigDocument &mdoc;
+    const ScreenInfo msi;
     Rect msr;
     std::map<QColor, int> mcolormap;
     int mnextcolorid;
@@ -76,15 +79,17 @@ class XFigExportImpVisitor : public ObjectImpVisitor
     }
 
     void emitLine(const Coordinate &a, const Coordinate &b, int width, bool vector = false);
+    void emitPoints(const std::vector<Coordinate> &pts);
 
 public:
     void visit(ObjectHolder *obj);
     void mapColor(const ObjectDrawer *obj);
 
-    XFigExportImpVisitor(QTextStream &s, const KigWidget &w)
+    XFigExportImpVisitor(QTextStream &s, const KigDocument &doc, const ScreenInfo &si)
         : mstream(s)
-        , mw(w)
-        , msr(mw.showingRect())
+        , mdoc(doc)
+        , msi(si)
+        , msr(si.shownRect())
         , mnextcolorid(32)
     {
         // predefined colors in XFig..
@@ -97,6 +102,21 @@ public:
         mcolormap[Qt::yellow] = 6;
         mcolormap[Qt::white] = 7;
     }
+    /**
+     * a copy of \p other , with the colors it mapped, that writes to
+     * \p s .
+     */
+    XFigExportImpVisitor(const XFigExportImpVisitor &other, QTextStream &s)
+        : mstream(s)
+        , mcurobj(nullptr)
+        , mdoc(other.mdoc)
+        , msi(other.msi)
+        , msr(other.msr)
+        , mcolormap(other.mcolormap)
+        , mnextcolorid(other.mnextcolorid)
+        , mcurcolorid(0)
+    {
+    }
     using ObjectImpVisitor::visit;
     void visit(const LineImp *imp) override;
     void visit(const PointImp *imp) override;
@@ -409,6 +429,37 @@ void XFigExportImpVisitor::visit(const ArcImp *imp)
             << "\n";
 }
 
+void XFigExportImpVisitor::emitPoints(const std::vector<Coordinate> &pts)
+{
+    // convertCoord, but for all of the points at once..
+    double data[3][3] = {{1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}};
+    const double scale = 9450 / msr.width();
+    data[1][0] = -msr.left() * scale;
+    data[1][1] = scale;
+    data[2][0] = (msr.height() + msr.bottom()) * scale;
+    data[2][2] = -scale;
+    CoordinateBuffer xfigpts(pts);
+    xfigpts.transform(Transformation(data, true));
+
+    // write the list of points, max 6 per line..
+    bool in_line = false;
+    for (uint i = 0; i < xfigpts.size(); ++i) {
+        int m = i % 6;
+        if (m == 0) {
+            in_line = true;
+            mstream << "\t";
+        }
+        QPoint p = xfigpts[i].toQPoint();
+        mstream << " " << p.x() << " " << p.y();
+        if (m == 5) {
+            in_line = false;
+            mstream << "\n";
+        }
+    }
+    if (in_line)
+        mstream << "\n";
+}
+
 void XFigExportImpVisitor::visit(const FilledPolygonImp *imp)
 {
     int width = mcurobj->drawer()->width();
@@ -439,23 +490,7 @@ void XFigExportImpVisitor::visit(const FilledPolygonImp *imp)
     mstream << pts.size(); // it has n (well, n+1) points
     mstream << "\n";
 
-    // write the list of points, max 6 per line..
-    bool in_line = false;
-    for (uint i = 0; i < pts.size(); ++i) {
-        int m = i % 6;
-        if (m == 0) {
-            in_line = true;
-            mstream << "\t";
-        }
-        QPoint p = convertCoord(pts[i]);
-        mstream << " " << p.x() << " " << p.y();
-        if (m == 5) {
-            in_line = false;
-            mstream << "\n";
-        }
-    }
-    if (in_line)
-        mstream << "\n";
+    emitPoints(pts);
 }
 
 void XFigExportImpVisitor::visit(const ClosedPolygonalImp *imp)
@@ -488,23 +523,7 @@ void XFigExportImpVisitor::visit(const ClosedPolygonalImp *imp)
     mstream << pts.size(); // it has n (well, n+1) points
     mstream << "\n";
 
-    // write the list of points, max 6 per line..
-    bool in_line = false;
-    for (uint i = 0; i < pts.size(); ++i) {
-        int m = i % 6;
-        if (m == 0) {
-            in_line = true;
-            mstream << "\t";
-        }
-        QPoint p = convertCoord(pts[i]);
-        mstream << " " << p.x() << " " << p.y();
-        if (m == 5) {
-            in_line = false;
-            mstream << "\n";
-        }
-    }
-    if (in_line)
-        mstream << "\n";
+    emitPoints(pts);
 }
 void XFigExportImpVisitor::visit(const OpenPolygonalImp *imp)
 {
@@ -532,23 +551,7 @@ void XFigExportImpVisitor::visit(const OpenPolygonalImp *imp)
     mstream << pts.size(); // it has n (well, n+1) points
     mstream << "\n";
 
-    // write the list of points, max 6 per line..
-    bool in_line = false;
-    for (uint i = 0; i < pts.size(); ++i) {
-        int m = i % 6;
-        if (m == 0) {
-            in_line = true;
-            mstream << "\t";
-        }
-        QPoint p = convertCoord(pts[i]);
-        mstream << " " << p.x() << " " << p.y();
-        if (m == 5) {
-            in_line = false;
-            mstream << "\n";
-        }
-    }
-    if (in_line)
-        mstream << "\n";
+    emitPoints(pts);
 }
 
 void XFigExporter::run(const KigPart &doc, KigWidget &w)
@@ -562,14 +565,24 @@ void XFigExporter::run(const KigPart &doc, KigWidget &w)
 
     delete kfd;
 
-    QFile file(file_name);
-    if (!file.open(QIODevice::WriteOnly)) {
+    if (!exportDocument(doc.document(), w.screenInfo(), file_name, KigExportOptions())) {
         KMessageBox::error(&w,
                            i18n("The file \"%1\" could not be opened. Please "
                                 "check if the file permissions are set correctly.",
                                 file_name));
-        return;
-    };
+    }
+}
+
+bool XFigExporter::supportsFormat(const QString &format) const
+{
+    return format == QLatin1String("fig");
+}
+
+bool XFigExporter::exportDocument(const KigDocument &doc, const ScreenInfo &si, const QString &file_name, const KigExportOptions &) const
+{
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
     QTextStream stream(&file);
     stream << "#FIG 3.2  Produced by Kig\n";
     stream << "Landscape\n";
@@ -581,14 +594,16 @@ void XFigExporter::run(const KigPart &doc, KigWidget &w)
     stream << "-2\n";
     stream << "1200 2\n";
 
-    std::vector<ObjectHolder *> os = doc.document().objects();
-    XFigExportImpVisitor visitor(stream, w);
+    std::vector<ObjectHolder *> os = doc.objects();
+    XFigExportImpVisitor visitor(stream, doc, si);
 
     for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i) {
         visitor.mapColor((*i)->drawer());
     };
 
-    for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i) {
-        visitor.visit(*i);
-    };
+    exportObjects(stream, os, [&visitor](QTextStream &s, ObjectHolder *o) {
+        XFigExportImpVisitor v(visitor, s);
+        v.visit(o);
+    });
+    return true;
 }
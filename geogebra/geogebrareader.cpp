@@ -0,0 +1,378 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "geogebrareader.h"
+
+#include <kig/kig_document.h>
+#include <misc/coordinate.h>
+#include <objects/bogus_imp.h>
+#include <objects/object_calcer.h>
+#include <objects/object_drawer.h>
+#include <objects/object_factory.h>
+#include <objects/object_type_factory.h>
+
+#include <QDebug>
+#include <QXmlStreamReader>
+
+// Enumerations of the Line Styles used by Geogebra
+// The values 0, 10, 15, 20 are the values used by Geogebra to represent the corresponding styles.
+enum {
+    SOLIDLINE = 0,
+    DASHDOTDOTLINE = 10,
+    DASHLINE = 15,
+    DOTLINE = 20,
+    DASHDOTLINE = 30,
+};
+
+// Enumerations of the point styles used by Geogebra.
+enum {
+    SOLIDCIRCLEPOINT = 0,
+    CROSSPOINT,
+    HOLLOWCIRCLEPOINT,
+    PLUSPOINT,
+    SOLIDDIAMONDPOINT,
+    HOLLOWDIAMONDPOINT,
+    UPARROWPOINT,
+    DOWNARROWPOINT,
+    RIGHTARROWPOINT,
+    LEFTARROWPOINT
+};
+
+static Qt::PenStyle penStyleFromGeogebra(int penType)
+{
+    switch (penType) {
+    case DASHDOTDOTLINE:
+        return Qt::DashDotDotLine;
+    case DASHLINE:
+        return Qt::DashLine;
+    case DOTLINE:
+        return Qt::DotLine;
+    case DASHDOTLINE:
+        return Qt::DashDotLine;
+    default:
+        return Qt::SolidLine;
+    };
+}
+
+static Kig::PointStyle pointStyleFromGeogebra(int pt)
+{
+    if (pt == SOLIDCIRCLEPOINT)
+        return Kig::Round;
+    else if (pt == SOLIDDIAMONDPOINT || pt == UPARROWPOINT || pt == DOWNARROWPOINT || pt == RIGHTARROWPOINT || pt == LEFTARROWPOINT)
+        return Kig::Rectangular;
+    else if (pt == HOLLOWCIRCLEPOINT)
+        return Kig::Round; // TODO should be mapped to RoundEmpty ( i.e. 1) but for some reason it is not drawing in KIG
+    else if (pt == HOLLOWDIAMONDPOINT)
+        return Kig::Rectangular; // TODO should be mapped to RectangularEmpty ( i.e. 3) but for some reason it is not drawing in KIG
+    else if (pt == CROSSPOINT || pt == PLUSPOINT)
+        return Kig::Cross;
+    return Kig::Round;
+}
+
+/*
+ * the GeoGebra commands that always map to the same Kig type.  The
+ * names are the internal names of the Kig ObjectType's.
+ */
+static const QHash<QByteArray, QByteArray> &simpleCommandTypes()
+{
+    static const QHash<QByteArray, QByteArray> types = {
+        {"Segment", "SegmentAB"},
+        {"Ray", "RayAB"},
+        {"Midpoint", "Midpoint"},
+        {"OrthogonalLine", "LinePerpend"},
+        {"PolyLine", "OpenPolygon"},
+        {"Vector", "Vector"},
+        {"Polygon", "PolygonBNP"},
+        {"CircumcircleArc", "ArcBTP"},
+        {"Parabola", "ParabolaBDP"},
+        {"Ellipse", "EllipseBFFP"},
+        {"Hyperbola", "HyperbolaBFFP"},
+        {"Conic", "ConicB5P"},
+        {"Translate", "Translation"},
+        {"Dilate", "ScalingOverCenter"},
+        {"Polar", "ConicPolarLine"},
+    };
+    return types;
+}
+
+GeogebraReader::Style::Style()
+    : show(true)
+    , width(-1)
+    , penStyle(Qt::SolidLine)
+    , pointStyle(Kig::Round)
+    , color(0, 0, 0)
+{
+}
+
+GeogebraReader::GeogebraReader(KigDocument *document)
+    : m_document(document)
+{
+}
+
+GeogebraReader::~GeogebraReader()
+{
+}
+
+bool GeogebraReader::read(QIODevice *device)
+{
+    QXmlStreamReader xml(device);
+    if (xml.readNextStartElement() && xml.name() == QLatin1String("geogebra"))
+        readGeogebra(xml);
+    else
+        xml.raiseError(QStringLiteral("not a GeoGebra file"));
+
+    if (xml.hasError()) {
+        qWarning() << "Error reading GeoGebra file:" << xml.errorString() << "at line" << xml.lineNumber();
+        return false;
+    }
+    return true;
+}
+
+void GeogebraReader::readGeogebra(QXmlStreamReader &xml)
+{
+    while (xml.readNextStartElement()) {
+        if (xml.name() == QLatin1String("euclidianView"))
+            readEuclidianView(xml);
+        else if (xml.name() == QLatin1String("construction"))
+            readConstruction(xml, std::vector<QByteArray>(), std::vector<QByteArray>());
+        else if (xml.name() == QLatin1String("macro"))
+            readMacro(xml);
+        else
+            xml.skipCurrentElement();
+    }
+}
+
+void GeogebraReader::readEuclidianView(QXmlStreamReader &xml)
+{
+    while (xml.readNextStartElement()) {
+        if (xml.name() == QLatin1String("evSettings")) {
+            const QXmlStreamAttributes attrs = xml.attributes();
+            if (attrs.hasAttribute(QLatin1String("axes")))
+                m_document->setAxes(attrs.value(QLatin1String("axes")) == QLatin1String("true"));
+            if (attrs.hasAttribute(QLatin1String("grid")))
+                m_document->setGrid(attrs.value(QLatin1String("grid")) == QLatin1String("true"));
+        }
+        xml.skipCurrentElement();
+    }
+}
+
+void GeogebraReader::readMacro(QXmlStreamReader &xml)
+{
+    const QXmlStreamAttributes attrs = xml.attributes();
+    const QString name = attrs.value(QLatin1String("toolName")).toString();
+    const QString description = attrs.value(QLatin1String("toolHelp")).toString();
+
+    std::vector<QByteArray> inputs;
+    std::vector<QByteArray> outputs;
+    while (xml.readNextStartElement()) {
+        if (xml.name() == QLatin1String("macroInput") || xml.name() == QLatin1String("macroOutput")) {
+            std::vector<QByteArray> &labels = xml.name() == QLatin1String("macroInput") ? inputs : outputs;
+            const QXmlStreamAttributes labelattrs = xml.attributes();
+            for (const QXmlStreamAttribute &a : labelattrs)
+                labels.push_back(a.value().toLatin1());
+            xml.skipCurrentElement();
+        } else if (xml.name() == QLatin1String("construction")) {
+            readConstruction(xml, inputs, outputs);
+            m_sections.back().setName(name);
+            m_sections.back().setDescription(description);
+        } else
+            xml.skipCurrentElement();
+    }
+}
+
+void GeogebraReader::readConstruction(QXmlStreamReader &xml, const std::vector<QByteArray> &inputs, const std::vector<QByteArray> &outputs)
+{
+    m_objectMap.clear();
+    m_objects.clear();
+    m_styles.clear();
+    m_commandOf.clear();
+    m_elementTypeOf.clear();
+
+    while (xml.readNextStartElement()) {
+        if (xml.name() == QLatin1String("element"))
+            readElement(xml);
+        else if (xml.name() == QLatin1String("command"))
+            readCommand(xml);
+        else
+            xml.skipCurrentElement();
+    }
+
+    m_sections.push_back(GeogebraSection());
+    GeogebraSection &section = m_sections.back();
+    if (inputs.empty()) {
+        // Not handling input/output objects, put everything in second
+        for (std::vector<std::pair<QByteArray, ObjectCalcer *>>::const_iterator i = m_objects.begin(); i != m_objects.end(); ++i) {
+            const Style style = m_styles.value(i->first);
+            section.addOutputObject(i->second);
+            section.addDrawer(new ObjectDrawer(style.color, style.width, style.show, style.penStyle, style.pointStyle));
+        }
+    } else {
+        for (std::vector<QByteArray>::const_iterator i = inputs.begin(); i != inputs.end(); ++i)
+            if (ObjectCalcer *oc = m_objectMap.value(*i))
+                section.addInputObject(oc);
+        for (std::vector<QByteArray>::const_iterator i = outputs.begin(); i != outputs.end(); ++i)
+            if (ObjectCalcer *oc = m_objectMap.value(*i))
+                section.addOutputObject(oc);
+    }
+}
+
+void GeogebraReader::readElement(QXmlStreamReader &xml)
+{
+    const QXmlStreamAttributes attrs = xml.attributes();
+    const QByteArray label = attrs.value(QLatin1String("label")).toLatin1();
+    const QByteArray type = attrs.value(QLatin1String("type")).toLatin1();
+    m_elementTypeOf.insert(label, type);
+
+    Style style;
+    Coordinate coords = Coordinate::invalidCoord();
+    int pointSize = -1;
+    while (xml.readNextStartElement()) {
+        const QXmlStreamAttributes a = xml.attributes();
+        if (xml.name() == QLatin1String("show"))
+            style.show = a.value(QLatin1String("object")) != QLatin1String("false");
+        else if (xml.name() == QLatin1String("objColor"))
+            style.color = QColor(a.value(QLatin1String("r")).toInt(), a.value(QLatin1String("g")).toInt(), a.value(QLatin1String("b")).toInt());
+        else if (xml.name() == QLatin1String("lineStyle")) {
+            if (a.hasAttribute(QLatin1String("thickness")))
+                style.width = a.value(QLatin1String("thickness")).toInt();
+            style.penStyle = penStyleFromGeogebra(a.value(QLatin1String("type")).toInt());
+        } else if (xml.name() == QLatin1String("pointSize"))
+            pointSize = a.value(QLatin1String("val")).toInt();
+        else if (xml.name() == QLatin1String("pointStyle"))
+            style.pointStyle = pointStyleFromGeogebra(a.value(QLatin1String("val")).toInt());
+        else if (xml.name() == QLatin1String("coords")) {
+            // homogeneous coordinates
+            double z = a.hasAttribute(QLatin1String("z")) ? a.value(QLatin1String("z")).toDouble() : 1.;
+            if (z == 0.)
+                z = 1.;
+            coords = Coordinate(a.value(QLatin1String("x")).toDouble() / z, a.value(QLatin1String("y")).toDouble() / z);
+        }
+        xml.skipCurrentElement();
+    }
+
+    if (type == "point") {
+        if (pointSize >= 0)
+            style.width = pointSize + 6;
+        // a point that no command of ours constructed: either a free
+        // point, or the result of a command we don't support, which we
+        // can only keep where it is now..
+        if (!m_objectMap.contains(label) && coords.valid()) {
+            ObjectTypeCalcer *oc = ObjectFactory::instance()->fixedPointCalcer(coords);
+            oc->calc(*m_document);
+            addObject(label, oc);
+        }
+    }
+    m_styles.insert(label, style);
+}
+
+void GeogebraReader::readCommand(QXmlStreamReader &xml)
+{
+    const QByteArray command = xml.attributes().value(QLatin1String("name")).toLatin1();
+    std::vector<QByteArray> inputs;
+    QByteArray label;
+    while (xml.readNextStartElement()) {
+        const QXmlStreamAttributes attrs = xml.attributes();
+        if (xml.name() == QLatin1String("input")) {
+            for (const QXmlStreamAttribute &a : attrs)
+                inputs.push_back(a.value().toLatin1());
+        } else if (xml.name() == QLatin1String("output")) {
+            for (const QXmlStreamAttribute &a : attrs) {
+                const QByteArray output = a.value().toLatin1();
+                m_commandOf.insert(output, command);
+                if (label.isEmpty())
+                    label = output;
+            }
+        }
+        xml.skipCurrentElement();
+    }
+
+    const ObjectType *type = kigType(command, inputs);
+    if (!type || label.isEmpty() || m_objectMap.contains(label))
+        return;
+
+    std::vector<ObjectCalcer *> args;
+    for (std::vector<QByteArray>::const_iterator i = inputs.begin(); i != inputs.end(); ++i) {
+        bool isDoubleValue;
+        i->toDouble(&isDoubleValue);
+        if (!isDoubleValue && !m_objectMap.contains(*i)) {
+            qWarning() << "GeoGebra object" << label << "depends on unknown object" << *i;
+            return;
+        }
+    }
+    for (std::vector<QByteArray>::const_iterator i = inputs.begin(); i != inputs.end(); ++i) {
+        bool isDoubleValue;
+        const double dblval = i->toDouble(&isDoubleValue);
+        if (isDoubleValue)
+            /* This is to handle the circle-point-radius, dilate (and similar) type of Geogebra objects.
+             * <command name="Circle">
+             * <input a0="A" a1="3"/>
+             * <output a0="c"/>
+             *
+             * Notice the attribute 'a1' of the 'input' element. The value - '3' is the radius of the circle.
+             */
+            args.push_back(new ObjectConstCalcer(new DoubleImp(dblval)));
+        else
+            args.push_back(m_objectMap.value(*i));
+    }
+
+    ObjectTypeCalcer *oc = new ObjectTypeCalcer(type, args);
+    oc->calc(*m_document);
+    addObject(label, oc);
+}
+
+const ObjectType *GeogebraReader::kigType(const QByteArray &command, const std::vector<QByteArray> &inputs) const
+{
+    const char *name = nullptr;
+    QHash<QByteArray, QByteArray>::const_iterator simple = simpleCommandTypes().find(command);
+    if (simple != simpleCommandTypes().end())
+        name = simple->constData();
+    else if (command == "Line") {
+        // a line through a point, parallel to another line
+        bool parallel = false;
+        for (std::vector<QByteArray>::const_iterator i = inputs.begin(); i != inputs.end(); ++i)
+            parallel = parallel || m_commandOf.value(*i) == "Line";
+        name = parallel ? "LineParallel" : "LineAB";
+    } else if (command == "Circle") {
+        if (inputs.size() == 3)
+            name = "CircleBTP";
+        else if (inputs.size() == 2) {
+            /*
+             * separate geogebra's circle-center-point type from compass and circle-center-radius types
+             * if both the inputs are of point type then the circle is of circle-center-point type (CircleBCPType),
+             * otherwise (CircleBPRType).
+             */
+            const bool twopoints = m_elementTypeOf.value(inputs[0]) == "point" && m_elementTypeOf.value(inputs[1]) == "point";
+            name = twopoints ? "CircleBCP" : "CircleBPR";
+        }
+    } else if (command == "Mirror") {
+        const QByteArray reflector = inputs.size() > 1 ? m_commandOf.value(inputs[1]) : QByteArray();
+        if (reflector == "Line")
+            name = "LineReflection";
+        else if (reflector == "Circle")
+            // TODO It cannot open reflection of Polygons.
+            name = "CircularInversion";
+        else
+            name = "PointReflection";
+    } else if (command == "Intersect") {
+        if (inputs.size() == 2 && m_commandOf.value(inputs[0]) == "Line" && m_commandOf.value(inputs[1]) == "Line")
+            name = "LineLineIntersection";
+    }
+    // Kig can't draw diameters of conics ( ?? )
+
+    if (!name)
+        return nullptr;
+    const ObjectType *type = ObjectTypeFactory::instance()->find(name);
+    if (!type)
+        qWarning() << name << " object not found!";
+    return type;
+}
+
+void GeogebraReader::addObject(const QByteArray &label, ObjectCalcer *oc)
+{
+    m_objectMap.insert(label, oc);
+    m_objects.push_back(std::make_pair(label, oc));
+}
@@ -0,0 +1,94 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QColor>
+#include <QHash>
+
+#include <vector>
+
+#include "../misc/point_style.h"
+#include "geogebrasection.h"
+
+class KigDocument;
+class ObjectType;
+class QIODevice;
+class QXmlStreamReader;
+
+/* This class reads the XML representation of a GeoGebra file ( the
+ * geogebra.xml of a worksheet or the geogebra_macro.xml of a tool file )
+ * into Kig's internal representation of objects ( with proper parent-child
+ * relationship ).
+ *
+ * It reads the XML in one pass with a QXmlStreamReader: GeoGebra writes
+ * every object after the objects it depends on, and the command that
+ * constructs an object before the element with its style, so we can
+ * build the objects as we go.  Nothing but the objects and their
+ * styles is kept in memory.
+ */
+class GeogebraReader
+{
+public:
+    explicit GeogebraReader(KigDocument *document);
+    ~GeogebraReader();
+
+    /**
+     * read the XML in \p device.  Returns false if it is not
+     * well-formed, in which case the sections read so far are still
+     * available.
+     */
+    bool read(QIODevice *device);
+
+    size_t getNumberOfSections() const
+    {
+        return m_sections.size();
+    };
+    const GeogebraSection &getSection(size_t sectionIdx) const
+    {
+        return m_sections[sectionIdx];
+    };
+
+private:
+    // the style of an object, from its element
+    struct Style {
+        Style();
+        bool show;
+        int width;
+        Qt::PenStyle penStyle;
+        Kig::PointStyle pointStyle;
+        QColor color;
+    };
+
+    void readGeogebra(QXmlStreamReader &xml);
+    void readEuclidianView(QXmlStreamReader &xml);
+    void readMacro(QXmlStreamReader &xml);
+    void readConstruction(QXmlStreamReader &xml, const std::vector<QByteArray> &inputs, const std::vector<QByteArray> &outputs);
+    void readElement(QXmlStreamReader &xml);
+    void readCommand(QXmlStreamReader &xml);
+
+    /**
+     * the Kig ObjectType to build for the GeoGebra command \p command with
+     * the inputs \p inputs, or 0 if we don't support it.
+     */
+    const ObjectType *kigType(const QByteArray &command, const std::vector<QByteArray> &inputs) const;
+    void addObject(const QByteArray &label, ObjectCalcer *oc);
+
+    KigDocument *m_document;
+    std::vector<GeogebraSection> m_sections;
+
+    /* the state of the construction we are reading */
+    QHash<QByteArray, ObjectCalcer *> m_objectMap;
+    // the objects in the order they were constructed in, with their labels
+    std::vector<std::pair<QByteArray, ObjectCalcer *>> m_objects;
+    QHash<QByteArray, Style> m_styles;
+    // the name of the command that constructed an object
+    QHash<QByteArray, QByteArray> m_commandOf;
+    // the type attribute of the element of an object
+    QHash<QByteArray, QByteArray> m_elementTypeOf;
+};
@@ -8,6 +8,7 @@
 #include "kig_commands.h"
 
 #include "kig_document.h"
+#include "kig_journal.h"
 #include "kig_part.h"
 #include "kig_view.h"
 
@@ -174,12 +175,14 @@ ChangeObjectConstCalcerTask::ChangeObjectConstCalcerTask(ObjectConstCalcer *calc
 void ChangeObjectConstCalcerTask::execute(KigPart &doc)
 {
     mnewimp = mcalcer->switchImp(mnewimp);
+    doc.document().objectsChanged();
 
     std::set<ObjectCalcer *> allchildren = getAllChildren(mcalcer.get());
     std::vector<ObjectCalcer *> allchildrenvect(allchildren.begin(), allchildren.end());
     allchildrenvect = calcPath(allchildrenvect);
     for (std::vector<ObjectCalcer *>::iterator i = allchildrenvect.begin(); i != allchildrenvect.end(); ++i)
         (*i)->calc(doc.document());
+    doc.journal().constCalcerChanged(mcalcer.get());
 }
 
 void ChangeObjectConstCalcerTask::unexecute(KigPart &doc)
@@ -250,6 +253,7 @@ void ChangeCoordSystemTask::execute(KigPart &doc)
     for (std::vector<ObjectCalcer *>::iterator i = calcpath.begin(); i != calcpath.end(); ++i)
         (*i)->calc(doc.document());
     doc.coordSystemChanged(doc.document().coordinateSystem().id());
+    doc.journal().documentChanged();
 }
 
 void ChangeCoordSystemTask::unexecute(KigPart &doc)
@@ -306,6 +310,7 @@ void ChangeParentsAndTypeTask::execute(KigPart &doc)
     allchildrenvect = calcPath(allchildrenvect);
     for (std::vector<ObjectCalcer *>::iterator i = allchildrenvect.begin(); i != allchildrenvect.end(); ++i)
         (*i)->calc(doc.document());
+    doc.journal().documentChanged();
 }
 
 void ChangeParentsAndTypeTask::unexecute(KigPart &doc)
@@ -336,11 +341,11 @@ KigViewShownRectChangeTask::~KigViewShownRectChangeTask()
     delete d;
 }
 
-void KigViewShownRectChangeTask::execute(KigPart &doc)
+void KigViewShownRectChangeTask::execute(KigPart &)
 {
     Rect oldrect = d->v.showingRect();
     d->v.setShowingRect(d->rect);
-    doc.mode()->redrawScreen(&d->v);
+    d->v.modeRedrawScreen();
     d->v.updateScrollBars();
     d->rect = oldrect;
 }
@@ -362,9 +367,11 @@ ChangeObjectDrawerTask::ChangeObjectDrawerTask(ObjectHolder *holder, ObjectDrawe
 {
 }
 
-void ChangeObjectDrawerTask::execute(KigPart &)
+void ChangeObjectDrawerTask::execute(KigPart &doc)
 {
     mnewdrawer = mholder->switchDrawer(mnewdrawer);
+    doc.document().objectsChanged();
+    doc.journal().documentChanged();
 }
 
 void ChangeObjectDrawerTask::unexecute(KigPart &doc)
@@ -24,6 +24,7 @@ KigDocument::KigDocument(const std::set<ObjectHolder *> &objects, CoordinateSyst
     , mshowaxes(showaxes)
     , mnightvision(nv)
     , mcoordinatePrecision(-1)
+    , mboundsvalid(false)
     , mcachedparam(0.0)
 {
 }
@@ -56,13 +57,13 @@ CoordinateSystem *KigDocument::switchCoordinateSystem(CoordinateSystem *s)
     return ret;
 }
 
-std::vector<ObjectHolder *> KigDocument::whatAmIOn(const Coordinate &p, const KigWidget &w) const
+std::vector<ObjectHolder *> KigDocument::whatAmIOn(const Coordinate &p, const ScreenInfo &si) const
 {
     std::vector<ObjectHolder *> ret;
     std::vector<ObjectHolder *> curves;
     std::vector<ObjectHolder *> fatobjects;
     for (std::set<ObjectHolder *>::const_iterator i = mobjects.begin(); i != mobjects.end(); ++i) {
-        if (!(*i)->contains(p, w, mnightvision))
+        if (!(*i)->contains(p, si, *this, mnightvision))
             continue;
         const ObjectImp *oimp = (*i)->imp();
         if (oimp->inherits(PointImp::stype()))
@@ -78,12 +79,12 @@ std::vector<ObjectHolder *> KigDocument::whatAmIOn(const Coordinate &p, const Ki
     return ret;
 }
 
-std::vector<ObjectHolder *> KigDocument::whatIsInHere(const Rect &p, const KigWidget &w)
+std::vector<ObjectHolder *> KigDocument::whatIsInHere(const Rect &p, const ScreenInfo &si)
 {
     std::vector<ObjectHolder *> ret;
     std::vector<ObjectHolder *> nonpoints;
     for (std::set<ObjectHolder *>::const_iterator i = mobjects.begin(); i != mobjects.end(); ++i) {
-        if (!(*i)->inRect(p, w))
+        if (!(*i)->inRect(p, si, *this))
             continue;
         if ((*i)->imp()->inherits(PointImp::stype()))
             ret.push_back(*i);
@@ -94,24 +95,32 @@ std::vector<ObjectHolder *> KigDocument::whatIsInHere(const Rect &p, const KigWi
     return ret;
 }
 
+// add the surroundingRect of \p o to \p bounds , if it is shown and
+// knows where it is..
+static void addToBounds(Rect &bounds, const ObjectHolder *o)
+{
+    if (!o->shown())
+        return;
+    Rect r = o->surroundingRect();
+    if (!r.valid())
+        return;
+    if (!bounds.valid())
+        bounds = r;
+    else
+        bounds.eat(r);
+}
+
 Rect KigDocument::suggestedRect() const
 {
-    bool rectInited = false;
-    Rect r(0., 0., 0., 0.);
-    for (std::set<ObjectHolder *>::const_iterator i = mobjects.begin(); i != mobjects.end(); ++i) {
-        if ((*i)->shown()) {
-            Rect cr = (*i)->imp()->surroundingRect();
-            if (!cr.valid())
-                continue;
-            if (!rectInited) {
-                r = cr;
-                rectInited = true;
-            } else
-                r.eat(cr);
-        };
-    };
+    if (!mboundsvalid) {
+        mbounds = Rect::invalidRect();
+        for (std::set<ObjectHolder *>::const_iterator i = mobjects.begin(); i != mobjects.end(); ++i)
+            addToBounds(mbounds, *i);
+        mboundsvalid = true;
+    }
 
-    if (!rectInited)
+    Rect r = mbounds;
+    if (!r.valid())
         return Rect(-5.5, -5.5, 11., 11.);
     r.setContains(Coordinate(0, 0));
     if (r.width() == 0)
@@ -124,25 +133,46 @@ Rect KigDocument::suggestedRect() const
     return r;
 }
 
+void KigDocument::objectsChanged() const
+{
+    mboundsvalid = false;
+}
+
 void KigDocument::addObject(ObjectHolder *o)
 {
     mobjects.insert(o);
+    // o may not have been calculated yet..
+    mboundsvalid = false;
 }
 
 void KigDocument::addObjects(const std::vector<ObjectHolder *> &os)
 {
+    // calculating the new objects doesn't change the ones we already
+    // have, so their bounds stay valid..
+    const bool boundsvalid = mboundsvalid;
     for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i)
         (*i)->calc(*this);
+    mboundsvalid = boundsvalid;
+    addCalculatedObjects(os);
+}
+
+void KigDocument::addCalculatedObjects(const std::vector<ObjectHolder *> &os)
+{
     std::copy(os.begin(), os.end(), std::inserter(mobjects, mobjects.begin()));
+    if (mboundsvalid)
+        for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i)
+            addToBounds(mbounds, *i);
 }
 
 void KigDocument::delObject(ObjectHolder *o)
 {
     mobjects.erase(o);
+    mboundsvalid = false;
 }
 
 void KigDocument::delObjects(const std::vector<ObjectHolder *> &os)
 {
+    mboundsvalid = false;
     for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i)
         mobjects.erase(*i);
 }
@@ -154,6 +184,8 @@ KigDocument::KigDocument()
     mshowaxes = true;
     mnightvision = false;
     mcoordinatePrecision = -1;
+    mboundsvalid = false;
+    mcachedparam = 0.0;
 }
 
 KigDocument::~KigDocument()
@@ -4,15 +4,17 @@
 
 #pragma once
 
+#include "../misc/rect.h"
+
+#include <atomic>
 #include <set>
 #include <vector>
 
 class Coordinate;
 class CoordinateSystem;
-class KigWidget;
 class ObjectHolder;
 class ObjectCalcer;
-class Rect;
+class ScreenInfo;
 
 /**
  * KigDocument is the class holding the real data in a Kig document.
@@ -54,8 +56,22 @@ class KigDocument
      */
     int mcoordinatePrecision;
 
+    /**
+     * suggestedRect() is needed after a lot of redraws, for the
+     * scrollbars, so we keep the union of the surroundingRect's of
+     * the shown objects.  New objects are added to it, and it is only
+     * computed again after objectsChanged(), or when objects have been
+     * removed.  Even then, only the objects that changed have their
+     * surroundingRect computed again, see
+     * ObjectHolder::surroundingRect().
+     */
+    mutable Rect mbounds;
+    mutable bool mboundsvalid;
+
 public:
-    mutable double mcachedparam;
+    // atomic, since the objects may be drawn from several threads at
+    // once, see drawObjectsTiled()
+    mutable std::atomic<double> mcachedparam;
 
 public:
     KigDocument();
@@ -104,12 +120,12 @@ public:
     /**
      * Return a vector of objects that contain the given point.
      */
-    std::vector<ObjectHolder *> whatAmIOn(const Coordinate &p, const KigWidget &w) const;
+    std::vector<ObjectHolder *> whatAmIOn(const Coordinate &p, const ScreenInfo &si) const;
 
     /**
      * Return a vector of objects that are in the given Rect.
      */
-    std::vector<ObjectHolder *> whatIsInHere(const Rect &p, const KigWidget &);
+    std::vector<ObjectHolder *> whatIsInHere(const Rect &p, const ScreenInfo &si);
 
     /**
      * Return a rect containing most of the objects, which would be a
@@ -117,6 +133,14 @@ public:
      */
     Rect suggestedRect() const;
 
+    /**
+     * tell the document that some of its calcers got a new ObjectImp,
+     * or some of its objects a new ObjectDrawer, so that
+     * suggestedRect() has to be computed again.  ObjectCalcer::calc()
+     * does this for you.
+     */
+    void objectsChanged() const;
+
     /**
      * Add the objects \p o to the document.
      */
@@ -125,6 +149,11 @@ public:
      * Add the objects \p os to the document.
      */
     void addObjects(const std::vector<ObjectHolder *> &os);
+    /**
+     * Add the objects \p os to the document, without calculating them
+     * first: they should already be, in this document.
+     */
+    void addCalculatedObjects(const std::vector<ObjectHolder *> &os);
     /**
      * Remove the object \p o from the document.
      */
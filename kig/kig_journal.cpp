@@ -0,0 +1,360 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "kig_journal.h"
+
+#include "kig_document.h"
+
+#include "../filters/native-filter.h"
+#include "../misc/binary_stream.h"
+#include "../misc/calcpaths.h"
+#include "../objects/common.h"
+#include "../objects/object_holder.h"
+#include "../objects/object_imp.h"
+#include "../objects/object_imp_factory.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QtEndian>
+
+#include <memory>
+#include <set>
+
+// the first bytes of a journal file
+static const char journalMagic[] = "KIGJ";
+static const quint32 journalVersion = 2;
+
+// the kinds of records in the journal.  Every record is its kind, the
+// size of its payload and the payload, which is what a KigBinaryWriter
+// wrote.  The journal always starts with a snapshot.
+enum JournalRecord { SnapshotRecord = 0, AddRecord, RemoveRecord, ChangeConstRecord };
+
+// wait this long before writing a snapshot, so that a series of changes
+// that need one only make us write one
+static const int snapshotDelay = 2000;
+// and never write one just because the journal is bigger than a tiny
+// snapshot
+static const qint64 minJournalSize = 64 * 1024;
+
+static QByteArray record(quint8 kind, const QByteArray &payload)
+{
+    const quint32 size = qToLittleEndian<quint32>(payload.size());
+    return QByteArray(1, static_cast<char>(kind)) + QByteArray(reinterpret_cast<const char *>(&size), sizeof(size)) + payload;
+}
+
+KigJournal::KigJournal(QObject *parent)
+    : QObject(parent)
+    , mdoc(nullptr)
+    , msnapshotpending(false)
+    , msnapshotsize(0)
+    , mjournalsize(0)
+    , msnapshottimer(new QTimer(this))
+{
+    mwriter.setMaxThreadCount(1);
+    msnapshottimer->setSingleShot(true);
+    msnapshottimer->setInterval(snapshotDelay);
+    connect(msnapshottimer, &QTimer::timeout, this, &KigJournal::writeSnapshot);
+}
+
+KigJournal::~KigJournal()
+{
+    stop();
+}
+
+QString KigJournal::journalFile(const QString &path)
+{
+    const QByteArray hash = QCryptographicHash::hash(QFileInfo(path).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/journal/") + QString::fromLatin1(hash)
+        + QStringLiteral(".kigj");
+}
+
+void KigJournal::start(const KigDocument *doc, const QString &path, bool modified)
+{
+    mdoc = doc;
+    mfile = journalFile(path);
+    mids.clear();
+    mcalcers.clear();
+    mjournalsize = 0;
+    msnapshottimer->stop();
+    if (modified) {
+        msnapshotpending = true;
+        writeSnapshot();
+    } else {
+        // the first change will need a snapshot, which then contains
+        // that change already
+        msnapshotpending = true;
+        const QString file = mfile;
+        mwriter.start([file]() {
+            QFile::remove(file);
+        });
+    }
+}
+
+void KigJournal::stop()
+{
+    msnapshottimer->stop();
+    if (!mfile.isEmpty()) {
+        const QString file = mfile;
+        mwriter.start([file]() {
+            QFile::remove(file);
+        });
+    }
+    mwriter.waitForDone();
+    mdoc = nullptr;
+    mfile.clear();
+    mids.clear();
+    mcalcers.clear();
+}
+
+void KigJournal::flush()
+{
+    mwriter.waitForDone();
+}
+
+void KigJournal::unsupported()
+{
+    // the binary format can't express the document, so we can't keep
+    // a journal of it.  A journal that stops here would be worse than
+    // none at all, since recovering it would silently lose changes.
+    qWarning() << "The document contains objects that the journal can't store, not keeping a journal of" << mfile;
+    stop();
+}
+
+void KigJournal::scheduleSnapshot()
+{
+    msnapshotpending = true;
+    if (!msnapshottimer->isActive())
+        msnapshottimer->start();
+}
+
+void KigJournal::writeSnapshot()
+{
+    if (!mdoc)
+        return;
+    std::vector<ObjectCalcer *> calcers;
+    const QByteArray snapshot = KigFilterNative::instance()->saveBinary(*mdoc, &calcers);
+    if (snapshot.isNull()) {
+        unsupported();
+        return;
+    }
+    mids.clear();
+    mcalcers.clear();
+    for (std::vector<ObjectCalcer *>::const_iterator i = calcers.begin(); i != calcers.end(); ++i) {
+        mids[*i] = mcalcers.size();
+        mcalcers.push_back(*i);
+    }
+    msnapshotpending = false;
+    msnapshotsize = snapshot.size();
+    mjournalsize = 0;
+
+    const quint32 version = qToLittleEndian(journalVersion);
+    const QByteArray contents =
+        QByteArray(journalMagic, 4) + QByteArray(reinterpret_cast<const char *>(&version), sizeof(version)) + record(SnapshotRecord, snapshot);
+    const QString file = mfile;
+    mwriter.start([file, contents]() {
+        QDir().mkpath(QFileInfo(file).absolutePath());
+        QSaveFile f(file);
+        if (!f.open(QIODevice::WriteOnly) || f.write(contents) != contents.size() || !f.commit())
+            qWarning() << "Could not write the journal" << file;
+    });
+}
+
+void KigJournal::append(quint8 kind, const QByteArray &payload)
+{
+    const QByteArray contents = record(kind, payload);
+    mjournalsize += contents.size();
+    const QString file = mfile;
+    mwriter.start([file, contents]() {
+        QFile f(file);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Append) || f.write(contents) != contents.size())
+            qWarning() << "Could not write the journal" << file;
+    });
+
+    // compact the journal once replaying it takes longer than loading
+    // a new snapshot
+    if (mjournalsize > qMax(msnapshotsize, minJournalSize))
+        scheduleSnapshot();
+}
+
+void KigJournal::objectsAdded(const std::vector<ObjectHolder *> &os)
+{
+    // while a snapshot is pending, it will contain the changes
+    if (!mdoc || msnapshotpending) {
+        if (mdoc)
+            scheduleSnapshot();
+        return;
+    }
+
+    std::vector<ObjectCalcer *> calcers = calcPath(getAllParents(getAllCalcers(os)));
+    std::vector<ObjectCalcer *> newcalcers;
+    for (std::vector<ObjectCalcer *>::const_iterator i = calcers.begin(); i != calcers.end(); ++i)
+        if (mids.find(*i) == mids.end()) {
+            newcalcers.push_back(*i);
+            mcalcers.push_back(*i);
+        }
+
+    KigBinaryWriter w;
+    if (!KigFilterNative::saveBinaryCalcers(newcalcers, mids, w)) {
+        unsupported();
+        return;
+    }
+    KigFilterNative::saveBinaryHolders(os, mids, w);
+    append(AddRecord, w.finish());
+}
+
+void KigJournal::objectsRemoved(const std::vector<ObjectHolder *> &os)
+{
+    if (!mdoc || msnapshotpending) {
+        if (mdoc)
+            scheduleSnapshot();
+        return;
+    }
+
+    KigBinaryWriter w;
+    w.writeUInt32(os.size());
+    for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i) {
+        std::map<const ObjectCalcer *, int>::const_iterator id = mids.find((*i)->calcer());
+        if (id == mids.end()) {
+            scheduleSnapshot();
+            return;
+        }
+        w.writeUInt32(id->second);
+    }
+    append(RemoveRecord, w.finish());
+}
+
+void KigJournal::constCalcerChanged(const ObjectConstCalcer *c)
+{
+    if (!mdoc || msnapshotpending) {
+        if (mdoc)
+            scheduleSnapshot();
+        return;
+    }
+
+    std::map<const ObjectCalcer *, int>::const_iterator id = mids.find(c);
+    if (id == mids.end()) {
+        // not in the document, e.g. a calcer of an object that is being
+        // constructed
+        return;
+    }
+    KigBinaryWriter w;
+    w.writeUInt32(id->second);
+    if (!ObjectImpFactory::instance()->serialize(*c->imp(), w)) {
+        unsupported();
+        return;
+    }
+    append(ChangeConstRecord, w.finish());
+}
+
+void KigJournal::documentChanged()
+{
+    if (mdoc)
+        scheduleSnapshot();
+}
+
+/**
+ * apply the record \p kind with payload \p r to \p doc , whose calcers
+ * are \p calcers .
+ */
+static bool replay(quint8 kind, KigBinaryReader &r, KigDocument &doc, std::vector<ObjectCalcer::shared_ptr> &calcers)
+{
+    KigFilterNative *filter = KigFilterNative::instance();
+    if (!r.readStringTable())
+        return false;
+    if (kind == AddRecord) {
+        std::vector<ObjectHolder *> holders;
+        if (!filter->loadBinaryCalcers(r, doc, calcers))
+            return false;
+        if (!filter->loadBinaryHolders(r, calcers, holders)) {
+            delete_all(holders.begin(), holders.end());
+            return false;
+        }
+        doc.addObjects(holders);
+    } else if (kind == RemoveRecord) {
+        const quint32 count = r.readUInt32();
+        std::set<ObjectCalcer *> removed;
+        for (quint32 i = 0; i < count; ++i) {
+            const quint32 id = r.readUInt32();
+            if (!r.ok() || id >= calcers.size())
+                return false;
+            removed.insert(calcers[id].get());
+        }
+        const std::vector<ObjectHolder *> objects = doc.objects();
+        for (std::vector<ObjectHolder *>::const_iterator i = objects.begin(); i != objects.end(); ++i)
+            if (removed.find((*i)->calcer()) != removed.end()) {
+                doc.delObject(*i);
+                delete *i;
+            }
+    } else if (kind == ChangeConstRecord) {
+        const quint32 id = r.readUInt32();
+        if (!r.ok() || id >= calcers.size())
+            return false;
+        ObjectConstCalcer *c = dynamic_cast<ObjectConstCalcer *>(calcers[id].get());
+        QString error;
+        ObjectImp *imp = ObjectImpFactory::instance()->deserialize(r, error);
+        if (!c || !imp) {
+            delete imp;
+            return false;
+        }
+        c->setImp(imp);
+    } else
+        return false;
+    return r.ok() && r.atEnd();
+}
+
+KigDocument *KigJournal::recover(const QString &path)
+{
+    QFile f(journalFile(path));
+    if (!f.open(QIODevice::ReadOnly))
+        return nullptr;
+    const QByteArray contents = f.readAll();
+    if (contents.size() < 8 || !contents.startsWith(journalMagic) || qFromLittleEndian<quint32>(contents.constData() + 4) != journalVersion)
+        return nullptr;
+
+    const char *pos = contents.constData() + 8;
+    const char *end = contents.constData() + contents.size();
+    std::unique_ptr<KigDocument> doc;
+    std::vector<ObjectCalcer::shared_ptr> calcers;
+    // a record that is cut off was being written when Kig crashed, stop
+    // there
+    while (end - pos >= 5) {
+        KigBinaryReader r(pos, end - pos);
+        const quint8 kind = r.readUInt8();
+        const quint32 size = r.readUInt32();
+        if (r.bytesLeft() < size)
+            break;
+        const char *payload = pos + 5;
+        pos = payload + size;
+
+        if (!doc) {
+            if (kind != SnapshotRecord)
+                return nullptr;
+            doc.reset(KigFilterNative::instance()->loadBinary(payload, size, &calcers));
+            if (!doc)
+                return nullptr;
+            continue;
+        }
+        KigBinaryReader pr(payload, size);
+        if (!replay(kind, pr, *doc, calcers)) {
+            qWarning() << "Could not replay the journal of" << path << "entirely";
+            break;
+        }
+    }
+
+    if (doc) {
+        std::vector<ObjectCalcer *> tmp = calcPath(getAllParents(getAllCalcers(doc->objects())));
+        for (std::vector<ObjectCalcer *>::iterator i = tmp.begin(); i != tmp.end(); ++i)
+            (*i)->calc(*doc);
+    }
+    return doc.release();
+}
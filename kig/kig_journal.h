@@ -0,0 +1,102 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include <map>
+#include <vector>
+
+#include "../objects/object_calcer.h"
+
+class KigDocument;
+class ObjectHolder;
+class QTimer;
+
+/**
+ * KigJournal keeps a copy of the unsaved changes to a document on disk,
+ * so that they can be recovered after a crash.
+ *
+ * The journal file starts with a snapshot of the entire document, in
+ * the binary native format, after which the changes that KigCommand's
+ * make are appended as they happen: added and removed objects, with
+ * only the new calcers, and new values of const calcers.  Changes that
+ * the journal can't express ( like a new coordinate system ), and a
+ * journal that has grown bigger than its snapshot, make it write a new
+ * snapshot a bit later, which replaces the whole file.
+ *
+ * The changes are serialized in the GUI thread, which is cheap since
+ * they are small, but written to disk by a thread of our own, in the
+ * order in which they happened, so that editing never waits for the
+ * disk.
+ */
+class KigJournal : public QObject
+{
+    Q_OBJECT
+
+    const KigDocument *mdoc;
+    QString mfile;
+    bool msnapshotpending;
+    qint64 msnapshotsize;
+    qint64 mjournalsize;
+    // the ids that the journal refers to calcers by.  mcalcers keeps the
+    // calcers alive until the next snapshot, so that a new calcer can't
+    // get the address, and with that the id, of a deleted one
+    std::map<const ObjectCalcer *, int> mids;
+    std::vector<ObjectCalcer::shared_ptr> mcalcers;
+    QTimer *msnapshottimer;
+    // has one thread, which does the writing
+    QThreadPool mwriter;
+
+    void scheduleSnapshot();
+    void unsupported();
+    void writeSnapshot();
+    void append(quint8 kind, const QByteArray &payload);
+
+public:
+    explicit KigJournal(QObject *parent = nullptr);
+    ~KigJournal();
+
+    /**
+     * the file the journal of the document stored at \p path is kept in.
+     */
+    static QString journalFile(const QString &path);
+    /**
+     * the document stored at \p path, with the changes in its journal
+     * applied, or 0 if the journal can't be read.
+     */
+    static KigDocument *recover(const QString &path);
+
+    /**
+     * start keeping the journal of \p doc, which is stored at \p path .
+     * If \p modified is false, the document has no unsaved changes, and
+     * an old journal of \p path is removed.  Otherwise it is replaced
+     * with a snapshot of \p doc right away.
+     */
+    void start(const KigDocument *doc, const QString &path, bool modified);
+    /**
+     * stop keeping the journal, and remove it.  Call this when the
+     * document is closed.
+     */
+    void stop();
+    /**
+     * wait until everything that was journaled so far is on disk.
+     */
+    void flush();
+
+    void objectsAdded(const std::vector<ObjectHolder *> &os);
+    void objectsRemoved(const std::vector<ObjectHolder *> &os);
+    void constCalcerChanged(const ObjectConstCalcer *c);
+    /**
+     * the document has changed in a way that the journal can't
+     * express: write a new snapshot.
+     */
+    void documentChanged();
+};
@@ -12,10 +12,12 @@
 #include "aboutdata.h"
 #include "kig_commands.h"
 #include "kig_document.h"
+#include "kig_journal.h"
 #include "kig_view.h"
 
 #include "../filters/exporter.h"
 #include "../filters/filter.h"
+#include "../filters/native-filter.h"
 #include "../misc/builtin_stuff.h"
 #include "../misc/calcpaths.h"
 #include "../misc/coordinate_system.h"
@@ -30,18 +32,22 @@
 #include "../objects/point_imp.h"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iterator>
 
+#include <QDir>
 #include <QDirIterator>
 #include <QFile>
 #include <QFileDialog>
+#include <QInputDialog>
 #include <QMimeDatabase>
 #include <QMimeType>
 #include <QPrintDialog>
 #include <QPrintPreviewDialog>
 #include <QPrinter>
 #include <QStandardPaths>
+#include <QThreadPool>
 #include <QTimer>
 
 #include <KActionCollection>
@@ -78,6 +84,42 @@ QStringList getDataFiles(const QString &folder)
     return dataFiles;
 }
 
+/**
+ * the filters are in kigcore, which has no widgets, so we show their
+ * messages for them, see KigFilterUi.
+ */
+class KigPartFilterUi : public KigFilterUi
+{
+public:
+    void error(const QString &text, const QString &explanation, const QString &title) override
+    {
+        if (explanation.isEmpty())
+            KMessageBox::error(nullptr, text, title);
+        else
+            KMessageBox::detailedError(nullptr, text, explanation, title);
+    }
+
+    void information(const QString &text) override
+    {
+        KMessageBox::information(nullptr, text);
+    }
+
+    bool chooseItem(const QString &title, const QString &label, const QStringList &items, QString &choice) override
+    {
+        bool ok = true;
+        const QString item = QInputDialog::getItem(nullptr, title, label, items, 0, false, &ok);
+        if (ok)
+            choice = item;
+        return ok;
+    }
+};
+
+static void setupFilterUi()
+{
+    static KigPartFilterUi ui;
+    KigFilter::setUi(&ui);
+}
+
 // export this class from this library...
 K_PLUGIN_CLASS_WITH_JSON(KigPart, "kig_part.json")
 
@@ -170,6 +212,8 @@ KigPart::KigPart(QWidget *parentWidget, QObject *parent, const KPluginMetaData &
     , mRememberConstruction(nullptr)
     , mdocument(new KigDocument())
 {
+    setupFilterUi();
+
     mMode = new NormalMode(*this);
 
     // we need a widget, to actually show the document
@@ -193,6 +237,8 @@ KigPart::KigPart(QWidget *parentWidget, QObject *parent, const KPluginMetaData &
     KUndoActions::createRedoAction(mhistory, actionCollection());
     connect(mhistory, &QUndoStack::cleanChanged, this, &KigPart::setHistoryClean);
 
+    mjournal = new KigJournal(this);
+
     // we are read-write by default
     setReadWrite(true);
 
@@ -362,6 +408,8 @@ KigPart::~KigPart()
     delete mMode;
     delete mhistory;
 
+    // we are closed, so the user doesn't want the unsaved changes
+    mjournal->stop();
     delete mdocument;
 }
 
@@ -397,7 +445,25 @@ bool KigPart::openFile()
         return false;
     };
 
-    KigDocument *newdoc = filter->load(localFilePath());
+    KigDocument *newdoc = nullptr;
+    bool recovered = false;
+    const QFileInfo journal(KigJournal::journalFile(localFilePath()));
+    // an older journal is left from before someone saved the file
+    // with another Kig
+    if (journal.exists() && journal.lastModified() >= QFileInfo(localFilePath()).lastModified()
+        && KMessageBox::questionTwoActions(widget(),
+                                           i18n("The document \"%1\" has changes that were not saved, "
+                                                "probably because Kig crashed. Do you want to recover them?",
+                                                localFilePath()),
+                                           i18n("Recover Unsaved Changes"),
+                                           KGuiItem(i18n("Recover")),
+                                           KStandardGuiItem::discard())
+            == KMessageBox::ButtonCode::PrimaryAction) {
+        newdoc = KigJournal::recover(localFilePath());
+        recovered = newdoc != nullptr;
+    }
+    if (!newdoc)
+        newdoc = filter->load(localFilePath());
     if (!newdoc) {
         closeUrl();
         setUrl(QUrl());
@@ -410,12 +476,14 @@ bool KigPart::openFile()
     aToggleAxes->setChecked(mdocument->axes());
     aToggleNightVision->setChecked(mdocument->getNightVision());
 
-    setModified(false);
     mhistory->clear();
+    // the recovered changes are not saved yet
+    setModified(recovered);
 
     std::vector<ObjectCalcer *> tmp = calcPath(getAllParents(getAllCalcers(document().objects())));
     for (std::vector<ObjectCalcer *>::iterator i = tmp.begin(); i != tmp.end(); ++i)
         (*i)->calc(document());
+    mjournal->start(mdocument, localFilePath(), recovered);
     Q_EMIT recenterScreen();
 
     redrawScreen();
@@ -430,7 +498,7 @@ bool KigPart::saveFile()
     // mimetype:
     const QMimeDatabase mimeDb;
     const QMimeType mimeType = mimeDb.mimeTypeForFile(localFilePath());
-    if (mimeType.name() != QLatin1String("application/x-kig")) {
+    if (mimeType.name() != QLatin1String("application/x-kig") && mimeType.name() != QLatin1String(KigFilterNative::binaryMimeType())) {
         // we don't support this mime type...
         if (KMessageBox::warningTwoActions(widget(),
                                            i18n("Kig does not support saving to any other file format than "
@@ -460,6 +528,7 @@ bool KigPart::saveFile()
     if (KigFilters::instance()->save(document(), localFilePath())) {
         setModified(false);
         mhistory->setClean();
+        mjournal->start(mdocument, localFilePath(), false);
         return true;
     }
     return false;
@@ -499,6 +568,7 @@ void KigPart::addObjects(const std::vector<ObjectHolder *> &os)
 void KigPart::_addObject(ObjectHolder *o)
 {
     document().addObject(o);
+    mjournal->objectsAdded(std::vector<ObjectHolder *>(1, o));
     setModified(true);
 }
 
@@ -513,12 +583,14 @@ void KigPart::delObject(ObjectHolder *o)
 void KigPart::_delObjects(const std::vector<ObjectHolder *> &o)
 {
     document().delObjects(o);
+    mjournal->objectsRemoved(o);
     setModified(true);
 }
 
 void KigPart::_delObject(ObjectHolder *o)
 {
     document().delObject(o);
+    mjournal->objectsRemoved(std::vector<ObjectHolder *>(1, o));
     setModified(true);
 }
 
@@ -532,9 +604,15 @@ void KigPart::setMode(KigMode *m)
 void KigPart::_addObjects(const std::vector<ObjectHolder *> &os)
 {
     document().addObjects(os);
+    mjournal->objectsAdded(os);
     setModified(true);
 }
 
+KigJournal &KigPart::journal()
+{
+    return *mjournal;
+}
+
 void KigPart::deleteObjects()
 {
     mode()->deleteObjects();
@@ -689,7 +767,7 @@ void KigPart::fileSave()
 bool KigPart::internalSaveAs()
 {
     // this slot is connected to the KStandardAction::saveAs action...
-    QString formats = i18n("Kig Documents (*.kig);;Compressed Kig Documents (*.kigz)");
+    QString formats = i18n("Kig Documents (*.kig);;Compressed Kig Documents (*.kigz);;Binary Kig Documents (*.kigb)");
     QString currentDir = url().toLocalFile();
 
     if (currentDir.isNull()) {
@@ -781,17 +859,9 @@ void KigPart::setupMacroTypes()
     if (!alreadysetup) {
         alreadysetup = true;
 
-        // the user's saved macro types:
-        const QStringList dataFiles = getDataFiles(QStringLiteral("kig-types"));
-        std::vector<Macro *> macros;
-        for (QStringList::const_iterator file = dataFiles.begin(); file != dataFiles.end(); ++file) {
-            std::vector<Macro *> nmacros;
-            bool ok = MacroList::instance()->load(*file, nmacros, *this);
-            if (!ok)
-                continue;
-            copy(nmacros.begin(), nmacros.end(), back_inserter(macros));
-        }
-        MacroList::instance()->add(macros);
+        // the user's saved macro types, which show up once they are
+        // loaded:
+        MacroList::instance()->loadInBackground(getDataFiles(QStringLiteral("kig-types")));
     };
     // hack: we need to plug the action lists _after_ the gui is
     // built. I can't find a better solution than this.
@@ -804,7 +874,10 @@ void KigPart::setupBuiltinMacros()
     if (!alreadysetup) {
         alreadysetup = true;
         // builtin macro types ( we try to make the user think these are
-        // normal types )..
+        // normal types )..  kigpartui.rc refers to their actions, so they
+        // have to be there before the GUI is built.  This only reads
+        // what the macros take and give, their hierarchies are built
+        // when they are first used.
         const QStringList builtinfiles = getDataFiles(QStringLiteral("builtin-macros"));
         for (QStringList::const_iterator file = builtinfiles.begin(); file != builtinfiles.end(); ++file) {
             std::vector<Macro *> macros;
@@ -962,22 +1035,16 @@ KigDocument &KigPart::document()
     return *mdocument;
 }
 
-extern "C" KIGPART_EXPORT int convertToNative(const QUrl &url, const QByteArray &outfile)
+/**
+ * load file, and calc it, the way a KigPart would when opening it.
+ * Used by the command line converters, which have no KigPart..
+ */
+static KigDocument *loadAndCalc(const QString &file)
 {
-    qDebug() << "converting " << url.toDisplayString(QUrl::PrettyDecoded) << " to " << outfile;
-
-    if (!url.isLocalFile()) {
-        // TODO
-        qCritical() << "--convert-to-native only supports local files for now.";
-        return -1;
-    }
-
-    QString file = url.toLocalFile();
-
     QFileInfo fileinfo(file);
     if (!fileinfo.exists()) {
         qCritical() << "The file \"" << file << "\" does not exist";
-        return -1;
+        return nullptr;
     };
 
     const QMimeDatabase mimeDb;
@@ -986,13 +1053,13 @@ extern "C" KIGPART_EXPORT int convertToNative(const QUrl &url, const QByteArray
     KigFilter *filter = KigFilters::instance()->find(mimeType.name());
     if (!filter) {
         qCritical() << "The file \"" << file << "\" is of a filetype not currently supported by Kig.";
-        return -1;
+        return nullptr;
     };
 
     KigDocument *doc = filter->load(file);
     if (!doc) {
         qCritical() << "Parse error in file \"" << file << "\".";
-        return -1;
+        return nullptr;
     }
 
     std::vector<ObjectCalcer *> tmp = calcPath(getAllParents(getAllCalcers(doc->objects())));
@@ -1000,6 +1067,24 @@ extern "C" KIGPART_EXPORT int convertToNative(const QUrl &url, const QByteArray
         (*i)->calc(*doc);
     for (std::vector<ObjectCalcer *>::iterator i = tmp.begin(); i != tmp.end(); ++i)
         (*i)->calc(*doc);
+    return doc;
+}
+
+extern "C" KIGPART_EXPORT int convertToNative(const QUrl &url, const QByteArray &outfile)
+{
+    qDebug() << "converting " << url.toDisplayString(QUrl::PrettyDecoded) << " to " << outfile;
+
+    if (!url.isLocalFile()) {
+        // TODO
+        qCritical() << "--convert-to-native only supports local files for now.";
+        return -1;
+    }
+
+    setupFilterUi();
+
+    KigDocument *doc = loadAndCalc(url.toLocalFile());
+    if (!doc)
+        return -1;
 
     QString out = (outfile == "-") ? QString() : outfile;
     bool success = KigFilters::instance()->save(*doc, out);
@@ -1013,6 +1098,99 @@ extern "C" KIGPART_EXPORT int convertToNative(const QUrl &url, const QByteArray
     return 0;
 }
 
+/**
+ * convert one file for batchConvert.  This runs in one of the worker
+ * threads, so it only touches its own document.
+ */
+static bool batchConvertFile(const QString &file, const QString &format, const QString &outdir, const QSize &size, const KigExportOptions &opts)
+{
+    KigDocument *doc = loadAndCalc(file);
+    if (!doc)
+        return false;
+
+    const QFileInfo fileinfo(file);
+    const QString dir = outdir.isEmpty() ? fileinfo.absolutePath() : outdir;
+    const QString out = QDir(dir).filePath(fileinfo.completeBaseName() + QLatin1Char('.') + format);
+
+    bool success;
+    if (format == QLatin1String("kig")) {
+        success = KigFilters::instance()->save(*doc, out);
+    } else {
+        // show the document the way a new KigWidget of this size would
+        const Rect viewrect = Rect::fromQRect(QRect(QPoint(0, 0), size));
+        const ScreenInfo si(doc->suggestedRect().matchShape(viewrect), QRect(QPoint(0, 0), size));
+        success = KigExportManager::instance()->exporterFor(format)->exportDocument(*doc, si, out, opts);
+    }
+    if (!success)
+        qCritical() << "something went wrong while writing" << out;
+
+    delete doc;
+    return success;
+}
+
+/**
+ * Load, calc and export or convert all of files, in parallel.  The
+ * options are:
+ * "format": the suffix of the output format ( "kig" for the native
+ *   format, or anything the exporters support ), "kig" by default,
+ * "outputDir": where to put the output files, next to the input files
+ *   by default,
+ * "jobs": how many files to handle at once, by default as many as
+ *   there are cores,
+ * "size": the QSize of the exported view,
+ * "grid", "axes", "frame", "standalone", "latexFormat" and "resolution":
+ *   see KigExportOptions.
+ *
+ * Returns the number of files that could not be converted, or -1 if
+ * the options are wrong.
+ */
+extern "C" KIGPART_EXPORT int batchConvert(const QStringList &files, const QVariantMap &options)
+{
+    const QString format = options.value(QStringLiteral("format"), QStringLiteral("kig")).toString().toLower();
+    const QString outdir = options.value(QStringLiteral("outputDir")).toString();
+    const QSize size = options.value(QStringLiteral("size"), QSize(630, 450)).toSize();
+    KigExportOptions opts;
+    opts.showGrid = options.value(QStringLiteral("grid"), opts.showGrid).toBool();
+    opts.showAxes = options.value(QStringLiteral("axes"), opts.showAxes).toBool();
+    opts.extraFrame = options.value(QStringLiteral("frame"), opts.extraFrame).toBool();
+    opts.standalone = options.value(QStringLiteral("standalone"), opts.standalone).toBool();
+    opts.latexFormat = options.value(QStringLiteral("latexFormat"), opts.latexFormat).toInt();
+    opts.resolution = options.value(QStringLiteral("resolution"), opts.resolution).toInt();
+
+    if (format != QLatin1String("kig") && !KigExportManager::instance()->exporterFor(format)) {
+        qCritical() << "Kig cannot export to" << format;
+        return -1;
+    }
+    if (!size.isValid() || size.isEmpty()) {
+        qCritical() << "Invalid size for the exported view.";
+        return -1;
+    }
+    if (!outdir.isEmpty() && !QDir().mkpath(outdir)) {
+        qCritical() << "Could not create the output directory" << outdir;
+        return -1;
+    }
+
+    // make sure the filters are created here, and not by the first
+    // workers racing each other
+    KigFilters::instance();
+
+    QThreadPool pool;
+    const int jobs = options.value(QStringLiteral("jobs"), 0).toInt();
+    if (jobs > 0)
+        pool.setMaxThreadCount(jobs);
+
+    std::atomic<int> failures(0);
+    for (const QString &file : files) {
+        pool.start([&failures, file, format, outdir, size, opts]() {
+            if (!batchConvertFile(QFileInfo(file).absoluteFilePath(), format, outdir, size, opts))
+                ++failures;
+        });
+    }
+    pool.waitForDone();
+
+    return failures;
+}
+
 void KigPart::toggleGrid()
 {
     bool toshow = !mdocument->grid();
@@ -23,6 +23,7 @@ class QPrinter;
 class GUIAction;
 class KigGUIAction;
 class KigDocument;
+class KigJournal;
 class KigMode;
 class KigPart;
 class KigView;
@@ -158,6 +159,12 @@ public:
     void _delObject(ObjectHolder *inObject);
     void _delObjects(const std::vector<ObjectHolder *> &o);
 
+    /**
+     * the KigCommandTask's tell the journal about the changes to the
+     * document that don't go through _addObjects() and _delObjects().
+     */
+    KigJournal &journal();
+
     /**
      * Call this method to start an object group which will
      * be deleted as a whole if the construction is canceled
@@ -200,6 +207,11 @@ protected:
      */
     QUndoStack *mhistory;
 
+    /**
+     * the crash recovery copy of our unsaved changes
+     */
+    KigJournal *mjournal;
+
 public:
     // actions: this is an annoying case, didn't really fit into my
     // model with KigModes. This is how it works now:
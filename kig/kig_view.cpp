@@ -10,14 +10,23 @@
 #include "../misc/coordinate_system.h"
 #include "../misc/kiginputdialog.h"
 #include "../misc/kigpainter.h"
+#include "../misc/tiled_renderer.h"
 #include "../modes/dragrectmode.h"
 #include "../modes/mode.h"
+#include "../objects/bezier_imp.h"
+#include "../objects/cubic_imp.h"
+#include "../objects/locus_imp.h"
+#include "../objects/object_imp.h"
 #include "kig_commands.h"
 #include "kig_document.h"
 #include "kig_part.h"
 
+#include <QElapsedTimer>
 #include <QGridLayout>
+#include <QImage>
+#include <QRegion>
 #include <QScrollBar>
+#include <QTimer>
 #include <QWheelEvent>
 
 #include <algorithm>
@@ -34,9 +43,25 @@ KigWidget::KigWidget(KigPart *part, KigView *view, QWidget *parent, bool fullscr
     , misfullscreen(fullscreen)
     , mispainting(false)
     , malreadyresized(false)
+    , mobjectspixvalid(false)
+    , mscrolltimer(new QTimer(this))
+    , mscrolling(false)
+    , mrefinetimer(new QTimer(this))
+    , mprogressive(false)
+    , mpreview(false)
+    , mrefinegrid(false)
 {
     part->addWidget(this);
 
+    mscrolltimer->setSingleShot(true);
+    mscrolltimer->setInterval(10);
+    connect(mscrolltimer, &QTimer::timeout, this, &KigWidget::applyScroll);
+    mrefinetimer->setSingleShot(true);
+    mrefinetimer->setInterval(0);
+    connect(mrefinetimer, &QTimer::timeout, this, [this]() {
+        refineStep();
+    });
+
     setFocusPolicy(Qt::ClickFocus);
     setAttribute(Qt::WA_OpaquePaintEvent, true);
     setMouseTracking(true);
@@ -60,12 +85,24 @@ void KigWidget::paintEvent(QPaintEvent *e)
 
 void KigWidget::mousePressEvent(QMouseEvent *e)
 {
+    // input comes first: we stop refining while the mode handles the
+    // press..
+    const bool preview = mpreview;
+    cancelRefine();
     if (e->button() & Qt::LeftButton)
-        return mpart->mode()->leftClicked(e, this);
-    if (e->button() & Qt::MiddleButton)
-        return mpart->mode()->midClicked(e, this);
-    if (e->button() & Qt::RightButton)
-        return mpart->mode()->rightClicked(e, this);
+        mpart->mode()->leftClicked(e, this);
+    else if (e->button() & Qt::MiddleButton)
+        mpart->mode()->midClicked(e, this);
+    else if (e->button() & Qt::RightButton)
+        mpart->mode()->rightClicked(e, this);
+    // .. and start again afterwards, unless the mode has drawn the
+    // screen again itself.  The preview is what we show now, so it
+    // doesn't need to be scaled.
+    if (preview && mpreview) {
+        mpreviousrect = msi.shownRect();
+        mprogressive = true;
+        modeRedrawScreen();
+    }
 }
 
 void KigWidget::mouseMoveEvent(QMouseEvent *e)
@@ -133,6 +170,7 @@ void KigWidget::resizeEvent(QResizeEvent *e)
     QSize nsize = e->size();
     Rect orect = msi.shownRect();
 
+    mscrolltimer->stop();
     curPix = QPixmap(nsize);
     stillPix = QPixmap(nsize);
     msi.setViewRect(rect());
@@ -157,21 +195,30 @@ void KigWidget::resizeEvent(QResizeEvent *e)
 
 void KigWidget::updateCurPix(const std::vector<QRect> &ol)
 {
+    // we add ol to oldOverlay, so that part of the widget will be
+    // updated too in updateWidget...  The two often overlap, so we
+    // merge them, and blit every part only once.
+    std::copy(ol.begin(), ol.end(), std::back_inserter(oldOverlay));
+    KigPainter::coalesceOverlay(oldOverlay, rect());
+
     // we make curPix look like stillPix again...
     QPainter p(&curPix);
     for (std::vector<QRect>::const_iterator i = oldOverlay.begin(); i != oldOverlay.end(); ++i)
         p.drawPixmap(i->topLeft(), stillPix, *i);
-    for (std::vector<QRect>::const_iterator i = ol.begin(); i != ol.end(); ++i)
-        p.drawPixmap(i->topLeft(), stillPix, *i);
     p.end();
+}
 
-    // we add ol to oldOverlay, so that part of the widget will be
-    // updated too in updateWidget...
-    std::copy(ol.begin(), ol.end(), std::back_inserter(oldOverlay));
+void KigWidget::restoreCurPix(const std::vector<QRect> &rects)
+{
+    QPainter p(&curPix);
+    for (std::vector<QRect>::const_iterator i = rects.begin(); i != rects.end(); ++i)
+        p.drawPixmap(i->topLeft(), stillPix, *i);
+    p.end();
 }
 
 void KigWidget::recenterScreen()
 {
+    mscrolltimer->stop();
     msi.setShownRect(matchScreenShape(mpart->document().suggestedRect()));
 }
 
@@ -211,7 +258,11 @@ void KigWidget::slotZoomOut()
 
 void KigWidget::clearStillPix()
 {
+    cancelRefine();
     stillPix.fill(Qt::white);
+    mobjectspixvalid = false;
+    mprogressive = false;
+    mpreview = false;
     oldOverlay.clear();
     oldOverlay.push_back(QRect(QPoint(0, 0), size()));
 }
@@ -224,8 +275,40 @@ void KigWidget::redrawScreen(const std::vector<ObjectHolder *> &_selection, bool
     std::sort(selection.begin(), selection.end());
     std::set_difference(objs.begin(), objs.end(), selection.begin(), selection.end(), std::back_inserter(nonselection));
 
+    cancelRefine();
+    const bool progressive = mprogressive;
+    mprogressive = false;
+    if (mscrolling) {
+        redrawScrolled(selection, nonselection);
+        if (dos)
+            updateEntireWidget();
+        return;
+    }
+    if (progressive) {
+        redrawProgressive(selection, nonselection);
+        if (dos)
+            updateEntireWidget();
+        return;
+    }
+
     // update the screen...
     clearStillPix();
+    if (tiledDrawingPays(size())) {
+        // big views are drawn in tiles, in parallel..
+        const KigDocument &doc = mpart->document();
+        QImage img(size(), QImage::Format_ARGB32_Premultiplied);
+        img.fill(Qt::white);
+        {
+            KigPainter p(msi, &img, doc, false);
+            p.drawGrid(doc.coordinateSystem(), doc.grid(), doc.axes());
+        }
+        drawObjectsTiled(img, msi, doc, selection, nonselection);
+        stillPix.convertFromImage(img);
+        updateCurPix();
+        if (dos)
+            updateEntireWidget();
+        return;
+    }
     KigPainter p(msi, &stillPix, mpart->document());
     p.drawGrid(mpart->document().coordinateSystem(), mpart->document().grid(), mpart->document().axes());
     p.drawObjects(selection, true);
@@ -235,6 +318,195 @@ void KigWidget::redrawScreen(const std::vector<ObjectHolder *> &_selection, bool
         updateEntireWidget();
 }
 
+/**
+ * the objects in os that can possibly show up in one of the parts of
+ * the document in rects.
+ */
+static std::vector<ObjectHolder *> objectsIn(const std::vector<ObjectHolder *> &os, const std::vector<Rect> &rects)
+{
+    std::vector<ObjectHolder *> ret;
+    for (ObjectHolder *o : os) {
+        Rect r = o->surroundingRect();
+        // an invalid surroundingRect means the object doesn't know where
+        // it is, and needs to be drawn anyway..
+        bool in = !r.valid();
+        for (std::vector<Rect>::const_iterator i = rects.begin(); !in && i != rects.end(); ++i)
+            in = r.intersects(*i);
+        if (in)
+            ret.push_back(o);
+    }
+    return ret;
+}
+
+void KigWidget::redrawScrolled(const std::vector<ObjectHolder *> &selection, const std::vector<ObjectHolder *> &nonselection)
+{
+    const KigDocument &doc = mpart->document();
+    QRegion exposed(rect());
+
+    if (mobjectspixvalid && mobjectspix.size() == size() && mobjectsselection == selection) {
+        Rect nr = msi.shownRect();
+        const double pw = msi.pixelWidth();
+        const double dx = (mobjectsrect.left() - nr.left()) / pw;
+        const double dy = (nr.bottom() - mobjectsrect.bottom()) / pw;
+        const int idx = static_cast<int>(std::round(dx));
+        const int idy = static_cast<int>(std::round(dy));
+        if (std::fabs(nr.width() - mobjectsrect.width()) <= 1e-9 * nr.width() && std::fabs(nr.height() - mobjectsrect.height()) <= 1e-9 * nr.height()
+            && std::abs(idx) < width() && std::abs(idy) < height()) {
+            // we can only move the pixmap by a whole number of pixels, so
+            // we move the shown rect by less than half a pixel to match..
+            nr.setBottomLeft(Coordinate(mobjectsrect.left() - idx * pw, mobjectsrect.bottom() + idy * pw));
+            msi.setShownRect(nr);
+            mobjectspix.scroll(idx, idy, mobjectspix.rect(), &exposed);
+        }
+    }
+
+    if (mobjectspix.size() != size()) {
+        mobjectspix = QPixmap(size());
+        // a new QPixmap is opaque, filling it with a transparent color
+        // gives it an alpha channel, without which the transparent
+        // strips below would end up black
+        mobjectspix.fill(Qt::transparent);
+    }
+    if (!exposed.isEmpty()) {
+        std::vector<Rect> exposedrects;
+        {
+            QPainter p(&mobjectspix);
+            p.setCompositionMode(QPainter::CompositionMode_Source);
+            for (const QRect &r : exposed) {
+                p.fillRect(r, Qt::transparent);
+                // objects that are just outside of the exposed part can
+                // still reach into it with their labels, line width, point
+                // size etc..
+                exposedrects.push_back(msi.fromScreen(r.adjusted(-20, -20, 20, 20)));
+            }
+        }
+        KigPainter p(msi, &mobjectspix, doc, false);
+        p.setClipRegion(exposed);
+        p.drawObjects(objectsIn(selection, exposedrects), true);
+        p.drawObjects(objectsIn(nonselection, exposedrects), false);
+    }
+    mobjectsrect = msi.shownRect();
+    mobjectsselection = selection;
+
+    // the grid depends on the shown rect, so we simply draw it again,
+    // and put the objects on top of it..
+    stillPix.fill(Qt::white);
+    oldOverlay.clear();
+    oldOverlay.push_back(QRect(QPoint(0, 0), size()));
+    {
+        KigPainter p(msi, &stillPix, doc, false);
+        p.drawGrid(doc.coordinateSystem(), doc.grid(), doc.axes());
+    }
+    QPainter p(&stillPix);
+    p.drawPixmap(0, 0, mobjectspix);
+    p.end();
+    mobjectspixvalid = true;
+    mpreview = false;
+    updateCurPix();
+}
+
+/**
+ * objects that are expensive to draw, because drawing them means
+ * sampling a lot of points.  These are drawn last when drawing
+ * progressively.
+ */
+static bool isExpensive(const ObjectHolder *o)
+{
+    const ObjectImp *imp = o->imp();
+    return imp->inherits(LocusImp::stype()) || imp->inherits(CubicImp::stype()) || imp->inherits(BezierImp::stype())
+        || imp->inherits(RationalBezierImp::stype());
+}
+
+void KigWidget::redrawProgressive(const std::vector<ObjectHolder *> &selection, const std::vector<ObjectHolder *> &nonselection)
+{
+    // what we showed before, scaled to the new shown rect, is shown
+    // until we have drawn the real thing..
+    const QPixmap previous = stillPix;
+    const QRectF previousrect = msi.toScreenF(mpreviousrect);
+    clearStillPix();
+    if (previous.size() == size()) {
+        QPainter p(&stillPix);
+        p.drawPixmap(previousrect, previous, QRectF(previous.rect()));
+    }
+    updateCurPix();
+    mpreview = true;
+    mrefinepix = QPixmap(size());
+
+    for (ObjectHolder *o : selection)
+        if (!isExpensive(o))
+            mrefinequeue.push_back(std::make_pair(o, true));
+    for (ObjectHolder *o : nonselection)
+        if (!isExpensive(o))
+            mrefinequeue.push_back(std::make_pair(o, false));
+    for (ObjectHolder *o : selection)
+        if (isExpensive(o))
+            mrefinequeue.push_back(std::make_pair(o, true));
+    for (ObjectHolder *o : nonselection)
+        if (isExpensive(o))
+            mrefinequeue.push_back(std::make_pair(o, false));
+    mrefinegrid = true;
+    mrefinetimer->start();
+}
+
+void KigWidget::refineStep()
+{
+    const KigDocument &doc = mpart->document();
+    const std::set<ObjectHolder *> &objs = doc.objectsSet();
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    if (mrefinegrid)
+        mrefinepix.fill(Qt::white);
+    std::vector<std::pair<ObjectHolder *, bool>>::iterator i = mrefinequeue.begin();
+    {
+        KigPainter p(msi, &mrefinepix, doc, false);
+        if (mrefinegrid) {
+            p.drawGrid(doc.coordinateSystem(), doc.grid(), doc.axes());
+            mrefinegrid = false;
+        }
+        for (; i != mrefinequeue.end(); ++i) {
+            // objects can have been removed from the document since the
+            // queue was filled..
+            if (objs.find(i->first) == objs.end())
+                continue;
+            // the cheap objects are all drawn in the first step, the
+            // expensive ones until we've spent enough time in this one..
+            if (elapsed.elapsed() > 15 && isExpensive(i->first))
+                break;
+            p.drawObject(i->first, i->second);
+        }
+    }
+    mrefinequeue.erase(mrefinequeue.begin(), i);
+    if (!mrefinequeue.empty()) {
+        mrefinetimer->start();
+        return;
+    }
+
+    // the new frame is complete, so it replaces the preview
+    stillPix = mrefinepix;
+    mrefinepix = QPixmap();
+    mpreview = false;
+    oldOverlay.clear();
+    oldOverlay.push_back(QRect(QPoint(0, 0), size()));
+    updateCurPix();
+    updateEntireWidget();
+}
+
+void KigWidget::cancelRefine()
+{
+    mrefinetimer->stop();
+    mrefinequeue.clear();
+    mrefinegrid = false;
+}
+
+void KigWidget::modeRedrawScreen()
+{
+    mpart->redrawScreen(this);
+    // not every mode draws, see KigMode::redrawScreen(), so we make
+    // sure that a progressive redraw we asked for doesn't stay pending
+    mprogressive = false;
+}
+
 const ScreenInfo &KigWidget::screenInfo() const
 {
     return msi;
@@ -385,22 +657,38 @@ void KigView::slotBottomScrollValueChanged(int v)
 
 void KigWidget::scrollSetBottom(double rhs)
 {
-    Rect sr = msi.shownRect();
+    Rect sr = mscrolltimer->isActive() ? mscrolltarget : msi.shownRect();
     Coordinate bl = sr.bottomLeft();
     bl.y = rhs;
     sr.setBottomLeft(bl);
-    msi.setShownRect(sr);
-    mpart->redrawScreen(this);
+    scrollTo(sr);
 }
 
 void KigWidget::scrollSetLeft(double rhs)
 {
-    Rect sr = msi.shownRect();
+    Rect sr = mscrolltimer->isActive() ? mscrolltarget : msi.shownRect();
     Coordinate bl = sr.bottomLeft();
     bl.x = rhs;
     sr.setBottomLeft(bl);
-    msi.setShownRect(sr);
+    scrollTo(sr);
+}
+
+void KigWidget::scrollTo(const Rect &r)
+{
+    mscrolltarget = r;
+    // we don't restart the timer if it's already running, so that a
+    // long burst of scroll events still gets the screen updated
+    // regularly..
+    if (!mscrolltimer->isActive())
+        mscrolltimer->start();
+}
+
+void KigWidget::applyScroll()
+{
+    msi.setShownRect(mscrolltarget);
+    mscrolling = true;
     mpart->redrawScreen(this);
+    mscrolling = false;
 }
 
 const ScreenInfo &KigView::screenInfo() const
@@ -502,10 +790,11 @@ void KigWidget::zoomRect()
 
         cd->addTask(new KigViewShownRectChangeTask(*this, nr));
         mpart->history()->push(cd);
-    };
-
-    mpart->redrawScreen(this);
-    updateScrollBars();
+    } else {
+        // the command redraws the screen otherwise
+        mpart->redrawScreen(this);
+        updateScrollBars();
+    }
 }
 
 void KigView::zoomRect()
@@ -515,7 +804,14 @@ void KigView::zoomRect()
 
 void KigWidget::setShowingRect(const Rect &r)
 {
-    msi.setShownRect(r.matchShape(Rect::fromQRect(rect())));
+    mscrolltimer->stop();
+    const Rect nr = r.matchShape(Rect::fromQRect(rect()));
+    // a change of scale is drawn progressively, see redrawProgressive()
+    if (std::fabs(nr.width() - msi.shownRect().width()) > 1e-9 * nr.width()) {
+        mpreviousrect = msi.shownRect();
+        mprogressive = true;
+    }
+    msi.setShownRect(nr);
 }
 
 void KigView::slotRecenterScreen()
@@ -552,10 +848,10 @@ void KigWidget::zoomArea()
 
         cd->addTask(new KigViewShownRectChangeTask(*this, nr));
         mpart->history()->push(cd);
+    } else {
+        mpart->redrawScreen(this);
+        updateScrollBars();
     }
-
-    mpart->redrawScreen(this);
-    updateScrollBars();
 }
 
 void KigView::zoomArea()
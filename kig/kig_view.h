@@ -12,6 +12,7 @@
 
 #include <kparts/part.h>
 
+#include <utility>
 #include <vector>
 
 #include "../misc/rect.h"
@@ -19,7 +20,9 @@
 #include "../objects/object_holder.h"
 
 class QGridLayout;
+class QRegion;
 class QScrollBar;
+class QTimer;
 
 class KigDocument;
 class KigView;
@@ -86,6 +89,61 @@ protected:
 
     bool malreadyresized;
 
+    /**
+     * Scrolling doesn't change what the objects look like, only where
+     * they are on the screen.  So while scrolling, we keep the objects
+     * in a transparent pixmap of their own, move its contents along,
+     * and only draw the objects again in the strips that were scrolled
+     * into view.  The grid depends on the shown rect, and is cheap
+     * enough to simply draw again.  mobjectspix shows mobjectsrect,
+     * with mobjectsselection drawn as selected, and can only be reused
+     * while mobjectspixvalid is true.
+     */
+    QPixmap mobjectspix;
+    Rect mobjectsrect;
+    std::vector<ObjectHolder *> mobjectsselection;
+    bool mobjectspixvalid;
+
+    /**
+     * scroll events tend to come in bursts ( every wheel step and every
+     * scrollbar tick is one ), so scrollSetBottom() and scrollSetLeft()
+     * only remember where we want to go in mscrolltarget, and
+     * mscrolltimer makes us go there at most once every few
+     * milliseconds.  mscrolling is set while we redraw for a scroll.
+     */
+    Rect mscrolltarget;
+    QTimer *mscrolltimer;
+    bool mscrolling;
+
+    /**
+     * When the scale changes, nothing we drew before can be reused.
+     * Instead of drawing everything at once, and not responding to
+     * input until we're done, we first show a scaled copy of what we
+     * showed before ( mpreviousrect ), and then draw in small steps
+     * from mrefinetimer: first the grid and the cheap objects, then the
+     * expensive ones ( loci, cubics, ... ) a few at a time.  Every new
+     * redraw cancels the steps that are still pending, so a burst of
+     * zooms never queues up more than one of them.  mrefinequeue holds
+     * the objects that still need to be drawn, and whether they are
+     * selected.  The steps draw on mrefinepix, and the preview stays
+     * in stillPix until the last step is done ( mpreview ).
+     */
+    QTimer *mrefinetimer;
+    Rect mpreviousrect;
+    bool mprogressive;
+    bool mpreview;
+    bool mrefinegrid;
+    QPixmap mrefinepix;
+    std::vector<std::pair<ObjectHolder *, bool>> mrefinequeue;
+
+private:
+    void scrollTo(const Rect &r);
+    void applyScroll();
+    void redrawScrolled(const std::vector<ObjectHolder *> &selection, const std::vector<ObjectHolder *> &nonselection);
+    void redrawProgressive(const std::vector<ObjectHolder *> &selection, const std::vector<ObjectHolder *> &nonselection);
+    void refineStep();
+    void cancelRefine();
+
 public:
     /**
      * standard qwidget constructor.  if fullscreen is true, we're a
@@ -147,6 +205,12 @@ public:
     void updateWidget(const std::vector<QRect> & = std::vector<QRect>());
     void updateEntireWidget();
 
+    /**
+     * make curPix look like stillPix again, but only in \p rects,
+     * unlike updateCurPix()...
+     */
+    void restoreCurPix(const std::vector<QRect> &rects);
+
     /**
      * Mapping between Internal Coordinate Systems
      * there are two coordinate systems:
@@ -158,7 +222,16 @@ public:
      * These are mapped by the KigView using the ScreenInfo class.
      */
     const Rect showingRect() const;
+    /**
+     * show \p r .  If that changes the scale, the next redraw is
+     * progressive, see redrawProgressive(), so redraw with
+     * modeRedrawScreen() afterwards.
+     */
     void setShowingRect(const Rect &r);
+    /**
+     * let the mode redraw us, see KigPart::redrawScreen().
+     */
+    void modeRedrawScreen();
 
     const Coordinate fromScreen(const QPoint &p);
     const Rect fromScreen(const QRect &r);
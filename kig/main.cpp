@@ -14,6 +14,8 @@
 #include <QFile>
 #include <QStandardPaths>
 #include <QLibrary>
+#include <QSize>
+#include <QVariantMap>
 
 #include <KAboutData>
 #include <KCrash>
@@ -34,8 +36,30 @@ static int convertToNative(const QUrl &file, const QByteArray &outfile)
     return (*converterfunction)(file, outfile);
 }
 
+static int batchConvert(const QStringList &files, const QVariantMap &options)
+{
+    KPluginMetaData libraryLoader(QStringLiteral("kf6/parts/kigpart"));
+    QLibrary library(libraryLoader.fileName());
+    int (*converterfunction)(const QStringList &, const QVariantMap &);
+    converterfunction = (int (*)(const QStringList &, const QVariantMap &))library.resolve("batchConvert");
+    if (!converterfunction) {
+        qCritical() << "Error: broken Kig installation: different library and application version !";
+        return -1;
+    }
+    return (*converterfunction)(files, options);
+}
+
 int main(int argc, char **argv)
 {
+    // batch mode needs no display, but we still need a QApplication for
+    // fonts and painting..
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--batch") == 0 && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+            break;
+        }
+    }
+
     QApplication app(argc, argv);
     KLocalizedString::setApplicationDomain("kig");
     KAboutData about = kigAboutData("kig");
@@ -47,6 +71,32 @@ int main(int argc, char **argv)
     QCommandLineOption outfileOption(QStringList() << QStringLiteral("o") << QStringLiteral("outfile"),
                                      i18n("File to output the created native file to. '-' means output to stdout. Default is stdout as well."),
                                      QStringLiteral("file"));
+    QCommandLineOption batchOption(QStringLiteral("batch"),
+                                   i18n("Do not show a GUI. Load and recalculate all of the specified files, and export or convert them, in parallel."));
+    QCommandLineOption formatOption(QStringLiteral("format"),
+                                    i18n("Format to convert to in batch mode: kig, svg, tex, asy, fig, or an image format like png. Default is kig."),
+                                    QStringLiteral("format"),
+                                    QStringLiteral("kig"));
+    QCommandLineOption outputDirOption(QStringLiteral("output-dir"),
+                                       i18n("Directory to write the converted files to in batch mode. Default is next to each input file."),
+                                       QStringLiteral("dir"));
+    QCommandLineOption jobsOption(QStringLiteral("jobs"),
+                                  i18n("Number of files to convert at once in batch mode. Default is the number of cores."),
+                                  QStringLiteral("n"));
+    QCommandLineOption sizeOption(QStringLiteral("size"), i18n("Size of the exported view in batch mode. Default is 630x450."), QStringLiteral("WxH"));
+    QCommandLineOption noGridOption(QStringLiteral("no-grid"), i18n("Do not export the grid in batch mode."));
+    QCommandLineOption noAxesOption(QStringLiteral("no-axes"), i18n("Do not export the axes in batch mode."));
+    QCommandLineOption frameOption(QStringLiteral("frame"), i18n("Export an extra frame in batch mode."));
+    QCommandLineOption latexFormatOption(QStringLiteral("latex-format"),
+                                         i18n("What to write when exporting to Latex in batch mode: pstricks, tikz or asymptote. Default is pstricks."),
+                                         QStringLiteral("format"),
+                                         QStringLiteral("pstricks"));
+    QCommandLineOption noStandaloneOption(QStringLiteral("no-standalone"),
+                                          i18n("Do not write a complete Latex document, only the picture, in batch mode."));
+    QCommandLineOption resolutionOption(QStringLiteral("resolution"),
+                                        i18n("Simplify the exported curves to this resolution, in dots per inch, in batch mode. Default is 0, which "
+                                             "does not simplify them."),
+                                        QStringLiteral("dpi"));
 
     QCoreApplication::setApplicationName(QStringLiteral("kig"));
     QCoreApplication::setApplicationVersion(KIG_VERSION_STRING);
@@ -57,13 +107,58 @@ int main(int argc, char **argv)
     about.setupCommandLine(&parser);
     parser.addOption(convertToNativeOption);
     parser.addOption(outfileOption);
+    parser.addOption(batchOption);
+    parser.addOption(formatOption);
+    parser.addOption(outputDirOption);
+    parser.addOption(jobsOption);
+    parser.addOption(sizeOption);
+    parser.addOption(noGridOption);
+    parser.addOption(noAxesOption);
+    parser.addOption(frameOption);
+    parser.addOption(latexFormatOption);
+    parser.addOption(noStandaloneOption);
+    parser.addOption(resolutionOption);
     parser.addPositionalArgument(QStringLiteral("URL"), i18n("Document to open"));
     parser.process(app);
     about.processCommandLine(&parser);
 
     QStringList urls = parser.positionalArguments();
 
-    if (parser.isSet(QStringLiteral("convert-to-native"))) {
+    if (parser.isSet(batchOption)) {
+        if (urls.isEmpty()) {
+            qCritical() << "Error: --batch specified without any files to convert.";
+            return -1;
+        }
+        QVariantMap options;
+        options[QStringLiteral("format")] = parser.value(formatOption);
+        if (parser.isSet(outputDirOption))
+            options[QStringLiteral("outputDir")] = parser.value(outputDirOption);
+        if (parser.isSet(jobsOption))
+            options[QStringLiteral("jobs")] = parser.value(jobsOption).toInt();
+        if (parser.isSet(sizeOption)) {
+            const QStringList wh = parser.value(sizeOption).split(QLatin1Char('x'));
+            if (wh.count() != 2) {
+                qCritical() << "Error: --size should be of the form WxH, e.g. 800x600.";
+                return -1;
+            }
+            options[QStringLiteral("size")] = QSize(wh[0].toInt(), wh[1].toInt());
+        }
+        options[QStringLiteral("grid")] = !parser.isSet(noGridOption);
+        options[QStringLiteral("axes")] = !parser.isSet(noAxesOption);
+        options[QStringLiteral("frame")] = parser.isSet(frameOption);
+        options[QStringLiteral("standalone")] = !parser.isSet(noStandaloneOption);
+        const QStringList latexFormats = QStringList() << QStringLiteral("pstricks") << QStringLiteral("tikz") << QStringLiteral("asymptote");
+        const int latexFormat = latexFormats.indexOf(parser.value(latexFormatOption).toLower());
+        if (latexFormat < 0) {
+            qCritical() << "Error: --latex-format should be one of pstricks, tikz or asymptote.";
+            return -1;
+        }
+        options[QStringLiteral("latexFormat")] = latexFormat;
+        if (parser.isSet(resolutionOption))
+            options[QStringLiteral("resolution")] = parser.value(resolutionOption).toInt();
+        int failures = batchConvert(urls, options);
+        return failures == 0 ? 0 : -1;
+    } else if (parser.isSet(QStringLiteral("convert-to-native"))) {
         QString outfile = parser.value(QStringLiteral("outfile"));
         if (outfile.isNull())
             outfile = '-';
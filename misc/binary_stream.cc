@@ -0,0 +1,176 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "binary_stream.h"
+
+#include "coordinate.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+KigBinaryWriter::KigBinaryWriter()
+{
+}
+
+KigBinaryWriter::~KigBinaryWriter()
+{
+}
+
+void KigBinaryWriter::writeUInt8(quint8 i)
+{
+    mdata.append(static_cast<char>(i));
+}
+
+void KigBinaryWriter::writeUInt32(quint32 i)
+{
+    const quint32 le = qToLittleEndian(i);
+    mdata.append(reinterpret_cast<const char *>(&le), sizeof(le));
+}
+
+void KigBinaryWriter::writeInt32(qint32 i)
+{
+    writeUInt32(static_cast<quint32>(i));
+}
+
+void KigBinaryWriter::writeDouble(double d)
+{
+    quint64 bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    bits = qToLittleEndian(bits);
+    mdata.append(reinterpret_cast<const char *>(&bits), sizeof(bits));
+}
+
+void KigBinaryWriter::writeCoordinate(const Coordinate &c)
+{
+    writeDouble(c.x);
+    writeDouble(c.y);
+}
+
+void KigBinaryWriter::writeString(const QByteArray &s)
+{
+    QHash<QByteArray, quint32>::const_iterator i = mstringids.constFind(s);
+    if (i != mstringids.constEnd()) {
+        writeUInt32(i.value());
+        return;
+    }
+    const quint32 id = mstrings.size();
+    mstrings.push_back(s);
+    mstringids.insert(s, id);
+    writeUInt32(id);
+}
+
+QByteArray KigBinaryWriter::finish() const
+{
+    KigBinaryWriter table;
+    table.writeUInt32(mstrings.size());
+    for (std::vector<QByteArray>::const_iterator i = mstrings.begin(); i != mstrings.end(); ++i) {
+        table.writeUInt32(i->size());
+        // the terminating 0 lets the reader hand out the strings in
+        // place as 0 terminated strings
+        table.mdata.append(i->constData(), i->size() + 1);
+    }
+    return table.mdata + mdata;
+}
+
+KigBinaryReader::KigBinaryReader(const char *data, qint64 size)
+    : mpos(data)
+    , mend(data + size)
+    , mok(true)
+{
+}
+
+KigBinaryReader::~KigBinaryReader()
+{
+}
+
+bool KigBinaryReader::canRead(qint64 size)
+{
+    if (mok && mend - mpos >= size)
+        return true;
+    mok = false;
+    return false;
+}
+
+bool KigBinaryReader::readStringTable()
+{
+    const quint32 count = readUInt32();
+    // every string takes at least 5 bytes, don't let a broken count
+    // make us reserve lots of memory
+    if (!canRead(qint64(count) * 5))
+        return false;
+    mstrings.reserve(count);
+    for (quint32 i = 0; i < count; ++i) {
+        const quint32 size = readUInt32();
+        if (!canRead(qint64(size) + 1) || mpos[size] != '\0') {
+            mok = false;
+            return false;
+        }
+        mstrings.push_back(QByteArray::fromRawData(mpos, size));
+        mpos += size + 1;
+    }
+    return mok;
+}
+
+quint8 KigBinaryReader::readUInt8()
+{
+    if (!canRead(1))
+        return 0;
+    return static_cast<quint8>(*mpos++);
+}
+
+quint32 KigBinaryReader::readUInt32()
+{
+    if (!canRead(sizeof(quint32)))
+        return 0;
+    quint32 ret = qFromLittleEndian<quint32>(mpos);
+    mpos += sizeof(quint32);
+    return ret;
+}
+
+qint32 KigBinaryReader::readInt32()
+{
+    return static_cast<qint32>(readUInt32());
+}
+
+double KigBinaryReader::readDouble()
+{
+    if (!canRead(sizeof(quint64)))
+        return 0.;
+    const quint64 bits = qFromLittleEndian<quint64>(mpos);
+    mpos += sizeof(quint64);
+    double ret;
+    std::memcpy(&ret, &bits, sizeof(ret));
+    return ret;
+}
+
+Coordinate KigBinaryReader::readCoordinate()
+{
+    const double x = readDouble();
+    const double y = readDouble();
+    return Coordinate(x, y);
+}
+
+quint32 KigBinaryReader::readStringId()
+{
+    return readUInt32();
+}
+
+const QByteArray &KigBinaryReader::string(quint32 id)
+{
+    static const QByteArray empty;
+    if (id >= mstrings.size()) {
+        mok = false;
+        return empty;
+    }
+    return mstrings[id];
+}
+
+const QByteArray &KigBinaryReader::readString()
+{
+    return string(readStringId());
+}
@@ -0,0 +1,103 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+
+#include <vector>
+
+class Coordinate;
+
+/**
+ * Writes the packed little endian data of Kig's binary file format.
+ * Strings are not written inline: every distinct string is put in a
+ * string table once, and the data refers to it by its index.  The
+ * string table is written in front of the data by finish().
+ */
+class KigBinaryWriter
+{
+    QByteArray mdata;
+    std::vector<QByteArray> mstrings;
+    QHash<QByteArray, quint32> mstringids;
+
+public:
+    KigBinaryWriter();
+    ~KigBinaryWriter();
+
+    void writeUInt8(quint8 i);
+    void writeUInt32(quint32 i);
+    void writeInt32(qint32 i);
+    void writeDouble(double d);
+    void writeCoordinate(const Coordinate &c);
+    /**
+     * write the index of \p s in the string table, adding it there if
+     * it is not in it yet.
+     */
+    void writeString(const QByteArray &s);
+
+    /**
+     * the string table, followed by the data written so far.
+     */
+    QByteArray finish() const;
+};
+
+/**
+ * Reads what a KigBinaryWriter wrote, from memory that it does not own
+ * ( typically a memory mapped file ), without copying it.  The strings
+ * returned by string() and readString() point into that memory too, so
+ * they must not be used after it is gone: copy what you need to keep.
+ *
+ * Reading past the end of the data or an unknown string index does not
+ * crash, but makes ok() return false, so callers can read a whole
+ * record and check once.
+ */
+class KigBinaryReader
+{
+    const char *mpos;
+    const char *mend;
+    bool mok;
+    std::vector<QByteArray> mstrings;
+
+    bool canRead(qint64 size);
+
+public:
+    KigBinaryReader(const char *data, qint64 size);
+    ~KigBinaryReader();
+
+    bool ok() const
+    {
+        return mok;
+    }
+    bool atEnd() const
+    {
+        return mpos == mend;
+    }
+    qint64 bytesLeft() const
+    {
+        return mend - mpos;
+    }
+
+    /**
+     * read the string table, which finish() put in front of the data.
+     */
+    bool readStringTable();
+
+    quint8 readUInt8();
+    quint32 readUInt32();
+    qint32 readInt32();
+    double readDouble();
+    Coordinate readCoordinate();
+    /**
+     * read a string index, for callers that want to cache what they
+     * make of the string, and look it up with string().
+     */
+    quint32 readStringId();
+    const QByteArray &string(quint32 id);
+    const QByteArray &readString();
+};
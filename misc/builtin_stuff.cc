@@ -34,6 +34,8 @@ void setupBuiltinStuff()
 {
     static bool done = false;
     if (!done) {
+        setupObjectTypeActions();
+
         ObjectConstructorList *ctors = ObjectConstructorList::instance();
         GUIActionList *actions = GUIActionList::instance();
         ObjectConstructor *c = nullptr;
@@ -479,6 +481,20 @@ void setupBuiltinStuff()
         ctors->add(c);
         actions->add(new ConstructibleAction(c, "objects_new_convexhull"));
 
+        c = new SimpleObjectTypeConstructor(PolygonPolygonUnionType::instance(),
+                                            i18n("Union of Polygons"),
+                                            i18n("A polygon that corresponds to the union of two polygons"),
+                                            "kig_polygon");
+        ctors->add(c);
+        actions->add(new ConstructibleAction(c, "objects_new_polygonunion"));
+
+        c = new SimpleObjectTypeConstructor(PolygonPolygonDifferenceType::instance(),
+                                            i18n("Difference of Polygons"),
+                                            i18n("A polygon that corresponds to the part of a polygon outside of another polygon"),
+                                            "kig_polygon");
+        ctors->add(c);
+        actions->add(new ConstructibleAction(c, "objects_new_polygondifference"));
+
         /* ----------- end polygons --------- */
 
         /* ----------- start bezier --------- */
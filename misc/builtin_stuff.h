@@ -5,3 +5,9 @@
 #pragma once
 
 void setupBuiltinStuff();
+
+/**
+ * register the special actions of the object types, see
+ * ObjectTypeActions.  setupBuiltinStuff() calls this.
+ */
+void setupObjectTypeActions();
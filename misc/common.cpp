@@ -7,14 +7,13 @@
 
 #include "common.h"
 
-#include "../kig/kig_view.h"
+#include "screeninfo.h"
+
 #include "../objects/object_imp.h"
 
 #include <cmath>
 #include <limits>
 
-#include <QInputDialog>
-
 Coordinate calcPointOnPerpend(const LineData &l, const Coordinate &t)
 {
     return calcPointOnPerpend(l.b - l.a, t);
@@ -317,14 +316,6 @@ Coordinate calcCircleRadicalStartPoint(const Coordinate &ca, const Coordinate &c
     return m + direc;
 }
 
-// TODO Decide whether we need to reimplement locale handling or if we can just remove this
-double getDoubleFromUser(const QString &caption, const QString &label, double value, QWidget *parent, bool *ok, double min, double max, int decimals)
-{
-    double ret = QInputDialog::getDouble(parent, caption, label, value, min, max, decimals, ok);
-
-    return ret;
-}
-
 const Coordinate calcCenter(const Coordinate &a, const Coordinate &b, const Coordinate &c)
 {
     // this algorithm is written by my brother, Christophe Devriese
@@ -359,9 +350,9 @@ const Coordinate calcCenter(const Coordinate &a, const Coordinate &b, const Coor
     return Coordinate(centerx, centery);
 }
 
-bool lineInRect(const Rect &r, const Coordinate &a, const Coordinate &b, const int width, const ObjectImp *imp, const KigWidget &w)
+bool lineInRect(const Rect &r, const Coordinate &a, const Coordinate &b, const int width, const ObjectImp *imp, const ScreenInfo &si, const KigDocument &doc)
 {
-    double miss = w.screenInfo().normalMiss(width);
+    double miss = si.normalMiss(width);
 
     // mp: the following test didn't work for vertical segments;
     //  fortunately the ieee floating point standard allows us to avoid
@@ -405,8 +396,8 @@ bool lineInRect(const Rect &r, const Coordinate &a, const Coordinate &b, const i
     // intersection ( this might not be the case for a segment, when the
     // intersection is not between the begin and end point. ) and if
     // the rect contains the intersection.  If it does, we have a winner.
-    return (imp->contains(leftint, width, w) && r.contains(leftint, miss)) || (imp->contains(rightint, width, w) && r.contains(rightint, miss))
-        || (imp->contains(bottomint, width, w) && r.contains(bottomint, miss)) || (imp->contains(topint, width, w) && r.contains(topint, miss));
+    return (imp->contains(leftint, width, si, doc) && r.contains(leftint, miss)) || (imp->contains(rightint, width, si, doc) && r.contains(rightint, miss))
+        || (imp->contains(bottomint, width, si, doc) && r.contains(bottomint, miss)) || (imp->contains(topint, width, si, doc) && r.contains(topint, miss));
 }
 
 bool operator==(const LineData &l, const LineData &r)
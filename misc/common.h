@@ -13,9 +13,9 @@
 #include <assert.h>
 #include <vector>
 
-class QWidget;
 class ObjectImp;
-class KigWidget;
+class KigDocument;
+class ScreenInfo;
 
 extern const double double_inf;
 
@@ -24,8 +24,6 @@ extern const double double_inf;
  * various places...
  */
 
-double getDoubleFromUser(const QString &caption, const QString &label, double value, QWidget *parent, bool *ok, double min, double max, int decimals);
-
 /**
  * Simple class representing a line.  Used by various functions in Kig.
  */
@@ -227,7 +225,7 @@ Coordinate calcCircleRadicalStartPoint(const Coordinate &ca, const Coordinate &c
  * distinguish between rays, lines, segments or whatever. ( we use
  * their contains functions actually. )
  */
-bool lineInRect(const Rect &r, const Coordinate &a, const Coordinate &b, const int width, const ObjectImp *imp, const KigWidget &w);
+bool lineInRect(const Rect &r, const Coordinate &a, const Coordinate &b, const int width, const ObjectImp *imp, const ScreenInfo &si, const KigDocument &doc);
 
 template<typename T>
 T kigMin(const T &a, const T &b)
@@ -0,0 +1,174 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "coordinate_buffer.h"
+
+#include "kigtransform.h"
+#include "rect.h"
+
+#include <cmath>
+#include <limits>
+#include <utility>
+
+CoordinateBuffer::CoordinateBuffer()
+{
+}
+
+CoordinateBuffer::CoordinateBuffer(const std::vector<Coordinate> &points)
+    : mx(points.size())
+    , my(points.size())
+{
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        mx[i] = points[i].x;
+        my[i] = points[i].y;
+    }
+}
+
+CoordinateBuffer::~CoordinateBuffer()
+{
+}
+
+void CoordinateBuffer::clear()
+{
+    mx.clear();
+    my.clear();
+}
+
+void CoordinateBuffer::reserve(std::size_t n)
+{
+    mx.reserve(n);
+    my.reserve(n);
+}
+
+void CoordinateBuffer::push_back(const Coordinate &c)
+{
+    mx.push_back(c.x);
+    my.push_back(c.y);
+}
+
+const std::vector<Coordinate> CoordinateBuffer::toVector() const
+{
+    std::vector<Coordinate> ret;
+    ret.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i)
+        ret.push_back(Coordinate(mx[i], my[i]));
+    return ret;
+}
+
+void CoordinateBuffer::transform(const Transformation &t)
+{
+    t.apply(mx.data(), my.data(), mx.data(), my.data(), size());
+}
+
+Rect CoordinateBuffer::boundingRect() const
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    double minx = inf, maxx = -inf, miny = inf, maxy = -inf;
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const double x = mx[i];
+        const double y = my[i];
+        // invalid coordinates have an infinite x or y, and are skipped
+        const bool valid = std::fabs(x) != inf && std::fabs(y) != inf;
+        minx = valid && x < minx ? x : minx;
+        maxx = valid && x > maxx ? x : maxx;
+        miny = valid && y < miny ? y : miny;
+        maxy = valid && y > maxy ? y : maxy;
+    }
+    if (minx > maxx)
+        return Rect::invalidRect();
+    return Rect(minx, miny, maxx - minx, maxy - miny);
+}
+
+double CoordinateBuffer::minDistance(const Coordinate &p, std::size_t *index) const
+{
+    // invalid points are at an infinite distance anyway, so they need
+    // no special treatment.
+    double min = std::numeric_limits<double>::infinity();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const double dx = mx[i] - p.x;
+        const double dy = my[i] - p.y;
+        const double d = dx * dx + dy * dy;
+        min = d < min ? d : min;
+    }
+    if (index) {
+        *index = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double dx = mx[i] - p.x;
+            const double dy = my[i] - p.y;
+            if (dx * dx + dy * dy == min) {
+                *index = i;
+                break;
+            }
+        }
+    }
+    return std::sqrt(min);
+}
+
+void CoordinateBuffer::simplify(double tolerance)
+{
+    const std::size_t n = size();
+    if (n <= 2 || !(tolerance > 0.))
+        return;
+    const double tolsq = tolerance * tolerance;
+
+    std::vector<char> keep(n, 0);
+    keep[0] = keep[n - 1] = 1;
+    // the ranges of points that we still need to look at.  We use a
+    // stack instead of recursion, since the ranges can get very deep for
+    // curves that are sampled finely..
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    ranges.push_back(std::make_pair(0, n - 1));
+    while (!ranges.empty()) {
+        const std::size_t first = ranges.back().first;
+        const std::size_t last = ranges.back().second;
+        ranges.pop_back();
+        if (last - first < 2)
+            continue;
+
+        // the squared distances from the points in between to the
+        // segment from first to last.  The segment can be a point, for
+        // a closed polyline..
+        const double ax = mx[first];
+        const double ay = my[first];
+        const double dx = mx[last] - ax;
+        const double dy = my[last] - ay;
+        const double lensq = dx * dx + dy * dy;
+        const double invlensq = lensq > 0. ? 1. / lensq : 0.;
+        double max = 0.;
+        std::size_t split = first + 1;
+        for (std::size_t i = first + 1; i < last; ++i) {
+            const double px = mx[i] - ax;
+            const double py = my[i] - ay;
+            double t = (px * dx + py * dy) * invlensq;
+            t = t < 0. ? 0. : t > 1. ? 1. : t;
+            const double ex = px - t * dx;
+            const double ey = py - t * dy;
+            const double d = ex * ex + ey * ey;
+            if (d > max) {
+                max = d;
+                split = i;
+            }
+        }
+        if (max <= tolsq)
+            continue;
+        keep[split] = 1;
+        ranges.push_back(std::make_pair(first, split));
+        ranges.push_back(std::make_pair(split, last));
+    }
+
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        if (keep[i]) {
+            mx[j] = mx[i];
+            my[j] = my[i];
+            ++j;
+        }
+    mx.resize(j);
+    my.resize(j);
+}
@@ -0,0 +1,102 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "coordinate.h"
+
+#include <cstddef>
+#include <vector>
+
+class Rect;
+class Transformation;
+
+/**
+ * A list of Coordinates, stored as one array of x values and one
+ * array of y values instead of as an array of Coordinate's.  The bulk
+ * operations below are simple loops over plain arrays of doubles, which
+ * the compiler can vectorise, so this is what the code paths working
+ * on many points at once ( drawing polygons and curves, exporting
+ * them ) should use.
+ *
+ * Invalid coordinates are allowed in the buffer, and are treated like
+ * Coordinate::valid() does.
+ */
+class CoordinateBuffer
+{
+    std::vector<double> mx;
+    std::vector<double> my;
+
+public:
+    CoordinateBuffer();
+    explicit CoordinateBuffer(const std::vector<Coordinate> &points);
+    ~CoordinateBuffer();
+
+    std::size_t size() const
+    {
+        return mx.size();
+    }
+    bool empty() const
+    {
+        return mx.empty();
+    }
+    void clear();
+    void reserve(std::size_t n);
+    void push_back(const Coordinate &c);
+
+    const Coordinate operator[](std::size_t i) const
+    {
+        return Coordinate(mx[i], my[i]);
+    }
+    const Coordinate back() const
+    {
+        return Coordinate(mx.back(), my.back());
+    }
+
+    /**
+     * The x and y values of the points, size() of each.
+     */
+    const double *xData() const
+    {
+        return mx.data();
+    }
+    const double *yData() const
+    {
+        return my.data();
+    }
+
+    const std::vector<Coordinate> toVector() const;
+
+    /**
+     * Apply t to all of the points in place.  This gives the same
+     * result as Transformation::apply on every point, including the
+     * invalid Coordinate for points that are sent to infinity.
+     */
+    void transform(const Transformation &t);
+
+    /**
+     * The smallest Rect containing all of the valid points.  If there
+     * are none, an invalid Rect is returned.
+     */
+    Rect boundingRect() const;
+
+    /**
+     * The distance from p to the nearest of the points, or infinity
+     * if there are no valid points.  If index is not null, it is set
+     * to the index of that point.
+     */
+    double minDistance(const Coordinate &p, std::size_t *index = nullptr) const;
+
+    /**
+     * Simplify the polyline through the points with the
+     * Ramer-Douglas-Peucker algorithm: leave out as many points as
+     * possible, while keeping the polyline within \p tolerance of all
+     * the points.  The first and the last point are always kept.  All
+     * of the points must be valid.
+     */
+    void simplify(double tolerance);
+};
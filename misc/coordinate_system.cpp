@@ -8,12 +8,12 @@
 #include "coordinate_system.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_view.h"
 
 #include "common.h"
 #include "coordinate.h"
 #include "goniometry.h"
 #include "kigpainter.h"
+#include "screeninfo.h"
 
 #include <cmath>
 #include <string>
@@ -446,18 +446,8 @@ void PolarCoords::drawGrid(KigPainter &p, bool showgrid, bool showaxes) const
 
     /****** the grid lines ******/
     if (showgrid) {
-        double d = kigMin(hd, vd);
-        double begin = kigMin(kigAbs(hgraphmin), kigAbs(vgraphmin));
-        if (kigSgn(hgraphmin) != kigSgn(hgraphmax) && kigSgn(vgraphmin) != kigSgn(vgraphmax))
-            begin = d;
-        double end = kigMax(hgraphmax, vgraphmax);
-
-        // we also want the circles that don't fit entirely in the
-        // screen..
-        Coordinate c(0, 0);
         p.setPen(QPen(Qt::lightGray, 0, Qt::DotLine));
-        for (double i = begin; i <= end + d / 2; i += d)
-            drawGridLine(p, c, fabs(i));
+        drawGridLines(p, kigMin(hd, vd));
     }
 
     /****** the axes ******/
@@ -589,9 +579,9 @@ QString CoordinateSystemFactory::setCoordinateSystemStatement(int id)
     }
 }
 
-Coordinate EuclideanCoords::snapToGrid(const Coordinate &c, const KigWidget &w) const
+Coordinate EuclideanCoords::snapToGrid(const Coordinate &c, const ScreenInfo &si) const
 {
-    Rect rect = w.showingRect();
+    Rect rect = si.shownRect();
     // we recalc the interval stuff since there is no way to cache it..
 
     // this function is again inspired upon ( public domain ) code from
@@ -605,7 +595,7 @@ Coordinate EuclideanCoords::snapToGrid(const Coordinate &c, const KigWidget &w)
 
     // the number of intervals we would like to have:
     // we try to have one of them per 40 pixels or so..
-    const int ntick = static_cast<int>(kigMax(hmax - hmin, vmax - vmin) / w.pixelWidth() / 40.) + 1;
+    const int ntick = static_cast<int>(kigMax(hmax - hmin, vmax - vmin) / si.pixelWidth() / 40.) + 1;
 
     const double hrange = nicenum(hmax - hmin, false);
     const double vrange = nicenum(vmax - vmin, false);
@@ -621,7 +611,7 @@ Coordinate EuclideanCoords::snapToGrid(const Coordinate &c, const KigWidget &w)
     return Coordinate(nx, ny);
 }
 
-Coordinate PolarCoords::snapToGrid(const Coordinate &c, const KigWidget &w) const
+Coordinate PolarCoords::snapToGrid(const Coordinate &c, const ScreenInfo &si) const
 {
     // we reuse the drawGrid code to find
 
@@ -629,7 +619,7 @@ Coordinate PolarCoords::snapToGrid(const Coordinate &c, const KigWidget &w) cons
     // the corners, that intersect with the axes outside of the
     // screen..
 
-    Rect r = w.showingRect();
+    Rect r = si.shownRect();
 
     const double hmax = M_SQRT2 * r.right();
     const double hmin = M_SQRT2 * r.left();
@@ -638,7 +628,7 @@ Coordinate PolarCoords::snapToGrid(const Coordinate &c, const KigWidget &w) cons
 
     // the intervals:
     // we try to have one of them per 40 pixels or so..
-    const int ntick = static_cast<int>(kigMax(hmax - hmin, vmax - vmin) / w.pixelWidth() / 40) + 1;
+    const int ntick = static_cast<int>(kigMax(hmax - hmin, vmax - vmin) / si.pixelWidth() / 40) + 1;
 
     const double hrange = nicenum(hmax - hmin, false);
     const double vrange = nicenum(vmax - vmin, false);
@@ -653,67 +643,80 @@ Coordinate PolarCoords::snapToGrid(const Coordinate &c, const KigWidget &w) cons
     return c.normalize(ndist);
 }
 
-void PolarCoords::drawGridLine(KigPainter &p, const Coordinate &c, double r) const
-{
-#ifdef KIG_TESSELLATE_POLAR_GRID_CIRCLE
-    Rect rect = p.window();
-
-    struct iterdata_t {
-        int xd;
-        int yd;
-        Coordinate (Rect::*point)() const;
-        Coordinate (Rect::*oppositepoint)() const;
-        double horizAngle;
-        double vertAngle;
-    };
-
-    static const iterdata_t iterdata[] = {{+1, +1, &Rect::topRight, &Rect::bottomLeft, 0, M_PI / 2},
-                                          {-1, +1, &Rect::topLeft, &Rect::bottomRight, M_PI, M_PI / 2},
-                                          {-1, -1, &Rect::bottomLeft, &Rect::topRight, M_PI, 3 * M_PI / 2},
-                                          {+1, -1, &Rect::bottomRight, &Rect::topLeft, 2 * M_PI, 3 * M_PI / 2}};
-    for (int i = 0; i < 4; ++i) {
-        int xd = iterdata[i].xd;
-        int yd = iterdata[i].yd;
-        Coordinate point = (rect.*iterdata[i].point)();
-        Coordinate opppoint = (rect.*iterdata[i].oppositepoint)();
-        double horizangle = iterdata[i].horizAngle;
-        double vertangle = iterdata[i].vertAngle;
-
-        if ((c.x - point.x) * xd > 0 || (c.y - point.y) * yd > 0)
-            continue;
-        if ((c.x - opppoint.x) * -xd > r || (c.y - opppoint.y) * -yd > r)
-            continue;
-
-        int posdir = xd * yd;
-        double hd = (point.x - c.x) * xd;
-        assert(hd >= 0);
-        if (hd < r) {
-            double anglediff = acos(hd / r);
-            horizangle += posdir * anglediff;
-        }
-
-        hd = (c.x - opppoint.x) * -xd;
-        if (hd >= 0) {
-            double anglediff = asin(hd / r);
-            vertangle -= posdir * anglediff;
+// the most grid circles we draw at once, whatever the zoom level.  The
+// grid step is chosen for about one circle per 40 pixels, so this only
+// kicks in for windows that are very far from the origin.
+static const int maxPolarGridCircles = 100;
+
+void PolarCoords::drawGridLines(KigPainter &p, double d) const
+{
+    const Rect w = p.window();
+
+    // the part of the plane we need to cover, as seen from the origin:
+    // the distances of the nearest and the farthest point of the window,
+    // and the angles under which we see it.
+    const double dx = kigMax(kigMax(w.left(), -w.right()), 0.);
+    const double dy = kigMax(kigMax(w.bottom(), -w.top()), 0.);
+    const double rmin = sqrt(dx * dx + dy * dy);
+    double rmax = 0.;
+    const Coordinate corners[] = {w.bottomLeft(), w.bottomRight(), w.topLeft(), w.topRight()};
+    for (const Coordinate &c : corners)
+        rmax = kigMax(rmax, c.length());
+
+    double startangle = 0.;
+    double span = 2 * M_PI;
+    if (rmin > 0) {
+        // the origin is outside the window, which we then see under an
+        // angle of less than 180 degrees around the angle of its center.
+        const Coordinate center = w.center();
+        const double centerangle = atan2(center.y, center.x);
+        double lo = 0.;
+        double hi = 0.;
+        for (const Coordinate &c : corners) {
+            const double a = remainder(atan2(c.y, c.x) - centerangle, 2 * M_PI);
+            lo = kigMin(lo, a);
+            hi = kigMax(hi, a);
         }
+        startangle = centerangle + lo;
+        span = hi - lo;
+    }
 
-        double vd = (point.y - c.y) * yd;
-        assert(vd >= 0);
-        if (vd < r) {
-            double anglediff = acos(vd / r);
-            vertangle -= posdir * anglediff;
-        }
+    // the circles: only the ones that cross the window, and only the
+    // arc of them that we can see.
+    // these are kept as doubles: far enough from the origin, they
+    // don't fit in an int.
+    double step = d;
+    double first = kigMax(ceil(rmin / step), 1.);
+    double last = floor(rmax / step);
+    if (last - first >= maxPolarGridCircles) {
+        step *= floor((last - first) / maxPolarGridCircles) + 1;
+        first = kigMax(ceil(rmin / step), 1.);
+        last = floor(rmax / step);
+    }
+    for (double i = first; i <= last; ++i)
+        drawGridLine(p, i * step, startangle, span);
+}
 
-        vd = (c.y - opppoint.y) * -xd;
-        if (vd >= 0) {
-            double anglediff = asin(hd / r);
-            horizangle += posdir * anglediff;
-        }
+void PolarCoords::drawGridLine(KigPainter &p, double r, double startangle, double span) const
+{
+    // a full circle only fits the window if the origin is in there,
+    // so it is small enough to let Qt draw it
+    if (span >= 2 * M_PI) {
+        p.drawCircle(Coordinate(0, 0), r);
+        return;
+    }
 
-        p.drawArc(c, r, kigMin(horizangle, vertangle), kigMax(horizangle, vertangle));
+    // otherwise we tessellate the arc ourselves: Qt copes badly with
+    // arcs of circles that are many times the size of the window.
+    // segments of 2 * sqrt( pw / r ) radians stay within half a pixel
+    // of the real circle.
+    const double maxstep = 2 * sqrt(p.pixelWidth() / r);
+    const int n = kigMin(kigMax(static_cast<int>(ceil(span / maxstep)), 1), 256);
+    std::vector<Coordinate> pts;
+    pts.reserve(n + 1);
+    for (int i = 0; i <= n; ++i) {
+        const double angle = startangle + span * i / n;
+        pts.push_back(Coordinate(r * cos(angle), r * sin(angle)));
     }
-#else
-    p.drawCircle(c, r);
-#endif
+    p.drawPolyline(pts);
 }
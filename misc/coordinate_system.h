@@ -11,8 +11,8 @@
 
 class KigPainter;
 class KigDocument;
-class KigWidget;
 class CoordinateSystem;
+class ScreenInfo;
 class QValidator;
 class Coordinate;
 class QString;
@@ -65,7 +65,7 @@ public:
     virtual Coordinate toScreen(const QString &pt, bool &ok) const = 0;
     virtual void drawGrid(KigPainter &p, bool showgrid = true, bool showaxes = true) const = 0;
     virtual QValidator *coordinateValidator() const = 0;
-    virtual Coordinate snapToGrid(const Coordinate &c, const KigWidget &w) const = 0;
+    virtual Coordinate snapToGrid(const Coordinate &c, const ScreenInfo &si) const = 0;
 
     virtual const char *type() const = 0;
     virtual int id() const = 0;
@@ -82,7 +82,7 @@ public:
     Coordinate toScreen(const QString &pt, bool &ok) const override;
     void drawGrid(KigPainter &p, bool showgrid = true, bool showaxes = true) const override;
     QValidator *coordinateValidator() const override;
-    Coordinate snapToGrid(const Coordinate &c, const KigWidget &w) const override;
+    Coordinate snapToGrid(const Coordinate &c, const ScreenInfo &si) const override;
 
     const char *type() const override;
     int id() const override;
@@ -90,7 +90,10 @@ public:
 
 class PolarCoords : public CoordinateSystem
 {
-    void drawGridLine(KigPainter &p, const Coordinate &center, double radius) const;
+    // draw the grid circles, \p d apart, but only the parts of them
+    // that fall in the window of \p p.
+    void drawGridLines(KigPainter &p, double d) const;
+    void drawGridLine(KigPainter &p, double radius, double startangle, double span) const;
 
 public:
     PolarCoords();
@@ -101,7 +104,7 @@ public:
     Coordinate toScreen(const QString &pt, bool &ok) const override;
     void drawGrid(KigPainter &p, bool showgrid = true, bool showaxes = true) const override;
     QValidator *coordinateValidator() const override;
-    Coordinate snapToGrid(const Coordinate &c, const KigWidget &w) const override;
+    Coordinate snapToGrid(const Coordinate &c, const ScreenInfo &si) const override;
 
     const char *type() const override;
     int id() const override;
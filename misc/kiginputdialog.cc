@@ -15,6 +15,7 @@
 
 #include <QComboBox>
 #include <QDialogButtonBox>
+#include <QInputDialog>
 #include <QLabel>
 #include <QLineEdit>
 #include <QPointer>
@@ -286,4 +287,12 @@ Goniometry KigInputDialog::getAngle(QWidget *parent, bool *ok, const Goniometry
     return goniometry;
 }
 
+// TODO Decide whether we need to reimplement locale handling or if we can just remove this
+double getDoubleFromUser(const QString &caption, const QString &label, double value, QWidget *parent, bool *ok, double min, double max, int decimals)
+{
+    double ret = QInputDialog::getDouble(parent, caption, label, value, min, max, decimals, ok);
+
+    return ret;
+}
+
 #include "moc_kiginputdialog.cpp"
@@ -99,3 +99,5 @@ public:
      */
     static Goniometry getAngle(QWidget *parent, bool *ok, const Goniometry &g);
 };
+
+double getDoubleFromUser(const QString &caption, const QString &label, double value, QWidget *parent, bool *ok, double min, double max, int decimals);
@@ -8,13 +8,14 @@
 #include "kigpainter.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 #include "../misc/goniometry.h"
 #include "../objects/curve_imp.h"
 #include "../objects/object_holder.h"
 #include "../objects/point_imp.h"
 #include "common.h"
 #include "conic-common.h"
+#include "coordinate_buffer.h"
 #include "coordinate_system.h"
 #include "cubic-common.h"
 #include "object_hierarchy.h"
@@ -45,6 +46,7 @@ KigPainter::KigPainter(const ScreenInfo &si, QPaintDevice *device, const KigDocu
     , mNeedOverlay(no)
     , overlayenlarge(0)
     , mSelected(false)
+    , msimplifytolerance(0.)
 {
     mP.setBackground(QBrush(Qt::white));
 }
@@ -53,6 +55,11 @@ KigPainter::~KigPainter()
 {
 }
 
+void KigPainter::setClipRegion(const QRegion &r)
+{
+    mP.setClipRegion(r);
+}
+
 void KigPainter::drawRect(const Rect &r)
 {
     Rect rt = r.normalized();
@@ -282,6 +289,11 @@ void KigPainter::setSelected(bool selected)
     mSelected = selected;
 }
 
+void KigPainter::setSimplifyTolerance(double tolerance)
+{
+    msimplifytolerance = tolerance;
+}
+
 /*
 static void setContains( QRect& r, const QPoint& p )
 {
@@ -296,13 +308,6 @@ static void setContains( QRect& r, const QPoint& p )
 
 void KigPainter::drawPolygon(const std::vector<QPoint> &pts, Qt::FillRule fillRule)
 {
-    QPen oldpen = mP.pen();
-    QBrush oldbrush = mP.brush();
-    QColor alphacolor = color;
-    if (!mSelected)
-        alphacolor.setAlpha(100);
-    setBrush(QBrush(alphacolor, Qt::SolidPattern));
-    setPen(Qt::NoPen);
     // i know this isn't really fast, but i blame it all on Qt with its
     // stupid container classes... what's wrong with the STL ?
     QPolygon t(pts.size());
@@ -310,6 +315,18 @@ void KigPainter::drawPolygon(const std::vector<QPoint> &pts, Qt::FillRule fillRu
     for (std::vector<QPoint>::const_iterator i = pts.begin(); i != pts.end(); ++i) {
         t.putPoints(c++, 1, i->x(), i->y());
     };
+    drawScreenPolygon(t, fillRule);
+}
+
+void KigPainter::drawScreenPolygon(const QPolygon &t, Qt::FillRule fillRule)
+{
+    QPen oldpen = mP.pen();
+    QBrush oldbrush = mP.brush();
+    QColor alphacolor = color;
+    if (!mSelected)
+        alphacolor.setAlpha(100);
+    setBrush(QBrush(alphacolor, Qt::SolidPattern));
+    setPen(Qt::NoPen);
     mP.drawPolygon(t, fillRule);
     setPen(oldpen);
     setBrush(oldbrush);
@@ -328,11 +345,8 @@ void KigPainter::drawArea(const std::vector<Coordinate> &pts, bool border)
     else
         setPen(Qt::NoPen);
     QPolygon t(pts.size());
-    int c = 0;
-    for (std::vector<Coordinate>::const_iterator i = pts.begin(); i != pts.end(); ++i) {
-        QPoint p = toScreen(*i);
-        t.putPoints(c++, 1, p.x(), p.y());
-    }
+    for (uint i = 0; i < pts.size(); ++i)
+        t[i] = toScreen(pts[i]);
     mP.drawPolygon(t);
     setPen(oldpen);
     setBrush(oldbrush);
@@ -498,6 +512,122 @@ void KigPainter::setWholeWinOverlay()
     mNeedOverlay = false;
 }
 
+// when there are more overlay rects than this, we merge them into
+// tiles, so that updating the widget doesn't take one blit per rect.
+static const uint maxOverlayRects = 32;
+// the smallest tiles we merge into, about the size of the overlay rects
+// of segments and circles
+static const int minOverlayTileSize = 32;
+
+void KigPainter::coalesceOverlay(std::vector<QRect> &rects, const QRect &bounds)
+{
+    if (rects.size() <= maxOverlayRects || bounds.isEmpty())
+        return;
+
+    // we mark the tiles of a grid over bounds that are touched by a rect,
+    // and make a rect of every horizontal run of marked tiles, merged
+    // with the one above it if it spans the same columns.  If that is
+    // still too many, we try again with tiles that are twice as big.
+    for (int tile = minOverlayTileSize;; tile *= 2) {
+        const int cols = (bounds.width() + tile - 1) / tile;
+        const int rows = (bounds.height() + tile - 1) / tile;
+        std::vector<bool> marked(cols * rows, false);
+        for (std::vector<QRect>::const_iterator i = rects.begin(); i != rects.end(); ++i) {
+            const QRect r = *i & bounds;
+            if (r.isEmpty())
+                continue;
+            const int x0 = (r.left() - bounds.left()) / tile;
+            const int x1 = (r.right() - bounds.left()) / tile;
+            const int y0 = (r.top() - bounds.top()) / tile;
+            const int y1 = (r.bottom() - bounds.top()) / tile;
+            for (int y = y0; y <= y1; ++y)
+                std::fill(marked.begin() + y * cols + x0, marked.begin() + y * cols + x1 + 1, true);
+        }
+
+        // the runs, in tile units, and for every column the index of the
+        // run of the previous row that starts there
+        std::vector<QRect> runs;
+        std::vector<int> above(cols, -1);
+        std::vector<int> current(cols, -1);
+        for (int y = 0; y < rows; ++y) {
+            std::fill(current.begin(), current.end(), -1);
+            for (int x = 0; x < cols; ++x) {
+                if (!marked[y * cols + x])
+                    continue;
+                const int start = x;
+                while (x + 1 < cols && marked[y * cols + x + 1])
+                    ++x;
+                const int prev = above[start];
+                if (prev >= 0 && runs[prev].right() == x) {
+                    runs[prev].setBottom(y);
+                    current[start] = prev;
+                } else {
+                    current[start] = runs.size();
+                    runs.push_back(QRect(QPoint(start, y), QPoint(x, y)));
+                }
+            }
+            above.swap(current);
+        }
+
+        if (runs.size() <= maxOverlayRects || (cols <= 1 && rows <= 1)) {
+            rects.clear();
+            for (std::vector<QRect>::const_iterator i = runs.begin(); i != runs.end(); ++i)
+                rects.push_back(QRect(bounds.left() + i->left() * tile, bounds.top() + i->top() * tile, i->width() * tile, i->height() * tile) & bounds);
+            return;
+        }
+    }
+}
+
+const std::vector<QRect> &KigPainter::overlay()
+{
+    coalesceOverlay(mOverlay, msi.viewRect());
+    return mOverlay;
+}
+
+std::vector<QRect> KigPainter::takeOverlay()
+{
+    std::vector<QRect> ret;
+    ret.swap(mOverlay);
+    coalesceOverlay(ret, msi.viewRect());
+    return ret;
+}
+
+static bool overlaps(const std::vector<QRect> &a, const std::vector<QRect> &b)
+{
+    for (std::vector<QRect>::const_iterator i = a.begin(); i != a.end(); ++i)
+        for (std::vector<QRect>::const_iterator j = b.begin(); j != b.end(); ++j)
+            if (i->intersects(*j))
+                return true;
+    return false;
+}
+
+std::vector<bool> KigPainter::objectsToRedraw(const std::vector<std::vector<QRect>> &drawn, const std::vector<bool> &changed)
+{
+    assert(drawn.size() == changed.size());
+    // the bounding rect of every object, so we only compare the rects
+    // of objects that are near each other..
+    std::vector<QRect> bounds(drawn.size());
+    for (uint i = 0; i < drawn.size(); ++i)
+        for (std::vector<QRect>::const_iterator j = drawn[i].begin(); j != drawn[i].end(); ++j)
+            bounds[i] |= *j;
+
+    std::vector<bool> ret = changed;
+    std::vector<uint> todo;
+    for (uint i = 0; i < ret.size(); ++i)
+        if (ret[i])
+            todo.push_back(i);
+    while (!todo.empty()) {
+        const uint i = todo.back();
+        todo.pop_back();
+        for (uint j = 0; j < drawn.size(); ++j)
+            if (!ret[j] && bounds[i].intersects(bounds[j]) && overlaps(drawn[i], drawn[j])) {
+                ret[j] = true;
+                todo.push_back(j);
+            }
+    }
+    return ret;
+}
+
 QPoint KigPainter::toScreen(const Coordinate &p) const
 {
     return msi.toScreen(p);
@@ -584,6 +714,38 @@ const Rect KigPainter::simpleBoundingRect(const Coordinate &c, const QString &s)
     return boundingRect(c, s, tf);
 }
 
+KigTextLayout::KigTextLayout(const QString &text)
+    : mtext(text)
+    , mlaidout(false)
+    , mdpi(0)
+{
+}
+
+KigTextLayout::~KigTextLayout()
+{
+}
+
+void KigPainter::layoutText(KigTextLayout &t)
+{
+    const int dpi = mP.device()->logicalDpiY();
+    if (t.mlaidout && t.mdpi == dpi && t.mfont == mP.font())
+        return;
+    // drawTextFrame() doesn't wrap the text, so we don't either..
+    t.msize = mP.boundingRect(QRect(), Qt::AlignLeft | Qt::AlignTop | Qt::TextDontClip, t.mtext).size();
+    t.mstatictext.setText(t.mtext);
+    t.mstatictext.setTextFormat(Qt::PlainText);
+    t.mstatictext.prepare(mP.transform(), mP.font());
+    t.mfont = mP.font();
+    t.mdpi = dpi;
+    t.mlaidout = true;
+}
+
+const Rect KigPainter::simpleBoundingRect(const Coordinate &c, KigTextLayout &t)
+{
+    layoutText(t);
+    return fromScreen(QRect(msi.toScreen(c), t.msize + QSize(4, 4)));
+}
+
 const Rect KigPainter::boundingRect(const Coordinate &c, const QString &s, int f) const
 {
     return boundingRect(Rect(c, mP.window().right(), mP.window().top()), s, f);
@@ -638,6 +800,41 @@ void KigPainter::drawRay(const LineData &d)
     drawRay(d.a, d.b);
 }
 
+// the bounding rect, in screen coordinates, of the arc of the circle
+// around \p c with radius \p radius from \p startangle over \p angle.
+// The screen y axis points down, hence the minus signs.
+static QRect arcBoundingRect(const QPoint &c, int radius, double startangle, double angle)
+{
+    double left = cos(startangle);
+    double right = left;
+    double top = -sin(startangle);
+    double bottom = top;
+    const double end = cos(startangle + angle);
+    left = kigMin(left, end);
+    right = kigMax(right, end);
+    top = kigMin(top, -sin(startangle + angle));
+    bottom = kigMax(bottom, -sin(startangle + angle));
+    // the extremes of the circle that lie on the arc
+    for (int i = static_cast<int>(ceil(startangle / (M_PI / 2))); i * M_PI / 2 <= startangle + angle; ++i) {
+        switch (((i % 4) + 4) % 4) {
+        case 0:
+            right = 1;
+            break;
+        case 1:
+            top = -1;
+            break;
+        case 2:
+            left = -1;
+            break;
+        case 3:
+            bottom = 1;
+            break;
+        }
+    }
+    return QRect(QPoint(c.x() + static_cast<int>(floor(left * radius)), c.y() + static_cast<int>(floor(top * radius))),
+                 QPoint(c.x() + static_cast<int>(ceil(right * radius)), c.y() + static_cast<int>(ceil(bottom * radius))));
+}
+
 void KigPainter::drawAngle(const Coordinate &point, double startangle, double angle, int radius)
 {
     const int startangleDegrees = static_cast<int>(Goniometry::convert(startangle, Goniometry::Rad, Goniometry::Deg));
@@ -665,9 +862,11 @@ void KigPainter::drawAngle(const Coordinate &point, double startangle, double an
     setBrushStyle(Qt::SolidPattern);
     mP.drawPolygon(arrow);
 
-    //  if ( mNeedOverlay ) mOverlay.push_back( toScreen( r ) );
-    setWholeWinOverlay(); // mp: ugly! why not compute a correct overlay?
-                          //     mOverlay.push_back( arrow.boundingRect() );
+    if (mNeedOverlay) {
+        const int pw = mP.pen().width() + 1;
+        mOverlay.push_back(arcBoundingRect(screenPoint, radius, startangle, angle).adjusted(-pw, -pw, pw, pw));
+        mOverlay.push_back(arrow.boundingRect().adjusted(-pw, -pw, pw, pw));
+    }
 }
 
 void KigPainter::drawRightAngle(const Coordinate &point, double startangle, int diagonal)
@@ -686,16 +885,25 @@ void KigPainter::drawRightAngle(const Coordinate &point, double startangle, int
 
     mP.drawPolyline(rightAnglePolygon);
 
-    setWholeWinOverlay();
+    if (mNeedOverlay) {
+        const int pw = mP.pen().width() + 1;
+        mOverlay.push_back(rightAnglePolygon.boundingRect().adjusted(-pw, -pw, pw, pw));
+    }
 }
 
 void KigPainter::drawPolygon(const std::vector<Coordinate> &pts, Qt::FillRule fillRule)
 {
-    using namespace std;
-    vector<QPoint> points;
+    QPolygon t(pts.size());
     for (uint i = 0; i < pts.size(); ++i)
-        points.push_back(toScreen(pts[i]));
-    drawPolygon(points, fillRule);
+        t[i] = toScreen(pts[i]);
+    drawScreenPolygon(t, fillRule);
+}
+
+void KigPainter::drawPolygon(const CoordinateBuffer &pts, Qt::FillRule fillRule)
+{
+    QPolygon t;
+    msi.toScreen(pts, t);
+    drawScreenPolygon(t, fillRule);
 }
 
 void KigPainter::drawVector(const Coordinate &a, const Coordinate &b)
@@ -827,11 +1035,19 @@ void KigPainter::drawCurve(const CurveImp *curve)
     // what this algorithm does is approximating the curve with a set of
     // segments.  we don't draw the individual segments, but use
     // QPainter::drawPolyline() so that the line styles work properly.
-    // Possibly there are performance advantages as well ?  this array
-    // is a buffer of the polyline approximation of the part of the
-    // curve that we are currently processing.
-    QPolygon curpolyline(1000);
-    int curpolylinenextfree = 0;
+    // Possibly there are performance advantages as well ?  this buffer
+    // contains the polyline approximation of the part of the curve that
+    // we are currently processing, it is converted to screen
+    // coordinates all at once when we flush it.
+    CoordinateBuffer curpolyline;
+    curpolyline.reserve(1000);
+    QPolygon screenpolyline;
+    auto flushPolyline = [&]() {
+        curpolyline.simplify(msimplifytolerance);
+        msi.toScreen(curpolyline, screenpolyline);
+        mP.drawPolyline(screenpolyline);
+        curpolyline.clear();
+    };
 
     // we don't use recursion, but a stack based approach for efficiency
     // concerns...
@@ -885,19 +1101,17 @@ void KigPainter::drawCurve(const CurveImp *curve)
             if (overlaypt)
                 overlaypt->setContains(p2);
             if (dodraw) {
-                // draw the two segments
-                QPoint tp0 = toScreen(p0);
-                QPoint tp1 = toScreen(p1);
-                QPoint tp2 = toScreen(p2);
-                if (curpolylinenextfree > 0 && curpolyline[curpolylinenextfree - 1] != tp1) {
+                // draw the two segments.  Consecutive segments share
+                // their end points exactly, so comparing the document
+                // coordinates is enough to know we're still on the
+                // same part of the curve.
+                if (!curpolyline.empty() && curpolyline.back() != p1)
                     // flush the current part of the curve
-                    mP.drawPolyline(curpolyline.constData(), curpolylinenextfree);
-                    curpolylinenextfree = 0;
-                }
-                if (curpolylinenextfree == 0)
-                    curpolyline[curpolylinenextfree++] = tp1;
-                curpolyline[curpolylinenextfree++] = tp2;
-                curpolyline[curpolylinenextfree++] = tp0;
+                    flushPolyline();
+                if (curpolyline.empty())
+                    curpolyline.push_back(p1);
+                curpolyline.push_back(p2);
+                curpolyline.push_back(p0);
             } else if (h >= hmin) // we do not continue to subdivide indefinitely!
             {
                 // push into stack in order to process both subintervals
@@ -911,8 +1125,7 @@ void KigPainter::drawCurve(const CurveImp *curve)
         }
     }
     // flush the rest of the curve
-    mP.drawPolyline(curpolyline.constData(), curpolylinenextfree);
-    curpolylinenextfree = 0;
+    flushPolyline();
 
     if (!workstack.empty())
         qDebug() << "Stack not empty in KigPainter::drawCurve!\n";
@@ -951,6 +1164,35 @@ void KigPainter::drawTextFrame(const Rect &frame, const QString &s, bool needfra
     drawText(frame, s, Qt::AlignVCenter | Qt::AlignLeft);
 }
 
+void KigPainter::drawTextFrame(const Rect &frame, KigTextLayout &t, bool needframe)
+{
+    layoutText(t);
+    QPen oldpen = mP.pen();
+    QBrush oldbrush = mP.brush();
+    if (needframe) {
+        setPen(QPen(Qt::black, 1));
+        setBrush(QBrush(QColor(255, 255, 222)));
+        drawRect(frame);
+        setPen(QPen(QColor(197, 194, 197), 1, Qt::SolidLine));
+
+        QRect qr = toScreen(frame);
+
+        mP.drawLine(qr.topLeft(), qr.topRight());
+        mP.drawLine(qr.topLeft(), qr.bottomLeft());
+    };
+    setPen(oldpen);
+    setBrush(oldbrush);
+
+    // this places the text like drawText( frame, s, Qt::AlignVCenter |
+    // Qt::AlignLeft ) does
+    QRect r = toScreen(frame);
+    r.adjust(2, 2, -2, -2);
+    const QPoint tl(r.left(), r.top() + (r.height() - t.msize.height()) / 2);
+    mP.drawStaticText(tl, t.mstatictext);
+    if (mNeedOverlay)
+        mOverlay.push_back(QRect(tl, t.msize + QSize(4, 4)));
+}
+
 void KigPainter::drawArc(const Coordinate &center, double radius, double dstartangle, double dangle)
 {
     // convert to 16th of degrees...
@@ -968,6 +1210,23 @@ void KigPainter::drawArc(const Coordinate &center, double radius, double dstarta
         QRectF rect = toScreenF(krect);
 
         mP.drawArc(rect, startangle, angle);
-        setWholeWinOverlay();
+        // the overlay of the whole circle is more than we need, but it
+        // is cheap and close enough
+        if (mNeedOverlay)
+            circleOverlay(center, radius);
     }
 }
+
+void KigPainter::drawPolyline(const std::vector<Coordinate> &pts)
+{
+    if (pts.size() < 2)
+        return;
+    QPolygonF t;
+    t.reserve(pts.size());
+    for (std::vector<Coordinate>::const_iterator i = pts.begin(); i != pts.end(); ++i)
+        t << toScreenF(*i);
+    mP.drawPolyline(t);
+    if (mNeedOverlay)
+        for (uint i = 1; i < pts.size(); ++i)
+            segmentOverlay(pts[i - 1], pts[i]);
+}
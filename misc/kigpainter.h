@@ -15,9 +15,11 @@
 #include <QColor>
 #include <QFont>
 #include <QPainter>
+#include <QStaticText>
 
 #include <vector>
 
+class CoordinateBuffer;
 class KigWidget;
 class QPaintDevice;
 class CoordinateSystem;
@@ -26,6 +28,33 @@ class CurveImp;
 class KigDocument;
 class ObjectHolder;
 
+/**
+ * A text, along with the way KigPainter lays it out.  Laying out text
+ * is expensive, so objects that draw the same text over and over again
+ * keep one of these around, and KigPainter only lays the text out again
+ * when the font or the resolution it is drawn with changes.
+ */
+class KigTextLayout
+{
+    friend class KigPainter;
+
+    QString mtext;
+    bool mlaidout;
+    QFont mfont;
+    int mdpi;
+    QSize msize;
+    QStaticText mstatictext;
+
+public:
+    explicit KigTextLayout(const QString &text);
+    ~KigTextLayout();
+
+    const QString &text() const
+    {
+        return mtext;
+    }
+};
+
 /**
  * KigPainter is an extended QPainter.
  *
@@ -55,6 +84,9 @@ protected:
     bool mNeedOverlay;
     int overlayenlarge;
     bool mSelected;
+    double msimplifytolerance;
+
+    void drawScreenPolygon(const QPolygon &t, Qt::FillRule fillRule);
 
 public:
     /**
@@ -97,6 +129,14 @@ public:
     void setFont(const QFont &f);
 
     void setSelected(bool selected);
+    /**
+     * the exporters set this to simplify the curves that drawCurve()
+     * draws to the resolution they are exported at: the polylines are
+     * simplified to within \p tolerance ( in document coordinates ) of
+     * the points calculated.  The default is 0, which draws all of the
+     * points.  \see CoordinateBuffer::simplify
+     */
+    void setSimplifyTolerance(double tolerance);
 
     QColor getColor() const;
     bool getNightVision() const;
@@ -112,6 +152,12 @@ public:
      */
     void setWholeWinOverlay();
 
+    /**
+     * only paint inside r from now on.  This is used to draw only the
+     * parts of the screen that need it, e.g. those scrolled into view.
+     */
+    void setClipRegion(const QRegion &r);
+
     /**
      * draw an object ( by calling its draw function. )
      */
@@ -191,6 +237,7 @@ public:
      */
     void drawPolygon(const std::vector<QPoint> &pts, Qt::FillRule fillRule = Qt::OddEvenFill);
     void drawPolygon(const std::vector<Coordinate> &pts, Qt::FillRule fillRule = Qt::OddEvenFill);
+    void drawPolygon(const CoordinateBuffer &pts, Qt::FillRule fillRule = Qt::OddEvenFill);
 
     /**
      * draw an area defined by the points in pts filled with the set
@@ -217,6 +264,12 @@ public:
      */
     void drawArc(const Coordinate &center, double radius, double startangle, double angle);
 
+    /**
+     * draw the open polyline through \p pts, in one go, so that the
+     * dash pattern of the pen runs on over the vertices.
+     */
+    void drawPolyline(const std::vector<Coordinate> &pts);
+
     /**
      * draw a vector ( with an arrow etc. )
      */
@@ -232,19 +285,50 @@ public:
 
     void drawSimpleText(const Coordinate &c, const QString &s);
     void drawTextFrame(const Rect &frame, const QString &s, bool needframe);
+    /**
+     * the same as the above, but with the layout of the text cached in
+     * t.
+     */
+    void drawTextFrame(const Rect &frame, KigTextLayout &t, bool needframe);
 
     const Rect boundingRect(const Rect &r, const QString &s, int f = 0) const;
 
     const Rect boundingRect(const Coordinate &c, const QString &s, int f = 0) const;
 
     const Rect simpleBoundingRect(const Coordinate &c, const QString &s);
+    const Rect simpleBoundingRect(const Coordinate &c, KigTextLayout &t);
 
     void drawGrid(const CoordinateSystem &c, bool showGrid = true, bool showAxes = true);
 
-    const std::vector<QRect> &overlay()
-    {
-        return mOverlay;
-    }
+    /**
+     * the places we have drawn on, merged into a limited number of
+     * rects, see coalesceOverlay().
+     */
+    const std::vector<QRect> &overlay();
+
+    /**
+     * merge \p rects into a small number of rects within \p bounds
+     * that together cover them.  Small sets of rects are kept as they
+     * are, larger ones are snapped to a grid of tiles, which gets
+     * coarser until there are few enough of them.
+     */
+    static void coalesceOverlay(std::vector<QRect> &rects, const QRect &bounds);
+
+    /**
+     * the places we have drawn on since the last call to
+     * takeOverlay(), like overlay().  The painter forgets them, so
+     * that the caller can find out where every single object is drawn.
+     */
+    std::vector<QRect> takeOverlay();
+
+    /**
+     * Some objects were drawn in the rects \p drawn, and the ones with
+     * \p changed set need to be drawn again.  Cleaning up the rects of
+     * an object also erases the parts of other objects that are drawn
+     * there, so those need to be drawn again too.  This returns which
+     * of the objects need to be drawn again.
+     */
+    static std::vector<bool> objectsToRedraw(const std::vector<std::vector<QRect>> &drawn, const std::vector<bool> &changed);
 
 protected:
     /**
@@ -274,6 +358,12 @@ protected:
      */
     void textOverlay(const QRect &r, const QString &s, int textFlags);
 
+    /**
+     * lay out t for the current font and paint device, unless that has
+     * already been done..
+     */
+    void layoutText(KigTextLayout &t);
+
     /**
      * the size we want the overlay rects to be...
      */
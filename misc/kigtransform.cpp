@@ -12,6 +12,19 @@
 #include "kignumerics.h"
 
 #include <cmath>
+#include <limits>
+
+#include <config-kig.h>
+
+#if defined(HAVE_IMMINTRIN_H) && (defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__))
+#include <immintrin.h>
+#define KIG_TRANSFORM_SSE2 1
+// the 256 bit kernel is compiled for AVX separately, and only used if
+// the CPU turns out to support it at runtime
+#if defined(__GNUC__)
+#define KIG_TRANSFORM_AVX 1
+#endif
+#endif
 
 using std::atan2;
 using std::cos;
@@ -617,6 +630,209 @@ const Coordinate Transformation::apply0(const Coordinate &p) const
     return apply(0., p.x, p.y);
 }
 
+/*
+ * batched versions of apply().  All of them compute exactly the same
+ * sums as apply( 1., x, y ), in the same order, so that they give
+ * bit for bit the same results, including the invalid Coordinate for
+ * points mapped to infinity.  The SIMD kernels read and write the
+ * Coordinates as pairs of doubles.
+ */
+
+static_assert(sizeof(Coordinate) == 2 * sizeof(double), "Coordinate must be a plain pair of doubles");
+
+static void applyScalar(const double m[3][3], const Coordinate *in, Coordinate *out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        const double x = in[i].x;
+        const double y = in[i].y;
+        const double w = m[0][0] + m[0][1] * x + m[0][2] * y;
+        if (w == 0.)
+            out[i] = Coordinate::invalidCoord();
+        else
+            out[i] = Coordinate((m[1][0] + m[1][1] * x + m[1][2] * y) / w, (m[2][0] + m[2][1] * x + m[2][2] * y) / w);
+    }
+}
+
+#ifdef KIG_TRANSFORM_SSE2
+static void applySSE2(const double m[3][3], const Coordinate *in, Coordinate *out, std::size_t n)
+{
+    // one Coordinate per register: [ x, y ]
+    const __m128d c0 = _mm_set_pd(m[2][0], m[1][0]);
+    const __m128d c1 = _mm_set_pd(m[2][1], m[1][1]);
+    const __m128d c2 = _mm_set_pd(m[2][2], m[1][2]);
+    const __m128d w0 = _mm_set1_pd(m[0][0]);
+    const __m128d w1 = _mm_set1_pd(m[0][1]);
+    const __m128d w2 = _mm_set1_pd(m[0][2]);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d inf = _mm_set1_pd(std::numeric_limits<double>::infinity());
+    for (std::size_t i = 0; i < n; ++i) {
+        const __m128d p = _mm_loadu_pd(&in[i].x);
+        const __m128d x = _mm_unpacklo_pd(p, p);
+        const __m128d y = _mm_unpackhi_pd(p, p);
+        const __m128d r = _mm_add_pd(_mm_add_pd(c0, _mm_mul_pd(c1, x)), _mm_mul_pd(c2, y));
+        const __m128d w = _mm_add_pd(_mm_add_pd(w0, _mm_mul_pd(w1, x)), _mm_mul_pd(w2, y));
+        const __m128d atinfinity = _mm_cmpeq_pd(w, zero);
+        const __m128d q = _mm_div_pd(r, w);
+        _mm_storeu_pd(&out[i].x, _mm_or_pd(_mm_andnot_pd(atinfinity, q), _mm_and_pd(atinfinity, inf)));
+    }
+}
+#endif
+
+#ifdef KIG_TRANSFORM_AVX
+__attribute__((target("avx"))) static void applyAVX(const double m[3][3], const Coordinate *in, Coordinate *out, std::size_t n)
+{
+    // two Coordinates per register: [ x0, y0, x1, y1 ]
+    const __m256d c0 = _mm256_set_pd(m[2][0], m[1][0], m[2][0], m[1][0]);
+    const __m256d c1 = _mm256_set_pd(m[2][1], m[1][1], m[2][1], m[1][1]);
+    const __m256d c2 = _mm256_set_pd(m[2][2], m[1][2], m[2][2], m[1][2]);
+    const __m256d w0 = _mm256_set1_pd(m[0][0]);
+    const __m256d w1 = _mm256_set1_pd(m[0][1]);
+    const __m256d w2 = _mm256_set1_pd(m[0][2]);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m256d p = _mm256_loadu_pd(&in[i].x);
+        const __m256d x = _mm256_unpacklo_pd(p, p);
+        const __m256d y = _mm256_unpackhi_pd(p, p);
+        const __m256d r = _mm256_add_pd(_mm256_add_pd(c0, _mm256_mul_pd(c1, x)), _mm256_mul_pd(c2, y));
+        const __m256d w = _mm256_add_pd(_mm256_add_pd(w0, _mm256_mul_pd(w1, x)), _mm256_mul_pd(w2, y));
+        const __m256d atinfinity = _mm256_cmp_pd(w, zero, _CMP_EQ_OQ);
+        const __m256d q = _mm256_div_pd(r, w);
+        _mm256_storeu_pd(&out[i].x, _mm256_blendv_pd(q, inf, atinfinity));
+    }
+    applyScalar(m, in + i, out + i, n - i);
+}
+
+static bool cpuHasAVX()
+{
+    static const bool ret = __builtin_cpu_supports("avx");
+    return ret;
+}
+#endif
+
+void Transformation::apply(const Coordinate *in, Coordinate *out, std::size_t n) const
+{
+#ifdef KIG_TRANSFORM_AVX
+    if (cpuHasAVX()) {
+        applyAVX(mdata, in, out, n);
+        return;
+    }
+#endif
+#ifdef KIG_TRANSFORM_SSE2
+    applySSE2(mdata, in, out, n);
+#else
+    applyScalar(mdata, in, out, n);
+#endif
+}
+
+const std::vector<Coordinate> Transformation::apply(const std::vector<Coordinate> &points) const
+{
+    std::vector<Coordinate> ret(points.size());
+    apply(points.data(), ret.data(), points.size());
+    return ret;
+}
+
+/*
+ * the same kernels for points stored as separate arrays of x and y
+ * values.  These need no shuffling: every register holds the x or the
+ * y values of a number of points.
+ */
+
+static void applyScalar(const double m[3][3], const double *xs, const double *ys, double *outx, double *outy, std::size_t n)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < n; ++i) {
+        const double x = xs[i];
+        const double y = ys[i];
+        const double w = m[0][0] + m[0][1] * x + m[0][2] * y;
+        if (w == 0.) {
+            outx[i] = inf;
+            outy[i] = inf;
+        } else {
+            outx[i] = (m[1][0] + m[1][1] * x + m[1][2] * y) / w;
+            outy[i] = (m[2][0] + m[2][1] * x + m[2][2] * y) / w;
+        }
+    }
+}
+
+#ifdef KIG_TRANSFORM_SSE2
+static void applySSE2(const double m[3][3], const double *xs, const double *ys, double *outx, double *outy, std::size_t n)
+{
+    // two points per register
+    const __m128d w0 = _mm_set1_pd(m[0][0]);
+    const __m128d w1 = _mm_set1_pd(m[0][1]);
+    const __m128d w2 = _mm_set1_pd(m[0][2]);
+    const __m128d x0 = _mm_set1_pd(m[1][0]);
+    const __m128d x1 = _mm_set1_pd(m[1][1]);
+    const __m128d x2 = _mm_set1_pd(m[1][2]);
+    const __m128d y0 = _mm_set1_pd(m[2][0]);
+    const __m128d y1 = _mm_set1_pd(m[2][1]);
+    const __m128d y2 = _mm_set1_pd(m[2][2]);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d inf = _mm_set1_pd(std::numeric_limits<double>::infinity());
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d x = _mm_loadu_pd(xs + i);
+        const __m128d y = _mm_loadu_pd(ys + i);
+        const __m128d w = _mm_add_pd(_mm_add_pd(w0, _mm_mul_pd(w1, x)), _mm_mul_pd(w2, y));
+        const __m128d rx = _mm_add_pd(_mm_add_pd(x0, _mm_mul_pd(x1, x)), _mm_mul_pd(x2, y));
+        const __m128d ry = _mm_add_pd(_mm_add_pd(y0, _mm_mul_pd(y1, x)), _mm_mul_pd(y2, y));
+        const __m128d atinfinity = _mm_cmpeq_pd(w, zero);
+        const __m128d qx = _mm_div_pd(rx, w);
+        const __m128d qy = _mm_div_pd(ry, w);
+        _mm_storeu_pd(outx + i, _mm_or_pd(_mm_andnot_pd(atinfinity, qx), _mm_and_pd(atinfinity, inf)));
+        _mm_storeu_pd(outy + i, _mm_or_pd(_mm_andnot_pd(atinfinity, qy), _mm_and_pd(atinfinity, inf)));
+    }
+    applyScalar(m, xs + i, ys + i, outx + i, outy + i, n - i);
+}
+#endif
+
+#ifdef KIG_TRANSFORM_AVX
+__attribute__((target("avx"))) static void applyAVX(const double m[3][3], const double *xs, const double *ys, double *outx, double *outy, std::size_t n)
+{
+    // four points per register
+    const __m256d w0 = _mm256_set1_pd(m[0][0]);
+    const __m256d w1 = _mm256_set1_pd(m[0][1]);
+    const __m256d w2 = _mm256_set1_pd(m[0][2]);
+    const __m256d x0 = _mm256_set1_pd(m[1][0]);
+    const __m256d x1 = _mm256_set1_pd(m[1][1]);
+    const __m256d x2 = _mm256_set1_pd(m[1][2]);
+    const __m256d y0 = _mm256_set1_pd(m[2][0]);
+    const __m256d y1 = _mm256_set1_pd(m[2][1]);
+    const __m256d y2 = _mm256_set1_pd(m[2][2]);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d x = _mm256_loadu_pd(xs + i);
+        const __m256d y = _mm256_loadu_pd(ys + i);
+        const __m256d w = _mm256_add_pd(_mm256_add_pd(w0, _mm256_mul_pd(w1, x)), _mm256_mul_pd(w2, y));
+        const __m256d rx = _mm256_add_pd(_mm256_add_pd(x0, _mm256_mul_pd(x1, x)), _mm256_mul_pd(x2, y));
+        const __m256d ry = _mm256_add_pd(_mm256_add_pd(y0, _mm256_mul_pd(y1, x)), _mm256_mul_pd(y2, y));
+        const __m256d atinfinity = _mm256_cmp_pd(w, zero, _CMP_EQ_OQ);
+        _mm256_storeu_pd(outx + i, _mm256_blendv_pd(_mm256_div_pd(rx, w), inf, atinfinity));
+        _mm256_storeu_pd(outy + i, _mm256_blendv_pd(_mm256_div_pd(ry, w), inf, atinfinity));
+    }
+    applyScalar(m, xs + i, ys + i, outx + i, outy + i, n - i);
+}
+#endif
+
+void Transformation::apply(const double *x, const double *y, double *outx, double *outy, std::size_t n) const
+{
+#ifdef KIG_TRANSFORM_AVX
+    if (cpuHasAVX()) {
+        applyAVX(mdata, x, y, outx, outy, n);
+        return;
+    }
+#endif
+#ifdef KIG_TRANSFORM_SSE2
+    applySSE2(mdata, x, y, outx, outy, n);
+#else
+    applyScalar(mdata, x, y, outx, outy, n);
+#endif
+}
+
 const Transformation Transformation::rotation(double alpha, const Coordinate &center)
 {
     Transformation ret = identity();
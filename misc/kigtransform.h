@@ -9,6 +9,7 @@
 #pragma once
 
 #include "coordinate.h"
+#include <cstddef>
 #include <vector>
 
 class LineData;
@@ -40,6 +41,22 @@ public:
     const Coordinate apply(const double x0, const double x1, const double x2) const;
     const Coordinate apply(const Coordinate &c) const;
     const Coordinate apply0(const Coordinate &c) const;
+    /**
+     * Apply this Transformation to n Coordinates at once: out[i] is
+     * set to apply( in[i] ).  in and out may point to the same array.
+     * This uses SIMD instructions where the CPU supports them, so it
+     * is a lot faster than calling apply in a loop when transforming
+     * the vertices of a polygon or the samples of a curve.
+     */
+    void apply(const Coordinate *in, Coordinate *out, std::size_t n) const;
+    /**
+     * The same for n points given by separate arrays of x and y
+     * values, like those of a CoordinateBuffer: the point ( x[i], y[i] )
+     * is mapped to ( outx[i], outy[i] ).  x and outx, and y and outy,
+     * may be the same arrays.
+     */
+    void apply(const double *x, const double *y, double *outx, double *outy, std::size_t n) const;
+    const std::vector<Coordinate> apply(const std::vector<Coordinate> &points) const;
 
     /**
      * Returns whether this is a homothetic (affine) transformation.
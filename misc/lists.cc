@@ -11,8 +11,11 @@
 #include "object_hierarchy.h"
 
 #include <KMessageBox>
+#include <QCoreApplication>
+#include <QDebug>
 #include <QFile>
 #include <QTextStream>
+#include <QThreadPool>
 #include <algorithm>
 #include <iterator>
 #include <qdom.h>
@@ -148,12 +151,25 @@ bool operator==(const Macro &l, const Macro &r)
         && (l.action->iconFileName() == r.action->iconFileName());
 }
 
+// a file that loadInBackground() reads
+struct MacroList::PendingFile {
+    QString file;
+    bool ok;
+    QDomDocument doc;
+};
+
 MacroList::MacroList()
+    : mloader(new QThreadPool)
+    , mloading(0)
 {
 }
 
 MacroList::~MacroList()
 {
+    // whatever is still being loaded is not needed anymore
+    mloader->waitForDone();
+    mpending.clear();
+
     std::vector<GUIAction *> actions;
     std::vector<ObjectConstructor *> ctors;
     for (vectype::iterator i = mdata.begin(); i != mdata.end(); ++i) {
@@ -204,11 +220,59 @@ void MacroList::remove(Macro *m)
     ObjectConstructorList::instance()->remove(c);
 }
 
-const MacroList::vectype &MacroList::macros() const
+const MacroList::vectype &MacroList::macros()
 {
+    finishLoading();
     return mdata;
 }
 
+void MacroList::loadInBackground(const QStringList &files)
+{
+    for (QStringList::const_iterator i = files.constBegin(); i != files.constEnd(); ++i) {
+        mpending.push_back(std::unique_ptr<PendingFile>(new PendingFile));
+        PendingFile *p = mpending.back().get();
+        p->file = *i;
+        p->ok = false;
+        ++mloading;
+        // the threads only read and parse the files, everything that
+        // looks up types or touches the GUI is done by finishLoading()
+        mloader->start([this, p]() {
+            p->ok = readFile(p->file, p->doc);
+            if (--mloading == 0 && QCoreApplication::instance())
+                QMetaObject::invokeMethod(
+                    QCoreApplication::instance(),
+                    [this]() {
+                        finishLoading();
+                    },
+                    Qt::QueuedConnection);
+        });
+    }
+}
+
+void MacroList::finishLoading()
+{
+    if (mpending.empty())
+        return;
+    mloader->waitForDone();
+    std::vector<std::unique_ptr<PendingFile>> pending;
+    pending.swap(mpending);
+
+    vectype macros;
+    for (std::vector<std::unique_ptr<PendingFile>>::const_iterator i = pending.begin(); i != pending.end(); ++i) {
+        const PendingFile &p = **i;
+        if (!p.ok) {
+            KMessageBox::error(nullptr, i18n("Could not open macro file '%1'", p.file));
+            continue;
+        }
+        vectype ms;
+        if (!loadDocument(p.file, p.doc, ms))
+            continue;
+        copy(ms.begin(), ms.end(), back_inserter(macros));
+    }
+    if (!macros.empty())
+        add(macros);
+}
+
 Macro::~Macro()
 {
 }
@@ -253,7 +317,7 @@ bool MacroList::save(const std::vector<Macro *> &ms, const QString &f)
 
         // data
         QDomElement hierelem = doc.createElement(QStringLiteral("Construction"));
-        ctor->hierarchy().serialize(hierelem, doc);
+        ctor->serializeHierarchy(hierelem, doc);
         macroelem.appendChild(hierelem);
 
         docelem.appendChild(macroelem);
@@ -269,23 +333,30 @@ bool MacroList::save(const std::vector<Macro *> &ms, const QString &f)
     return true;
 }
 
-bool MacroList::load(const QString &f, std::vector<Macro *> &ret, const KigPart &kdoc)
+bool MacroList::readFile(const QString &f, QDomDocument &doc)
 {
     QFile file(f);
-    if (!file.open(QIODevice::ReadOnly)) {
-        KMessageBox::error(nullptr, i18n("Could not open macro file '%1'", f));
+    if (!file.open(QIODevice::ReadOnly))
         return false;
-    }
+    return doc.setContent(&file);
+}
+
+bool MacroList::load(const QString &f, std::vector<Macro *> &ret, const KigPart &)
+{
     QDomDocument doc(QStringLiteral("KigMacroFile"));
-    if (!doc.setContent(&file)) {
+    if (!readFile(f, doc)) {
         KMessageBox::error(nullptr, i18n("Could not open macro file '%1'", f));
         return false;
     }
-    file.close();
+    return loadDocument(f, doc, ret);
+}
+
+bool MacroList::loadDocument(const QString &f, const QDomDocument &doc, std::vector<Macro *> &ret)
+{
     QDomElement main = doc.documentElement();
 
     if (main.tagName() == QLatin1String("KigMacroFile"))
-        return loadNew(main, ret, kdoc);
+        return loadNew(main, ret);
     else {
         KMessageBox::detailedError(nullptr,
                                    i18n("Kig cannot open the macro file \"%1\".", f),
@@ -298,7 +369,7 @@ bool MacroList::load(const QString &f, std::vector<Macro *> &ret, const KigPart
     }
 }
 
-bool MacroList::loadNew(const QDomElement &docelem, std::vector<Macro *> &ret, const KigPart &)
+bool MacroList::loadNew(const QDomElement &docelem, std::vector<Macro *> &ret)
 {
     bool sok = true;
     // unused..
@@ -308,11 +379,10 @@ bool MacroList::loadNew(const QDomElement &docelem, std::vector<Macro *> &ret, c
 
 
     int unnamedindex = 1;
-    QString tmp;
 
     for (QDomElement macroelem = docelem.firstChild().toElement(); !macroelem.isNull(); macroelem = macroelem.nextSibling().toElement()) {
         QString name, description;
-        ObjectHierarchy *hierarchy = nullptr;
+        QDomElement construction;
         QByteArray actionname;
         QByteArray iconfile("system-run");
         if (macroelem.tagName() != QLatin1String("Macro"))
@@ -323,7 +393,7 @@ bool MacroList::loadNew(const QDomElement &docelem, std::vector<Macro *> &ret, c
             else if (dataelem.tagName() == QLatin1String("Description"))
                 description = dataelem.text();
             else if (dataelem.tagName() == QLatin1String("Construction"))
-                hierarchy = ObjectHierarchy::buildSafeObjectHierarchy(dataelem, tmp);
+                construction = dataelem;
             else if (dataelem.tagName() == QLatin1String("ActionName"))
                 actionname = dataelem.text().toLatin1();
             else if (dataelem.tagName() == QLatin1String("IconFileName"))
@@ -331,18 +401,21 @@ bool MacroList::loadNew(const QDomElement &docelem, std::vector<Macro *> &ret, c
             else
                 continue;
         };
-        assert(hierarchy);
         // if the macro has no name, we give it a bogus name...
         bool name_i18ned = false;
         if (name.isEmpty()) {
             name = i18n("Unnamed Macro #%1", unnamedindex++);
             name_i18ned = true;
         }
-        MacroConstructor *ctor = new MacroConstructor(*hierarchy,
-                                                      name_i18ned ? name : i18n(name.toUtf8()),
-                                                      description.isEmpty() ? QString() : i18n(description.toUtf8()),
-                                                      iconfile);
-        delete hierarchy;
+        // the hierarchy is only built when the macro is first used
+        MacroConstructor *ctor = MacroConstructor::fromXml(construction,
+                                                           name_i18ned ? name : i18n(name.toUtf8()),
+                                                           description.isEmpty() ? QString() : i18n(description.toUtf8()),
+                                                           iconfile);
+        if (!ctor) {
+            qWarning() << "Could not read the macro" << name;
+            continue;
+        }
         GUIAction *act = new ConstructibleAction(ctor, actionname);
         Macro *macro = new Macro(act, ctor);
         ret.push_back(macro);
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <QStringList>
+
+#include <atomic>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -14,7 +18,9 @@ class KigDocument;
 class KigPart;
 class KigWidget;
 class QString;
+class QDomDocument;
 class QDomElement;
+class QThreadPool;
 class ObjectCalcer;
 
 /**
@@ -104,7 +110,14 @@ public:
     typedef std::vector<Macro *> vectype;
 
 private:
+    struct PendingFile;
+
     vectype mdata;
+    // the files that loadInBackground() is reading, or has read but
+    // whose macros haven't been added yet
+    std::vector<std::unique_ptr<PendingFile>> mpending;
+    std::unique_ptr<QThreadPool> mloader;
+    std::atomic<int> mloading;
     MacroList();
     ~MacroList();
 
@@ -152,10 +165,32 @@ public:
     bool load(const QString &f, vectype &ret, const KigPart &);
 
     /**
-     * get access to the list of macro's.
+     * load the macro's from the files \p files, and add them, without
+     * making the caller wait: the files are read and parsed by
+     * threads of their own, in parallel, and their macro's are added
+     * by the GUI thread once all of them are read.  This is only for
+     * the user's macro's: the builtin ones are referred to by the GUI
+     * description of the part, so they must exist before it is built.
+     *
+     * Only the names and the arguments of the macro's are read when they
+     * are added, their hierarchies are built when they are first used.
+     * \see MacroConstructor::fromXml
+     */
+    void loadInBackground(const QStringList &files);
+    /**
+     * wait until the files that loadInBackground() is reading are
+     * read, and add their macro's now.
+     */
+    void finishLoading();
+
+    /**
+     * get access to the list of macro's.  This waits for the macro's
+     * that are still being loaded, see finishLoading().
      */
-    const vectype &macros() const;
+    const vectype &macros();
 
 private:
-    bool loadNew(const QDomElement &docelem, std::vector<Macro *> &ret, const KigPart &);
+    static bool readFile(const QString &f, QDomDocument &doc);
+    bool loadDocument(const QString &f, const QDomDocument &doc, vectype &ret);
+    bool loadNew(const QDomElement &docelem, std::vector<Macro *> &ret);
 };
@@ -23,8 +23,11 @@
 
 #include "../modes/construct_mode.h"
 
+#include <QDebug>
 #include <QPen>
 
+#include <KMessageBox>
+
 #include <algorithm>
 #include <functional>
 #include <iterator>
@@ -314,13 +317,39 @@ QString MergeObjectConstructor::selectStatement(const std::vector<ObjectCalcer *
 
 MacroConstructor::MacroConstructor(const ObjectHierarchy &hier, const QString &name, const QString &desc, const QByteArray &iconfile)
     : ObjectConstructor()
-    , mhier(hier)
+    , mhier(new ObjectHierarchy(hier))
+    , mname(name)
+    , mdesc(desc)
+    , mbuiltin(false)
+    , miconfile(iconfile)
+    , mparser(mhier->argParser())
+    , mnumberofargs(mhier->numberOfArgs())
+    , mnumberofresults(mhier->numberOfResults())
+    , mlastresult(mhier->idOfLastResult())
+{
+}
+
+MacroConstructor::MacroConstructor(const QDomElement &construction, const QString &name, const QString &desc, const QByteArray &iconfile)
+    : ObjectConstructor()
+    , mconstruction(construction)
     , mname(name)
     , mdesc(desc)
     , mbuiltin(false)
     , miconfile(iconfile)
-    , mparser(mhier.argParser())
+    , mnumberofargs(0)
+    , mnumberofresults(0)
+    , mlastresult(nullptr)
+{
+}
+
+MacroConstructor *MacroConstructor::fromXml(const QDomElement &construction, const QString &name, const QString &desc, const QByteArray &iconfile)
 {
+    MacroConstructor *ret = new MacroConstructor(construction, name, desc, iconfile);
+    if (!ObjectHierarchy::readSignature(construction, ret->mparser, ret->mnumberofargs, ret->mnumberofresults, ret->mlastresult)) {
+        delete ret;
+        return nullptr;
+    }
+    return ret;
 }
 
 MacroConstructor::MacroConstructor(const std::vector<ObjectCalcer *> &input,
@@ -329,12 +358,15 @@ MacroConstructor::MacroConstructor(const std::vector<ObjectCalcer *> &input,
                                    const QString &description,
                                    const QByteArray &iconfile)
     : ObjectConstructor()
-    , mhier(input, output)
+    , mhier(new ObjectHierarchy(input, output))
     , mname(name)
     , mdesc(description)
     , mbuiltin(false)
     , miconfile(iconfile)
-    , mparser(mhier.argParser())
+    , mparser(mhier->argParser())
+    , mnumberofargs(mhier->numberOfArgs())
+    , mnumberofresults(mhier->numberOfResults())
+    , mlastresult(mhier->idOfLastResult())
 {
 }
 
@@ -367,10 +399,17 @@ int MacroConstructor::wantArgs(const std::vector<ObjectCalcer *> &os, const KigD
     return mparser.check(os);
 }
 
-void MacroConstructor::handleArgs(const std::vector<ObjectCalcer *> &os, KigPart &d, KigWidget &) const
+void MacroConstructor::handleArgs(const std::vector<ObjectCalcer *> &os, KigPart &d, KigWidget &v) const
 {
     std::vector<ObjectCalcer *> args = mparser.parse(os);
-    std::vector<ObjectCalcer *> bos = mhier.buildObjects(args, d.document());
+    const ObjectHierarchy &hier = hierarchy();
+    if (!merror.isNull()) {
+        KMessageBox::error(&v, i18n("The macro \"%1\" cannot be used, because its construction is broken: %2", mname, merror));
+        return;
+    }
+    if (args.size() != hier.numberOfArgs())
+        return;
+    std::vector<ObjectCalcer *> bos = hier.buildObjects(args, d.document());
     std::vector<ObjectHolder *> hos;
     for (std::vector<ObjectCalcer *>::iterator i = bos.begin(); i != bos.end(); ++i) {
         hos.push_back(new ObjectHolder(*i));
@@ -406,14 +445,17 @@ QString MacroConstructor::useText(const ObjectCalcer &o, const std::vector<Objec
 
 void MacroConstructor::handlePrelim(KigPainter &p, const std::vector<ObjectCalcer *> &sel, const KigDocument &doc, const KigWidget &) const
 {
-    if (sel.size() != mhier.numberOfArgs())
+    if (sel.size() != mnumberofargs)
         return;
 
     using namespace std;
     Args args;
     transform(sel.begin(), sel.end(), back_inserter(args), std::mem_fn(&ObjectCalcer::imp));
     args = mparser.parse(args);
-    std::vector<ObjectImp *> ret = mhier.calc(args, doc);
+    const ObjectHierarchy &hier = hierarchy();
+    if (args.size() != hier.numberOfArgs())
+        return;
+    std::vector<ObjectImp *> ret = hier.calc(args, doc);
     for (uint i = 0; i < ret.size(); ++i) {
         ObjectDrawer d;
         d.draw(*ret[i], p, true);
@@ -438,19 +480,19 @@ void MacroConstructor::plug(KigPart *doc, KigGUIAction *kact)
 {
     if (mbuiltin)
         return;
-    if (mhier.numberOfResults() != 1)
+    if (mnumberofresults != 1)
         doc->aMNewOther.append(kact);
     else {
-        if (mhier.idOfLastResult() == SegmentImp::stype())
+        if (mlastresult == SegmentImp::stype())
             doc->aMNewSegment.append(kact);
-        else if (mhier.idOfLastResult() == PointImp::stype())
+        else if (mlastresult == PointImp::stype())
             doc->aMNewPoint.append(kact);
-        else if (mhier.idOfLastResult() == CircleImp::stype())
+        else if (mlastresult == CircleImp::stype())
             doc->aMNewCircle.append(kact);
-        else if (mhier.idOfLastResult()->inherits(AbstractLineImp::stype()))
+        else if (mlastresult->inherits(AbstractLineImp::stype()))
             // line or ray
             doc->aMNewLine.append(kact);
-        else if (mhier.idOfLastResult() == ConicImp::stype())
+        else if (mlastresult == ConicImp::stype())
             doc->aMNewConic.append(kact);
         else
             doc->aMNewOther.append(kact);
@@ -460,7 +502,37 @@ void MacroConstructor::plug(KigPart *doc, KigGUIAction *kact)
 
 const ObjectHierarchy &MacroConstructor::hierarchy() const
 {
-    return mhier;
+    if (!mhier) {
+        QString error;
+        ObjectHierarchy *hier = ObjectHierarchy::buildSafeObjectHierarchy(mconstruction, error);
+        if (!hier) {
+            // readSignature() only checked the parts of the construction
+            // that tell how the macro is used.  Give the macro a
+            // hierarchy that takes no arguments, which makes it do
+            // nothing, and remember why, so that handleArgs() can tell
+            // the user.  We keep the construction, so that saving the
+            // macro doesn't lose it
+            qWarning() << "Could not build the macro" << mname << ":" << error;
+            merror = error.isEmpty() ? i18n("unknown error") : error;
+            mhier.reset(new ObjectHierarchy(std::vector<ObjectCalcer *>(), std::vector<ObjectCalcer *>()));
+            return *mhier;
+        }
+        mhier.reset(hier);
+        // this keeps the whole macro file in memory
+        mconstruction = QDomElement();
+    }
+    return *mhier;
+}
+
+void MacroConstructor::serializeHierarchy(QDomElement &parent, QDomDocument &doc) const
+{
+    const ObjectHierarchy &hier = hierarchy();
+    if (merror.isNull()) {
+        hier.serialize(parent, doc);
+        return;
+    }
+    for (QDomNode n = mconstruction.firstChild(); !n.isNull(); n = n.nextSibling())
+        parent.appendChild(doc.importNode(n, true));
 }
 
 bool SimpleObjectTypeConstructor::isTransform() const
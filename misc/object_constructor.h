@@ -7,6 +7,10 @@
 #include "argsparser.h"
 #include "object_hierarchy.h"
 
+#include <QDomElement>
+
+#include <memory>
+
 class KigPainter;
 class KigDocument;
 class KigGUIAction;
@@ -277,12 +281,23 @@ public:
  */
 class MacroConstructor : public ObjectConstructor
 {
-    ObjectHierarchy mhier;
+    // the hierarchy of a macro that was read from a macro file is only
+    // built from mconstruction when hierarchy() is first called
+    mutable std::unique_ptr<ObjectHierarchy> mhier;
+    mutable QDomElement mconstruction;
+    // why the hierarchy couldn't be built from mconstruction, if it
+    // couldn't
+    mutable QString merror;
     QString mname;
     QString mdesc;
     bool mbuiltin;
     QByteArray miconfile;
     ArgsParser mparser;
+    uint mnumberofargs;
+    uint mnumberofresults;
+    const ObjectImpType *mlastresult;
+
+    MacroConstructor(const QDomElement &construction, const QString &name, const QString &desc, const QByteArray &iconfile);
 
 public:
     MacroConstructor(const std::vector<ObjectCalcer *> &input,
@@ -291,9 +306,26 @@ public:
                      const QString &description,
                      const QByteArray &iconfile = nullptr);
     MacroConstructor(const ObjectHierarchy &hier, const QString &name, const QString &desc, const QByteArray &iconfile = nullptr);
+    /**
+     * the macro whose hierarchy is described by \p construction , the
+     * Construction element of a macro file.  Only what the macro takes
+     * and gives is read here, its hierarchy is built when the macro is
+     * first used.  Returns 0 if \p construction can't be read.
+     */
+    static MacroConstructor *fromXml(const QDomElement &construction, const QString &name, const QString &desc, const QByteArray &iconfile = nullptr);
     ~MacroConstructor();
 
+    /**
+     * the hierarchy of the macro.  If it is built from a broken macro
+     * file, this is a hierarchy that does nothing, and using the macro
+     * shows an error.
+     */
     const ObjectHierarchy &hierarchy() const;
+    /**
+     * save the hierarchy of the macro in \p parent .  A broken
+     * construction read from a macro file is saved as it was read.
+     */
+    void serializeHierarchy(QDomElement &parent, QDomDocument &doc) const;
 
     const QString descriptiveName() const override;
     const QString description() const override;
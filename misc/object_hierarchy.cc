@@ -5,6 +5,9 @@
 #include "object_hierarchy.h"
 
 #include <algorithm>
+#include <atomic>
+
+#include "kigtransform.h"
 
 #include "../objects/bogus_imp.h"
 #include "../objects/object_holder.h"
@@ -24,7 +27,6 @@ public:
     virtual int id() const = 0;
 
     virtual ~Node();
-    virtual Node *copy() const = 0;
 
     virtual void apply(std::vector<const ObjectImp *> &stack, int loc, const KigDocument &) const = 0;
 
@@ -51,7 +53,7 @@ ObjectHierarchy::Node::~Node()
 
 class PushStackNode : public ObjectHierarchy::Node
 {
-    ObjectImp *mimp;
+    const ObjectImp *mimp;
 
 public:
     PushStackNode(ObjectImp *imp)
@@ -66,7 +68,6 @@ public:
     }
 
     int id() const override;
-    Node *copy() const override;
     void apply(std::vector<const ObjectImp *> &stack, int loc, const KigDocument &) const override;
     void apply(std::vector<ObjectCalcer *> &stack, int loc) const override;
 
@@ -99,11 +100,6 @@ PushStackNode::~PushStackNode()
     delete mimp;
 }
 
-ObjectHierarchy::Node *PushStackNode::copy() const
-{
-    return new PushStackNode(mimp->copy());
-}
-
 void PushStackNode::apply(std::vector<const ObjectImp *> &stack, int loc, const KigDocument &) const
 {
     stack[loc] = mimp->copy();
@@ -121,7 +117,6 @@ public:
     {
     }
     ~ApplyTypeNode();
-    Node *copy() const override;
 
     const ObjectType *type() const
     {
@@ -136,6 +131,15 @@ public:
     void apply(std::vector<const ObjectImp *> &stack, int loc, const KigDocument &) const override;
     void apply(std::vector<ObjectCalcer *> &stack, int loc) const override;
 
+    // evaluate a transform node that is part of a chain of transform
+    // nodes, see ObjectHierarchy::calc.  If defer is true, the result
+    // is not computed, but recorded in pending.
+    void applyTransformLink(std::vector<const ObjectImp *> &stack,
+                            std::map<int, Transformation> &pending,
+                            bool defer,
+                            int loc,
+                            const KigDocument &) const;
+
     void checkDependsOnGiven(std::vector<bool> &dependsstack, int loc) const override;
     void checkArgumentsUsed(std::vector<bool> &usedstack) const override;
 };
@@ -165,11 +169,6 @@ ApplyTypeNode::~ApplyTypeNode()
 {
 }
 
-ObjectHierarchy::Node *ApplyTypeNode::copy() const
-{
-    return new ApplyTypeNode(mtype, mparents);
-}
-
 void ApplyTypeNode::apply(std::vector<ObjectCalcer *> &stack, int loc) const
 {
     std::vector<ObjectCalcer *> parents;
@@ -187,9 +186,79 @@ void ApplyTypeNode::apply(std::vector<const ObjectImp *> &stack, int loc, const
     stack[loc] = mtype->calc(args, doc);
 }
 
+static void calcPendingTransform(std::vector<const ObjectImp *> &stack, std::map<int, Transformation> &pending, int loc)
+{
+    std::map<int, Transformation>::iterator i = pending.find(loc);
+    if (i == pending.end())
+        return;
+    stack[loc] = stack[loc]->transform(i->second);
+    pending.erase(i);
+}
+
+void ApplyTypeNode::applyTransformLink(std::vector<const ObjectImp *> &stack,
+                                       std::map<int, Transformation> &pending,
+                                       bool defer,
+                                       int loc,
+                                       const KigDocument &doc) const
+{
+    // the stack entry of a pending parent is not its real value, but
+    // the object at the start of its chain.  That is only a valid
+    // stand-in if it ends up as the object we transform, and if that
+    // object isn't passed to us in some other way too.
+    int chained = -1;
+    bool ambiguous = false;
+    for (uint i = 0; i < mparents.size(); ++i) {
+        if (pending.find(mparents[i]) == pending.end())
+            continue;
+        ambiguous |= chained != -1;
+        chained = mparents[i];
+    }
+
+    Args args;
+    for (uint i = 0; i < mparents.size(); ++i)
+        args.push_back(stack[mparents[i]]);
+    if (chained != -1)
+        ambiguous |= std::count(args.begin(), args.end(), stack[chained]) != 1;
+    args = mtype->sortArgs(args);
+
+    Transformation t = Transformation::identity();
+    if (chained != -1) {
+        // only homotheties are composed, since they don't change the
+        // type of the objects they're applied to, so the composed
+        // transformation gives the same result as applying them one by
+        // one.
+        if (!ambiguous && args[0] == stack[chained] && mtype->transformation(args, doc, t) && t.isHomothetic()) {
+            std::map<int, Transformation>::iterator p = pending.find(chained);
+            t = t * p->second;
+            pending.erase(p);
+            stack[chained] = nullptr;
+        } else {
+            for (uint i = 0; i < mparents.size(); ++i)
+                calcPendingTransform(stack, pending, mparents[i]);
+            args.clear();
+            for (uint i = 0; i < mparents.size(); ++i)
+                args.push_back(stack[mparents[i]]);
+            args = mtype->sortArgs(args);
+            chained = -1;
+        }
+    }
+    if (chained == -1 && !mtype->transformation(args, doc, t)) {
+        stack[loc] = mtype->calc(args, doc);
+        return;
+    }
+
+    if (defer && t.isHomothetic()) {
+        pending.insert(std::make_pair(loc, t));
+        stack[loc] = args[0];
+    } else
+        stack[loc] = args[0]->transform(t);
+}
+
 class FetchPropertyNode : public ObjectHierarchy::Node
 {
-    mutable int mpropgid;
+    // the node can be shared by hierarchies that are calc'ed by
+    // different threads, hence the atomic
+    mutable std::atomic<int> mpropgid;
     int mparent;
     const QByteArray mname;
 
@@ -205,7 +274,6 @@ public:
     {
     }
     ~FetchPropertyNode();
-    Node *copy() const override;
 
     void checkDependsOnGiven(std::vector<bool> &dependsstack, int loc) const override;
     void checkArgumentsUsed(std::vector<bool> &usedstack) const override;
@@ -237,11 +305,6 @@ void FetchPropertyNode::checkDependsOnGiven(std::vector<bool> &dependsstack, int
     dependsstack[loc] = dependsstack[mparent];
 }
 
-ObjectHierarchy::Node *FetchPropertyNode::copy() const
-{
-    return new FetchPropertyNode(mparent, mname, mpropgid);
-}
-
 int FetchPropertyNode::id() const
 {
     return ID_FetchProp;
@@ -250,20 +313,54 @@ int FetchPropertyNode::id() const
 void FetchPropertyNode::apply(std::vector<const ObjectImp *> &stack, int loc, const KigDocument &d) const
 {
     assert(stack[mparent]);
-    if (mpropgid == -1)
-        mpropgid = stack[mparent]->getPropGid(mname);
-    if (mpropgid != -1)
-        stack[loc] = stack[mparent]->property(stack[mparent]->getPropLid(mpropgid), d);
+    int propgid = mpropgid;
+    if (propgid == -1)
+        mpropgid = propgid = stack[mparent]->getPropGid(mname);
+    if (propgid != -1)
+        stack[loc] = stack[mparent]->property(stack[mparent]->getPropLid(propgid), d);
     else
         stack[loc] = new InvalidImp();
 }
 
 void FetchPropertyNode::apply(std::vector<ObjectCalcer *> &stack, int loc) const
 {
-    if (mpropgid == -1)
-        mpropgid = stack[mparent]->imp()->getPropGid(mname);
-    assert(mpropgid != -1);
-    stack[loc] = new ObjectPropertyCalcer(stack[mparent], mpropgid, false);
+    int propgid = mpropgid;
+    if (propgid == -1)
+        mpropgid = propgid = stack[mparent]->imp()->getPropGid(mname);
+    assert(propgid != -1);
+    stack[loc] = new ObjectPropertyCalcer(stack[mparent], propgid, false);
+}
+
+/**
+ * Find the transform nodes whose result is not one of the results of
+ * the hierarchy, and is used by exactly one other node, which is a
+ * transform node as well.  Nobody but that other node ever gets to
+ * see the result of such a node, so they don't need to be computed if
+ * that other node can apply their transformation too.
+ */
+static std::vector<bool> transformChainLinks(const std::vector<std::shared_ptr<const ObjectHierarchy::Node>> &nodes, uint numberofargs, uint numberofresults)
+{
+    // the number of nodes using each stack entry, or -1 if it is used by
+    // a node that is not a transform node.
+    std::vector<int> users(numberofargs + nodes.size(), 0);
+    for (uint i = 0; i < nodes.size(); ++i) {
+        if (nodes[i]->id() == ObjectHierarchy::Node::ID_ApplyType) {
+            const ApplyTypeNode *node = static_cast<const ApplyTypeNode *>(nodes[i].get());
+            const bool transform = node->type()->isTransform();
+            for (uint j = 0; j < node->parents().size(); ++j) {
+                int &u = users[node->parents()[j]];
+                if (u != -1)
+                    u = transform ? u + 1 : -1;
+            }
+        } else if (nodes[i]->id() == ObjectHierarchy::Node::ID_FetchProp)
+            users[static_cast<const FetchPropertyNode *>(nodes[i].get())->parent()] = -1;
+    }
+
+    std::vector<bool> ret(nodes.size(), false);
+    for (uint i = 0; i + numberofresults < nodes.size(); ++i)
+        ret[i] = nodes[i]->id() == ObjectHierarchy::Node::ID_ApplyType
+            && static_cast<const ApplyTypeNode *>(nodes[i].get())->type()->isTransform() && users[numberofargs + i] == 1;
+    return ret;
 }
 
 std::vector<ObjectImp *> ObjectHierarchy::calc(const Args &a, const KigDocument &doc) const
@@ -275,9 +372,23 @@ std::vector<ObjectImp *> ObjectHierarchy::calc(const Args &a, const KigDocument
     std::vector<const ObjectImp *> stack;
     stack.resize(mnodes.size() + mnumberofargs, nullptr);
     std::copy(a.begin(), a.end(), stack.begin());
+
+    // chains of transformations, like the ones transformFinalObject
+    // builds for a locus that is rotated, and then translated etc., are
+    // evaluated as one composed transformation, so that we don't
+    // need to build all of the intermediate objects.  pending contains
+    // the composed transformation of the chains we're in the middle of.
+    const std::vector<bool> links = transformChainLinks(mnodes, mnumberofargs, mnumberofresults);
+    std::map<int, Transformation> pending;
     for (uint i = 0; i < mnodes.size(); ++i) {
-        mnodes[i]->apply(stack, mnumberofargs + i, doc);
+        const bool transform =
+            mnodes[i]->id() == Node::ID_ApplyType && static_cast<const ApplyTypeNode *>(mnodes[i].get())->type()->isTransform();
+        if (transform && (links[i] || !pending.empty()))
+            static_cast<const ApplyTypeNode *>(mnodes[i].get())->applyTransformLink(stack, pending, links[i], mnumberofargs + i, doc);
+        else
+            mnodes[i]->apply(stack, mnumberofargs + i, doc);
     };
+    assert(pending.empty());
     for (uint i = mnumberofargs; i < stack.size() - mnumberofresults; ++i)
         delete stack[i];
     if (stack.size() < mnumberofargs + mnumberofresults) {
@@ -306,7 +417,7 @@ int ObjectHierarchy::visit(const ObjectCalcer *o, std::map<const ObjectCalcer *,
             int ret = mnumberofargs + mnodes.size();
             std::vector<int> parents;
             parents.push_back(smi->second);
-            mnodes.push_back(new ApplyTypeNode(CopyObjectType::instance(), parents));
+            mnodes.push_back(std::make_shared<ApplyTypeNode>(CopyObjectType::instance(), parents));
             return ret;
         } else
             return smi->second;
@@ -329,8 +440,7 @@ int ObjectHierarchy::visit(const ObjectCalcer *o, std::map<const ObjectCalcer *,
             // o is an object that does not depend on the given objects, but
             // is needed by other objects, so we just have to just save its
             // current value here.
-            Node *node = new PushStackNode(o->imp()->copy());
-            mnodes.push_back(node);
+            mnodes.push_back(std::make_shared<PushStackNode>(o->imp()->copy()));
             int ret = mnodes.size() + mnumberofargs - 1;
             seenmap[o] = ret;
             return ret;
@@ -343,21 +453,18 @@ int ObjectHierarchy::visit(const ObjectCalcer *o, std::map<const ObjectCalcer *,
 
 ObjectHierarchy::~ObjectHierarchy()
 {
-    for (uint i = 0; i < mnodes.size(); ++i)
-        delete mnodes[i];
 }
 
 ObjectHierarchy::ObjectHierarchy(const ObjectHierarchy &h)
-    : mnumberofargs(h.mnumberofargs)
+    : mnodes(h.mnodes)
+    , mnumberofargs(h.mnumberofargs)
     , mnumberofresults(h.mnumberofresults)
     , msaveinputtags(h.msaveinputtags)
     , margrequirements(h.margrequirements)
     , musetexts(h.musetexts)
     , mselectstatements(h.mselectstatements)
 {
-    mnodes.reserve(h.mnodes.size());
-    for (uint i = 0; i < h.mnodes.size(); ++i)
-        mnodes.push_back(h.mnodes[i]->copy());
+    // the nodes never change, so the copy simply shares them
 }
 
 ObjectHierarchy ObjectHierarchy::withFixedArgs(const Args &a) const
@@ -368,11 +475,11 @@ ObjectHierarchy ObjectHierarchy::withFixedArgs(const Args &a) const
     ret.mnumberofargs -= a.size();
     ret.margrequirements.resize(ret.mnumberofargs);
 
-    std::vector<Node *> newnodes(mnodes.size() + a.size());
-    std::vector<Node *>::iterator newnodesiter = newnodes.begin();
+    std::vector<std::shared_ptr<const Node>> newnodes(mnodes.size() + a.size());
+    std::vector<std::shared_ptr<const Node>>::iterator newnodesiter = newnodes.begin();
     for (uint i = 0; i < a.size(); ++i) {
         assert(!a[i]->isCache());
-        *newnodesiter++ = new PushStackNode(a[i]->copy());
+        *newnodesiter++ = std::make_shared<PushStackNode>(a[i]->copy());
     };
     std::copy(ret.mnodes.begin(), ret.mnodes.end(), newnodesiter);
     ret.mnodes = newnodes;
@@ -439,7 +546,7 @@ void ObjectHierarchy::serialize(QDomElement &parent, QDomDocument &doc) const
         e.setAttribute(QStringLiteral("id"), id++);
 
         if (mnodes[i]->id() == Node::ID_ApplyType) {
-            const ApplyTypeNode *node = static_cast<const ApplyTypeNode *>(mnodes[i]);
+            const ApplyTypeNode *node = static_cast<const ApplyTypeNode *>(mnodes[i].get());
             e.setAttribute(QStringLiteral("action"), QStringLiteral("calc"));
             e.setAttribute(QStringLiteral("type"), QString::fromLatin1(node->type()->fullName()));
             for (uint i = 0; i < node->parents().size(); ++i) {
@@ -449,7 +556,7 @@ void ObjectHierarchy::serialize(QDomElement &parent, QDomDocument &doc) const
                 e.appendChild(arge);
             };
         } else if (mnodes[i]->id() == Node::ID_FetchProp) {
-            const FetchPropertyNode *node = static_cast<const FetchPropertyNode *>(mnodes[i]);
+            const FetchPropertyNode *node = static_cast<const FetchPropertyNode *>(mnodes[i].get());
             e.setAttribute(QStringLiteral("action"), QStringLiteral("fetch-property"));
             e.setAttribute(QStringLiteral("property"), QString(node->propinternalname()));
             QDomElement arge = doc.createElement(QStringLiteral("arg"));
@@ -457,7 +564,7 @@ void ObjectHierarchy::serialize(QDomElement &parent, QDomDocument &doc) const
             e.appendChild(arge);
         } else {
             assert(mnodes[i]->id() == ObjectHierarchy::Node::ID_PushStack);
-            const PushStackNode *node = static_cast<const PushStackNode *>(mnodes[i]);
+            const PushStackNode *node = static_cast<const PushStackNode *>(mnodes[i].get());
             e.setAttribute(QStringLiteral("action"), QStringLiteral("push"));
             QString type = ObjectImpFactory::instance()->serialize(*node->imp(), e, doc);
             e.setAttribute(QStringLiteral("type"), type);
@@ -474,52 +581,110 @@ ObjectHierarchy::ObjectHierarchy()
 {
 }
 
-ObjectHierarchy *ObjectHierarchy::buildSafeObjectHierarchy(const QDomElement &parent, QString &error)
+bool ObjectHierarchy::readInputs(QDomElement &e)
 {
-#define KIG_GENERIC_PARSE_ERROR                                                                                                                                \
-    {                                                                                                                                                          \
-        error = i18n("An error was encountered at line %1 in file %2.", __LINE__, __FILE__);                                                                   \
-        return nullptr;                                                                                                                                        \
-    }
-
-    ObjectHierarchy *obhi = new ObjectHierarchy();
-
     bool ok = true;
     QString tmp;
-    QDomElement e = parent.firstChild().toElement();
     for (; !e.isNull(); e = e.nextSibling().toElement()) {
         if (e.tagName() != QLatin1String("input"))
             break;
 
         tmp = e.attribute(QStringLiteral("id"));
         uint id = tmp.toInt(&ok);
-        if (!ok)
-            KIG_GENERIC_PARSE_ERROR;
+        if (!ok || id == 0)
+            return false;
 
-        obhi->mnumberofargs = qMax(id, obhi->mnumberofargs);
+        mnumberofargs = qMax(id, mnumberofargs);
 
         tmp = e.attribute(QStringLiteral("requirement"));
         const ObjectImpType *req = ObjectImpType::typeFromInternalName(tmp.toLatin1());
         if (req == nullptr)
             req = ObjectImp::stype(); // sucks, i know..
-        obhi->margrequirements.resize(obhi->mnumberofargs, ObjectImp::stype());
-        obhi->musetexts.resize(obhi->mnumberofargs, "");
-        obhi->mselectstatements.resize(obhi->mnumberofargs, "");
-        obhi->margrequirements[id - 1] = req;
-        obhi->musetexts[id - 1] = req->selectStatement();
+        margrequirements.resize(mnumberofargs, ObjectImp::stype());
+        musetexts.resize(mnumberofargs, "");
+        mselectstatements.resize(mnumberofargs, "");
+        margrequirements[id - 1] = req;
+        musetexts[id - 1] = req->selectStatement();
         QDomElement esub = e.firstChild().toElement();
         for (; !esub.isNull(); esub = esub.nextSibling().toElement()) {
             if (esub.tagName() == QLatin1String("UseText")) {
-                obhi->msaveinputtags = true;
-                obhi->musetexts[id - 1] = esub.text();
+                msaveinputtags = true;
+                musetexts[id - 1] = esub.text();
             } else if (esub.tagName() == QLatin1String("SelectStatement")) {
-                obhi->msaveinputtags = true;
-                obhi->mselectstatements[id - 1] = esub.text();
+                msaveinputtags = true;
+                mselectstatements[id - 1] = esub.text();
             } else {
                 // broken file ? ignore...
             }
         }
     }
+    return true;
+}
+
+bool ObjectHierarchy::readSignature(const QDomElement &parent, ArgsParser &parser, uint &numberofargs, uint &numberofresults, const ObjectImpType *&lastresult)
+{
+    ObjectHierarchy h;
+    QDomElement e = parent.firstChild().toElement();
+    if (!h.readInputs(e))
+        return false;
+
+    // the last result is the node with the highest id, see
+    // idOfLastResult()
+    QDomElement last;
+    int lastid = 0;
+    bool ok = true;
+    for (; !e.isNull(); e = e.nextSibling().toElement()) {
+        if (e.tagName() == QLatin1String("result"))
+            ++h.mnumberofresults;
+        const int id = e.attribute(QStringLiteral("id")).toInt(&ok);
+        if (!ok)
+            return false;
+        if (id > lastid) {
+            lastid = id;
+            last = e;
+        }
+    }
+    if (last.isNull())
+        return false;
+
+    const QString action = last.attribute(QStringLiteral("action"));
+    if (action == QLatin1String("calc")) {
+        const ObjectType *type = ObjectTypeFactory::instance()->find(last.attribute(QStringLiteral("type")).toLatin1());
+        if (!type)
+            return false;
+        lastresult = type->resultId();
+    } else if (action == QLatin1String("fetch-property"))
+        lastresult = ObjectImp::stype();
+    else {
+        QString error;
+        ObjectImp *imp = ObjectImpFactory::instance()->deserialize(last.attribute(QStringLiteral("type")), last, error);
+        if (!imp)
+            return false;
+        lastresult = imp->type();
+        delete imp;
+    }
+
+    parser = h.argParser();
+    numberofargs = h.mnumberofargs;
+    numberofresults = h.mnumberofresults;
+    return true;
+}
+
+ObjectHierarchy *ObjectHierarchy::buildSafeObjectHierarchy(const QDomElement &parent, QString &error)
+{
+#define KIG_GENERIC_PARSE_ERROR                                                                                                                                \
+    {                                                                                                                                                          \
+        error = i18n("An error was encountered at line %1 in file %2.", __LINE__, __FILE__);                                                                   \
+        return nullptr;                                                                                                                                        \
+    }
+
+    ObjectHierarchy *obhi = new ObjectHierarchy();
+
+    bool ok = true;
+    QString tmp;
+    QDomElement e = parent.firstChild().toElement();
+    if (!obhi->readInputs(e))
+        KIG_GENERIC_PARSE_ERROR;
     for (; !e.isNull(); e = e.nextSibling().toElement()) {
         bool result = e.tagName() == QLatin1String("result");
         if (result)
@@ -531,7 +696,7 @@ ObjectHierarchy *ObjectHierarchy::buildSafeObjectHierarchy(const QDomElement &pa
             KIG_GENERIC_PARSE_ERROR;
 
         tmp = e.attribute(QStringLiteral("action"));
-        Node *newnode = nullptr;
+        std::shared_ptr<const Node> newnode;
         if (tmp == QLatin1String("calc")) {
             // ApplyTypeNode
             QByteArray typen = e.attribute(QStringLiteral("type")).toLatin1();
@@ -559,7 +724,7 @@ ObjectHierarchy *ObjectHierarchy::buildSafeObjectHierarchy(const QDomElement &pa
                     KIG_GENERIC_PARSE_ERROR;
                 parents.push_back(pid - 1);
             };
-            newnode = new ApplyTypeNode(type, parents);
+            newnode = std::make_shared<ApplyTypeNode>(type, parents);
         } else if (tmp == QLatin1String("fetch-property")) {
             // FetchPropertyNode
             QByteArray propname = e.attribute(QStringLiteral("property")).toLatin1();
@@ -567,7 +732,7 @@ ObjectHierarchy *ObjectHierarchy::buildSafeObjectHierarchy(const QDomElement &pa
             int parent = arge.text().toInt(&ok);
             if (!ok)
                 KIG_GENERIC_PARSE_ERROR;
-            newnode = new FetchPropertyNode(parent - 1, propname);
+            newnode = std::make_shared<FetchPropertyNode>(parent - 1, propname);
         } else {
             // PushStackNode
             if (e.attribute(QStringLiteral("action")) != QLatin1String("push"))
@@ -578,7 +743,7 @@ ObjectHierarchy *ObjectHierarchy::buildSafeObjectHierarchy(const QDomElement &pa
             ObjectImp *imp = ObjectImpFactory::instance()->deserialize(typen, e, error);
             if ((!imp) && !error.isEmpty())
                 return nullptr;
-            newnode = new PushStackNode(imp);
+            newnode = std::make_shared<PushStackNode>(imp);
         };
         obhi->mnodes.resize(qMax(size_t(id - obhi->mnumberofargs), obhi->mnodes.size()));
         obhi->mnodes[id - obhi->mnumberofargs - 1] = newnode;
@@ -624,7 +789,9 @@ std::vector<ObjectCalcer *> ObjectHierarchy::buildObjects(const std::vector<Obje
 
 const ObjectImpType *ObjectHierarchy::idOfLastResult() const
 {
-    const Node *n = mnodes.back();
+    if (mnodes.empty())
+        return ObjectImp::stype();
+    const Node *n = mnodes.back().get();
     if (n->id() == Node::ID_PushStack)
         return static_cast<const PushStackNode *>(n)->imp()->type();
     else if (n->id() == Node::ID_FetchProp)
@@ -637,13 +804,13 @@ ObjectHierarchy ObjectHierarchy::transformFinalObject(const Transformation &t) c
 {
     assert(mnumberofresults == 1);
     ObjectHierarchy ret(*this);
-    ret.mnodes.push_back(new PushStackNode(new TransformationImp(t)));
+    ret.mnodes.push_back(std::make_shared<PushStackNode>(new TransformationImp(t)));
 
     std::vector<int> parents;
     parents.push_back(ret.mnodes.size() - 1);
     parents.push_back(ret.mnodes.size());
     const ObjectType *type = ApplyTransformationObjectType::instance();
-    ret.mnodes.push_back(new ApplyTypeNode(type, parents));
+    ret.mnodes.push_back(std::make_shared<ApplyTypeNode>(type, parents));
     return ret;
 }
 
@@ -714,8 +881,7 @@ int ObjectHierarchy::storeObject(const ObjectCalcer *o,
             if (po[i]->imp()->isCache()) {
                 pl[i] = visit(po[i], seenmap, true, false);
             } else {
-                Node *argnode = new PushStackNode(po[i]->imp()->copy());
-                mnodes.push_back(argnode);
+                mnodes.push_back(std::make_shared<PushStackNode>(po[i]->imp()->copy()));
                 int argloc = mnumberofargs + mnodes.size() - 1;
                 seenmap[po[i]] = argloc;
                 pl[i] = argloc;
@@ -729,7 +895,7 @@ int ObjectHierarchy::storeObject(const ObjectCalcer *o,
         };
     };
     if (dynamic_cast<const ObjectTypeCalcer *>(o))
-        mnodes.push_back(new ApplyTypeNode(static_cast<const ObjectTypeCalcer *>(o)->type(), pl));
+        mnodes.push_back(std::make_shared<ApplyTypeNode>(static_cast<const ObjectTypeCalcer *>(o)->type(), pl));
     else if (dynamic_cast<const ObjectPropertyCalcer *>(o)) {
         assert(pl.size() == 1);
         int parent = pl.front();
@@ -738,7 +904,7 @@ int ObjectHierarchy::storeObject(const ObjectCalcer *o,
         int propgid = static_cast<const ObjectPropertyCalcer *>(o)->propGid();
         //    assert( propid < op->imp()->propertiesInternalNames().size() );
         //    mnodes.push_back( new FetchPropertyNode( parent, op->imp()->propertiesInternalNames()[propid], propgid ) );
-        mnodes.push_back(new FetchPropertyNode(parent, op->imp()->getPropName(propgid), propgid));
+        mnodes.push_back(std::make_shared<FetchPropertyNode>(parent, op->imp()->getPropName(propgid), propgid));
     } else
         assert(false);
     seenmap[o] = mnumberofargs + mnodes.size() - 1;
@@ -7,6 +7,7 @@
 #include "../objects/common.h"
 
 #include <map>
+#include <memory>
 #include <vector>
 
 class ObjectImpType;
@@ -18,7 +19,11 @@ public:
     class Node;
 
 private:
-    std::vector<Node *> mnodes;
+    // the nodes are immutable once they are in a hierarchy, so copies
+    // of a hierarchy, and the ones that withFixedArgs() and
+    // transformFinalObject() derive from it, share them instead of
+    // copying them
+    std::vector<std::shared_ptr<const Node>> mnodes;
     uint mnumberofargs;
     uint mnumberofresults;
     bool msaveinputtags; // if true the UseText and SelectStatement are serialized for saving
@@ -33,6 +38,11 @@ private:
     friend bool operator==(const ObjectHierarchy &lhs, const ObjectHierarchy &rhs);
 
     void init(const std::vector<ObjectCalcer *> &from, const std::vector<ObjectCalcer *> &to);
+    /**
+     * read the input elements starting at \p e, and leave \p e at the
+     * first element after them.
+     */
+    bool readInputs(QDomElement &e);
 
     /**
      * this constructor is private since it should be used only by the static
@@ -55,9 +65,18 @@ public:
     /**
      * this creates a new ObjectHierarchy, that takes a.size() less
      * arguments, but uses copies of the ObjectImp's in \p a instead.
+     * The other nodes are shared with this hierarchy.
      */
     ObjectHierarchy withFixedArgs(const Args &a) const;
 
+    /**
+     * calculate the results of the hierarchy for the arguments \p a .
+     * A chain of homothetic transformations, whose intermediate
+     * results are used by nothing but the next transformation in the
+     * chain, is evaluated as one composed transformation.
+     * ObjectTypeCalcer::calc() does the same for the chains that
+     * buildObjects() leaves in a document.
+     */
     std::vector<ObjectImp *> calc(const Args &a, const KigDocument &doc) const;
 
     /**
@@ -70,6 +89,17 @@ public:
      * static to return 0 in case of error.
      */
     static ObjectHierarchy *buildSafeObjectHierarchy(const QDomElement &parent, QString &error);
+
+    /**
+     * Read only what the hierarchy in the xml element \p parent takes
+     * and gives: the argParser(), numberOfArgs(), numberOfResults() and
+     * idOfLastResult() of the hierarchy that buildSafeObjectHierarchy()
+     * would build from it.  This doesn't build the nodes of the
+     * hierarchy, which is what takes time, so MacroConstructor uses it
+     * to postpone that until the macro is used.  Returns false if
+     * \p parent is not a valid hierarchy.
+     */
+    static bool readSignature(const QDomElement &parent, ArgsParser &parser, uint &numberofargs, uint &numberofresults, const ObjectImpType *&lastresult);
     //  explicit ObjectHierarchy( const QDomElement& parent );
 
     /**
@@ -0,0 +1,404 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "polygon_clipping.h"
+
+#include "polygon_edge_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+namespace
+{
+struct Side {
+    Coordinate a;
+    Coordinate b;
+    double xmin;
+    double xmax;
+    double ymin;
+    double ymax;
+    // the points where this side needs to be split, as parameters
+    // along the side together with the exact point to use, so that
+    // both sides involved in an intersection get the same vertex.
+    std::vector<std::pair<double, Coordinate>> cuts;
+};
+
+struct Piece {
+    Coordinate a;
+    Coordinate b;
+};
+
+// parametric tolerance under which an intersection is considered to
+// be at the endpoint of a side.
+const double paramtol = 1e-10;
+}
+
+static double cross(const Coordinate &u, const Coordinate &v)
+{
+    return u.x * v.y - u.y * v.x;
+}
+
+static bool lessThan(const Coordinate &p, const Coordinate &q)
+{
+    return p.x < q.x || (p.x == q.x && p.y < q.y);
+}
+
+static void collectSides(const std::vector<Coordinate> &points, std::vector<Side> &sides)
+{
+    const unsigned int n = points.size();
+    for (unsigned int i = 0; i < n; ++i) {
+        Side s;
+        s.a = points[i];
+        s.b = points[(i + 1) % n];
+        if (s.a == s.b)
+            continue;
+        s.xmin = std::min(s.a.x, s.b.x);
+        s.xmax = std::max(s.a.x, s.b.x);
+        s.ymin = std::min(s.a.y, s.b.y);
+        s.ymax = std::max(s.a.y, s.b.y);
+        sides.push_back(s);
+    }
+}
+
+static double paramOn(const Side &s, const Coordinate &p)
+{
+    const Coordinate d = s.b - s.a;
+    return ((p - s.a) * d) / d.squareLength();
+}
+
+static void cutInside(Side &s, const Coordinate &p)
+{
+    const double t = paramOn(s, p);
+    if (t > paramtol && t < 1 - paramtol)
+        s.cuts.push_back(std::make_pair(t, p));
+}
+
+static void intersectSides(Side &s, Side &r, double disttol)
+{
+    if (s.ymax < r.ymin || r.ymax < s.ymin)
+        return;
+
+    const Coordinate ds = s.b - s.a;
+    const Coordinate dr = r.b - r.a;
+    const double ls = ds.length();
+    const double lr = dr.length();
+    const double den = cross(ds, dr);
+
+    if (std::fabs(den) <= 1e-12 * ls * lr) {
+        // parallel sides: they only matter if they overlap, in which
+        // case both get split at the endpoints of the other one.
+        if (std::fabs(cross(ds, r.a - s.a)) > disttol * ls)
+            return;
+        cutInside(s, r.a);
+        cutInside(s, r.b);
+        cutInside(r, s.a);
+        cutInside(r, s.b);
+        return;
+    }
+
+    const double t = cross(r.a - s.a, dr) / den;
+    const double u = cross(r.a - s.a, ds) / den;
+    if (t < -paramtol || t > 1 + paramtol || u < -paramtol || u > 1 + paramtol)
+        return;
+
+    // intersections very close to an endpoint are snapped to it, we
+    // don't want tiny pieces with almost coinciding vertices.
+    const bool sendpoint = t <= paramtol || t >= 1 - paramtol;
+    const bool rendpoint = u <= paramtol || u >= 1 - paramtol;
+    if (sendpoint && rendpoint)
+        return;
+    if (sendpoint) {
+        cutInside(r, t <= paramtol ? s.a : s.b);
+    } else if (rendpoint) {
+        cutInside(s, u <= paramtol ? r.a : r.b);
+    } else {
+        const Coordinate p = s.a + t * ds;
+        s.cuts.push_back(std::make_pair(t, p));
+        r.cuts.push_back(std::make_pair(u, p));
+    }
+}
+
+static bool isInResult(bool ina, bool inb, PolygonClipping::Operation op)
+{
+    switch (op) {
+    case PolygonClipping::Intersection:
+        return ina && inb;
+    case PolygonClipping::Union:
+        return ina || inb;
+    case PolygonClipping::Difference:
+        return ina && !inb;
+    }
+    return false;
+}
+
+static Coordinate transposed(const Coordinate &c)
+{
+    return Coordinate(c.y, c.x);
+}
+
+static std::vector<Coordinate> transposed(const std::vector<Coordinate> &points)
+{
+    std::vector<Coordinate> ret;
+    ret.reserve(points.size());
+    for (const Coordinate &c : points)
+        ret.push_back(transposed(c));
+    return ret;
+}
+
+namespace
+{
+/**
+ * The edge indexes of both polygons, once as they are and once with
+ * x and y swapped.  We look along a horizontal ray from steep pieces,
+ * and along a vertical one from flat pieces, so that the piece is
+ * never nearly parallel to the ray.
+ */
+class PolygonIndexes
+{
+    PolygonEdgeIndex ma;
+    PolygonEdgeIndex mb;
+    PolygonEdgeIndex mta;
+    PolygonEdgeIndex mtb;
+
+    static void sides(const PolygonEdgeIndex &index, const Coordinate &mid, double tol, bool &inminus, bool &inplus)
+    {
+        int right;
+        int through;
+        index.countCrossings(mid, tol, right, through);
+        inplus = right % 2 == 1;
+        inminus = (right + through) % 2 == 1;
+    }
+
+public:
+    PolygonIndexes(const std::vector<Coordinate> &a, const std::vector<Coordinate> &b)
+        : ma(a)
+        , mb(b)
+        , mta(transposed(a))
+        , mtb(transposed(b))
+    {
+    }
+
+    void classify(const Piece &p, double tol, PolygonClipping::Operation op, bool &inleft, bool &inright) const
+    {
+        const Coordinate d = p.b - p.a;
+        const bool steep = std::fabs(d.y) >= std::fabs(d.x);
+        // transposing mirrors the plane, which swaps left and right
+        const Coordinate mid = steep ? (p.a + p.b) / 2 : transposed((p.a + p.b) / 2);
+        const double dy = steep ? d.y : d.x;
+        bool aminus, aplus, bminus, bplus;
+        sides(steep ? ma : mta, mid, tol, aminus, aplus);
+        sides(steep ? mb : mtb, mid, tol, bminus, bplus);
+        const bool inminus = isInResult(aminus, bminus, op);
+        const bool inplus = isInResult(aplus, bplus, op);
+        // a piece going up has the ray origin side on its left
+        const bool minusisleft = (dy > 0) == steep;
+        inleft = minusisleft ? inminus : inplus;
+        inright = minusisleft ? inplus : inminus;
+    }
+};
+}
+
+static void simplifyRing(std::vector<Coordinate> &ring)
+{
+    // drop the vertices we introduced by splitting sides where
+    // the result goes straight on.
+    bool changed = true;
+    while (changed && ring.size() >= 3) {
+        changed = false;
+        for (unsigned int i = 0; i < ring.size() && ring.size() >= 3; ++i) {
+            const Coordinate &prev = ring[(i + ring.size() - 1) % ring.size()];
+            const Coordinate &next = ring[(i + 1) % ring.size()];
+            const Coordinate din = ring[i] - prev;
+            const Coordinate dout = next - ring[i];
+            if (std::fabs(cross(din, dout)) <= 1e-12 * din.length() * dout.length() && din * dout > 0) {
+                ring.erase(ring.begin() + i);
+                changed = true;
+            }
+        }
+    }
+}
+
+std::vector<std::vector<Coordinate>> PolygonClipping::compute(const std::vector<Coordinate> &a, const std::vector<Coordinate> &b, Operation op)
+{
+    std::vector<std::vector<Coordinate>> ret;
+    if (a.size() < 3 || b.size() < 3)
+        return ret;
+
+    std::vector<Side> sides;
+    collectSides(a, sides);
+    collectSides(b, sides);
+    if (sides.empty())
+        return ret;
+
+    double xmin = sides[0].xmin, xmax = sides[0].xmax, ymin = sides[0].ymin, ymax = sides[0].ymax;
+    for (const Side &s : sides) {
+        xmin = std::min(xmin, s.xmin);
+        xmax = std::max(xmax, s.xmax);
+        ymin = std::min(ymin, s.ymin);
+        ymax = std::max(ymax, s.ymax);
+    }
+    const double scale = std::hypot(xmax - xmin, ymax - ymin);
+    if (!(scale > 0.) || !std::isfinite(scale))
+        return ret;
+    const double disttol = 1e-10 * scale;
+
+    // find all intersections between the sides.  A uniform grid
+    // over the bounding box is used as the broad phase: every side is
+    // registered in the cells it passes through, and only sides
+    // sharing a cell are tested against each other.  This also finds
+    // the self-intersections of twisted polygons, which we need so
+    // that the classification below is constant along every piece.
+    const unsigned int gridsize = std::max(1u, std::min(1024u, static_cast<unsigned int>(std::sqrt(static_cast<double>(sides.size())))));
+    const double cellwidth = std::max(xmax - xmin, disttol) / gridsize;
+    const double cellheight = std::max(ymax - ymin, disttol) / gridsize;
+    auto cellIndex = [gridsize](double v, double origin, double size) {
+        const double r = std::floor((v - origin) / size);
+        if (!(r > 0.))
+            return 0u;
+        if (r >= gridsize - 1)
+            return gridsize - 1;
+        return static_cast<unsigned int>(r);
+    };
+    std::vector<std::vector<unsigned int>> grid(gridsize * gridsize);
+    std::vector<std::vector<unsigned int>> sidecells(sides.size());
+    for (unsigned int i = 0; i < sides.size(); ++i) {
+        const Side &s = sides[i];
+        const unsigned int firstcol = cellIndex(s.xmin - disttol, xmin, cellwidth);
+        const unsigned int lastcol = cellIndex(s.xmax + disttol, xmin, cellwidth);
+        for (unsigned int col = firstcol; col <= lastcol; ++col) {
+            // the part of the side within this column of cells
+            double ylo = s.ymin;
+            double yhi = s.ymax;
+            if (s.a.x != s.b.x) {
+                const double x0 = std::max(s.xmin, xmin + col * cellwidth);
+                const double x1 = std::min(s.xmax, xmin + (col + 1) * cellwidth);
+                const double slope = (s.b.y - s.a.y) / (s.b.x - s.a.x);
+                const double y0 = s.a.y + (x0 - s.a.x) * slope;
+                const double y1 = s.a.y + (x1 - s.a.x) * slope;
+                ylo = std::max(s.ymin, std::min(y0, y1));
+                yhi = std::min(s.ymax, std::max(y0, y1));
+            }
+            const unsigned int firstrow = cellIndex(ylo - disttol, ymin, cellheight);
+            const unsigned int lastrow = cellIndex(yhi + disttol, ymin, cellheight);
+            for (unsigned int row = firstrow; row <= lastrow; ++row) {
+                grid[row * gridsize + col].push_back(i);
+                sidecells[i].push_back(row * gridsize + col);
+            }
+        }
+    }
+    std::vector<unsigned int> lasttested(sides.size(), static_cast<unsigned int>(-1));
+    for (unsigned int i = 0; i < sides.size(); ++i) {
+        for (unsigned int cell : sidecells[i]) {
+            for (unsigned int j : grid[cell]) {
+                if (j >= i || lasttested[j] == i)
+                    continue;
+                lasttested[j] = i;
+                if (sides[j].xmax < sides[i].xmin - disttol || sides[i].xmax < sides[j].xmin - disttol)
+                    continue;
+                intersectSides(sides[j], sides[i], disttol);
+            }
+        }
+    }
+
+    // split the sides into pieces.  Where the boundaries overlap, the
+    // same piece comes from a side of each polygon, we keep only one
+    // copy of it, since the classification below looks at both
+    // polygons anyway.
+    std::vector<Piece> pieces;
+    for (Side &s : sides) {
+        s.cuts.push_back(std::make_pair(0., s.a));
+        s.cuts.push_back(std::make_pair(1., s.b));
+        std::sort(s.cuts.begin(), s.cuts.end(), [](const std::pair<double, Coordinate> &x, const std::pair<double, Coordinate> &y) {
+            return x.first < y.first;
+        });
+        for (unsigned int j = 1; j < s.cuts.size(); ++j) {
+            Piece p;
+            p.a = s.cuts[j - 1].second;
+            p.b = s.cuts[j].second;
+            if (p.a == p.b)
+                continue;
+            if (lessThan(p.b, p.a))
+                std::swap(p.a, p.b);
+            pieces.push_back(p);
+        }
+    }
+    std::sort(pieces.begin(), pieces.end(), [](const Piece &x, const Piece &y) {
+        return lessThan(x.a, y.a) || (x.a == y.a && lessThan(x.b, y.b));
+    });
+    pieces.erase(std::unique(pieces.begin(),
+                             pieces.end(),
+                             [](const Piece &x, const Piece &y) {
+                                 return x.a == y.a && x.b == y.b;
+                             }),
+                 pieces.end());
+
+    // a piece is part of the boundary of the result if the result
+    // is on one side of it, and not on the other.  We orient it so
+    // that the result is on its left.
+    const PolygonIndexes indexes(a, b);
+    std::vector<Piece> boundary;
+    for (const Piece &p : pieces) {
+        bool inleft;
+        bool inright;
+        indexes.classify(p, disttol, op, inleft, inright);
+        if (inleft == inright)
+            continue;
+        Piece d = p;
+        if (inright)
+            std::swap(d.a, d.b);
+        boundary.push_back(d);
+    }
+
+    // chain the boundary pieces into rings.  Where more than one
+    // piece leaves a vertex, we take the leftmost one, which splits
+    // components touching in a single vertex into separate rings.
+    std::map<std::pair<double, double>, std::vector<unsigned int>> outgoing;
+    for (unsigned int i = 0; i < boundary.size(); ++i)
+        outgoing[std::make_pair(boundary[i].a.x, boundary[i].a.y)].push_back(i);
+    std::vector<bool> used(boundary.size(), false);
+    for (unsigned int first = 0; first < boundary.size(); ++first) {
+        if (used[first])
+            continue;
+        std::vector<Coordinate> ring;
+        unsigned int cur = first;
+        bool closed = false;
+        for (;;) {
+            used[cur] = true;
+            ring.push_back(boundary[cur].a);
+            const Coordinate &end = boundary[cur].b;
+            if (end == boundary[first].a) {
+                closed = true;
+                break;
+            }
+            const std::vector<unsigned int> &candidates = outgoing[std::make_pair(end.x, end.y)];
+            const Coordinate din = boundary[cur].b - boundary[cur].a;
+            int best = -1;
+            double bestangle = 0.;
+            for (unsigned int c : candidates) {
+                if (used[c])
+                    continue;
+                const Coordinate dout = boundary[c].b - boundary[c].a;
+                const double angle = std::atan2(cross(din, dout), din * dout);
+                if (best < 0 || angle > bestangle) {
+                    best = c;
+                    bestangle = angle;
+                }
+            }
+            if (best < 0)
+                break;
+            cur = best;
+        }
+        if (!closed)
+            continue;
+        simplifyRing(ring);
+        if (ring.size() >= 3)
+            ret.push_back(ring);
+    }
+    return ret;
+}
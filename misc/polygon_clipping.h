@@ -0,0 +1,39 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "coordinate.h"
+
+#include <vector>
+
+/**
+ * Boolean operations on polygons.
+ *
+ * The polygons are interpreted with the even-odd rule, just like
+ * AbstractPolygonImp::isInPolygon does, so twisted (self-intersecting)
+ * polygons are handled as well.  All sides of both polygons are split
+ * at their mutual intersections, which are found with a uniform grid
+ * over the bounding box as the broad phase: only sides passing through
+ * the same cell are tested against each other.  Every resulting piece
+ * is then classified by looking at both of its sides with a
+ * PolygonEdgeIndex for each of the polygons, and the pieces separating
+ * the inside of the result from the outside are chained into closed
+ * rings.
+ */
+namespace PolygonClipping
+{
+enum Operation { Intersection, Union, Difference };
+
+/**
+ * Compute a op b.  The result is a list of closed rings, with the
+ * inside of the result on the left of every side: outer boundaries
+ * are counterclockwise, holes are clockwise.  An empty result means
+ * that the result is empty.
+ */
+std::vector<std::vector<Coordinate>> compute(const std::vector<Coordinate> &a, const std::vector<Coordinate> &b, Operation op);
+}
@@ -0,0 +1,152 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "polygon_edge_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+PolygonEdgeIndex::PolygonEdgeIndex(const std::vector<Coordinate> &points)
+    : mpoints(points)
+    , mymin(0.)
+    , mymax(0.)
+    , mbucketheight(1.)
+{
+    const unsigned int n = mpoints.size();
+    if (n == 0)
+        return;
+
+    mymin = mymax = mpoints[0].y;
+    for (unsigned int i = 1; i < n; ++i) {
+        mymin = std::min(mymin, mpoints[i].y);
+        mymax = std::max(mymax, mpoints[i].y);
+    }
+
+    // about two sides per bucket for reasonably shaped polygons, but
+    // we don't want long sides to be copied into too many buckets, so
+    // we reduce the number of buckets until the total number of
+    // entries is at most a small multiple of the number of sides.
+    unsigned int nbuckets = std::max(1u, std::min(n / 2, 4096u));
+    for (;;) {
+        mbucketheight = (mymax - mymin) / nbuckets;
+        if (!(mbucketheight > 0.)) {
+            nbuckets = 1;
+            mbucketheight = 1.;
+            break;
+        }
+        mbuckets.assign(nbuckets, std::vector<unsigned int>());
+        unsigned long entries = 0;
+        for (unsigned int i = 0; i < n; ++i) {
+            const Coordinate &a = mpoints[i];
+            const Coordinate &b = mpoints[(i + 1) % n];
+            entries += bucketFor(std::max(a.y, b.y)) - bucketFor(std::min(a.y, b.y)) + 1;
+        }
+        if (nbuckets == 1 || entries <= 8ul * n)
+            break;
+        nbuckets /= 2;
+    }
+
+    mbuckets.assign(nbuckets, std::vector<unsigned int>());
+    for (unsigned int i = 0; i < n; ++i) {
+        const Coordinate &a = mpoints[i];
+        const Coordinate &b = mpoints[(i + 1) % n];
+        const unsigned int last = bucketFor(std::max(a.y, b.y));
+        for (unsigned int j = bucketFor(std::min(a.y, b.y)); j <= last; ++j)
+            mbuckets[j].push_back(i);
+    }
+}
+
+PolygonEdgeIndex::~PolygonEdgeIndex()
+{
+}
+
+unsigned int PolygonEdgeIndex::bucketFor(double y) const
+{
+    // this needs to be monotonous in y, so that a side is always
+    // found in the bucket of any y value in its extent.
+    double r = std::floor((y - mymin) / mbucketheight);
+    if (!(r > 0.))
+        return 0;
+    const unsigned int last = mbuckets.size() - 1;
+    if (r >= last)
+        return last;
+    return static_cast<unsigned int>(r);
+}
+
+const std::vector<Coordinate> &PolygonEdgeIndex::points() const
+{
+    return mpoints;
+}
+
+bool PolygonEdgeIndex::contains(const Coordinate &p) const
+{
+    // the same crossing test as in AbstractPolygonImp::isInPolygon,
+    // restricted to the sides which can possibly cross the horizontal
+    // ray from p to the right.
+    if (mpoints.empty() || p.y < mymin || p.y > mymax)
+        return false;
+
+    const double cx = p.x;
+    const double cy = p.y;
+    const unsigned int n = mpoints.size();
+    const std::vector<unsigned int> &sides = mbuckets[bucketFor(cy)];
+    bool inside_flag = false;
+    for (unsigned int i : sides) {
+        const Coordinate &prevpoint = mpoints[i];
+        const Coordinate &point = mpoints[(i + 1) % n];
+        if ((prevpoint.y >= cy) == (point.y >= cy))
+            continue;
+        if ((point.x - cx) * (prevpoint.x - cx) > 0) {
+            if (point.x >= cx)
+                inside_flag = !inside_flag;
+        } else {
+            double num = (point.y - cy) * (prevpoint.x - point.x);
+            double den = prevpoint.y - point.y;
+            if (num == den * (point.x - cx))
+                return false;
+            if (num / den <= point.x - cx)
+                inside_flag = !inside_flag;
+        }
+    }
+    return inside_flag;
+}
+
+void PolygonEdgeIndex::countCrossings(const Coordinate &p, double tol, int &right, int &through) const
+{
+    right = 0;
+    through = 0;
+    if (mpoints.empty() || p.y < mymin || p.y > mymax)
+        return;
+
+    const unsigned int n = mpoints.size();
+    for (unsigned int i : mbuckets[bucketFor(p.y)]) {
+        const Coordinate &prevpoint = mpoints[i];
+        const Coordinate &point = mpoints[(i + 1) % n];
+        if ((prevpoint.y >= p.y) == (point.y >= p.y))
+            continue;
+        const double x = point.x + (p.y - point.y) * (prevpoint.x - point.x) / (prevpoint.y - point.y);
+        if (x > p.x + tol)
+            ++right;
+        else if (x >= p.x - tol)
+            ++through;
+    }
+}
+
+void PolygonEdgeIndex::sidesInYRange(double ymin, double ymax, std::vector<unsigned int> &ret) const
+{
+    ret.clear();
+    if (mpoints.empty() || ymax < mymin || ymin > mymax)
+        return;
+
+    const unsigned int last = bucketFor(ymax);
+    for (unsigned int j = bucketFor(ymin); j <= last; ++j)
+        ret.insert(ret.end(), mbuckets[j].begin(), mbuckets[j].end());
+    if (last > bucketFor(ymin)) {
+        std::sort(ret.begin(), ret.end());
+        ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+    }
+}
@@ -0,0 +1,68 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "coordinate.h"
+
+#include <vector>
+
+/**
+ * A spatial index over the sides of a closed polygon.  The y range
+ * of the polygon is cut into horizontal buckets, and every side is
+ * registered in all buckets its y extent overlaps.  A horizontal ray
+ * can then only cross the sides registered in the bucket of its
+ * origin, so point in polygon queries cost roughly
+ * O( sqrt( n ) ) instead of O( n ).
+ *
+ * Side i goes from vertex i to vertex i + 1 (and the last side back
+ * to vertex 0).  The index keeps its own copy of the vertices, so it
+ * stays valid independently of where they came from.
+ */
+class PolygonEdgeIndex
+{
+    std::vector<Coordinate> mpoints;
+    double mymin;
+    double mymax;
+    double mbucketheight;
+    std::vector<std::vector<unsigned int>> mbuckets;
+
+    unsigned int bucketFor(double y) const;
+
+public:
+    explicit PolygonEdgeIndex(const std::vector<Coordinate> &points);
+    ~PolygonEdgeIndex();
+
+    /**
+     * The vertices this index was built from.
+     */
+    const std::vector<Coordinate> &points() const;
+
+    /**
+     * Even-odd point in polygon test.  This gives exactly the same
+     * answers as AbstractPolygonImp::isInPolygon, including returning
+     * false for points on the boundary.
+     */
+    bool contains(const Coordinate &p) const;
+
+    /**
+     * Count the sides crossing the horizontal ray from p to the right.
+     * Sides crossing it within a distance tol of p are counted in
+     * through instead of in right.  This allows to know on which side
+     * of a side through p the polygon is: points just to the right of
+     * p are inside iff right is odd, points just to the left of it
+     * iff right + through is odd.
+     */
+    void countCrossings(const Coordinate &p, double tol, int &right, int &through) const;
+
+    /**
+     * Set ret to the sides whose y extent may overlap the interval
+     * [ ymin, ymax ].  Every side overlapping it is reported exactly
+     * once, but some sides outside of it may be reported as well.
+     */
+    void sidesInYRange(double ymin, double ymax, std::vector<unsigned int> &ret) const;
+};
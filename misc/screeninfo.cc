@@ -4,6 +4,8 @@
 
 #include "screeninfo.h"
 
+#include "coordinate_buffer.h"
+
 #include <cmath>
 
 ScreenInfo::ScreenInfo(const Rect &docRect, const QRect &viewRect)
@@ -35,6 +37,30 @@ QPoint ScreenInfo::toScreen(const Coordinate &p) const
     return QPoint((int)t.x, mqrect.height() - (int)t.y);
 }
 
+void ScreenInfo::toScreen(const CoordinateBuffer &pts, QPolygon &ret) const
+{
+    // the same arithmetic as above, on the arrays of the buffer.
+    const std::size_t n = pts.size();
+    ret.resize(n);
+    const double left = mkrect.left();
+    const double bottom = mkrect.bottom();
+    const double qwidth = mqrect.width();
+    const double kwidth = mkrect.width();
+    const int qheight = mqrect.height();
+    const double *xs = pts.xData();
+    const double *ys = pts.yData();
+    QPoint *out = ret.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        double tx = xs[i] - left;
+        double ty = ys[i] - bottom;
+        tx *= qwidth;
+        ty *= qwidth;
+        tx /= kwidth;
+        ty /= kwidth;
+        out[i] = QPoint((int)tx, qheight - (int)ty);
+    }
+}
+
 QRect ScreenInfo::toScreen(const Rect &r) const
 {
     return QRect(toScreen(r.bottomLeft()), toScreen(r.topRight())).normalized();
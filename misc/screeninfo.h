@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include <QPolygon>
 #include <QRect>
 
 #include "rect.h"
 
+class CoordinateBuffer;
+
 /**
  * ScreenInfo is a simple utility class that maps a region of the
  * document onto a region of the screen.  It is used by both
@@ -29,6 +32,11 @@ public:
     QRect toScreen(const Rect &r) const;
     QPointF toScreenF(const Coordinate &p) const;
     QRectF toScreenF(const Rect &r) const;
+    /**
+     * Convert all of the points in \p pts at once, this gives the same
+     * result as calling toScreen on every one of them.
+     */
+    void toScreen(const CoordinateBuffer &pts, QPolygon &ret) const;
 
     double pixelWidth() const;
 
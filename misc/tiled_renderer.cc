@@ -0,0 +1,138 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "tiled_renderer.h"
+
+#include "../objects/object_holder.h"
+#include "../objects/object_imp.h"
+#include "../objects/text_imp.h"
+#include "kigpainter.h"
+#include "rect.h"
+#include "screeninfo.h"
+
+#include <QImage>
+#include <QPainter>
+#include <QSemaphore>
+#include <QThreadPool>
+
+// the size of the tiles, in pixels
+static const int tileSize = 256;
+// below this, we draw in one go: starting the threads and compositing
+// the tiles would cost more than it saves
+static const int minTiledPixels = 2 * tileSize * tileSize;
+// objects that are just outside of a tile can still reach into it with
+// their line width, point size etc.
+static const int tileMargin = 20;
+
+namespace
+{
+struct TiledObject {
+    const ObjectHolder *object;
+    bool selected;
+    Rect rect;
+};
+}
+
+bool tiledDrawingPays(const QSize &size)
+{
+    return size.width() * size.height() >= minTiledPixels && QThreadPool::globalInstance()->maxThreadCount() > 1;
+}
+
+/**
+ * the part of the document that the pixels of \p r, in the view \p si,
+ * show.  We don't use ScreenInfo::fromScreen( QRect ), since the tiles
+ * need to fit together exactly.
+ */
+static Rect tileShownRect(const ScreenInfo &si, const QRect &r)
+{
+    const Rect &shown = si.shownRect();
+    const double pw = shown.width() / si.viewRect().width();
+    const double left = shown.left() + r.left() * pw;
+    const double bottom = shown.bottom() + (si.viewRect().height() - r.top() - r.height()) * pw;
+    return Rect(Coordinate(left, bottom), r.width() * pw, r.height() * pw);
+}
+
+static void drawTile(QImage &tile, const ScreenInfo &tsi, const KigDocument &doc, const std::vector<TiledObject> &os, double simplifytolerance)
+{
+    tile.fill(Qt::transparent);
+    const double margin = tileMargin * tsi.pixelWidth();
+    Rect near = tsi.shownRect();
+    near.setLeft(near.left() - margin);
+    near.setBottom(near.bottom() - margin);
+    near.setRight(near.right() + margin);
+    near.setTop(near.top() + margin);
+
+    KigPainter p(tsi, &tile, doc, false);
+    p.setSimplifyTolerance(simplifytolerance);
+    for (std::vector<TiledObject>::const_iterator i = os.begin(); i != os.end(); ++i)
+        // an invalid rect means the object doesn't know where it is..
+        if (!i->rect.valid() || i->rect.intersects(near))
+            p.drawObject(i->object, i->selected);
+}
+
+void drawObjectsTiled(QImage &img,
+                      const ScreenInfo &si,
+                      const KigDocument &doc,
+                      const std::vector<ObjectHolder *> &selection,
+                      const std::vector<ObjectHolder *> &nonselection,
+                      double simplifytolerance)
+{
+    std::vector<TiledObject> os;
+    std::vector<TiledObject> texts;
+    os.reserve(selection.size() + nonselection.size());
+    for (int s = 0; s < 2; ++s) {
+        const std::vector<ObjectHolder *> &v = s == 0 ? selection : nonselection;
+        for (std::vector<ObjectHolder *>::const_iterator i = v.begin(); i != v.end(); ++i) {
+            TiledObject o = {*i, s == 0, Rect::invalidRect()};
+            if ((*i)->imp()->inherits(TextImp::stype()))
+                texts.push_back(o);
+            else {
+                o.rect = (*i)->surroundingRect();
+                os.push_back(o);
+            }
+        }
+    }
+
+    if (!tiledDrawingPays(img.size())) {
+        KigPainter p(si, &img, doc, false);
+        p.setSimplifyTolerance(simplifytolerance);
+        for (std::vector<TiledObject>::const_iterator i = os.begin(); i != os.end(); ++i)
+            p.drawObject(i->object, i->selected);
+        for (std::vector<TiledObject>::const_iterator i = texts.begin(); i != texts.end(); ++i)
+            p.drawObject(i->object, i->selected);
+        return;
+    }
+
+    std::vector<QRect> rects;
+    for (int y = 0; y < img.height(); y += tileSize)
+        for (int x = 0; x < img.width(); x += tileSize)
+            rects.push_back(QRect(x, y, qMin(tileSize, img.width() - x), qMin(tileSize, img.height() - y)));
+    std::vector<QImage> tiles(rects.size());
+
+    QSemaphore done;
+    QThreadPool *pool = QThreadPool::globalInstance();
+    for (uint i = 0; i < rects.size(); ++i) {
+        tiles[i] = QImage(rects[i].size(), QImage::Format_ARGB32_Premultiplied);
+        const ScreenInfo tsi(tileShownRect(si, rects[i]), QRect(QPoint(0, 0), rects[i].size()));
+        QImage *tile = &tiles[i];
+        pool->start([tile, tsi, &doc, &os, &done, simplifytolerance]() {
+            drawTile(*tile, tsi, doc, os, simplifytolerance);
+            done.release();
+        });
+    }
+    done.acquire(rects.size());
+
+    {
+        QPainter p(&img);
+        for (uint i = 0; i < rects.size(); ++i)
+            p.drawImage(rects[i].topLeft(), tiles[i]);
+    }
+
+    KigPainter p(si, &img, doc, false);
+    for (std::vector<TiledObject>::const_iterator i = texts.begin(); i != texts.end(); ++i)
+        p.drawObject(i->object, i->selected);
+}
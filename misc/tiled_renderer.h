@@ -0,0 +1,57 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <vector>
+
+class KigDocument;
+class ObjectHolder;
+class QImage;
+class QSize;
+class ScreenInfo;
+
+/**
+ * whether drawing an image of size \p size with drawObjectsTiled() is
+ * worth the trouble, i.e. whether it is big enough and we have more
+ * than one thread to draw it with.
+ */
+bool tiledDrawingPays(const QSize &size);
+
+/**
+ * draw \p selection ( selected ) and \p nonselection on top of \p img,
+ * which is shown as \p si.
+ *
+ * The image is cut in tiles, and the tiles are drawn in parallel by
+ * the threads of the global QThreadPool, each with its own KigPainter
+ * on its own QImage, and then put on \p img in this thread.  Every
+ * tile only draws the objects whose surroundingRect() is near it.
+ *
+ * The text labels are drawn afterwards, in this thread: they remember
+ * their layout and their bounding rect when they are drawn, and the
+ * latter is used for hit testing in the entire view.  For the same
+ * reason, the surrounding rects of the objects, which ObjectHolder
+ * caches, are looked up here and not in the tiles.
+ *
+ * The tiles share the imps, and calc'ing a locus in a tile can ask
+ * the imps of its parents for their properties and parameters, so the
+ * caches that imps fill on demand must be thread safe: the generic
+ * getParam() samples of CurveImp, the edge index and winding number
+ * of polygons, the property ids of FetchPropertyNode and the registry
+ * of ObjectImpType's all are.  Don't add one that isn't.
+ *
+ * The grid is not drawn here, since it depends on the size of the
+ * window it is drawn in: draw it on \p img first.
+ *
+ * \p simplifytolerance is passed on to KigPainter::setSimplifyTolerance.
+ */
+void drawObjectsTiled(QImage &img,
+                      const ScreenInfo &si,
+                      const KigDocument &doc,
+                      const std::vector<ObjectHolder *> &selection,
+                      const std::vector<ObjectHolder *> &nonselection,
+                      double simplifytolerance = 0.);
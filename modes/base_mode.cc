@@ -33,7 +33,7 @@ void BaseMode::leftClicked(QMouseEvent *e, KigWidget *v)
     v->updateWidget();
 
     mplc = e->pos();
-    moco = mdoc.document().whatAmIOn(v->fromScreen(mplc), *v);
+    moco = mdoc.document().whatAmIOn(v->fromScreen(mplc), v->screenInfo());
 
     if (moco.empty()) {
         // clicked on an empty spot --> we show the rectangle for
@@ -80,7 +80,7 @@ void BaseMode::midClicked(QMouseEvent *e, KigWidget *v)
     v->updateWidget();
 
     mplc = e->pos();
-    moco = mdoc.document().whatAmIOn(v->fromScreen(e->pos()), *v);
+    moco = mdoc.document().whatAmIOn(v->fromScreen(e->pos()), v->screenInfo());
 }
 
 void BaseMode::midReleased(QMouseEvent *e, KigWidget *v)
@@ -100,14 +100,14 @@ void BaseMode::rightClicked(QMouseEvent *e, KigWidget *w)
     w->setCursor(Qt::ArrowCursor);
 
     mplc = e->pos();
-    moco = mdoc.document().whatAmIOn(w->fromScreen(mplc), *w);
+    moco = mdoc.document().whatAmIOn(w->fromScreen(mplc), w->screenInfo());
 
     rightClicked(moco, mplc, *w);
 }
 
 void BaseMode::mouseMoved(QMouseEvent *e, KigWidget *w)
 {
-    std::vector<ObjectHolder *> os = mdoc.document().whatAmIOn(w->fromScreen(e->pos()), *w);
+    std::vector<ObjectHolder *> os = mdoc.document().whatAmIOn(w->fromScreen(e->pos()), w->screenInfo());
     mouseMoved(os, e->pos(), *w, e->modifiers() & Qt::ShiftModifier);
 }
 
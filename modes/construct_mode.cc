@@ -32,7 +32,15 @@
 
 static void redefinePoint(ObjectTypeCalcer *mpt, const Coordinate &c, KigDocument &doc, const KigWidget &w)
 {
-    ObjectFactory::instance()->redefinePoint(mpt, c, doc, w);
+    ObjectFactory::instance()->redefinePoint(mpt, c, doc, w.screenInfo());
+    mpt->calc(doc);
+}
+
+// the same, when the mouse is at c, and os is what is under it: no need
+// to look for that again
+static void redefinePoint(ObjectTypeCalcer *mpt, const Coordinate &c, KigDocument &doc, const KigWidget &w, const std::vector<ObjectHolder *> &os)
+{
+    ObjectFactory::instance()->redefinePoint(mpt, c, doc, w.screenInfo(), os);
     mpt->calc(doc);
 }
 
@@ -111,7 +119,7 @@ void BaseConstructMode::leftClickedObject(ObjectHolder *o, const QPoint &p, KigW
         mdoc.addObject(n);
         selectObject(n, w);
         // get a new mpt for our further use..
-        mpt = ObjectFactory::instance()->sensiblePointCalcer(w.fromScreen(p), mdoc.document(), w);
+        mpt = ObjectFactory::instance()->sensiblePointCalcer(w.fromScreen(p), mdoc.document(), w.screenInfo());
         mpt->calc(mdoc.document());
         return;
     }
@@ -127,7 +135,7 @@ void BaseConstructMode::leftClickedObject(ObjectHolder *o, const QPoint &p, KigW
         ObjectHolder *n = new ObjectHolder(mcursor);
         selectObject(n, w);
         mcursor = ObjectFactory::instance()->cursorPointCalcer(w.fromScreen(p));
-        //    mcursor = ObjectFactory::instance()->sensiblePointCalcer( w.fromScreen( p ), mdoc.document(), w );
+        //    mcursor = ObjectFactory::instance()->sensiblePointCalcer( w.fromScreen( p ), mdoc.document(), w.screenInfo() );
         mcursor->calc(mdoc.document());
         delete n;
     }
@@ -143,7 +151,7 @@ void BaseConstructMode::midClicked(const QPoint &p, KigWidget &w)
 
         selectObject(n, w);
 
-        mpt = ObjectFactory::instance()->sensiblePointCalcer(w.fromScreen(p), mdoc.document(), w);
+        mpt = ObjectFactory::instance()->sensiblePointCalcer(w.fromScreen(p), mdoc.document(), w.screenInfo());
         mpt->calc(mdoc.document());
     }
 }
@@ -161,10 +169,11 @@ void BaseConstructMode::mouseMoved(const std::vector<ObjectHolder *> &os, const
     KigPainter pter(w.screenInfo(), &w.curPix, mdoc.document());
 
     Coordinate ncoord = w.fromScreen(p);
-    if (shiftpressed)
-        ncoord = mdoc.document().coordinateSystem().snapToGrid(ncoord, w);
-
-    redefinePoint(mpt.get(), ncoord, mdoc.document(), w);
+    if (shiftpressed) {
+        ncoord = mdoc.document().coordinateSystem().snapToGrid(ncoord, w.screenInfo());
+        redefinePoint(mpt.get(), ncoord, mdoc.document(), w);
+    } else
+        redefinePoint(mpt.get(), ncoord, mdoc.document(), w, os);
     mcursor->move(ncoord, mdoc.document());
     mcursor->calc(mdoc.document());
 
@@ -281,16 +290,17 @@ void PointConstructMode::rightClicked(const std::vector<ObjectHolder *> &, const
     cancelConstruction();
 }
 
-void PointConstructMode::mouseMoved(const std::vector<ObjectHolder *> &, const QPoint &p, KigWidget &w, bool shiftpressed)
+void PointConstructMode::mouseMoved(const std::vector<ObjectHolder *> &os, const QPoint &p, KigWidget &w, bool shiftpressed)
 {
     w.updateCurPix();
     KigPainter pter(w.screenInfo(), &w.curPix, mdoc.document());
 
     Coordinate ncoord = w.fromScreen(p);
-    if (shiftpressed)
-        ncoord = mdoc.document().coordinateSystem().snapToGrid(ncoord, w);
-
-    redefinePoint(mpt.get(), ncoord, mdoc.document(), w);
+    if (shiftpressed) {
+        ncoord = mdoc.document().coordinateSystem().snapToGrid(ncoord, w.screenInfo());
+        redefinePoint(mpt.get(), ncoord, mdoc.document(), w);
+    } else
+        redefinePoint(mpt.get(), ncoord, mdoc.document(), w, os);
 
     ObjectDrawer d;
     d.draw(*mpt->imp(), pter, true);
@@ -49,7 +49,7 @@ void DragRectMode::released(const QPoint &p, KigWidget &w, bool nc)
 {
     if (mstartselected) {
         mrect = w.fromScreen(QRect(mstart, p));
-        mret = mdoc.document().whatIsInHere(mrect, w);
+        mret = mdoc.document().whatIsInHere(mrect, w.screenInfo());
         mnc = nc;
 
         mdoc.doneMode(this);
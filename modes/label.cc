@@ -14,6 +14,7 @@
 #include "../kig/kig_view.h"
 #include "../misc/calcpaths.h"
 #include "../misc/common.h"
+#include "../misc/kiginputdialog.h"
 #include "../misc/kigpainter.h"
 #include "../objects/bogus_imp.h"
 #include "../objects/curve_imp.h"
@@ -138,7 +139,7 @@ void TextLabelModeBase::leftReleased(QMouseEvent *e, KigWidget *v, ObjectTypeCal
     case ReallySelectingArgs: {
         if ((d->plc - e->pos()).manhattanLength() > 4)
             break;
-        std::vector<ObjectHolder *> os = mdoc.document().whatAmIOn(v->fromScreen(d->plc), *v);
+        std::vector<ObjectHolder *> os = mdoc.document().whatAmIOn(v->fromScreen(d->plc), v->screenInfo());
         if (os.empty())
             break;
         ObjectHolder *o = os[0];
@@ -217,13 +218,13 @@ void TextLabelModeBase::enableActions()
 void TextLabelModeBase::mouseMoved(QMouseEvent *e, KigWidget *w)
 {
     if (d->mwawd == ReallySelectingArgs) {
-        std::vector<ObjectHolder *> os = mdoc.document().whatAmIOn(w->fromScreen(e->pos()), *w);
+        std::vector<ObjectHolder *> os = mdoc.document().whatAmIOn(w->fromScreen(e->pos()), w->screenInfo());
         if (!os.empty())
             w->setCursor(Qt::PointingHandCursor);
         else
             w->setCursor(Qt::ArrowCursor);
     } else if (d->mwawd == SelectingLocation) {
-        std::vector<ObjectHolder *> os = mdoc.document().whatAmIOn(w->fromScreen(e->pos()), *w);
+        std::vector<ObjectHolder *> os = mdoc.document().whatAmIOn(w->fromScreen(e->pos()), w->screenInfo());
         bool attachable = false;
         d->locationparent = nullptr;
         for (std::vector<ObjectHolder *>::iterator i = os.begin(); i != os.end(); ++i) {
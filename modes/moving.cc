@@ -47,7 +47,10 @@ void MovingModeBase::initScreen(const std::vector<ObjectCalcer *> &in)
     mview.updateCurPix();
 
     KigPainter p2(mview.screenInfo(), &mview.curPix, mdoc.document());
-    p2.drawObjects(drawableset.begin(), drawableset.end(), true);
+    for (std::vector<ObjectHolder *>::const_iterator i = mdrawable.begin(); i != mdrawable.end(); ++i) {
+        p2.drawObject(*i, true);
+        mdrawnrects.push_back(p2.takeOverlay());
+    }
 }
 
 void MovingModeBase::leftReleased(QMouseEvent *, KigWidget *v)
@@ -67,19 +70,47 @@ void MovingModeBase::leftReleased(QMouseEvent *, KigWidget *v)
 
 void MovingModeBase::mouseMoved(QMouseEvent *e, KigWidget *v)
 {
-    v->updateCurPix();
     Coordinate c = v->fromScreen(e->pos());
 
+    std::vector<const ObjectImp *> oldimps;
+    oldimps.reserve(mdrawable.size());
+    for (std::vector<ObjectHolder *>::const_iterator i = mdrawable.begin(); i != mdrawable.end(); ++i)
+        oldimps.push_back((*i)->imp());
+
     bool snaptogrid = e->modifiers() & Qt::ShiftModifier;
     moveTo(c, snaptogrid);
     for (std::vector<ObjectCalcer *>::iterator i = mcalcable.begin(); i != mcalcable.end(); ++i)
         (*i)->calc(mdoc.document());
+
+    // objects that kept their imp ( e.g. labels still showing the same
+    // text, see ObjectType::canKeepImp() ) are still on curPix, and
+    // we leave them there, unless cleaning up after the other ones
+    // erases part of them..
+    std::vector<bool> changed(mdrawable.size());
+    for (uint i = 0; i < mdrawable.size(); ++i)
+        changed[i] = mdrawable[i]->imp() != oldimps[i];
+    const std::vector<bool> redraw = KigPainter::objectsToRedraw(mdrawnrects, changed);
+
+    std::vector<QRect> cleaned;
+    for (uint i = 0; i < mdrawable.size(); ++i)
+        if (redraw[i])
+            std::copy(mdrawnrects[i].begin(), mdrawnrects[i].end(), std::back_inserter(cleaned));
+    v->restoreCurPix(cleaned);
+
     KigPainter p(v->screenInfo(), &v->curPix, mdoc.document());
     // TODO: only draw the explicitly moving objects as selected, the
     // other ones as deselected. Needs some support from the
     // subclasses.
-    p.drawObjects(mdrawable, true);
-    v->updateWidget(p.overlay());
+    std::vector<QRect> overlay = cleaned;
+    for (uint i = 0; i < mdrawable.size(); ++i) {
+        if (!redraw[i])
+            continue;
+        p.drawObject(mdrawable[i], true);
+        mdrawnrects[i] = p.takeOverlay();
+        std::copy(mdrawnrects[i].begin(), mdrawnrects[i].end(), std::back_inserter(overlay));
+    }
+    KigPainter::coalesceOverlay(overlay, v->rect());
+    v->updateWidget(overlay);
     v->updateScrollBars();
 }
 
@@ -145,7 +176,7 @@ void MovingMode::moveTo(const Coordinate &o, bool snaptogrid)
         assert(d->refmap.find(*i) != d->refmap.end());
         Coordinate nc = d->refmap[*i] + (o - d->pwwsm);
         if (snaptogrid)
-            nc = mdoc.document().coordinateSystem().snapToGrid(nc, mview);
+            nc = mdoc.document().coordinateSystem().snapToGrid(nc, mview.screenInfo());
         (*i)->move(nc, mdoc.document());
     };
 }
@@ -170,8 +201,8 @@ PointRedefineMode::PointRedefineMode(ObjectHolder *p, KigPart &d, KigWidget &v)
 
 void PointRedefineMode::moveTo(const Coordinate &o, bool snaptogrid)
 {
-    Coordinate realo = snaptogrid ? mdoc.document().coordinateSystem().snapToGrid(o, mview) : o;
-    ObjectFactory::instance()->redefinePoint(static_cast<ObjectTypeCalcer *>(mp->calcer()), realo, mdoc.document(), mview);
+    Coordinate realo = snaptogrid ? mdoc.document().coordinateSystem().snapToGrid(o, mview.screenInfo()) : o;
+    ObjectFactory::instance()->redefinePoint(static_cast<ObjectTypeCalcer *>(mp->calcer()), realo, mdoc.document(), mview.screenInfo());
 }
 
 PointRedefineMode::~PointRedefineMode()
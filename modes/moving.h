@@ -9,6 +9,10 @@
 #include "../misc/coordinate.h"
 #include "../objects/object_calcer.h"
 
+#include <QRect>
+
+#include <vector>
+
 class ObjectType;
 class Coordinate;
 class NormalPoint;
@@ -33,6 +37,9 @@ private:
     // called.
     std::vector<ObjectCalcer *> mcalcable;
     std::vector<ObjectHolder *> mdrawable;
+    // the rects of curPix that each of mdrawable was drawn in the last
+    // time..
+    std::vector<std::vector<QRect>> mdrawnrects;
 
 protected:
     MovingModeBase(KigPart &doc, KigWidget &v);
@@ -186,7 +186,7 @@ void NormalMode::leftClickedObject(ObjectHolder *o, const QPoint &, KigWidget &w
 
 void NormalMode::midClicked(const QPoint &p, KigWidget &w)
 {
-    ObjectHolder *pto = ObjectFactory::instance()->sensiblePoint(w.fromScreen(p), mdoc.document(), w);
+    ObjectHolder *pto = ObjectFactory::instance()->sensiblePoint(w.fromScreen(p), mdoc.document(), w.screenInfo());
     pto->calc(mdoc.document());
     mdoc.addObject(pto);
 
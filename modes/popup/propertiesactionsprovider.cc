@@ -20,6 +20,8 @@
 
 #include <KIconEngine>
 #include <KIconLoader>
+#include <KLocalizedString>
+#include <KMessageBox>
 
 void PropertiesActionsProvider::fillUpMenu(NormalModePopupObjects &popup, int menu, int &nextfree)
 {
@@ -29,8 +31,12 @@ void PropertiesActionsProvider::fillUpMenu(NormalModePopupObjects &popup, int me
     int np = o->imp()->numberOfProperties();
     if (menu != NormalModePopupObjects::ConstructMenu && menu != NormalModePopupObjects::ShowMenu)
         return;
+    // we only look at the types of the properties here: calculating them
+    // all can take long ( equations of loci, ... ), and we only need the
+    // one the user picks, in executeAction()..
+    const QList<KLazyLocalizedString> names = o->imp()->properties();
     for (int i = 0; i < np; ++i) {
-        ObjectImp *prop = o->imp()->property(i, popup.part().document());
+        const ObjectImpType *prop = o->imp()->propertyResultType(i);
         const char *iconfile = o->imp()->iconForProperty(i);
         bool add = true;
         if (menu == NormalModePopupObjects::ConstructMenu) {
@@ -45,13 +51,12 @@ void PropertiesActionsProvider::fillUpMenu(NormalModePopupObjects &popup, int me
             add &= prop->canFillInNextEscape();
         if (add) {
             if (iconfile && *iconfile) {
-                popup.addInternalAction(menu, QIcon(new KIconEngine(iconfile, KIconLoader::global())), o->imp()->properties()[i].toString(), nextfree++);
+                popup.addInternalAction(menu, QIcon(new KIconEngine(iconfile, KIconLoader::global())), names[i].toString(), nextfree++);
             } else {
-                popup.addInternalAction(menu, o->imp()->properties()[i].toString(), nextfree++);
+                popup.addInternalAction(menu, names[i].toString(), nextfree++);
             };
             mprops[menu - 1].push_back(i);
         };
-        delete prop;
     };
 }
 
@@ -89,6 +94,16 @@ bool PropertiesActionsProvider::executeAction(int menu,
     } else {
         ObjectHolder *h = new ObjectHolder(new ObjectPropertyCalcer(parent->calcer(), propid, true));
         h->calc(doc.document());
+        // fillUpMenu() only looked at the type of the property, so it
+        // may still be undefined for this object, e.g. the center of
+        // mass of a polygon whose sides cross..
+        if (h->imp()->inherits(BogusImp::stype())) {
+            KMessageBox::error(&w,
+                               i18n("The property \"%1\" is not defined for this object, so it cannot be constructed.",
+                                    parent->imp()->properties()[propid].toString()));
+            delete h;
+            return true;
+        }
         doc.addObject(h);
     };
     return true;
@@ -7,6 +7,7 @@
 
 #include "typesdialog.h"
 
+#include "../geogebra/geogebrareader.h"
 #include "../kig/kig_document.h"
 #include "../kig/kig_part.h"
 #include "../misc/guiaction.h"
@@ -16,7 +17,9 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 
+#include <QDebug>
 #include <QDialogButtonBox>
 #include <QFileDialog>
 #include <QMenu>
@@ -27,15 +30,7 @@
 #include <KHelpClient>
 #include <KIconLoader>
 #include <KMessageBox>
-
-#ifdef WITH_GEOGEBRA
-#include "../geogebra/geogebratransformer.h"
-
-#include <QDebug>
-#include <QXmlQuery>
-
 #include <KZip>
-#endif // WITH_GEOGEBRA
 
 static QString wrapAt(const QString &str, int col = 50)
 {
@@ -473,9 +468,7 @@ void TypesDialog::importTypes()
     // TODO : Do this through MIME types
     QStringList toolFilters;
     toolFilters << i18n("Kig Types Files (*.kigt)");
-#ifdef WITH_GEOGEBRA
     toolFilters << i18n("Geogebra Tool Files (*.ggt)");
-#endif // WITH_GEOGEBRA
     toolFilters << i18n("All Files (*)");
     QStringList file_names = QFileDialog::getOpenFileNames(this,
                                                            i18n("Import Types"),
@@ -485,13 +478,11 @@ void TypesDialog::importTypes()
     std::vector<Macro *> macros;
     for (QStringList::const_iterator i = file_names.constBegin(); i != file_names.constEnd(); ++i) {
         std::vector<Macro *> nmacros;
-#ifdef WITH_GEOGEBRA
         if (i->endsWith(QLatin1String(".ggt"))) // The input file is a Geogebra Tool file..
         {
             loadGeogebraTools(*i, macros, mpart);
             continue;
         }
-#endif // WITH_GEOGEBRA
         bool ok = MacroList::instance()->load(*i, nmacros, mpart);
         if (!ok)
             continue;
@@ -564,7 +555,6 @@ void TypesDialog::typeListContextMenu(const QPoint &pos)
     popup->exec(mtypeswidget->typeList->viewport()->mapToGlobal(pos));
 }
 
-#ifdef WITH_GEOGEBRA
 bool TypesDialog::loadGeogebraTools(const QString &sFrom, std::vector<Macro *> &vec, KigPart & /*kigpart*/)
 {
     KZip geogebraFile(sFrom);
@@ -573,25 +563,18 @@ bool TypesDialog::loadGeogebraTools(const QString &sFrom, std::vector<Macro *> &
         const KZipFileEntry *geogebraXMLEntry = dynamic_cast<const KZipFileEntry *>(geogebraFile.directory()->entry(QStringLiteral("geogebra_macro.xml")));
 
         if (geogebraXMLEntry) {
-            KigDocument *document = new KigDocument();
-            QXmlNamePool np;
-            QXmlQuery geogebraXSLT(QXmlQuery::XSLT20, np);
-            const QString encodedData = QString::fromUtf8(geogebraXMLEntry->data().constData());
-            QFile queryDevice(QStringLiteral(":/kig/geogebra/geogebra.xsl"));
-            GeogebraTransformer ggttransformer(document, np);
-
-            queryDevice.open(QFile::ReadOnly);
-            geogebraXSLT.setFocus(encodedData);
-            geogebraXSLT.setQuery(&queryDevice);
-            geogebraXSLT.evaluateTo(&ggttransformer);
-            queryDevice.close();
+            // only needed to calculate the objects in
+            KigDocument document;
+            std::unique_ptr<QIODevice> xmlDevice(geogebraXMLEntry->createDevice());
+            GeogebraReader ggtreader(&document);
+            ggtreader.read(xmlDevice.get());
 
-            const size_t nmacros = ggttransformer.getNumberOfSections();
+            const size_t nmacros = ggtreader.getNumberOfSections();
 
             for (size_t i = 0; i < nmacros; i++) {
-                const GeogebraSection f = ggttransformer.getSection(i);
+                const GeogebraSection &f = ggtreader.getSection(i);
                 ObjectHierarchy hrchy(f.getInputObjects(), f.getOutputObjects());
-                MacroConstructor *ctor = new MacroConstructor(hrchy, ggttransformer.getSection(i).getName(), ggttransformer.getSection(i).getDescription());
+                MacroConstructor *ctor = new MacroConstructor(hrchy, f.getName(), f.getDescription());
                 ConstructibleAction *act = new ConstructibleAction(ctor, nullptr);
 
                 Macro *newmacro = new Macro(act, ctor);
@@ -605,6 +588,5 @@ bool TypesDialog::loadGeogebraTools(const QString &sFrom, std::vector<Macro *> &
 
     return true;
 }
-#endif // WITH_GEOEBRA
 
 #include "moc_typesdialog.cpp"
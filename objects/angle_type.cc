@@ -5,13 +5,9 @@
 
 #include "angle_type.h"
 
-#include "../kig/kig_commands.h"
-#include "../kig/kig_part.h"
-#include "../kig/kig_view.h"
 #include "../misc/calcpaths.h"
 #include "../misc/common.h"
 #include "../misc/goniometry.h"
-#include "../misc/kiginputdialog.h"
 #include "bogus_imp.h"
 #include "other_imp.h"
 #include "point_imp.h"
@@ -92,54 +88,6 @@ QStringList AngleType::specialActions() const
     return ret;
 }
 
-void AngleType::executeAction(int i, ObjectHolder &, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &) const
-{
-    if (i == 0) {
-        std::vector<ObjectCalcer *> parents = t.parents();
-
-        assert(margsparser.checkArgs(parents));
-
-        Coordinate a = static_cast<const PointImp *>(parents[0]->imp())->coordinate();
-        Coordinate b = static_cast<const PointImp *>(parents[1]->imp())->coordinate();
-        Coordinate c = static_cast<const PointImp *>(parents[2]->imp())->coordinate();
-
-        Coordinate lvect = a - b;
-        Coordinate rvect = c - b;
-
-        double startangle = atan2(lvect.y, lvect.x);
-        double endangle = atan2(rvect.y, rvect.x);
-        double anglelength = endangle - startangle;
-        if (anglelength < 0)
-            anglelength += 2 * M_PI;
-        if (startangle < 0)
-            startangle += 2 * M_PI;
-
-        Goniometry go(anglelength, Goniometry::Rad);
-        go.convertTo(Goniometry::Deg);
-
-        bool ok;
-        Goniometry newsize = KigInputDialog::getAngle(&w, &ok, go);
-        if (!ok)
-            return;
-        newsize.convertTo(Goniometry::Rad);
-
-        double newcangle = startangle + newsize.value();
-        Coordinate cdir(cos(newcangle), sin(newcangle));
-        Coordinate nc = b + cdir.normalize(rvect.length());
-
-        MonitorDataObjects mon(getAllParents(parents));
-        parents[2]->move(nc, d.document());
-        KigCommand *kc = new KigCommand(d, i18n("Resize Angle"));
-        mon.finish(kc);
-        d.history()->push(kc);
-    } else if (i == 1) {
-        AngleImp *angleImp = const_cast<AngleImp *>(dynamic_cast<const AngleImp *>(t.imp()));
-
-        angleImp->setMarkRightAngle(!angleImp->markRightAngle());
-        d.redrawScreen();
-    }
-}
-
 KIG_INSTANTIATE_OBJECT_TYPE_INSTANCE(HalfAngleType)
 
 HalfAngleType::HalfAngleType()
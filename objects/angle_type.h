@@ -18,7 +18,7 @@ public:
     const ObjectImpType *resultId() const override;
 
     QStringList specialActions() const override;
-    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const override;
+    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const;
 };
 
 class HalfAngleType : public ArgsParserObjectType
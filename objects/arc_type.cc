@@ -11,9 +11,6 @@
 #include "other_imp.h"
 #include "point_imp.h"
 
-#include "../kig/kig_commands.h"
-#include "../kig/kig_part.h"
-#include "../kig/kig_view.h"
 #include "../misc/calcpaths.h"
 #include "../misc/common.h"
 #include "../misc/goniometry.h"
@@ -24,7 +21,6 @@
 
 using std::find;
 
-
 /*
  * oriented arc by three points
  */
@@ -12,11 +12,12 @@
 
 #include "../misc/common.h"
 #include "../misc/coordinate.h"
+#include "../misc/coordinate_buffer.h"
 #include "../misc/kigpainter.h"
 #include "../misc/kigtransform.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 
 #include <KLazyLocalizedString>
 
@@ -59,12 +60,10 @@ ObjectImp *BezierImp::transform(const Transformation &t) const
     {
         return new InvalidImp;
     }
-    std::vector<Coordinate> np;
-    for (uint i = 0; i < mpoints.size(); ++i) {
-        Coordinate nc = t.apply(mpoints[i]);
-        if (!nc.valid())
+    std::vector<Coordinate> np = t.apply(mpoints);
+    for (uint i = 0; i < np.size(); ++i) {
+        if (!np[i].valid())
             return new InvalidImp;
-        np.push_back(nc);
     }
     return new BezierImp(np);
 }
@@ -74,17 +73,17 @@ void BezierImp::draw(KigPainter &p) const
     p.drawCurve(this);
 }
 
-bool BezierImp::inRect(const Rect &r, int width, const KigWidget &w) const
+bool BezierImp::inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
     bool ret = false;
     uint reduceddim = mpoints.size() - 1;
     for (uint i = 0; !ret && i < reduceddim; ++i) {
         SegmentImp s(mpoints[i], mpoints[i + 1]);
-        ret = lineInRect(r, mpoints[i], mpoints[i + 1], width, &s, w);
+        ret = lineInRect(r, mpoints[i], mpoints[i + 1], width, &s, si, doc);
     }
     if (!ret) {
         SegmentImp s(mpoints[reduceddim], mpoints[0]);
-        ret = lineInRect(r, mpoints[reduceddim], mpoints[0], width, &s, w);
+        ret = lineInRect(r, mpoints[reduceddim], mpoints[0], width, &s, si, doc);
     }
 
     return ret;
@@ -166,6 +165,23 @@ ObjectImp *BezierImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *BezierImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return IntImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return OpenPolygonalImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 const std::vector<Coordinate> BezierImp::points() const
 {
     return mpoints;
@@ -266,16 +282,15 @@ bool BezierImp::isPropertyDefinedOnOrThroughThisImp(int which) const
 
 Rect BezierImp::surroundingRect() const
 {
-    Rect r(0., 0., 0., 0.);
-    for (uint i = 0; i < mpoints.size(); ++i) {
-        r.setContains(mpoints[i]);
-    }
-    return r;
+    // the curve lies within the convex hull of its control points.
+    // This is only called once for every imp, the ObjectHolder keeps
+    // the result.
+    return CoordinateBuffer(mpoints).boundingRect();
 }
 
-bool BezierImp::contains(const Coordinate &o, int width, const KigWidget &w) const
+bool BezierImp::contains(const Coordinate &o, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return internalContainsPoint(o, w.screenInfo().normalMiss(width), w.document());
+    return internalContainsPoint(o, si.normalMiss(width), doc);
 }
 
 bool BezierImp::containsPoint(const Coordinate &p, const KigDocument &doc) const
@@ -285,9 +300,17 @@ bool BezierImp::containsPoint(const Coordinate &p, const KigDocument &doc) const
 
 bool BezierImp::internalContainsPoint(const Coordinate &p, double threshold, const KigDocument &doc) const
 {
-    double param = getParam(p, doc);
-    double dist = getDist(param, p, doc);
-    return fabs(dist) <= threshold;
+    return genericContainsPoint(p, threshold, mparamcache, doc);
+}
+
+double BezierImp::getParam(const Coordinate &p, const KigDocument &doc) const
+{
+    return searchParam(p, mparamcache, doc);
+}
+
+double BezierImp::getParamNear(const Coordinate &p, double hint, double maxdist, const KigDocument &doc) const
+{
+    return searchParamNear(p, hint, maxdist, mparamcache, doc);
 }
 
 Coordinate BezierImp::deCasteljau(unsigned int m, unsigned int k, double p) const
@@ -348,12 +371,10 @@ ObjectImp *RationalBezierImp::transform(const Transformation &t) const
     {
         return new InvalidImp;
     }
-    std::vector<Coordinate> np;
-    for (uint i = 0; i < mpoints.size(); ++i) {
-        Coordinate nc = t.apply(mpoints[i]);
-        if (!nc.valid())
+    std::vector<Coordinate> np = t.apply(mpoints);
+    for (uint i = 0; i < np.size(); ++i) {
+        if (!np[i].valid())
             return new InvalidImp;
-        np.push_back(nc);
     }
     return new RationalBezierImp(np, mweights);
 }
@@ -363,17 +384,17 @@ void RationalBezierImp::draw(KigPainter &p) const
     p.drawCurve(this);
 }
 
-bool RationalBezierImp::inRect(const Rect &r, int width, const KigWidget &w) const
+bool RationalBezierImp::inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
     bool ret = false;
     uint reduceddim = mpoints.size() - 1;
     for (uint i = 0; !ret && i < reduceddim; ++i) {
         SegmentImp s(mpoints[i], mpoints[i + 1]);
-        ret = lineInRect(r, mpoints[i], mpoints[i + 1], width, &s, w);
+        ret = lineInRect(r, mpoints[i], mpoints[i + 1], width, &s, si, doc);
     }
     if (!ret) {
         SegmentImp s(mpoints[reduceddim], mpoints[0]);
-        ret = lineInRect(r, mpoints[reduceddim], mpoints[0], width, &s, w);
+        ret = lineInRect(r, mpoints[reduceddim], mpoints[0], width, &s, si, doc);
     }
 
     return ret;
@@ -455,6 +476,23 @@ ObjectImp *RationalBezierImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *RationalBezierImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return IntImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return OpenPolygonalImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 const std::vector<Coordinate> RationalBezierImp::points() const
 {
     return mpoints;
@@ -555,16 +593,14 @@ bool RationalBezierImp::isPropertyDefinedOnOrThroughThisImp(int which) const
 
 Rect RationalBezierImp::surroundingRect() const
 {
-    Rect r(0., 0., 0., 0.);
-    for (uint i = 0; i < mpoints.size(); ++i) {
-        r.setContains(mpoints[i]);
-    }
-    return r;
+    // with positive weights, the curve lies within the convex hull of
+    // its control points too
+    return CoordinateBuffer(mpoints).boundingRect();
 }
 
-bool RationalBezierImp::contains(const Coordinate &o, int width, const KigWidget &w) const
+bool RationalBezierImp::contains(const Coordinate &o, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return internalContainsPoint(o, w.screenInfo().normalMiss(width), w.document());
+    return internalContainsPoint(o, si.normalMiss(width), doc);
 }
 
 bool RationalBezierImp::containsPoint(const Coordinate &p, const KigDocument &doc) const
@@ -574,9 +610,17 @@ bool RationalBezierImp::containsPoint(const Coordinate &p, const KigDocument &do
 
 bool RationalBezierImp::internalContainsPoint(const Coordinate &p, double threshold, const KigDocument &doc) const
 {
-    double param = getParam(p, doc);
-    double dist = getDist(param, p, doc);
-    return fabs(dist) <= threshold;
+    return genericContainsPoint(p, threshold, mparamcache, doc);
+}
+
+double RationalBezierImp::getParam(const Coordinate &p, const KigDocument &doc) const
+{
+    return searchParam(p, mparamcache, doc);
+}
+
+double RationalBezierImp::getParamNear(const Coordinate &p, double hint, double maxdist, const KigDocument &doc) const
+{
+    return searchParamNear(p, hint, maxdist, mparamcache, doc);
 }
 
 Coordinate RationalBezierImp::deCasteljauPoints(unsigned int m, unsigned int k, double p) const
@@ -19,6 +19,8 @@ class BezierImp : public CurveImp
     uint mnpoints;
     std::vector<Coordinate> mpoints;
     Coordinate mcenterofmass;
+    // for the generic search of getParam()
+    CurveParamCache mparamcache;
 
     Coordinate deCasteljau(unsigned int m, unsigned int k, double p) const;
 
@@ -42,12 +44,14 @@ public:
     ObjectImp *transform(const Transformation &) const override;
 
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
-    bool inRect(const Rect &r, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
+    bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     bool valid() const;
     Rect surroundingRect() const override;
 
     const Coordinate getPoint(double param, const KigDocument &) const override;
+    double getParam(const Coordinate &point, const KigDocument &) const override;
+    double getParamNear(const Coordinate &point, double hint, double maxdist, const KigDocument &) const override;
     bool containsPoint(const Coordinate &p, const KigDocument &doc) const override;
     bool internalContainsPoint(const Coordinate &p, double threshold, const KigDocument &doc) const;
 
@@ -55,6 +59,7 @@ public:
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -87,6 +92,8 @@ class RationalBezierImp : public CurveImp
     std::vector<Coordinate> mpoints;
     std::vector<double> mweights;
     Coordinate mcenterofmass;
+    // for the generic search of getParam()
+    CurveParamCache mparamcache;
 
     Coordinate deCasteljauPoints(unsigned int m, unsigned int k, double p) const;
     double deCasteljauWeights(unsigned int m, unsigned int k, double p) const;
@@ -111,12 +118,14 @@ public:
     ObjectImp *transform(const Transformation &) const override;
 
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
-    bool inRect(const Rect &r, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
+    bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     bool valid() const;
     Rect surroundingRect() const override;
 
     const Coordinate getPoint(double param, const KigDocument &) const override;
+    double getParam(const Coordinate &point, const KigDocument &) const override;
+    double getParamNear(const Coordinate &point, double hint, double maxdist, const KigDocument &) const override;
     bool containsPoint(const Coordinate &p, const KigDocument &doc) const override;
     bool internalContainsPoint(const Coordinate &p, double threshold, const KigDocument &doc) const;
 
@@ -124,6 +133,7 @@ public:
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
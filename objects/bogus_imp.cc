@@ -17,12 +17,12 @@ void BogusImp::draw(KigPainter &) const
 {
 }
 
-bool BogusImp::contains(const Coordinate &, int, const KigWidget &) const
+bool BogusImp::contains(const Coordinate &, int, const ScreenInfo &, const KigDocument &) const
 {
     return false;
 }
 
-bool BogusImp::inRect(const Rect &, int, const KigWidget &) const
+bool BogusImp::inRect(const Rect &, int, const ScreenInfo &, const KigDocument &) const
 {
     return false;
 }
@@ -172,26 +172,6 @@ bool TransformationImp::equals(const ObjectImp &rhs) const
     return rhs.inherits(TransformationImp::stype()) && static_cast<const TransformationImp &>(rhs).data() == mdata;
 }
 
-bool InvalidImp::canFillInNextEscape() const
-{
-    return true;
-}
-
-bool DoubleImp::canFillInNextEscape() const
-{
-    return true;
-}
-
-bool IntImp::canFillInNextEscape() const
-{
-    return true;
-}
-
-bool StringImp::canFillInNextEscape() const
-{
-    return true;
-}
-
 const ObjectImpType *InvalidImp::stype()
 {
     static const ObjectImpType t(Parent::stype(),
@@ -204,7 +184,8 @@ const ObjectImpType *InvalidImp::stype()
                                  KLazyLocalizedString(),
                                  KLazyLocalizedString(),
                                  KLazyLocalizedString(),
-                                 KLazyLocalizedString());
+                                 KLazyLocalizedString(),
+                                 true);
     return &t;
 }
 
@@ -220,7 +201,8 @@ const ObjectImpType *StringImp::stype()
                                  KLazyLocalizedString(),
                                  KLazyLocalizedString(),
                                  KLazyLocalizedString(),
-                                 KLazyLocalizedString());
+                                 KLazyLocalizedString(),
+                                 true);
     return &t;
 }
 const ObjectImpType *HierarchyImp::stype()
@@ -296,7 +278,8 @@ const ObjectImpType *DoubleImp::stype()
                                  KLazyLocalizedString(),
                                  KLazyLocalizedString(),
                                  KLazyLocalizedString(),
-                                 KLazyLocalizedString());
+                                 KLazyLocalizedString(),
+                                 true);
     return &t;
 }
 
@@ -312,7 +295,8 @@ const ObjectImpType *IntImp::stype()
                                  KLazyLocalizedString(),
                                  KLazyLocalizedString(),
                                  KLazyLocalizedString(),
-                                 KLazyLocalizedString());
+                                 KLazyLocalizedString(),
+                                 true);
     return &t;
 }
 
@@ -408,6 +392,19 @@ ObjectImp *TestResultImp::property(int which, const KigDocument &d) const
     return new InvalidImp;
 }
 
+const ObjectImpType *TestResultImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 const char *TestResultImp::iconForProperty(int which) const
 {
     if (which < Parent::numberOfProperties())
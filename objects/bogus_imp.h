@@ -32,8 +32,8 @@ public:
 
     Coordinate attachPoint() const override;
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &w) const override;
-    bool inRect(const Rect &r, int width, const KigWidget &w) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
+    bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     Rect surroundingRect() const override;
 
     ObjectImp *transform(const Transformation &) const override;
@@ -62,7 +62,6 @@ public:
     const ObjectImpType *type() const override;
     void visit(ObjectImpVisitor *vtor) const override;
 
-    bool canFillInNextEscape() const override;
     void fillInNextEscape(QString &s, const KigDocument &) const override;
 
     bool equals(const ObjectImp &rhs) const override;
@@ -107,7 +106,6 @@ public:
     const ObjectImpType *type() const override;
     void visit(ObjectImpVisitor *vtor) const override;
 
-    bool canFillInNextEscape() const override;
     void fillInNextEscape(QString &s, const KigDocument &) const override;
 
     bool equals(const ObjectImp &rhs) const override;
@@ -152,7 +150,6 @@ public:
     const ObjectImpType *type() const override;
     void visit(ObjectImpVisitor *vtor) const override;
 
-    bool canFillInNextEscape() const override;
     void fillInNextEscape(QString &s, const KigDocument &) const override;
 
     bool equals(const ObjectImp &rhs) const override;
@@ -197,7 +194,6 @@ public:
     const ObjectImpType *type() const override;
     void visit(ObjectImpVisitor *vtor) const override;
 
-    bool canFillInNextEscape() const override;
     void fillInNextEscape(QString &s, const KigDocument &) const override;
 
     bool equals(const ObjectImp &rhs) const override;
@@ -286,6 +282,7 @@ public:
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &d) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -14,8 +14,6 @@
 #include "../misc/common.h"
 #include "../misc/conic-common.h"
 //#include "../misc/calcpaths.h"
-#include "../kig/kig_part.h"
-#include "../kig/kig_view.h"
 
 static const KLazyLocalizedString constructcenterofcurvaturepoint = {};
 //  I18N_NOOP( "Construct the center of curvature corresponding to this point" );
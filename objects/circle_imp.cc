@@ -13,7 +13,7 @@
 #include "../misc/kigtransform.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 
 #include <KLazyLocalizedString>
 #include <math.h>
@@ -49,12 +49,12 @@ void CircleImp::draw(KigPainter &p) const
     p.drawCircle(mcenter, fabs(mradius));
 }
 
-bool CircleImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool CircleImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    return fabs((mcenter - p).length() - fabs(mradius)) <= w.screenInfo().normalMiss(width);
+    return fabs((mcenter - p).length() - fabs(mradius)) <= si.normalMiss(width);
 }
 
-bool CircleImp::inRect(const Rect &r, int width, const KigWidget &w) const
+bool CircleImp::inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &) const
 {
     // first we check if the rect contains at least one of the
     // north/south/east/west points of the circle
@@ -68,7 +68,7 @@ bool CircleImp::inRect(const Rect &r, int width, const KigWidget &w) const
         return true;
 
     // we allow a miss of some pixels ..
-    double miss = w.screenInfo().normalMiss(width);
+    double miss = si.normalMiss(width);
     double bigradius = fabs(mradius) + miss;
     bigradius *= bigradius;
     double smallradius = fabs(mradius) - miss;
@@ -197,6 +197,31 @@ ObjectImp *CircleImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *CircleImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < CurveImp::numberOfProperties())
+        return CurveImp::propertyResultType(which);
+    else if (which == CurveImp::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == CurveImp::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == CurveImp::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == CurveImp::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == CurveImp::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else if (which == CurveImp::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else if (which == CurveImp::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 const Coordinate CircleImp::center() const
 {
     return mcenter;
@@ -16,7 +16,7 @@
 #include "../misc/kigpainter.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 
 ObjectImp *ConicImp::transform(const Transformation &t) const
 {
@@ -38,12 +38,12 @@ bool ConicImp::valid() const
     return true;
 }
 
-bool ConicImp::contains(const Coordinate &o, int width, const KigWidget &w) const
+bool ConicImp::contains(const Coordinate &o, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    return internalContainsPoint(o, w.screenInfo().normalMiss(width));
+    return internalContainsPoint(o, si.normalMiss(width));
 }
 
-bool ConicImp::inRect(const Rect &, int, const KigWidget &) const
+bool ConicImp::inRect(const Rect &, int, const ScreenInfo &, const KigDocument &) const
 {
     // TODO
     return false;
@@ -133,6 +133,29 @@ ObjectImp *ConicImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *ConicImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 double ConicImp::getParam(const Coordinate &p, const KigDocument &) const
 {
     return getParam(p);
@@ -508,9 +531,9 @@ ObjectImp *ConicArcImp::transform(const Transformation &t) const
     return result;
 }
 
-bool ConicArcImp::contains(const Coordinate &o, int width, const KigWidget &w) const
+bool ConicArcImp::contains(const Coordinate &o, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return internalContainsPoint(o, w.screenInfo().normalMiss(width), w.document());
+    return internalContainsPoint(o, si.normalMiss(width), doc);
 }
 
 int ConicArcImp::numberOfProperties() const
@@ -569,6 +592,23 @@ ObjectImp *ConicArcImp::property(int which, const KigDocument &d) const
     return new InvalidImp;
 }
 
+const ObjectImpType *ConicArcImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return ConicImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 bool ConicArcImp::isPropertyDefinedOnOrThroughThisImp(int which) const
 {
     int pnum = 0;
@@ -37,8 +37,8 @@ public:
     ObjectImp *transform(const Transformation &) const override;
 
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
-    bool inRect(const Rect &r, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
+    bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     bool valid() const;
     Rect surroundingRect() const override;
 
@@ -49,6 +49,7 @@ public:
     const QByteArrayList propertiesInternalNames() const override;
     const char *iconForProperty(int which) const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
 
     double getParam(const Coordinate &point, const KigDocument &) const override;
     const Coordinate getPoint(double param, const KigDocument &) const override;
@@ -175,7 +176,7 @@ public:
     ConicArcImp *copy() const override;
 
     ObjectImp *transform(const Transformation &t) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     bool containsPoint(const Coordinate &p, const KigDocument &doc) const override;
     bool internalContainsPoint(const Coordinate &p, double threshold, const KigDocument &doc) const;
 
@@ -183,6 +184,7 @@ public:
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
 
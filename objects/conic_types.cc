@@ -4,8 +4,6 @@
 
 #include "conic_types.h"
 
-#include "../kig/kig_commands.h"
-#include "../kig/kig_part.h"
 #include "../misc/common.h"
 #include "../misc/conic-common.h"
 #include "bogus_imp.h"
@@ -605,18 +603,3 @@ QStringList ConicRadicalType::specialActions() const
     return ret;
 }
 
-void ConicRadicalType::executeAction(int i, ObjectHolder &, ObjectTypeCalcer &t, KigPart &d, KigWidget &, NormalMode &) const
-{
-    assert(i == 0);
-    std::vector<ObjectCalcer *> parents = t.parents();
-    assert(dynamic_cast<ObjectConstCalcer *>(parents[3]));
-    ObjectConstCalcer *zeroindexo = static_cast<ObjectConstCalcer *>(parents[3]);
-    MonitorDataObjects mon(zeroindexo);
-    assert(zeroindexo->imp()->inherits(IntImp::stype()));
-    int oldzeroindex = static_cast<const IntImp *>(zeroindexo->imp())->data();
-    int newzeroindex = oldzeroindex % 3 + 1;
-    zeroindexo->setImp(new IntImp(newzeroindex));
-    KigCommand *kc = new KigCommand(d, i18n("Switch Conic Radical Lines"));
-    mon.finish(kc);
-    d.history()->push(kc);
-}
@@ -163,5 +163,5 @@ public:
     ObjectImp *calc(const Args &parents, const KigDocument &) const override;
     const ObjectImpType *resultId() const override;
     QStringList specialActions() const override;
-    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &m) const override;
+    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &m) const;
 };
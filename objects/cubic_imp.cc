@@ -6,7 +6,6 @@
 
 #include "bogus_imp.h"
 
-#include "../kig/kig_view.h"
 #include "../misc/common.h"
 #include "../misc/equationstring.h"
 #include "../misc/kignumerics.h"
@@ -43,12 +42,12 @@ void CubicImp::draw(KigPainter &p) const
     p.drawCurve(this);
 }
 
-bool CubicImp::contains(const Coordinate &o, int width, const KigWidget &w) const
+bool CubicImp::contains(const Coordinate &o, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    return internalContainsPoint(o, w.screenInfo().normalMiss(width));
+    return internalContainsPoint(o, si.normalMiss(width));
 }
 
-bool CubicImp::inRect(const Rect &, int, const KigWidget &) const
+bool CubicImp::inRect(const Rect &, int, const ScreenInfo &, const KigDocument &) const
 {
     // TODO ?
     return false;
@@ -319,6 +318,19 @@ ObjectImp *CubicImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *CubicImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 const CubicCartesianData CubicImp::data() const
 {
     return mdata;
@@ -26,8 +26,8 @@ public:
 
     ObjectImp *transform(const Transformation &) const override;
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
-    bool inRect(const Rect &r, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
+    bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     Rect surroundingRect() const override;
     QString cartesianEquationString(const KigDocument &) const;
 
@@ -35,6 +35,7 @@ public:
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
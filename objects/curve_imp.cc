@@ -9,8 +9,12 @@
 #include "../misc/equationstring.h"
 #include "../misc/kignumerics.h"
 
+#include <algorithm>
 #include <cmath>
 
+// the number of intervals the generic getParam() cuts [0,1] into
+static const int paramSampleIntervals = 64;
+
 const ObjectImpType *CurveImp::stype()
 {
     static const ObjectImpType t(Parent::stype(),
@@ -27,6 +31,47 @@ const ObjectImpType *CurveImp::stype()
     return &t;
 }
 
+CurveImp::CurveImp()
+{
+}
+
+CurveParamCache::CurveParamCache()
+    : mlastparam(-1.)
+{
+}
+
+const CoordinateBuffer &CurveParamCache::samples(const CurveImp &curve, const KigDocument &doc) const
+{
+    std::call_once(msamplesonce, [this, &curve, &doc]() {
+        msamples.reserve(paramSampleIntervals + 1);
+        for (int j = 0; j <= paramSampleIntervals; ++j)
+            msamples.push_back(curve.getPoint(j / (double)paramSampleIntervals, doc));
+    });
+    return msamples;
+}
+
+void CurveParamCache::remember(const Coordinate &p, double param) const
+{
+    std::lock_guard<std::mutex> lock(mlastmutex);
+    mlastpoint = p;
+    mlastparam = param;
+}
+
+bool CurveParamCache::last(const Coordinate &p, double &param) const
+{
+    std::lock_guard<std::mutex> lock(mlastmutex);
+    if (mlastparam < 0. || !(mlastpoint == p))
+        return false;
+    param = mlastparam;
+    return true;
+}
+
+double CurveParamCache::last() const
+{
+    std::lock_guard<std::mutex> lock(mlastmutex);
+    return mlastparam;
+}
+
 Coordinate CurveImp::attachPoint() const
 {
     return Coordinate::invalidCoord();
@@ -120,6 +165,14 @@ double CurveImp::getDist(double param, const Coordinate &p, const KigDocument &d
 }
 
 double CurveImp::getParam(const Coordinate &p, const KigDocument &doc) const
+{
+    // curves that use the generic search keep a cache for it, and
+    // reimplement this function with it.
+    const CurveParamCache cache;
+    return searchParam(p, cache, doc);
+}
+
+double CurveImp::searchParam(const Coordinate &p, const CurveParamCache &cache, const KigDocument &doc) const
 {
     // this function ( and related functions like getInterval etc. ) is
     // written by Franco Pasquarelli <pasqui@dmf.bs.unicatt.it>.
@@ -135,8 +188,9 @@ double CurveImp::getParam(const Coordinate &p, const KigDocument &doc) const
     // was itself computed previously using getPoint.  So the param used in getPoint
     // is cached in LocusImp, BezierImp, ... and then checked for validity here.
 
-    if (doc.mcachedparam >= 0. && doc.mcachedparam <= 1. && getPoint(doc.mcachedparam, doc) == p)
-        return doc.mcachedparam;
+    const double cachedparam = doc.mcachedparam;
+    if (cachedparam >= 0. && cachedparam <= 1. && getPoint(cachedparam, doc) == p)
+        return cachedparam;
 
     // consider the function that returns the distance for a point at
     // parameter x to the locus for a given parameter x.  What we do
@@ -145,33 +199,24 @@ double CurveImp::getParam(const Coordinate &p, const KigDocument &doc) const
     // for a local minimum from there on.  If we find one, we keep it if
     // it is the lowest of all the ones we've already found..
 
-    const int N = 64;
+    const int N = paramSampleIntervals;
     const double incr = 1. / (double)N;
+    const CoordinateBuffer &samples = cache.samples(*this, doc);
 
     // xm is the best parameter we've found so far, fxm is the distance
-    // to the locus from that point.  We start with some
-    // pseudo-values.
+    // to the locus from that point.  We start with the sample nearest
+    // to p.
     // (mp) note that if the distance is actually increasing in the
     // whole interval [0,1] this value will be returned in the end.
-    double xm = 0.;
-    double fxm = getDist(xm, p, doc);
+    std::size_t nearest;
+    double fxm = samples.minDistance(p, &nearest);
+    double xm = nearest * incr;
     double x1, x2;
 
     double mm[N + 1];
-    mm[0] = fxm;
+    for (int j = 0; j < N + 1; j++)
+        mm[j] = samples[j].valid() ? (samples[j] - p).length() : +double_inf;
 
-    for (int j = 1; j < N + 1; j++) {
-        // [x1,x2] is the range we're currently considering..
-        x1 = j * incr;
-
-        // check the range x1,x2 for the first local maximum..
-        double mm1 = getDist(x1, p, doc);
-        if (mm1 < fxm) {
-            xm = x1;
-            fxm = mm1;
-        }
-        mm[j] = mm1;
-    }
     if (xm == 0.) {
         x1 = 0.;
         x2 = incr;
@@ -202,9 +247,43 @@ double CurveImp::getParam(const Coordinate &p, const KigDocument &doc) const
             }
         }
     }
+    cache.remember(p, xm);
     return xm;
 }
 
+double CurveImp::getParamNear(const Coordinate &p, double, double, const KigDocument &doc) const
+{
+    return getParam(p, doc);
+}
+
+double CurveImp::searchParamNear(const Coordinate &p, double hint, double maxdist, const CurveParamCache &cache, const KigDocument &doc) const
+{
+    double last;
+    if (cache.last(p, last))
+        return last;
+
+    // a local minimum within one sample interval of hint is good
+    // enough if it is close enough to p: the point is then where the
+    // user pointed, and most probably on the same branch of the curve
+    // as before..
+    if (hint >= 0. && hint <= 1.) {
+        const double incr = 1. / paramSampleIntervals;
+        const double param = getParamofmin(std::max(hint - incr, 0.), std::min(hint + incr, 1.), p, doc);
+        if (getDist(param, p, doc) <= maxdist) {
+            cache.remember(p, param);
+            return param;
+        }
+    }
+    return searchParam(p, cache, doc);
+}
+
+bool CurveImp::genericContainsPoint(const Coordinate &p, double threshold, const CurveParamCache &cache, const KigDocument &doc) const
+{
+    double param = searchParamNear(p, cache.last(), threshold, cache, doc);
+    double dist = getDist(param, p, doc);
+    return fabs(dist) <= threshold;
+}
+
 // This function is used to obtain a pseudo-random number using bitwise operators
 // it probably should be moved elsewhere, or made completely local...
 //
@@ -6,6 +6,50 @@
 
 #include "object_imp.h"
 
+#include "../misc/coordinate.h"
+#include "../misc/coordinate_buffer.h"
+
+#include <mutex>
+#include <vector>
+
+class CurveImp;
+
+/**
+ * What the generic search for the parameter of a point on a curve (
+ * see CurveImp::searchParam() ) remembers about the curve between
+ * calls.  Only the curves that use that search, loci and Bézier
+ * curves, keep one: the other curves calculate their parameters
+ * directly.
+ */
+class CurveParamCache
+{
+    // the points at the parameters 0, 1/64, ..., 1, which the search
+    // starts from.  An imp never changes, so we only calculate them
+    // once.  Imps are shared by the threads that draw tiles or export
+    // objects, hence the once_flag.
+    mutable CoordinateBuffer msamples;
+    mutable std::once_flag msamplesonce;
+
+    // the last point the search was asked for, and the parameter it
+    // found for it.  Moving the mouse over a curve asks for the same
+    // point when testing whether it is under the mouse and when
+    // attaching a point to it, and for a point near the last one on
+    // the next move.  Only getParamNear() and containsPoint() use this,
+    // so that getParam() does not depend on what was asked before.
+    mutable std::mutex mlastmutex;
+    mutable Coordinate mlastpoint;
+    mutable double mlastparam;
+
+public:
+    CurveParamCache();
+
+    const CoordinateBuffer &samples(const CurveImp &curve, const KigDocument &doc) const;
+
+    void remember(const Coordinate &p, double param) const;
+    bool last(const Coordinate &p, double &param) const;
+    double last() const;
+};
+
 /**
  * This class represents a curve: something which is composed of
  * points, like a line, a circle, a locus.
@@ -16,10 +60,36 @@ private:
     double revert(int n) const;
 
 protected:
+    CurveImp();
+
     // following two functions are used by generic getParam()
     double getParamofmin(double a, double b, const Coordinate &p, const KigDocument &doc) const;
     double getDist(double param, const Coordinate &p, const KigDocument &doc) const;
 
+    /**
+     * the generic getParam(): search the parameter of the point of
+     * the curve nearest to \p p numerically.  Curves that have no
+     * better way reimplement getParam() with this, and keep a \p cache
+     * for it.
+     */
+    double searchParam(const Coordinate &p, const CurveParamCache &cache, const KigDocument &doc) const;
+
+    /**
+     * the generic version of getParamNear(): look for a local minimum
+     * of the distance to \p p around \p hint first, and only search
+     * the entire curve if that is not within \p maxdist of \p p .
+     * Curves that use searchParam() reimplement getParamNear() with
+     * this.
+     */
+    double searchParamNear(const Coordinate &p, double hint, double maxdist, const CurveParamCache &cache, const KigDocument &doc) const;
+
+    /**
+     * whether there is a point on the curve within \p threshold of \p p,
+     * for the curves that use searchParam(). The search starts from
+     * where the last one ended.
+     */
+    bool genericContainsPoint(const Coordinate &p, double threshold, const CurveParamCache &cache, const KigDocument &doc) const;
+
 public:
     typedef ObjectImp Parent;
 
@@ -33,8 +103,19 @@ public:
     // param is between 0 and 1.  Note that 0 and 1 should be the
     // end-points.  E.g. for a Line, getPoint(0) returns a more or less
     // infinite point.  getPoint(0.5) should return the point in the
-    // middle.
+    // middle.  The default implementation is searchParam(), without a
+    // cache.
     virtual double getParam(const Coordinate &point, const KigDocument &) const;
+    /**
+     * like getParam(), for when we already have an idea where \p point
+     * is: \p hint is the parameter of a point near it, e.g. where a
+     * point that is dragged over the curve was before.  If there is a
+     * point of the curve within \p maxdist of \p point near \p hint,
+     * its parameter may be returned without looking at the rest of the
+     * curve.  The default implementation simply calls getParam(), which
+     * is fine for the curves that calculate it directly.
+     */
+    virtual double getParamNear(const Coordinate &point, double hint, double maxdist, const KigDocument &) const;
     // this should be the inverse function of getPoint().
     // Note that it should also do something reasonable when p is not on
     // the curve.  You can return an invalid Coordinate(
@@ -7,7 +7,7 @@
 #include "bogus_imp.h"
 #include "point_imp.h"
 
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 #include "../misc/common.h"
 #include "../misc/equationstring.h"
 #include "../misc/kigpainter.h"
@@ -27,9 +27,9 @@ AbstractLineImp::~AbstractLineImp()
 {
 }
 
-bool AbstractLineImp::inRect(const Rect &r, int width, const KigWidget &w) const
+bool AbstractLineImp::inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return lineInRect(r, mdata.a, mdata.b, width, this, w);
+    return lineInRect(r, mdata.a, mdata.b, width, this, si, doc);
 }
 
 int AbstractLineImp::numberOfProperties() const
@@ -71,6 +71,21 @@ ObjectImp *AbstractLineImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *AbstractLineImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 const QByteArrayList AbstractLineImp::propertiesInternalNames() const
 {
     QByteArrayList l = Parent::propertiesInternalNames();
@@ -173,6 +188,29 @@ ObjectImp *SegmentImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *SegmentImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return LineImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 int RayImp::numberOfProperties() const
 {
     return Parent::numberOfProperties() + 2;
@@ -233,6 +271,21 @@ ObjectImp *RayImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *RayImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return LineImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 double AbstractLineImp::slope() const
 {
     Coordinate diff = mdata.dir();
@@ -282,9 +335,9 @@ void SegmentImp::draw(KigPainter &p) const
     p.drawSegment(mdata);
 }
 
-bool SegmentImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool SegmentImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    return internalContainsPoint(p, w.screenInfo().normalMiss(width));
+    return internalContainsPoint(p, si.normalMiss(width));
 }
 
 void RayImp::draw(KigPainter &p) const
@@ -292,9 +345,9 @@ void RayImp::draw(KigPainter &p) const
     p.drawRay(mdata);
 }
 
-bool RayImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool RayImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    return internalContainsPoint(p, w.screenInfo().normalMiss(width));
+    return internalContainsPoint(p, si.normalMiss(width));
 }
 
 void LineImp::draw(KigPainter &p) const
@@ -302,9 +355,9 @@ void LineImp::draw(KigPainter &p) const
     p.drawLine(mdata);
 }
 
-bool LineImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool LineImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    return internalContainsPoint(p, w.screenInfo().normalMiss(width));
+    return internalContainsPoint(p, si.normalMiss(width));
 }
 
 SegmentImp::SegmentImp(const Coordinate &a, const Coordinate &b)
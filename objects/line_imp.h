@@ -31,12 +31,13 @@ public:
 
     ~AbstractLineImp();
 
-    bool inRect(const Rect &r, int width, const KigWidget &) const override;
+    bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const override;
 
     int numberOfProperties() const override;
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &d) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -83,7 +84,7 @@ public:
     explicit SegmentImp(const LineData &d);
 
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &si) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     Rect surroundingRect() const override;
 
     ObjectImp *transform(const Transformation &) const override;
@@ -95,6 +96,7 @@ public:
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &d) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -138,7 +140,7 @@ public:
     explicit RayImp(const LineData &d);
 
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &si) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     Rect surroundingRect() const override;
 
     ObjectImp *transform(const Transformation &) const override;
@@ -150,6 +152,7 @@ public:
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &d) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -186,7 +189,7 @@ public:
      */
     explicit LineImp(const LineData &d);
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &si) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     Rect surroundingRect() const override;
 
     ObjectImp *transform(const Transformation &) const override;
@@ -10,9 +10,6 @@
 #include "other_imp.h"
 #include "point_imp.h"
 
-#include "../kig/kig_commands.h"
-#include "../kig/kig_part.h"
-#include "../kig/kig_view.h"
 #include "../misc/calcpaths.h"
 #include "../misc/common.h"
 
@@ -225,32 +222,6 @@ QStringList SegmentABType::specialActions() const
     return ret;
 }
 
-void SegmentABType::executeAction(int i, ObjectHolder &, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &) const
-{
-    assert(i == 0);
-    // pretend to use this var..
-    (void)i;
-
-    std::vector<ObjectCalcer *> parents = c.parents();
-    assert(margsparser.checkArgs(parents));
-
-    Coordinate a = static_cast<const PointImp *>(parents[0]->imp())->coordinate();
-    Coordinate b = static_cast<const PointImp *>(parents[1]->imp())->coordinate();
-
-    bool ok = true;
-    double length = getDoubleFromUser(i18n("Set Segment Length"), i18n("Choose the new length: "), (b - a).length(), &w, &ok, -2147483647, 2147483647, 3);
-    if (!ok)
-        return;
-
-    Coordinate nb = a + (b - a).normalize(length);
-
-    MonitorDataObjects mon(getAllParents(parents));
-    parents[1]->move(nb, d.document());
-    KigCommand *cd = new KigCommand(d, i18n("Resize Segment"));
-    mon.finish(cd);
-    d.history()->push(cd);
-}
-
 static const ArgsParser::spec argsspecLineByVector[] = {
     {VectorImp::stype(), kli18n("Construct a line by this vector"), kli18n("Select a vector in the direction of the new line..."), true},
     {PointImp::stype(), constructlineabstat, kli18n("Select a point for the new line to go through..."), true}};
@@ -23,7 +23,7 @@ public:
     /**
      * execute the \p i 'th action from the specialActions above.
      */
-    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const override;
+    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const;
 };
 
 class LineABType : public ObjectABType
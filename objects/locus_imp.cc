@@ -5,7 +5,7 @@
 #include "locus_imp.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 #include "../misc/common.h"
 #include "../misc/coordinate.h"
 #include "../misc/equationstring.h"
@@ -35,12 +35,12 @@ void LocusImp::draw(KigPainter &p) const
     p.drawCurve(this);
 }
 
-bool LocusImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool LocusImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return internalContainsPoint(p, w.screenInfo().normalMiss(width), w.document());
+    return internalContainsPoint(p, si.normalMiss(width), doc);
 }
 
-bool LocusImp::inRect(const Rect &, int, const KigWidget &) const
+bool LocusImp::inRect(const Rect &, int, const ScreenInfo &, const KigDocument &) const
 {
     // TODO ?
     return false;
@@ -125,6 +125,19 @@ ObjectImp *LocusImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *LocusImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 LocusImp *LocusImp::copy() const
 {
     return new LocusImp(mcurve->copy(), mhier);
@@ -207,9 +220,17 @@ bool LocusImp::containsPoint(const Coordinate &p, const KigDocument &doc) const
 
 bool LocusImp::internalContainsPoint(const Coordinate &p, double threshold, const KigDocument &doc) const
 {
-    double param = getParam(p, doc);
-    double dist = getDist(param, p, doc);
-    return fabs(dist) <= threshold;
+    return genericContainsPoint(p, threshold, mparamcache, doc);
+}
+
+double LocusImp::getParam(const Coordinate &p, const KigDocument &doc) const
+{
+    return searchParam(p, mparamcache, doc);
+}
+
+double LocusImp::getParamNear(const Coordinate &p, double hint, double maxdist, const KigDocument &doc) const
+{
+    return searchParamNear(p, hint, maxdist, mparamcache, doc);
 }
 
 bool LocusImp::isPropertyDefinedOnOrThroughThisImp(int which) const
@@ -44,6 +44,8 @@ class LocusImp : public CurveImp
 {
     CurveImp *mcurve;
     const ObjectHierarchy mhier;
+    // for the generic search of getParam()
+    CurveParamCache mparamcache;
 
     void getInterval(double &x1, double &x2, double incr, const Coordinate &p, const KigDocument &doc) const;
 
@@ -58,16 +60,19 @@ public:
     ObjectImp *transform(const Transformation &) const override;
 
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     Rect surroundingRect() const override;
-    bool inRect(const Rect &r, int width, const KigWidget &) const override;
+    bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     const Coordinate getPoint(double param, const KigDocument &) const override;
+    double getParam(const Coordinate &point, const KigDocument &) const override;
+    double getParamNear(const Coordinate &point, double hint, double maxdist, const KigDocument &) const override;
 
     // TODO ?
     int numberOfProperties() const override;
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
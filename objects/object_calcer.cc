@@ -4,7 +4,9 @@
 
 #include "object_calcer.h"
 
+#include "../kig/kig_document.h"
 #include "../misc/coordinate.h"
+#include "../misc/kigtransform.h"
 #include "bogus_imp.h"
 #include "common.h"
 #include "object_holder.h"
@@ -18,18 +20,95 @@
 
 void ObjectTypeCalcer::calc(const KigDocument &doc)
 {
-    Args a;
-    a.reserve(mparents.size());
-    std::transform(mparents.begin(), mparents.end(), std::back_inserter(a), std::mem_fn(&ObjectCalcer::imp));
-    ObjectImp *n = mtype->calc(a, doc);
+    if (foldsIntoChild()) {
+        // our child applies our transformation along with its own, so
+        // we don't calculate our imp until somebody else asks for it,
+        // see imp()..
+        delete mimp;
+        mimp = nullptr;
+        mfoldeddoc = &doc;
+        return;
+    }
+    calcImp(doc);
+}
+
+void ObjectTypeCalcer::calcImp(const KigDocument &doc)
+{
+    mfoldeddoc = nullptr;
+    ObjectImp *n = calcTransformChain(doc);
+    if (!n) {
+        Args a;
+        a.reserve(mparents.size());
+        std::transform(mparents.begin(), mparents.end(), std::back_inserter(a), std::mem_fn(&ObjectCalcer::imp));
+        n = mtype->calc(a, doc);
+    }
+    if (mimp && mtype->canKeepImp(*mimp, *n, !mchildren.empty())) {
+        delete n;
+        return;
+    }
     delete mimp;
     mimp = n;
+    doc.objectsChanged();
+}
+
+bool ObjectTypeCalcer::foldsIntoChild() const
+{
+    // a macro can build a chain of transformations of which only the
+    // last one is held by an ObjectHolder.  The others are only
+    // referenced by the next transformation in the chain, which is
+    // their only child, and transforms them.  Only that child ever
+    // looks at their imps, so it can just as well compose their
+    // transformations with its own, see calcTransformChain().
+    if (refcount != 1 || mchildren.size() != 1 || !mtype->isTransform())
+        return false;
+    const ObjectTypeCalcer *child = dynamic_cast<const ObjectTypeCalcer *>(mchildren[0]);
+    return child && child->mtype->isTransform() && child->mparents[0] == this
+        && std::count(child->mparents.begin(), child->mparents.end(), this) == 1;
+}
+
+ObjectImp *ObjectTypeCalcer::calcTransformChain(const KigDocument &doc) const
+{
+    if (!mtype->isTransform() || mparents.empty())
+        return nullptr;
+
+    // the links of the chain that end with us, from the last to the
+    // first one, and the object at its start.
+    std::vector<const ObjectTypeCalcer *> links(1, this);
+    for (;;) {
+        const ObjectTypeCalcer *p = dynamic_cast<const ObjectTypeCalcer *>(links.back()->mparents[0]);
+        if (!p || !p->mfoldeddoc)
+            break;
+        links.push_back(p);
+    }
+    if (links.size() == 1)
+        return nullptr;
+    const ObjectImp *start = links.back()->mparents[0]->imp();
+
+    // like in ObjectHierarchy::calc, only homotheties are composed,
+    // since they don't change the type of the objects they're applied
+    // to.  That also makes the object at the start of the chain a
+    // valid stand-in for the objects that the links transform.  If a
+    // link is not a homothety, we give up, and let imp() calculate our
+    // parent after all..
+    Transformation t = Transformation::identity();
+    for (std::vector<const ObjectTypeCalcer *>::const_reverse_iterator i = links.rbegin(); i != links.rend(); ++i) {
+        Args a;
+        a.reserve((*i)->mparents.size());
+        a.push_back(start);
+        std::transform((*i)->mparents.begin() + 1, (*i)->mparents.end(), std::back_inserter(a), std::mem_fn(&ObjectCalcer::imp));
+        Transformation link = Transformation::identity();
+        if (!(*i)->mtype->transformation(a, doc, link) || !link.isHomothetic())
+            return nullptr;
+        t = link * t;
+    }
+    return start->transform(t);
 }
 
 ObjectTypeCalcer::ObjectTypeCalcer(const ObjectType *type, const std::vector<ObjectCalcer *> &parents, bool sort)
     : mparents((sort) ? type->sortArgs(parents) : parents)
     , mtype(type)
     , mimp(nullptr)
+    , mfoldeddoc(nullptr)
 {
     std::for_each(mparents.begin(), mparents.end(), [this](ObjectCalcer* parent) {
         parent->addChild(this);
@@ -88,6 +167,8 @@ void intrusive_ptr_release(ObjectCalcer *p)
 
 const ObjectImp *ObjectTypeCalcer::imp() const
 {
+    if (mfoldeddoc)
+        const_cast<ObjectTypeCalcer *>(this)->calcImp(*mfoldeddoc);
     return mimp;
 }
 
@@ -180,6 +261,7 @@ void ObjectPropertyCalcer::calc(const KigDocument &doc)
         n = new InvalidImp;
     delete mimp;
     mimp = n;
+    doc.objectsChanged();
 }
 
 ObjectImp *ObjectConstCalcer::switchImp(ObjectImp *newimp)
@@ -103,7 +103,8 @@ public:
     virtual const ObjectImp *imp() const = 0;
     /**
      * Makes the ObjectCalcer recalculate its ObjectImp from its
-     * parents.
+     * parents.  When that gives it a new ObjectImp, it tells the
+     * document, see KigDocument::objectsChanged().
      */
     virtual void calc(const KigDocument &) = 0;
 
@@ -171,6 +172,18 @@ class ObjectTypeCalcer : public ObjectCalcer
     std::vector<ObjectCalcer *> mparents;
     const ObjectType *mtype;
     ObjectImp *mimp;
+    // if this calcer is a link in a chain of transformations that its
+    // child evaluates as a whole, see foldsIntoChild(), calc() doesn't
+    // calculate mimp, but remembers the document here, so that imp()
+    // can calculate it if it's asked for it after all.
+    const KigDocument *mfoldeddoc;
+
+    void calcImp(const KigDocument &doc);
+    bool foldsIntoChild() const;
+    // the result of the chain of transformations that ends with this
+    // calcer, calculated as a single transformation, or 0 if this
+    // calcer isn't at the end of such a chain.
+    ObjectImp *calcTransformChain(const KigDocument &doc) const;
 
 public:
     typedef myboost::intrusive_ptr<ObjectTypeCalcer> shared_ptr;
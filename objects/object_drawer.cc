@@ -28,10 +28,10 @@ void ObjectDrawer::draw(const ObjectImp &imp, KigPainter &p, bool sel) const
     }
 }
 
-bool ObjectDrawer::contains(const ObjectImp &imp, const Coordinate &pt, const KigWidget &w, bool nv) const
+bool ObjectDrawer::contains(const ObjectImp &imp, const Coordinate &pt, const ScreenInfo &si, const KigDocument &doc, bool nv) const
 {
     bool shownornv = mshown || nv;
-    return shownornv && imp.contains(pt, mwidth, w);
+    return shownornv && imp.contains(pt, mwidth, si, doc);
 }
 
 bool ObjectDrawer::shown() const
@@ -156,9 +156,9 @@ ObjectDrawer::ObjectDrawer()
 {
 }
 
-bool ObjectDrawer::inRect(const ObjectImp &imp, const Rect &r, const KigWidget &w) const
+bool ObjectDrawer::inRect(const ObjectImp &imp, const Rect &r, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return mshown && imp.inRect(r, mwidth, w);
+    return mshown && imp.inRect(r, mwidth, si, doc);
 }
 
 Qt::PenStyle ObjectDrawer::styleFromString(const QString &style)
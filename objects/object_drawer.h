@@ -13,8 +13,9 @@
 class ObjectImp;
 class KigPainter;
 class Coordinate;
-class KigWidget;
+class KigDocument;
 class Rect;
+class ScreenInfo;
 
 /**
  * A class holding some information about how a certain object is
@@ -57,12 +58,12 @@ public:
      * dependent on whether it is shown ( when it will never contain
      * anything ), and on its width.
      */
-    bool contains(const ObjectImp &imp, const Coordinate &pt, const KigWidget &w, bool nv = false) const;
+    bool contains(const ObjectImp &imp, const Coordinate &pt, const ScreenInfo &si, const KigDocument &doc, bool nv = false) const;
     /**
      * returns whether the object \p imp is in the rectangle \p r . This is
      * dependent on whether it is shown and on its width.
      */
-    bool inRect(const ObjectImp &imp, const Rect &r, const KigWidget &w) const;
+    bool inRect(const ObjectImp &imp, const Rect &r, const ScreenInfo &si, const KigDocument &doc) const;
 
     /**
      * returns whether the object this ObjectDrawer is responsible for
@@ -17,7 +17,7 @@
 #include "text_type.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 #include "../misc/calcpaths.h"
 #include "../misc/coordinate.h"
 #include "../misc/object_hierarchy.h"
@@ -78,9 +78,9 @@ const ObjectFactory *ObjectFactory::instance()
     return &f;
 }
 
-ObjectTypeCalcer *ObjectFactory::sensiblePointCalcer(const Coordinate &c, const KigDocument &d, const KigWidget &w) const
+ObjectTypeCalcer *ObjectFactory::sensiblePointCalcer(const Coordinate &c, const KigDocument &d, const ScreenInfo &si) const
 {
-    std::vector<ObjectHolder *> os = d.whatAmIOn(c, w);
+    const std::vector<ObjectHolder *> os = d.whatAmIOn(c, si);
     if (os.size() == 2) {
         // we can calc intersection point *only* between two objects...
         std::vector<ObjectCalcer *> args;
@@ -237,15 +237,15 @@ ObjectTypeCalcer *ObjectFactory::sensiblePointCalcer(const Coordinate &c, const
         }
         // other cases will follow...
     }
-    for (std::vector<ObjectHolder *>::iterator i = os.begin(); i != os.end(); ++i)
+    for (std::vector<ObjectHolder *>::const_iterator i = os.begin(); i != os.end(); ++i)
         if ((*i)->imp()->inherits(CurveImp::stype()))
             return constrainedPointCalcer((*i)->calcer(), c, d);
     return fixedPointCalcer(c);
 }
 
-ObjectHolder *ObjectFactory::sensiblePoint(const Coordinate &c, const KigDocument &d, const KigWidget &w) const
+ObjectHolder *ObjectFactory::sensiblePoint(const Coordinate &c, const KigDocument &d, const ScreenInfo &si) const
 {
-    return new ObjectHolder(sensiblePointCalcer(c, d, w));
+    return new ObjectHolder(sensiblePointCalcer(c, d, si));
 }
 
 ObjectTypeCalcer *ObjectFactory::relativePointCalcer(ObjectCalcer *o, const Coordinate &loc) const
@@ -431,9 +431,17 @@ ObjectHolder *ObjectFactory::propertyObject(ObjectCalcer *o, const char *p) cons
     return new ObjectHolder(propertyObjectCalcer(o, p));
 }
 
-void ObjectFactory::redefinePoint(ObjectTypeCalcer *point, const Coordinate &c, KigDocument &doc, const KigWidget &w) const
+void ObjectFactory::redefinePoint(ObjectTypeCalcer *point, const Coordinate &c, KigDocument &doc, const ScreenInfo &si) const
+{
+    redefinePoint(point, c, doc, si, doc.whatAmIOn(c, si));
+}
+
+void ObjectFactory::redefinePoint(ObjectTypeCalcer *point,
+                                  const Coordinate &c,
+                                  KigDocument &doc,
+                                  const ScreenInfo &si,
+                                  const std::vector<ObjectHolder *> &hos) const
 {
-    std::vector<ObjectHolder *> hos = doc.whatAmIOn(c, w);
     std::vector<ObjectCalcer *> os;
     ObjectCalcer *(ObjectHolder::*calcmeth)() = &ObjectHolder::calcer;
     std::transform(hos.begin(), hos.end(), std::back_inserter(os), std::mem_fn(calcmeth));
@@ -450,7 +458,6 @@ void ObjectFactory::redefinePoint(ObjectTypeCalcer *point, const Coordinate &c,
     if (v) {
         // we want a constrained point...
         const CurveImp *curveimp = static_cast<const CurveImp *>(v->imp());
-        double newparam = curveimp->getParam(c, doc);
 
         if (point->type()->inherits(ObjectType::ID_ConstrainedPointType)) {
             // point already was constrained -> simply update the param
@@ -461,6 +468,14 @@ void ObjectFactory::redefinePoint(ObjectTypeCalcer *point, const Coordinate &c,
             assert(parents[0]->imp()->inherits(DoubleImp::stype()));
             dataobj = parents[0];
 
+            // if it stays on the same curve, c is probably near where it
+            // was, so we start looking there..
+            double newparam;
+            if (parents[1] == v)
+                newparam = curveimp->getParamNear(c, static_cast<const DoubleImp *>(dataobj->imp())->data(), si.normalMiss(-1), doc);
+            else
+                newparam = curveimp->getParam(c, doc);
+
             parents.clear();
             parents.push_back(dataobj);
             parents.push_back(v);
@@ -470,6 +485,7 @@ void ObjectFactory::redefinePoint(ObjectTypeCalcer *point, const Coordinate &c,
             static_cast<ObjectConstCalcer *>(dataobj)->setImp(new DoubleImp(newparam));
         } else {
             // point used to be fixed -> add a new DataObject etc.
+            double newparam = curveimp->getParam(c, doc);
             std::vector<ObjectCalcer *> args;
             args.push_back(new ObjectConstCalcer(new DoubleImp(newparam)));
             args.push_back(v);
@@ -64,13 +64,21 @@ public:
      * sometime. Note that the returned object is not added to
      * the document.
      */
-    ObjectTypeCalcer *sensiblePointCalcer(const Coordinate &c, const KigDocument &d, const KigWidget &w) const;
-    ObjectHolder *sensiblePoint(const Coordinate &c, const KigDocument &d, const KigWidget &w) const;
+    ObjectTypeCalcer *sensiblePointCalcer(const Coordinate &c, const KigDocument &d, const ScreenInfo &si) const;
+    ObjectHolder *sensiblePoint(const Coordinate &c, const KigDocument &d, const ScreenInfo &si) const;
 
     /**
-     * set point to what sensiblePoint would have returned.
+     * set point to what sensiblePoint would have returned.  If point
+     * is already attached to the curve it is attached to now, it is
+     * searched for near where it was, which is a lot cheaper for loci
+     * and bezier curves, while the point is dragged over them.
      */
-    void redefinePoint(ObjectTypeCalcer *point, const Coordinate &c, KigDocument &d, const KigWidget &w) const;
+    void redefinePoint(ObjectTypeCalcer *point, const Coordinate &c, KigDocument &d, const ScreenInfo &si) const;
+    /**
+     * the same, with \p hits what KigDocument::whatAmIOn() returns for
+     * \p c .
+     */
+    void redefinePoint(ObjectTypeCalcer *point, const Coordinate &c, KigDocument &d, const ScreenInfo &si, const std::vector<ObjectHolder *> &hits) const;
 
     /**
      * return a locus, defined by the two points ( one constrained, and
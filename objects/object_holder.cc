@@ -14,6 +14,8 @@ ObjectHolder::ObjectHolder(ObjectCalcer *calcer)
     : mcalcer(calcer)
     , mdrawer(new ObjectDrawer)
     , mnamecalcer(nullptr)
+    , mrectserial(0)
+    , mrect(Rect::invalidRect())
 {
 }
 
@@ -21,6 +23,8 @@ ObjectHolder::ObjectHolder(ObjectCalcer *calcer, ObjectDrawer *drawer, ObjectCon
     : mcalcer(calcer)
     , mdrawer(drawer)
     , mnamecalcer(namecalcer)
+    , mrectserial(0)
+    , mrect(Rect::invalidRect())
 {
     assert(!namecalcer || namecalcer->imp()->inherits(StringImp::stype()));
 }
@@ -29,6 +33,8 @@ ObjectHolder::ObjectHolder(ObjectCalcer *calcer, ObjectDrawer *drawer)
     : mcalcer(calcer)
     , mdrawer(drawer)
     , mnamecalcer(nullptr)
+    , mrectserial(0)
+    , mrect(Rect::invalidRect())
 {
 }
 
@@ -65,6 +71,7 @@ void ObjectHolder::setDrawer(ObjectDrawer *d)
 void ObjectHolder::calc(const KigDocument &d)
 {
     mcalcer->calc(d);
+    mrectserial = 0;
 }
 
 void ObjectHolder::draw(KigPainter &p, bool selected) const
@@ -72,14 +79,14 @@ void ObjectHolder::draw(KigPainter &p, bool selected) const
     mdrawer->draw(*imp(), p, selected);
 }
 
-bool ObjectHolder::contains(const Coordinate &pt, const KigWidget &w, bool nv) const
+bool ObjectHolder::contains(const Coordinate &pt, const ScreenInfo &si, const KigDocument &doc, bool nv) const
 {
-    return mdrawer->contains(*imp(), pt, w, nv);
+    return mdrawer->contains(*imp(), pt, si, doc, nv);
 }
 
-bool ObjectHolder::inRect(const Rect &r, const KigWidget &w) const
+bool ObjectHolder::inRect(const Rect &r, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return mdrawer->inRect(*imp(), r, w);
+    return mdrawer->inRect(*imp(), r, si, doc);
 }
 
 ObjectCalcer *ObjectHolder::calcer()
@@ -121,9 +128,23 @@ ObjectDrawer *ObjectHolder::switchDrawer(ObjectDrawer *d)
 {
     ObjectDrawer *tmp = mdrawer;
     mdrawer = d;
+    mrectserial = 0;
     return tmp;
 }
 
+const Rect ObjectHolder::surroundingRect() const
+{
+    const ObjectImp *i = imp();
+    if (i->serial() != mrectserial) {
+        mrect = i->surroundingRect();
+        // text labels only know their size once they've been drawn..
+        if (!mrect.valid())
+            return mrect;
+        mrectserial = i->serial();
+    }
+    return mrect;
+}
+
 bool ObjectHolder::shown() const
 {
     return mdrawer->shown();
@@ -6,6 +6,8 @@
 
 #include "object_calcer.h"
 
+#include "../misc/rect.h"
+
 #include <QString>
 
 /**
@@ -29,6 +31,9 @@ class ObjectHolder
     ObjectDrawer *mdrawer;
     ObjectConstCalcer::shared_ptr mnamecalcer;
 
+    mutable unsigned long mrectserial;
+    mutable Rect mrect;
+
 public:
     /**
      * Construct a new ObjectHolder with a given ObjectCalcer and
@@ -89,16 +94,23 @@ public:
     /**
      * Returns whether this object contains the point \p p .
      */
-    bool contains(const Coordinate &p, const KigWidget &w, bool nv = false) const;
+    bool contains(const Coordinate &p, const ScreenInfo &si, const KigDocument &doc, bool nv = false) const;
     /**
      * Returns whether this object is in the rectangle \p r .
      */
-    bool inRect(const Rect &r, const KigWidget &w) const;
+    bool inRect(const Rect &r, const ScreenInfo &si, const KigDocument &doc) const;
     /**
      * Returns whether this object is shown.
      */
     bool shown() const;
 
+    /**
+     * imp()->surroundingRect(), which is only computed again after
+     * calc(), a new drawer, or when imp() has changed otherwise, e.g.
+     * because the calcer was calculated directly.
+     */
+    const Rect surroundingRect() const;
+
     /**
      * This call is simply forwarded to the ObjectCalcer.  Check the
      * documentation of ObjectCalcer::moveReferencePoint() for more info.
@@ -9,16 +9,35 @@
 #include "../misc/coordinate.h"
 
 #include <KLazyLocalizedString>
+#include <QMutex>
+#include <atomic>
 #include <map>
 
 class ObjectImpType::StaticPrivate
 {
 public:
+    // the types are created the first time their stype() is called,
+    // which can be from the threads that draw tiles too
+    QMutex mutex;
     std::map<QByteArray, const ObjectImpType *> namemap;
 };
 
+// atomic, so that ObjectImp's can be created from other threads as well
+static std::atomic<unsigned long> lastserial(0);
+
 ObjectImp::ObjectImp()
+    : mserial(++lastserial)
+{
+}
+
+ObjectImp::ObjectImp(const ObjectImp &)
+    : mserial(++lastserial)
+{
+}
+
+unsigned long ObjectImp::serial() const
 {
+    return mserial;
 }
 
 ObjectImp::~ObjectImp()
@@ -61,6 +80,13 @@ ObjectImp *ObjectImp::property(int i, const KigDocument &) const
     return new InvalidImp;
 }
 
+const ObjectImpType *ObjectImp::propertyResultType(int which) const
+{
+    if (which == 0)
+        return StringImp::stype();
+    return InvalidImp::stype();
+}
+
 const ObjectImpType *ObjectImp::impRequirementForProperty(int) const
 {
     return ObjectImp::stype();
@@ -178,7 +204,7 @@ const char *ObjectImp::iconForProperty(int) const
 
 bool ObjectImp::canFillInNextEscape() const
 {
-    return false;
+    return type()->canFillInNextEscape();
 }
 
 ObjectImpType::ObjectImpType(const ObjectImpType *parent,
@@ -191,7 +217,8 @@ ObjectImpType::ObjectImpType(const ObjectImpType *parent,
                              const KLazyLocalizedString &moveastatement,
                              const KLazyLocalizedString &attachtothisstatement,
                              const KLazyLocalizedString &showastatement,
-                             const KLazyLocalizedString &hideastatement)
+                             const KLazyLocalizedString &hideastatement,
+                             bool canfillinnextescape)
     : mparent(parent)
     , minternalname(internalname)
     , mtranslatedname(translatedname)
@@ -203,7 +230,9 @@ ObjectImpType::ObjectImpType(const ObjectImpType *parent,
     , mattachtothisstatement(attachtothisstatement)
     , mshowastatement(showastatement)
     , mhideastatement(hideastatement)
+    , mcanfillinnextescape(canfillinnextescape)
 {
+    QMutexLocker locker(&sd()->mutex);
     sd()->namemap[minternalname] = this;
 }
 
@@ -260,6 +289,7 @@ QString ObjectImpType::moveAStatement() const
 const ObjectImpType *ObjectImpType::typeFromInternalName(const char *string)
 {
     QByteArray s(string);
+    QMutexLocker locker(&sd()->mutex);
     std::map<QByteArray, const ObjectImpType *>::iterator i = sd()->namemap.find(s);
     if (i == sd()->namemap.end())
         return nullptr;
@@ -314,15 +344,24 @@ QString ObjectImpType::hideAStatement() const
     return mhideastatement.toString();
 }
 
+bool ObjectImpType::canFillInNextEscape() const
+{
+    return mcanfillinnextescape || (mparent && mparent->canFillInNextEscape());
+}
+
 bool ObjectImp::isPropertyDefinedOnOrThroughThisImp(int) const
 {
     return false;
 }
 
 static QByteArrayList propertiesGlobalInternalNames;
+// the list grows as properties are looked up, possibly from several
+// threads at once in batch mode
+static QMutex propertiesGlobalInternalNamesMutex;
 
 int ObjectImp::getPropGid(const char *pname) const
 {
+    QMutexLocker locker(&propertiesGlobalInternalNamesMutex);
     int wp = propertiesGlobalInternalNames.indexOf(pname);
     if (wp >= 0)
         return wp;
@@ -339,6 +378,7 @@ int ObjectImp::getPropGid(const char *pname) const
 
 int ObjectImp::getPropLid(int propgid) const
 {
+    QMutexLocker locker(&propertiesGlobalInternalNamesMutex);
     assert(propgid >= 0 && propgid < propertiesGlobalInternalNames.size());
     int proplid = propertiesInternalNames().indexOf(propertiesGlobalInternalNames[propgid]);
     //  printf ("getPropLid: converting %d in %d\n", propgid, proplid);
@@ -347,6 +387,7 @@ int ObjectImp::getPropLid(int propgid) const
 
 const char *ObjectImp::getPropName(int propgid) const
 {
+    QMutexLocker locker(&propertiesGlobalInternalNamesMutex);
     assert(propgid >= 0 && propgid < propertiesGlobalInternalNames.size());
     return propertiesGlobalInternalNames[propgid];
 }
@@ -93,6 +93,7 @@ class ObjectImpType
     KLazyLocalizedString mattachtothisstatement;
     KLazyLocalizedString mshowastatement;
     KLazyLocalizedString mhideastatement;
+    bool mcanfillinnextescape;
     class StaticPrivate;
     static StaticPrivate *sd();
 
@@ -124,6 +125,9 @@ public:
      *     this segment"
      * @param showastatement is a translatable string like "Show a Segment"
      * @param hideastatement is a translatable string like "Hide a Segment"
+     * @param canfillinnextescape is whether the imps of this type can
+     *     fill in an escape in a label, see
+     *     ObjectImp::fillInNextEscape().  Subtypes inherit this.
      *
      * All translatable strings should have
      * I18N_NOOP around them!
@@ -138,7 +142,8 @@ public:
                            const KLazyLocalizedString &moveastatement,
                            const KLazyLocalizedString &attachtothisstatement,
                            const KLazyLocalizedString &showastatement,
-                           const KLazyLocalizedString &hideastatement);
+                           const KLazyLocalizedString &hideastatement,
+                           bool canfillinnextescape = false);
     virtual ~ObjectImpType();
 
     /**
@@ -206,6 +211,13 @@ public:
      * E.g. "Hide a Segment".
      */
     QString hideAStatement() const;
+
+    /**
+     * Whether the imps of this type can fill in an escape in a label,
+     * see ObjectImp::fillInNextEscape().  This is known without an imp
+     * of the type, e.g. for the results of properties.
+     */
+    bool canFillInNextEscape() const;
 };
 
 /**
@@ -216,8 +228,11 @@ public:
  */
 class ObjectImp
 {
+    unsigned long mserial;
+
 protected:
     ObjectImp();
+    ObjectImp(const ObjectImp &);
 
 public:
     /**
@@ -270,6 +285,14 @@ public:
 
     virtual ~ObjectImp();
 
+    /**
+     * A number that is different for every ObjectImp created while Kig
+     * runs.  ObjectImp's never change, so something computed from an
+     * ObjectImp can be cached along with its serial, and stays correct
+     * for as long as the serial is the same.
+     */
+    unsigned long serial() const;
+
     /**
      * Returns true if this ObjectImp inherits the ObjectImp type
      * represented by t.
@@ -310,8 +333,12 @@ public:
     virtual ObjectImp *transform(const Transformation &t) const = 0;
 
     virtual void draw(KigPainter &p) const = 0;
-    virtual bool contains(const Coordinate &p, int width, const KigWidget &si) const = 0;
-    virtual bool inRect(const Rect &r, int width, const KigWidget &si) const = 0;
+    /**
+     * hit testing: \p si is the view this ObjectImp is shown in, and
+     * is used to turn \p width into a distance.
+     */
+    virtual bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const = 0;
+    virtual bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const = 0;
     virtual Rect surroundingRect() const = 0;
 
     /**
@@ -330,6 +357,11 @@ public:
     // only letters and dashes, no spaces..
     virtual const QByteArrayList propertiesInternalNames() const;
     virtual ObjectImp *property(int which, const KigDocument &d) const;
+    // The type of the imp that property( which ) returns, without
+    // calculating it.  Some properties can also turn out an InvalidImp,
+    // e.g. the area of a self-intersecting polygon, but never anything
+    // else.  The popup menus use this to decide what to offer..
+    virtual const ObjectImpType *propertyResultType(int which) const;
     // Sometimes we need to know which type an imp needs to be at least
     // in order to have the imp with number which.  Macro's need it
     // foremost.  This function answers that question..
@@ -371,11 +403,11 @@ public:
     // sees with the "value" of this imp ( using the QString::arg
     // functions ).  This is e.g. used by TextType to turn its variable
     // args into strings..
-    // if you implement this, then you should return true in
-    // canFillInEscape() ( standard implementation returns false ), and
-    // override fillInNextEscape() ( standard implementation does an
-    // assert( false ) )..
-    virtual bool canFillInNextEscape() const;
+    // if you implement this, then you should pass true as
+    // canfillinnextescape to the constructor of your ObjectImpType (
+    // the default is false ), and override fillInNextEscape() (
+    // standard implementation does an assert( false ) )..
+    bool canFillInNextEscape() const;
     virtual void fillInNextEscape(QString &s, const KigDocument &) const;
 
     /**
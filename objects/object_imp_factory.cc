@@ -15,6 +15,7 @@
 #include "point_imp.h"
 #include "text_imp.h"
 
+#include "../misc/binary_stream.h"
 #include "../misc/coordinate.h"
 
 #include <qdom.h>
@@ -440,3 +441,244 @@ ObjectImp *ObjectImpFactory::deserialize(const QString &type, const QDomElement
         type);
     return nullptr;
 }
+
+// the tags that the binary format writes in front of the data of an
+// ObjectImp.  Never change or reuse the values of these, they are in
+// the files people saved: add new ones at the end.
+enum BinaryImpTag {
+    IntTag = 1,
+    DoubleTag,
+    StringTag,
+    HierarchyTag,
+    TransformationTag,
+    LineTag,
+    SegmentTag,
+    RayTag,
+    PointTag,
+    AngleTag,
+    ArcTag,
+    VectorTag,
+    CircleTag,
+    ConicTag,
+    CubicTag,
+    TextTag,
+    LocusTag
+};
+
+bool ObjectImpFactory::serialize(const ObjectImp &d, KigBinaryWriter &w) const
+{
+    if (d.inherits(IntImp::stype())) {
+        w.writeUInt8(IntTag);
+        w.writeInt32(static_cast<const IntImp &>(d).data());
+    } else if (d.inherits(DoubleImp::stype())) {
+        w.writeUInt8(DoubleTag);
+        w.writeDouble(static_cast<const DoubleImp &>(d).data());
+    } else if (d.inherits(StringImp::stype())) {
+        w.writeUInt8(StringTag);
+        w.writeString(static_cast<const StringImp &>(d).data().toUtf8());
+    } else if (d.inherits(HierarchyImp::stype())) {
+        // only the hierarchies of loci end up here, and there are few
+        // of them, so we don't bother with a binary format for them..
+        QDomDocument doc;
+        QDomElement e = doc.createElement(QStringLiteral("hierarchy"));
+        static_cast<const HierarchyImp &>(d).data().serialize(e, doc);
+        doc.appendChild(e);
+        w.writeUInt8(HierarchyTag);
+        w.writeString(doc.toByteArray());
+    } else if (d.inherits(TransformationImp::stype())) {
+        const Transformation &trans = static_cast<const TransformationImp &>(d).data();
+        w.writeUInt8(TransformationTag);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                w.writeDouble(trans.data(i, j));
+        w.writeUInt8(trans.isHomothetic());
+    } else if (d.inherits(AbstractLineImp::stype())) {
+        LineData l = static_cast<const AbstractLineImp &>(d).data();
+        if (d.inherits(SegmentImp::stype()))
+            w.writeUInt8(SegmentTag);
+        else if (d.inherits(RayImp::stype()))
+            w.writeUInt8(RayTag);
+        else
+            w.writeUInt8(LineTag);
+        w.writeCoordinate(l.a);
+        w.writeCoordinate(l.b);
+    } else if (d.inherits(PointImp::stype())) {
+        w.writeUInt8(PointTag);
+        w.writeCoordinate(static_cast<const PointImp &>(d).coordinate());
+    } else if (d.inherits(TextImp::stype())) {
+        // new documents never have these as data, but files of old Kig
+        // versions and some of the import filters do
+        const TextImp &t = static_cast<const TextImp &>(d);
+        w.writeUInt8(TextTag);
+        w.writeString(t.text().toUtf8());
+        w.writeCoordinate(t.coordinate());
+        w.writeUInt8(t.hasFrame());
+    } else if (d.inherits(AngleImp::stype())) {
+        w.writeUInt8(AngleTag);
+        w.writeDouble(static_cast<const AngleImp &>(d).size());
+    } else if (d.inherits(ArcImp::stype())) {
+        const ArcImp &a = static_cast<const ArcImp &>(d);
+        w.writeUInt8(ArcTag);
+        w.writeCoordinate(a.center());
+        w.writeDouble(a.radius());
+        w.writeDouble(a.startAngle());
+        w.writeDouble(a.angle());
+    } else if (d.inherits(VectorImp::stype())) {
+        w.writeUInt8(VectorTag);
+        w.writeCoordinate(static_cast<const VectorImp &>(d).dir());
+    } else if (d.inherits(LocusImp::stype())) {
+        const LocusImp &locus = static_cast<const LocusImp &>(d);
+        w.writeUInt8(LocusTag);
+        if (!serialize(*locus.curve(), w))
+            return false;
+        QDomDocument doc;
+        QDomElement e = doc.createElement(QStringLiteral("hierarchy"));
+        locus.hierarchy().serialize(e, doc);
+        doc.appendChild(e);
+        w.writeString(doc.toByteArray());
+    } else if (d.inherits(CircleImp::stype())) {
+        const CircleImp &c = static_cast<const CircleImp &>(d);
+        w.writeUInt8(CircleTag);
+        w.writeCoordinate(c.center());
+        w.writeDouble(c.radius());
+    } else if (d.inherits(ConicImp::stype())) {
+        const ConicPolarData data = static_cast<const ConicImp &>(d).polarData();
+        w.writeUInt8(ConicTag);
+        w.writeCoordinate(data.focus1);
+        w.writeDouble(data.pdimen);
+        w.writeDouble(data.ecostheta0);
+        w.writeDouble(data.esintheta0);
+    } else if (d.inherits(CubicImp::stype())) {
+        const CubicCartesianData data = static_cast<const CubicImp &>(d).data();
+        w.writeUInt8(CubicTag);
+        for (int i = 0; i < 10; ++i)
+            w.writeDouble(data.coeffs[i]);
+    } else
+        return false;
+    return true;
+}
+
+ObjectImp *ObjectImpFactory::deserialize(KigBinaryReader &r, QString &error) const
+{
+    ObjectImp *ret = nullptr;
+    const quint8 tag = r.readUInt8();
+    switch (tag) {
+    case IntTag:
+        ret = new IntImp(r.readInt32());
+        break;
+    case DoubleTag:
+        ret = new DoubleImp(r.readDouble());
+        break;
+    case StringTag:
+        ret = new StringImp(QString::fromUtf8(r.readString()));
+        break;
+    case HierarchyTag: {
+        QDomDocument doc;
+        if (!r.ok() || !doc.setContent(r.readString()))
+            KIG_GENERIC_PARSE_ERROR;
+        ObjectHierarchy *hier = ObjectHierarchy::buildSafeObjectHierarchy(doc.documentElement(), error);
+        if (!hier)
+            return nullptr;
+        ret = new HierarchyImp(*hier);
+        delete hier;
+        break;
+    }
+    case TransformationTag: {
+        double data[3][3];
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                data[i][j] = r.readDouble();
+        const bool homothetic = r.readUInt8();
+        ret = new TransformationImp(Transformation(data, homothetic));
+        break;
+    }
+    case LineTag:
+    case SegmentTag:
+    case RayTag: {
+        const Coordinate a = r.readCoordinate();
+        const Coordinate b = r.readCoordinate();
+        if (tag == LineTag)
+            ret = new LineImp(a, b);
+        else if (tag == SegmentTag)
+            ret = new SegmentImp(a, b);
+        else
+            ret = new RayImp(a, b);
+        break;
+    }
+    case PointTag:
+        ret = new PointImp(r.readCoordinate());
+        break;
+    case TextTag: {
+        const QString text = QString::fromUtf8(r.readString());
+        const Coordinate loc = r.readCoordinate();
+        ret = new TextImp(text, loc, r.readUInt8());
+        break;
+    }
+    case AngleTag:
+        ret = new AngleImp(Coordinate(), 0, r.readDouble(), false);
+        break;
+    case ArcTag: {
+        const Coordinate center = r.readCoordinate();
+        const double radius = r.readDouble();
+        const double startangle = r.readDouble();
+        const double angle = r.readDouble();
+        ret = new ArcImp(center, radius, startangle, angle);
+        break;
+    }
+    case VectorTag:
+        ret = new VectorImp(Coordinate(), r.readCoordinate());
+        break;
+    case LocusTag: {
+        ObjectImp *curve = deserialize(r, error);
+        if (!curve)
+            return nullptr;
+        QDomDocument doc;
+        if (!curve->inherits(CurveImp::stype()) || !r.ok() || !doc.setContent(r.readString())) {
+            delete curve;
+            KIG_GENERIC_PARSE_ERROR;
+        }
+        ObjectHierarchy *hier = ObjectHierarchy::buildSafeObjectHierarchy(doc.documentElement(), error);
+        if (!hier) {
+            delete curve;
+            return nullptr;
+        }
+        ret = new LocusImp(static_cast<CurveImp *>(curve), *hier);
+        delete hier;
+        break;
+    }
+    case CircleTag: {
+        const Coordinate center = r.readCoordinate();
+        ret = new CircleImp(center, r.readDouble());
+        break;
+    }
+    case ConicTag: {
+        const Coordinate focus1 = r.readCoordinate();
+        const double pdimen = r.readDouble();
+        const double ecostheta0 = r.readDouble();
+        const double esintheta0 = r.readDouble();
+        ret = new ConicImpPolar(ConicPolarData(focus1, pdimen, ecostheta0, esintheta0));
+        break;
+    }
+    case CubicTag: {
+        double coeffs[10];
+        for (int i = 0; i < 10; ++i)
+            coeffs[i] = r.readDouble();
+        ret = new CubicImp(CubicCartesianData(coeffs));
+        break;
+    }
+    default:
+        if (r.ok()) {
+            error = i18n(
+                "This Kig file uses an object type "
+                "which this Kig version does not support."
+                "Perhaps you are using an older Kig version.");
+            return nullptr;
+        }
+    }
+
+    if (!r.ok()) {
+        delete ret;
+        KIG_GENERIC_PARSE_ERROR;
+    }
+    return ret;
+}
@@ -6,6 +6,9 @@
 
 #include "common.h"
 
+class KigBinaryReader;
+class KigBinaryWriter;
+
 class ObjectImpFactory
 {
     ObjectImpFactory();
@@ -22,4 +25,16 @@ public:
      * adds data to \p parent , and returns a type string.
      */
     QString serialize(const ObjectImp &d, QDomElement &parent, QDomDocument &doc) const;
+
+    /**
+     * reads a new ObjectImp from \p r , in the format that the other
+     * serialize() writes.
+     */
+    ObjectImp *deserialize(KigBinaryReader &r, QString &error) const;
+    /**
+     * writes \p d to \p w , in Kig's binary format: a tag for its type,
+     * followed by its data.  Returns false, leaving \p w in an undefined
+     * state, if the binary format has no way to write \p d .
+     */
+    bool serialize(const ObjectImp &d, KigBinaryWriter &w) const;
 };
@@ -12,6 +12,7 @@
 #include <QStringList>
 
 #include <iterator>
+#include <map>
 
 const char *ObjectType::fullName() const
 {
@@ -72,14 +73,41 @@ bool ObjectType::isTransform() const
     return false;
 }
 
+bool ObjectType::transformation(const Args &, const KigDocument &, Transformation &) const
+{
+    return false;
+}
+
+bool ObjectType::canKeepImp(const ObjectImp &, const ObjectImp &, bool) const
+{
+    return false;
+}
+
 QStringList ObjectType::specialActions() const
 {
     return QStringList();
 }
 
-void ObjectType::executeAction(int, ObjectHolder &, ObjectTypeCalcer &, KigPart &, KigWidget &, NormalMode &) const
+ObjectTypeActions::~ObjectTypeActions()
 {
-    assert(false);
+}
+
+static std::map<const ObjectType *, const ObjectTypeActions *> &typeActions()
+{
+    static std::map<const ObjectType *, const ObjectTypeActions *> actions;
+    return actions;
+}
+
+void ObjectType::setActions(const ObjectType *type, const ObjectTypeActions *actions)
+{
+    typeActions()[type] = actions;
+}
+
+void ObjectType::executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &m) const
+{
+    std::map<const ObjectType *, const ObjectTypeActions *>::const_iterator a = typeActions().find(this);
+    assert(a != typeActions().end());
+    a->second->executeAction(i, o, t, d, w, m);
 }
 
 const Coordinate ObjectType::moveReferencePoint(const ObjectTypeCalcer &) const
@@ -9,6 +9,24 @@
 
 class ObjectTypeCalcer;
 
+/**
+ * The special actions of an ObjectType need the GUI, which is not part
+ * of kigcore.  So kigpart registers an ObjectTypeActions for every type
+ * that has specialActions(), see ObjectType::setActions(), and
+ * ObjectType::executeAction() calls that.
+ */
+class ObjectTypeActions
+{
+public:
+    virtual ~ObjectTypeActions();
+
+    /**
+     * execute the \p i 'th action from the specialActions of the type
+     * of \p t .
+     */
+    virtual void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &m) const = 0;
+};
+
 /**
  * The ObjectType class is a thing that represents the "behaviour" for
  * a certain type.  This basically means that it decides what
@@ -73,6 +91,28 @@ public:
      */
     virtual bool isTransform() const;
 
+    /**
+     * Some transform types compute their result as
+     * parents[0]->transform( t ), where the transformation t only
+     * depends on the other parents.  Those types set \p t to that
+     * transformation and return true here.  This allows a chain of
+     * them to be evaluated as a single composed transformation, see
+     * ObjectHierarchy::calc and ObjectTypeCalcer::calc.  If the
+     * transformation can't be computed from \p parents, or if this
+     * type doesn't work this way, false is returned.
+     */
+    virtual bool transformation(const Args &parents, const KigDocument &d, Transformation &t) const;
+
+    /**
+     * ObjectTypeCalcer::calc() asks this before replacing its ObjectImp
+     * \p oldimp with the newly calculated \p newimp.  Returning true
+     * means nobody could tell the difference between the two, so the
+     * calcer keeps \p oldimp, and doesn't need to be drawn again.
+     * \p haschildren tells whether other calcers use the ObjectImp.
+     * The default returns false.
+     */
+    virtual bool canKeepImp(const ObjectImp &oldimp, const ObjectImp &newimp, bool haschildren) const;
+
     // ObjectType's can define some special actions, that are strictly
     // specific to the type at hand.  E.g. a text label allows to toggle
     // the display of a frame around the text.  Constrained and fixed
@@ -83,9 +123,15 @@ public:
      */
     virtual QStringList specialActions() const;
     /**
-     * execute the \p i 'th action from the specialActions above.
+     * execute the \p i 'th action from the specialActions above, with
+     * the ObjectTypeActions registered for this type.
+     */
+    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &m) const;
+    /**
+     * register \p actions as the special actions of \p type .  kigpart
+     * does this for all of its types, see object_type_actions.cc.
      */
-    virtual void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &m) const;
+    static void setActions(const ObjectType *type, const ObjectTypeActions *actions);
 };
 
 /**
@@ -0,0 +1,328 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// The special actions of the object types.  They need the KigPart and
+// the GUI, so they live here, in kigpart, and not with the rest of the
+// types in kigcore.
+
+#include "angle_type.h"
+#include "bogus_imp.h"
+#include "conic_types.h"
+#include "line_type.h"
+#include "object_calcer.h"
+#include "object_drawer.h"
+#include "object_holder.h"
+#include "other_imp.h"
+#include "point_imp.h"
+#include "point_type.h"
+#include "special_imptypes.h"
+#include "text_imp.h"
+#include "text_type.h"
+
+#include "../kig/kig_commands.h"
+#include "../kig/kig_document.h"
+#include "../kig/kig_part.h"
+#include "../kig/kig_view.h"
+#include "../misc/builtin_stuff.h"
+#include "../misc/calcpaths.h"
+#include "../misc/common.h"
+#include "../misc/coordinate_system.h"
+#include "../misc/goniometry.h"
+#include "../misc/kiginputdialog.h"
+#include "../modes/label.h"
+#include "../modes/moving.h"
+
+#include <cmath>
+
+#include <QApplication>
+#include <QClipboard>
+#include <QFontDialog>
+
+namespace
+{
+// the executeAction's of the types are not virtual, since kigcore
+// doesn't have them, so we call them through an ObjectTypeActions
+template<class Type>
+class TypeActions : public ObjectTypeActions
+{
+public:
+    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &m) const override
+    {
+        assert(t.type() == Type::instance());
+        Type::instance()->executeAction(i, o, t, d, w, m);
+    }
+};
+
+template<class Type>
+void registerActions()
+{
+    static const TypeActions<Type> actions;
+    ObjectType::setActions(Type::instance(), &actions);
+}
+}
+
+void setupObjectTypeActions()
+{
+    registerActions<AngleType>();
+    registerActions<SegmentABType>();
+    registerActions<ConicRadicalType>();
+    registerActions<FixedPointType>();
+    registerActions<ConstrainedPointType>();
+    registerActions<TextType>();
+    registerActions<NumericTextType>();
+}
+
+void AngleType::executeAction(int i, ObjectHolder &, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &) const
+{
+    if (i == 0) {
+        std::vector<ObjectCalcer *> parents = t.parents();
+
+        assert(margsparser.checkArgs(parents));
+
+        Coordinate a = static_cast<const PointImp *>(parents[0]->imp())->coordinate();
+        Coordinate b = static_cast<const PointImp *>(parents[1]->imp())->coordinate();
+        Coordinate c = static_cast<const PointImp *>(parents[2]->imp())->coordinate();
+
+        Coordinate lvect = a - b;
+        Coordinate rvect = c - b;
+
+        double startangle = atan2(lvect.y, lvect.x);
+        double endangle = atan2(rvect.y, rvect.x);
+        double anglelength = endangle - startangle;
+        if (anglelength < 0)
+            anglelength += 2 * M_PI;
+        if (startangle < 0)
+            startangle += 2 * M_PI;
+
+        Goniometry go(anglelength, Goniometry::Rad);
+        go.convertTo(Goniometry::Deg);
+
+        bool ok;
+        Goniometry newsize = KigInputDialog::getAngle(&w, &ok, go);
+        if (!ok)
+            return;
+        newsize.convertTo(Goniometry::Rad);
+
+        double newcangle = startangle + newsize.value();
+        Coordinate cdir(cos(newcangle), sin(newcangle));
+        Coordinate nc = b + cdir.normalize(rvect.length());
+
+        MonitorDataObjects mon(getAllParents(parents));
+        parents[2]->move(nc, d.document());
+        KigCommand *kc = new KigCommand(d, i18n("Resize Angle"));
+        mon.finish(kc);
+        d.history()->push(kc);
+    } else if (i == 1) {
+        AngleImp *angleImp = const_cast<AngleImp *>(dynamic_cast<const AngleImp *>(t.imp()));
+
+        angleImp->setMarkRightAngle(!angleImp->markRightAngle());
+        d.redrawScreen();
+    }
+}
+
+void SegmentABType::executeAction(int i, ObjectHolder &, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &) const
+{
+    assert(i == 0);
+    // pretend to use this var..
+    (void)i;
+
+    std::vector<ObjectCalcer *> parents = c.parents();
+    assert(margsparser.checkArgs(parents));
+
+    Coordinate a = static_cast<const PointImp *>(parents[0]->imp())->coordinate();
+    Coordinate b = static_cast<const PointImp *>(parents[1]->imp())->coordinate();
+
+    bool ok = true;
+    double length = getDoubleFromUser(i18n("Set Segment Length"), i18n("Choose the new length: "), (b - a).length(), &w, &ok, -2147483647, 2147483647, 3);
+    if (!ok)
+        return;
+
+    Coordinate nb = a + (b - a).normalize(length);
+
+    MonitorDataObjects mon(getAllParents(parents));
+    parents[1]->move(nb, d.document());
+    KigCommand *cd = new KigCommand(d, i18n("Resize Segment"));
+    mon.finish(cd);
+    d.history()->push(cd);
+}
+
+void ConicRadicalType::executeAction(int i, ObjectHolder &, ObjectTypeCalcer &t, KigPart &d, KigWidget &, NormalMode &) const
+{
+    assert(i == 0);
+    std::vector<ObjectCalcer *> parents = t.parents();
+    assert(dynamic_cast<ObjectConstCalcer *>(parents[3]));
+    ObjectConstCalcer *zeroindexo = static_cast<ObjectConstCalcer *>(parents[3]);
+    MonitorDataObjects mon(zeroindexo);
+    assert(zeroindexo->imp()->inherits(IntImp::stype()));
+    int oldzeroindex = static_cast<const IntImp *>(zeroindexo->imp())->data();
+    int newzeroindex = oldzeroindex % 3 + 1;
+    zeroindexo->setImp(new IntImp(newzeroindex));
+    KigCommand *kc = new KigCommand(d, i18n("Switch Conic Radical Lines"));
+    mon.finish(kc);
+    d.history()->push(kc);
+}
+
+static void redefinePoint(ObjectHolder *o, KigPart &d, KigWidget &w)
+{
+    PointRedefineMode pm(o, d, w);
+    d.runMode(&pm);
+}
+
+void FixedPointType::executeAction(int i, ObjectHolder &oh, ObjectTypeCalcer &o, KigPart &d, KigWidget &w, NormalMode &) const
+{
+    switch (i) {
+    case 0: {
+        bool ok = true;
+        assert(o.imp()->inherits(PointImp::stype()));
+        Coordinate oldc = static_cast<const PointImp *>(o.imp())->coordinate();
+        KigInputDialog::getCoordinate(i18n("Set Coordinate"),
+                                      i18n("Enter the new coordinate.") + QLatin1String("<br>")
+                                          + d.document().coordinateSystem().coordinateFormatNoticeMarkup(),
+                                      &w,
+                                      &ok,
+                                      d.document(),
+                                      &oldc);
+        if (!ok)
+            break;
+
+        MonitorDataObjects mon(getAllParents(&o));
+        o.move(oldc, d.document());
+        KigCommand *kc = new KigCommand(d, PointImp::stype()->moveAStatement());
+        mon.finish(kc);
+
+        d.history()->push(kc);
+        break;
+    };
+    case 1:
+        redefinePoint(&oh, d, w);
+        break;
+    default:
+        assert(false);
+    };
+}
+
+void ConstrainedPointType::executeAction(int i, ObjectHolder &oh, ObjectTypeCalcer &o, KigPart &d, KigWidget &w, NormalMode &) const
+{
+    switch (i) {
+    case 1:
+        redefinePoint(&oh, d, w);
+        break;
+    case 0: {
+        std::vector<ObjectCalcer *> parents = o.parents();
+        assert(dynamic_cast<ObjectConstCalcer *>(parents[0]) && parents[0]->imp()->inherits(DoubleImp::stype()));
+
+        ObjectConstCalcer *po = static_cast<ObjectConstCalcer *>(parents[0]);
+        double oldp = static_cast<const DoubleImp *>(po->imp())->data();
+
+        bool ok = true;
+        double newp = getDoubleFromUser(i18n("Set Point Parameter"), i18n("Choose the new parameter: "), oldp, &w, &ok, 0, 1, 4);
+        if (!ok)
+            return;
+
+        MonitorDataObjects mon(parents);
+        po->setImp(new DoubleImp(newp));
+        KigCommand *kc = new KigCommand(d, i18n("Change Parameter of Constrained Point"));
+        mon.finish(kc);
+        d.history()->push(kc);
+        break;
+    };
+    default:
+        assert(false);
+    };
+}
+
+void GenericTextType::executeAction(int i, ObjectHolder &oh, ObjectTypeCalcer &c, KigPart &doc, KigWidget &w, NormalMode &) const
+{
+    std::vector<ObjectCalcer *> parents = c.parents();
+    assert(parents.size() >= 3);
+
+    std::vector<ObjectCalcer *> firstthree(parents.begin(), parents.begin() + 3);
+
+    assert(mparser.checkArgs(firstthree));
+    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[0]));
+    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[2]));
+
+    if (i == 0) {
+        QClipboard *cb = QApplication::clipboard();
+
+        // copy the text into the clipboard
+        const TextImp *ti = static_cast<const TextImp *>(c.imp());
+        cb->setText(ti->text(), QClipboard::Clipboard);
+    } else if (i == 1) {
+        // toggle label frame
+        int n = (static_cast<const IntImp *>(firstthree[0]->imp())->data() + 1) % 2;
+        KigCommand *kc = new KigCommand(doc, i18n("Toggle Label Frame"));
+        kc->addTask(new ChangeObjectConstCalcerTask(static_cast<ObjectConstCalcer *>(firstthree[0]), new IntImp(n)));
+        doc.history()->push(kc);
+    } else if (i == 2) {
+        // change label font
+        QFont f = oh.drawer()->font();
+        bool result;
+        f = QFontDialog::getFont(&result, f, &w);
+        if (!result)
+            return;
+        KigCommand *kc = new KigCommand(doc, i18n("Change Label Font"));
+        kc->addTask(new ChangeObjectDrawerTask(&oh, oh.drawer()->getCopyFont(f)));
+        doc.history()->push(kc);
+    } else
+        assert(false);
+}
+
+void TextType::executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &doc, KigWidget &w, NormalMode &nm) const
+{
+    std::vector<ObjectCalcer *> parents = c.parents();
+    assert(parents.size() >= 3);
+
+    std::vector<ObjectCalcer *> firstthree(parents.begin(), parents.begin() + 3);
+
+    assert(argParser().checkArgs(firstthree));
+    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[0]));
+    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[2]));
+
+    const int parentactions = GenericTextType::specialActions().count();
+    if (i < parentactions)
+        GenericTextType::executeAction(i, o, c, doc, w, nm);
+    else if (i == parentactions) {
+        assert(dynamic_cast<ObjectTypeCalcer *>(o.calcer()));
+        // redefine..
+        TextLabelRedefineMode m(doc, static_cast<ObjectTypeCalcer *>(o.calcer()));
+        doc.runMode(&m);
+    } else
+        assert(false);
+}
+
+void NumericTextType::executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &doc, KigWidget &w, NormalMode &nm) const
+{
+    std::vector<ObjectCalcer *> parents = c.parents();
+    assert(parents.size() == 4);
+
+    std::vector<ObjectCalcer *> firstthree(parents.begin(), parents.begin() + 3);
+
+    assert(o.imp()->inherits(NumericTextImp::stype()));
+    assert(argParser().checkArgs(firstthree));
+    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[0]));
+    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[2]));
+
+    const int parentactions = GenericTextType::specialActions().count();
+    if (i < parentactions)
+        GenericTextType::executeAction(i, o, c, doc, w, nm);
+    else if (i == parentactions) {
+        bool ok;
+        ObjectConstCalcer *valuecalcer = dynamic_cast<ObjectConstCalcer *>(parents[3]);
+        assert(valuecalcer);
+        double oldvalue = static_cast<const NumericTextImp *>(o.imp())->getValue();
+        double value = getDoubleFromUser(i18n("Set Value"), i18n("Enter the new value:"), oldvalue, &w, &ok, -2147483647, 2147483647, 7);
+        if (!ok)
+            return;
+        MonitorDataObjects mon(parents);
+        valuecalcer->setImp(new DoubleImp(value));
+        KigCommand *kc = new KigCommand(doc, i18n("Change Displayed Value"));
+        mon.finish(kc);
+        doc.history()->push(kc);
+    } else
+        assert(false);
+}
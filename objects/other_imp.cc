@@ -11,7 +11,6 @@
 #include "line_imp.h"
 #include "point_imp.h"
 
-#include "../kig/kig_view.h"
 #include "../misc/common.h"
 #include "../misc/goniometry.h"
 #include "../misc/kigpainter.h"
@@ -51,24 +50,24 @@ AngleImp::AngleImp(const Coordinate &pt, double start_angle_in_radials, double a
 {
 }
 
-bool AngleImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool AngleImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    double radius = AngleImp::radius * w.screenInfo().pixelWidth();
+    double radius = AngleImp::radius * si.pixelWidth();
 
     if (mangle == M_PI / 2 && mmarkRightAngle) {
         // rotate around -mstartangle
         double fixedX = cos(mstartangle) * (p.x - mpoint.x) + sin(mstartangle) * (p.y - mpoint.y);
         double fixedY = -sin(mstartangle) * (p.x - mpoint.x) + cos(mstartangle) * (p.y - mpoint.y);
 
-        if (fabs(fixedX - radius * sin(M_PI / 4)) < w.screenInfo().normalMiss(width)) {
+        if (fabs(fixedX - radius * sin(M_PI / 4)) < si.normalMiss(width)) {
             return (fixedY <= radius * sin(M_PI / 4)) && (fixedY > 0);
-        } else if (fabs(fixedY - radius * sin(M_PI / 4)) < w.screenInfo().normalMiss(width)) {
+        } else if (fabs(fixedY - radius * sin(M_PI / 4)) < si.normalMiss(width)) {
             return (fixedX <= radius * sin(M_PI / 4)) && (fixedX > 0);
         }
 
         return false;
     } else {
-        if (fabs((p - mpoint).length() - radius) > w.screenInfo().normalMiss(width))
+        if (fabs((p - mpoint).length() - radius) > si.normalMiss(width))
             return false;
 
         Coordinate vect = p - mpoint;
@@ -79,10 +78,10 @@ bool AngleImp::contains(const Coordinate &p, int width, const KigWidget &w) cons
     }
 }
 
-bool AngleImp::inRect(const Rect &r, int width, const KigWidget &w) const
+bool AngleImp::inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &) const
 {
     // TODO ?
-    return r.contains(mpoint, w.screenInfo().normalMiss(width));
+    return r.contains(mpoint, si.normalMiss(width));
 }
 
 Coordinate AngleImp::attachPoint() const
@@ -157,6 +156,23 @@ ObjectImp *AngleImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *AngleImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return RayImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 double AngleImp::size() const
 {
     return mangle;
@@ -191,14 +207,14 @@ void VectorImp::draw(KigPainter &p) const
     p.drawVector(mdata.a, mdata.b);
 }
 
-bool VectorImp::contains(const Coordinate &o, int width, const KigWidget &w) const
+bool VectorImp::contains(const Coordinate &o, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    return internalContainsPoint(o, w.screenInfo().normalMiss(width));
+    return internalContainsPoint(o, si.normalMiss(width));
 }
 
-bool VectorImp::inRect(const Rect &r, int width, const KigWidget &w) const
+bool VectorImp::inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return lineInRect(r, mdata.a, mdata.b, width, this, w);
+    return lineInRect(r, mdata.a, mdata.b, width, this, si, doc);
 }
 
 int VectorImp::numberOfProperties() const
@@ -276,6 +292,27 @@ ObjectImp *VectorImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *VectorImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return VectorImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 VectorImp *VectorImp::copy() const
 {
     return new VectorImp(mdata.a, mdata.b);
@@ -364,12 +401,12 @@ void ArcImp::draw(KigPainter &p) const
     p.drawArc(mcenter, fabs(mradius), msa, ma);
 }
 
-bool ArcImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool ArcImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    return internalContainsPoint(p, w.screenInfo().normalMiss(width));
+    return internalContainsPoint(p, si.normalMiss(width));
 }
 
-bool ArcImp::inRect(const Rect &, int, const KigWidget &) const
+bool ArcImp::inRect(const Rect &, int, const ScreenInfo &, const KigDocument &) const
 {
     // TODO
     return false;
@@ -478,6 +515,37 @@ ObjectImp *ArcImp::property(int which, const KigDocument &d) const
     return new InvalidImp;
 }
 
+const ObjectImpType *ArcImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return AngleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return CircleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 double ArcImp::sectorSurface() const
 {
     return mradius * mradius * ma / 2;
@@ -6,11 +6,9 @@
 
 #include "bogus_imp.h"
 #include "locus_imp.h"
+#include "object_calcer.h"
 #include "point_imp.h"
 
-#include "../kig/kig_commands.h"
-#include "../kig/kig_part.h"
-#include "../kig/kig_view.h"
 #include "../misc/calcpaths.h"
 #include "../misc/common.h"
 #include "../misc/goniometry.h"
@@ -5,7 +5,7 @@
 #include "point_imp.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 #include "../misc/coordinate_system.h"
 #include "../misc/kigpainter.h"
 #include "../misc/kigtransform.h"
@@ -29,15 +29,15 @@ void PointImp::draw(KigPainter &p) const
     p.drawFatPoint(mc);
 }
 
-bool PointImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool PointImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &) const
 {
     int twidth = width == -1 ? 5 : width;
-    return (p - mc).length() - twidth * w.screenInfo().pixelWidth() < 0;
+    return (p - mc).length() - twidth * si.pixelWidth() < 0;
 }
 
-bool PointImp::inRect(const Rect &r, int width, const KigWidget &w) const
+bool PointImp::inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &) const
 {
-    double am = w.screenInfo().normalMiss(width);
+    double am = si.normalMiss(width);
     return r.contains(mc, am);
 }
 
@@ -103,6 +103,23 @@ ObjectImp *PointImp::property(int which, const KigDocument &d) const
     return new InvalidImp;
 }
 
+const ObjectImpType *PointImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 PointImp::~PointImp()
 {
 }
@@ -141,11 +158,6 @@ bool PointImp::equals(const ObjectImp &rhs) const
     return rhs.inherits(PointImp::stype()) && static_cast<const PointImp &>(rhs).coordinate() == coordinate();
 }
 
-bool PointImp::canFillInNextEscape() const
-{
-    return true;
-}
-
 const ObjectImpType *PointImp::stype()
 {
     static const ObjectImpType t(Parent::stype(),
@@ -158,7 +170,8 @@ const ObjectImpType *PointImp::stype()
                                  kli18n("Move a Point"),
                                  kli18n("Attach to this point"),
                                  kli18n("Show a Point"),
-                                 kli18n("Hide a Point"));
+                                 kli18n("Hide a Point"),
+                                 true);
     return &t;
 }
 
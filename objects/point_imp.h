@@ -43,13 +43,14 @@ public:
     void setCoordinate(const Coordinate &c);
 
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
-    bool inRect(const Rect &r, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
+    bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const override;
 
     int numberOfProperties() const override;
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &d) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -62,7 +63,6 @@ public:
     void visit(ObjectImpVisitor *vtor) const override;
 
     void fillInNextEscape(QString &s, const KigDocument &) const override;
-    bool canFillInNextEscape() const override;
 
     bool equals(const ObjectImp &rhs) const override;
 };
@@ -9,19 +9,15 @@
 #include "bogus_imp.h"
 #include "curve_imp.h"
 #include "line_imp.h"
+#include "object_calcer.h"
 #include "other_imp.h"
 #include "point_imp.h"
 #include "special_imptypes.h"
 
-#include "../kig/kig_commands.h"
 #include "../kig/kig_document.h"
-#include "../kig/kig_part.h"
-#include "../kig/kig_view.h"
 #include "../misc/calcpaths.h"
 #include "../misc/common.h"
 #include "../misc/coordinate_system.h"
-#include "../misc/kiginputdialog.h"
-#include "../modes/moving.h"
 
 static const ArgsParser::spec argsspecFixedPoint[] = {{DoubleImp::stype(), "x", {}, false},
                                                       {DoubleImp::stype(), "y", {}, false}};
@@ -396,75 +392,6 @@ QStringList ConstrainedPointType::specialActions() const
     return ret;
 }
 
-static void redefinePoint(ObjectHolder *o, KigPart &d, KigWidget &w)
-{
-    PointRedefineMode pm(o, d, w);
-    d.runMode(&pm);
-}
-
-void FixedPointType::executeAction(int i, ObjectHolder &oh, ObjectTypeCalcer &o, KigPart &d, KigWidget &w, NormalMode &) const
-{
-    switch (i) {
-    case 0: {
-        bool ok = true;
-        assert(o.imp()->inherits(PointImp::stype()));
-        Coordinate oldc = static_cast<const PointImp *>(o.imp())->coordinate();
-        KigInputDialog::getCoordinate(i18n("Set Coordinate"),
-                                      i18n("Enter the new coordinate.") + QLatin1String("<br>")
-                                          + d.document().coordinateSystem().coordinateFormatNoticeMarkup(),
-                                      &w,
-                                      &ok,
-                                      d.document(),
-                                      &oldc);
-        if (!ok)
-            break;
-
-        MonitorDataObjects mon(getAllParents(&o));
-        o.move(oldc, d.document());
-        KigCommand *kc = new KigCommand(d, PointImp::stype()->moveAStatement());
-        mon.finish(kc);
-
-        d.history()->push(kc);
-        break;
-    };
-    case 1:
-        redefinePoint(&oh, d, w);
-        break;
-    default:
-        assert(false);
-    };
-}
-
-void ConstrainedPointType::executeAction(int i, ObjectHolder &oh, ObjectTypeCalcer &o, KigPart &d, KigWidget &w, NormalMode &) const
-{
-    switch (i) {
-    case 1:
-        redefinePoint(&oh, d, w);
-        break;
-    case 0: {
-        std::vector<ObjectCalcer *> parents = o.parents();
-        assert(dynamic_cast<ObjectConstCalcer *>(parents[0]) && parents[0]->imp()->inherits(DoubleImp::stype()));
-
-        ObjectConstCalcer *po = static_cast<ObjectConstCalcer *>(parents[0]);
-        double oldp = static_cast<const DoubleImp *>(po->imp())->data();
-
-        bool ok = true;
-        double newp = getDoubleFromUser(i18n("Set Point Parameter"), i18n("Choose the new parameter: "), oldp, &w, &ok, 0, 1, 4);
-        if (!ok)
-            return;
-
-        MonitorDataObjects mon(parents);
-        po->setImp(new DoubleImp(newp));
-        KigCommand *kc = new KigCommand(d, i18n("Change Parameter of Constrained Point"));
-        mon.finish(kc);
-        d.history()->push(kc);
-        break;
-    };
-    default:
-        assert(false);
-    };
-}
-
 const Coordinate FixedPointType::moveReferencePoint(const ObjectTypeCalcer &ourobj) const
 {
     assert(ourobj.imp()->inherits(PointImp::stype()));
@@ -29,7 +29,7 @@ public:
     const ObjectImpType *resultId() const override;
 
     QStringList specialActions() const override;
-    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &m) const override;
+    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &t, KigPart &d, KigWidget &w, NormalMode &m) const;
 };
 
 class RelativePointType : public ArgsParserObjectType
@@ -112,7 +112,7 @@ public:
     const ObjectImpType *resultId() const override;
 
     QStringList specialActions() const override;
-    void executeAction(int i, ObjectHolder &, ObjectTypeCalcer &o, KigPart &d, KigWidget &w, NormalMode &m) const override;
+    void executeAction(int i, ObjectHolder &, ObjectTypeCalcer &o, KigPart &d, KigWidget &w, NormalMode &m) const;
 };
 
 class MidPointType : public ObjectABType
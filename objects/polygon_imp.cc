@@ -24,20 +24,29 @@
 #include "../misc/coordinate.h"
 #include "../misc/kigpainter.h"
 #include "../misc/kigtransform.h"
+#include "../misc/polygon_edge_index.h"
 
 #include "../kig/kig_document.h"
-#include "../kig/kig_view.h"
+#include "../misc/screeninfo.h"
 
 #include <cmath>
 
+// below this number of vertices, walking all the sides is cheaper
+// than building and querying a PolygonEdgeIndex.
+static const uint edgeIndexThreshold = 32;
+
 AbstractPolygonImp::AbstractPolygonImp(const uint npoints, const std::vector<Coordinate> &points, const Coordinate &centerofmass)
     : mnpoints(npoints)
     , mpoints(points)
+    , mbuffer(points)
     , mcenterofmass(centerofmass)
+    , mwindingnumber(0)
 {
 }
 
 AbstractPolygonImp::AbstractPolygonImp(const std::vector<Coordinate> &points)
+    : mbuffer(points)
+    , mwindingnumber(0)
 {
     uint npoints = points.size();
     Coordinate centerofmassn = Coordinate(0, 0);
@@ -54,6 +63,16 @@ AbstractPolygonImp::~AbstractPolygonImp()
 {
 }
 
+const PolygonEdgeIndex *AbstractPolygonImp::edgeIndex() const
+{
+    if (mpoints.size() < edgeIndexThreshold)
+        return nullptr;
+    std::call_once(medgeindexonce, [this]() {
+        medgeindex.reset(new PolygonEdgeIndex(mpoints));
+    });
+    return medgeindex.get();
+}
+
 Coordinate AbstractPolygonImp::attachPoint() const
 {
     return mcenterofmass;
@@ -90,11 +109,10 @@ std::vector<Coordinate> AbstractPolygonImp::ptransform(const Transformation &t)
         if (maxp > 0 && minp < 0)
             return np;
     }
-    for (uint i = 0; i < mpoints.size(); ++i) {
-        Coordinate nc = t.apply(mpoints[i]);
-        if (!nc.valid())
-            return np;
-        np.push_back(nc);
+    np = t.apply(mpoints);
+    for (uint i = 0; i < np.size(); ++i) {
+        if (!np[i].valid())
+            return std::vector<Coordinate>();
     }
     return np;
 }
@@ -125,6 +143,11 @@ ObjectImp *OpenPolygonalImp::transform(const Transformation &t) const
 
 bool AbstractPolygonImp::isInPolygon(const Coordinate &p) const
 {
+    // large polygons only look at the sides near p, using the same
+    // test as below.
+    if (const PolygonEdgeIndex *index = edgeIndex())
+        return index->contains(p);
+
     // (algorithm sent to me by domi)
     // We intersect with the horizontal ray from point to the right and
     // count the number of intersections.  That, along with some
@@ -184,6 +207,16 @@ bool AbstractPolygonImp::isOnOPolygonBorder(const Coordinate &p, double dist, co
 {
     bool ret = false;
     uint reduceddim = mpoints.size() - 1;
+    if (const PolygonEdgeIndex *index = edgeIndex()) {
+        // only the sides passing near p can be within dist of it
+        std::vector<unsigned int> sides;
+        index->sidesInYRange(p.y - dist, p.y + dist, sides);
+        for (uint i : sides) {
+            if (i < reduceddim && isOnSegment(p, mpoints[i], mpoints[i + 1], dist))
+                return true;
+        }
+        return false;
+    }
     for (uint i = 0; i < reduceddim; ++i) {
         ret |= isOnSegment(p, mpoints[i], mpoints[i + 1], dist);
     }
@@ -191,17 +224,17 @@ bool AbstractPolygonImp::isOnOPolygonBorder(const Coordinate &p, double dist, co
     return ret;
 }
 
-bool AbstractPolygonImp::inRect(const Rect &r, int width, const KigWidget &w) const
+bool AbstractPolygonImp::inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
     bool ret = false;
     uint reduceddim = mpoints.size() - 1;
     for (uint i = 0; !ret && i < reduceddim; ++i) {
         SegmentImp s(mpoints[i], mpoints[i + 1]);
-        ret = lineInRect(r, mpoints[i], mpoints[i + 1], width, &s, w);
+        ret = lineInRect(r, mpoints[i], mpoints[i + 1], width, &s, si, doc);
     }
     if (!ret) {
         SegmentImp s(mpoints[reduceddim], mpoints[0]);
-        ret = lineInRect(r, mpoints[reduceddim], mpoints[0], width, &s, w);
+        ret = lineInRect(r, mpoints[reduceddim], mpoints[0], width, &s, si, doc);
     }
 
     return ret;
@@ -442,6 +475,12 @@ ObjectImp *AbstractPolygonImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *AbstractPolygonImp::propertyResultType(int which) const
+{
+    assert(which < AbstractPolygonImp::numberOfProperties());
+    return Parent::propertyResultType(which);
+}
+
 ObjectImp *FilledPolygonImp::property(int which, const KigDocument &w) const
 {
     assert(which < FilledPolygonImp::numberOfProperties());
@@ -474,6 +513,31 @@ ObjectImp *FilledPolygonImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *FilledPolygonImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return IntImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return ClosedPolygonalImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return OpenPolygonalImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return IntImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 ObjectImp *ClosedPolygonalImp::property(int which, const KigDocument &w) const
 {
     assert(which < ClosedPolygonalImp::numberOfProperties());
@@ -506,6 +570,31 @@ ObjectImp *ClosedPolygonalImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *ClosedPolygonalImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return IntImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return FilledPolygonImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return OpenPolygonalImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return PointImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return IntImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 ObjectImp *OpenPolygonalImp::property(int which, const KigDocument &w) const
 {
     assert(which < OpenPolygonalImp::numberOfProperties());
@@ -528,6 +617,27 @@ ObjectImp *OpenPolygonalImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *OpenPolygonalImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return IntImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return BezierImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return FilledPolygonImp::stype();
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return ClosedPolygonalImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 const std::vector<Coordinate> AbstractPolygonImp::points() const
 {
     return mpoints;
@@ -761,14 +871,10 @@ bool OpenPolygonalImp::isPropertyDefinedOnOrThroughThisImp(int which) const
 
 Rect AbstractPolygonImp::surroundingRect() const
 {
-    Rect r(0., 0., 0., 0.);
-    for (uint i = 0; i < mpoints.size(); ++i) {
-        r.setContains(mpoints[i]);
-    }
-    return r;
+    return mbuffer.boundingRect();
 }
 
-int AbstractPolygonImp::windingNumber() const
+static int polygonWindingNumber(const std::vector<Coordinate> &points)
 {
     /*
      * this is defined as the sum of the external angles while at
@@ -781,13 +887,13 @@ int AbstractPolygonImp::windingNumber() const
      */
 
     int winding = 0;
-    uint npoints = mpoints.size();
-    Coordinate prevside = mpoints[0] - mpoints[npoints - 1];
+    uint npoints = points.size();
+    Coordinate prevside = points[0] - points[npoints - 1];
     for (uint i = 0; i < npoints; ++i) {
         uint nexti = i + 1;
         if (nexti >= npoints)
             nexti = 0;
-        Coordinate side = mpoints[nexti] - mpoints[i];
+        Coordinate side = points[nexti] - points[i];
         double vecprod = side.x * prevside.y - side.y * prevside.x;
         int steeringdir = (vecprod > 0) ? 1 : -1;
         if (vecprod == 0.0 || side.y * prevside.y > 0) {
@@ -801,6 +907,14 @@ int AbstractPolygonImp::windingNumber() const
     return winding;
 }
 
+int AbstractPolygonImp::windingNumber() const
+{
+    std::call_once(mwindingnumberonce, [this]() {
+        mwindingnumber = polygonWindingNumber(mpoints);
+    });
+    return mwindingnumber;
+}
+
 bool AbstractPolygonImp::isTwisted() const
 {
     /*
@@ -900,10 +1014,10 @@ FilledPolygonImp::FilledPolygonImp(const std::vector<Coordinate> &points)
 
 void FilledPolygonImp::draw(KigPainter &p) const
 {
-    p.drawPolygon(mpoints);
+    p.drawPolygon(mbuffer);
 }
 
-bool FilledPolygonImp::contains(const Coordinate &p, int, const KigWidget &) const
+bool FilledPolygonImp::contains(const Coordinate &p, int, const ScreenInfo &, const KigDocument &) const
 {
     return isInPolygon(p);
 }
@@ -920,9 +1034,9 @@ void ClosedPolygonalImp::draw(KigPainter &p) const
     p.drawSegment(mpoints[mnpoints - 1], mpoints[0]);
 }
 
-bool ClosedPolygonalImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool ClosedPolygonalImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return isOnCPolygonBorder(p, w.screenInfo().normalMiss(width), w.document());
+    return isOnCPolygonBorder(p, si.normalMiss(width), doc);
 }
 
 OpenPolygonalImp::OpenPolygonalImp(const std::vector<Coordinate> &points)
@@ -936,9 +1050,9 @@ void OpenPolygonalImp::draw(KigPainter &p) const
         p.drawSegment(mpoints[i], mpoints[i + 1]);
 }
 
-bool OpenPolygonalImp::contains(const Coordinate &p, int width, const KigWidget &w) const
+bool OpenPolygonalImp::contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const
 {
-    return isOnOPolygonBorder(p, w.screenInfo().normalMiss(width), w.document());
+    return isOnOPolygonBorder(p, si.normalMiss(width), doc);
 }
 
 /*
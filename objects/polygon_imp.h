@@ -5,9 +5,14 @@
 #pragma once
 
 #include "../misc/coordinate.h"
+#include "../misc/coordinate_buffer.h"
 #include "object_imp.h"
+#include <memory>
+#include <mutex>
 #include <vector>
 
+class PolygonEdgeIndex;
+
 /**
  * An ObjectImp representing a polygon.
  */
@@ -16,9 +21,27 @@ class AbstractPolygonImp : public ObjectImp
 protected:
     uint mnpoints;
     std::vector<Coordinate> mpoints;
+    // the same points, for the bulk operations of drawing and of
+    // calculating the surrounding rect
+    CoordinateBuffer mbuffer;
     //  bool minside;   // true: filled polygon, false: polygon boundary
     //  bool mopen;     // true: polygonal curve (minside must be false)
     Coordinate mcenterofmass;
+    // built on first use, see edgeIndex().  Imps are shared by the
+    // threads that draw tiles, so they are built under a once_flag.
+    mutable std::unique_ptr<PolygonEdgeIndex> medgeindex;
+    mutable std::once_flag medgeindexonce;
+    mutable int mwindingnumber;
+    mutable std::once_flag mwindingnumberonce;
+
+    /**
+     * Returns an index over the sides of this polygon, used to answer
+     * point in polygon and hit tests without walking all the sides.
+     * Only polygons with many vertices get one, it returns null for
+     * the others.  Since an ObjectImp never changes, the index is built
+     * the first time it is needed and reused until the imp is deleted.
+     */
+    const PolygonEdgeIndex *edgeIndex() const;
 
 public:
     typedef ObjectImp Parent;
@@ -31,12 +54,16 @@ public:
     explicit AbstractPolygonImp(const std::vector<Coordinate> &points);
     AbstractPolygonImp(const uint nsides, const std::vector<Coordinate> &points, const Coordinate &centerofmass);
     ~AbstractPolygonImp();
+    // imps are copied with copy(), which builds a new one from the
+    // points, and the caches are not to be copied anyway
+    AbstractPolygonImp(const AbstractPolygonImp &) = delete;
+    AbstractPolygonImp &operator=(const AbstractPolygonImp &) = delete;
     //  PolygonImp* copy() const;
 
     Coordinate attachPoint() const override;
     std::vector<Coordinate> ptransform(const Transformation &) const;
 
-    bool inRect(const Rect &r, int width, const KigWidget &) const override;
+    bool inRect(const Rect &r, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     bool valid() const;
     Rect surroundingRect() const override;
 
@@ -44,6 +71,7 @@ public:
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -93,11 +121,12 @@ public:
     static const ObjectImpType *stype4();
     ObjectImp *transform(const Transformation &) const override;
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     int numberOfProperties() const override;
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -119,11 +148,12 @@ public:
     static const ObjectImpType *stype();
     ObjectImp *transform(const Transformation &) const override;
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     int numberOfProperties() const override;
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -145,11 +175,12 @@ public:
     static const ObjectImpType *stype();
     ObjectImp *transform(const Transformation &) const override;
     void draw(KigPainter &p) const override;
-    bool contains(const Coordinate &p, int width, const KigWidget &) const override;
+    bool contains(const Coordinate &p, int width, const ScreenInfo &si, const KigDocument &doc) const override;
     int numberOfProperties() const override;
     const QList<KLazyLocalizedString> properties() const override;
     const QByteArrayList propertiesInternalNames() const override;
     ObjectImp *property(int which, const KigDocument &w) const override;
+    const ObjectImpType *propertyResultType(int which) const override;
     const char *iconForProperty(int which) const override;
     const ObjectImpType *impRequirementForProperty(int which) const override;
     bool isPropertyDefinedOnOrThroughThisImp(int which) const override;
@@ -13,6 +13,7 @@
 #include "polygon_imp.h"
 
 #include "../misc/common.h"
+#include "../misc/polygon_clipping.h"
 
 #include <cmath>
 #include <vector>
@@ -665,8 +666,7 @@ const ObjectImpType *CPolygonalLineIntersectionType::resultId() const
  * t1 and t2 are the two values of the parameter that produce
  * the two endpoints (in case the return value is >= 2) of the
  * computed intersection segment: a + t*(b-a).
- * The "intersectionside" parameter (needed for the computation of
- * the polygon-polygon intersection) is a pointer to the vertex of the
+ * The "intersectionside" parameter is a pointer to the vertex of the
  * polygon preceding the second intersection (t2).
  *
  * this function is rather involved, mainly because of the special
@@ -771,16 +771,6 @@ int polygonlineintersection(const std::vector<Coordinate> &ppoints,
     return numintersections;
 }
 
-int polygonlineintersection(const std::vector<Coordinate> &ppoints,
-                            const Coordinate &a,
-                            const Coordinate &b,
-                            double &t1,
-                            double &t2,
-                            std::vector<Coordinate>::const_iterator &intersectionside)
-{
-    return polygonlineintersection(ppoints, a, b, true, true, true, false, t1, t2, intersectionside);
-}
-
 /* polygon-polygon intersection */
 
 static const ArgsParser::spec argsspecPolygonPolygonIntersection[] = {
@@ -807,119 +797,117 @@ const PolygonPolygonIntersectionType *PolygonPolygonIntersectionType::instance()
     return &t;
 }
 
+/*
+ * the polygon-polygon operations are done by PolygonClipping, which
+ * also copes with twisted polygons.
+ */
+
+static ObjectImp *polygonPolygonOperation(const Args &parents, PolygonClipping::Operation op)
+{
+    const std::vector<Coordinate> ppoints1 = static_cast<const FilledPolygonImp *>(parents[0])->points();
+    const std::vector<Coordinate> ppoints2 = static_cast<const FilledPolygonImp *>(parents[1])->points();
+
+    // a polygon has one boundary.  If the result has holes, or more
+    // than one component, no polygon can represent it.
+    const std::vector<std::vector<Coordinate>> result = PolygonClipping::compute(ppoints1, ppoints2, op);
+    if (result.size() != 1 || result[0].size() < 3)
+        return new InvalidImp;
+    return new FilledPolygonImp(result[0]);
+}
+
 ObjectImp *PolygonPolygonIntersectionType::calc(const Args &parents, const KigDocument &) const
 {
     if (!margsparser.checkArgs(parents))
         return new InvalidImp;
 
-    const FilledPolygonImp *polygon1 = static_cast<const FilledPolygonImp *>(parents[0]);
-    const std::vector<Coordinate> ppoints1 = polygon1->points();
-    const FilledPolygonImp *polygon2 = static_cast<const FilledPolygonImp *>(parents[1]);
-    const std::vector<Coordinate> ppoints2 = polygon2->points();
-    std::vector<Coordinate> ppointsint;
-    double t1, t2;
-    uint numintersections;
-    std::vector<Coordinate>::const_iterator ipoint, iprevpoint, iprevprevpoint, intersectionside, istartpoint;
-    Coordinate point;
-    const std::vector<Coordinate> *ppointsa, *ppointsb, *ppointsc, *ppointsstart;
-    ppointsa = &ppoints1;
-    ppointsb = &ppoints2;
-    int direction = 1;
-
-    if (polygon1->isTwisted() || polygon2->isTwisted())
+    return polygonPolygonOperation(parents, PolygonClipping::Intersection);
+}
+
+const ObjectImpType *PolygonPolygonIntersectionType::resultId() const
+{
+    return FilledPolygonImp::stype();
+}
+
+/* polygon-polygon union */
+
+static const ArgsParser::spec argsspecPolygonPolygonUnion[] = {
+    {FilledPolygonImp::stype(),
+     kli18n("Construct the union of this polygon with another polygon"),
+     kli18n("Select the first of the two polygons of which you want to construct the union..."),
+     false},
+    {FilledPolygonImp::stype(),
+     kli18n("Construct the union with this polygon"),
+     kli18n("Select the second of the two polygons of which you want to construct the union..."),
+     false}};
+
+KIG_INSTANTIATE_OBJECT_TYPE_INSTANCE(PolygonPolygonUnionType)
+
+PolygonPolygonUnionType::PolygonPolygonUnionType()
+    : ArgsParserObjectType("PolygonPolygonUnion", argsspecPolygonPolygonUnion, 2)
+{
+}
+
+PolygonPolygonUnionType::~PolygonPolygonUnionType()
+{
+}
+
+const PolygonPolygonUnionType *PolygonPolygonUnionType::instance()
+{
+    static const PolygonPolygonUnionType t;
+    return &t;
+}
+
+ObjectImp *PolygonPolygonUnionType::calc(const Args &parents, const KigDocument &) const
+{
+    if (!margsparser.checkArgs(parents))
         return new InvalidImp;
 
-    bool intersect = false;
+    return polygonPolygonOperation(parents, PolygonClipping::Union);
+}
 
-    for (int k = 0; k < 2; k++) {
-        iprevpoint = ppointsa->end();
-        --iprevpoint;
-        for (ipoint = ppointsa->begin(); ipoint != ppointsa->end(); ++ipoint) {
-            numintersections = polygonlineintersection(*ppointsb, *iprevpoint, *ipoint, t1, t2, intersectionside);
-            if (numintersections >= 2) {
-                intersect = true;
-                break;
-            }
-            iprevpoint = ipoint;
-        }
-        if (intersect)
-            break;
-        ppointsa = &ppoints2;
-        ppointsb = &ppoints1;
-    }
+const ObjectImpType *PolygonPolygonUnionType::resultId() const
+{
+    return FilledPolygonImp::stype();
+}
+
+/* polygon-polygon difference */
+
+static const ArgsParser::spec argsspecPolygonPolygonDifference[] = {
+    {FilledPolygonImp::stype(),
+     kli18n("Remove another polygon from this polygon"),
+     kli18n("Select the polygon from which you want to remove another polygon..."),
+     false},
+    {FilledPolygonImp::stype(),
+     kli18n("Remove this polygon from the other polygon"),
+     kli18n("Select the polygon you want to remove from the first one..."),
+     false}};
+
+KIG_INSTANTIATE_OBJECT_TYPE_INSTANCE(PolygonPolygonDifferenceType)
+
+PolygonPolygonDifferenceType::PolygonPolygonDifferenceType()
+    : ArgsParserObjectType("PolygonPolygonDifference", argsspecPolygonPolygonDifference, 2)
+{
+}
+
+PolygonPolygonDifferenceType::~PolygonPolygonDifferenceType()
+{
+}
 
-    if (!intersect)
+const PolygonPolygonDifferenceType *PolygonPolygonDifferenceType::instance()
+{
+    static const PolygonPolygonDifferenceType t;
+    return &t;
+}
+
+ObjectImp *PolygonPolygonDifferenceType::calc(const Args &parents, const KigDocument &) const
+{
+    if (!margsparser.checkArgs(parents))
         return new InvalidImp;
-    ppointsstart = ppointsa;
-    istartpoint = ipoint;
-    point = *iprevpoint + t1 * (*ipoint - *iprevpoint);
-    ppointsint.push_back(point);
-    point = *iprevpoint + t2 * (*ipoint - *iprevpoint);
-    ppointsint.push_back(point);
-
-    do {
-        if (t2 == 1.0) {
-            /*
-             * in this case I will continue cycling along the current polygon
-             */
-            iprevprevpoint = iprevpoint; /* we need this in the special case */
-            iprevpoint = ipoint;
-            if (direction < 0 && ipoint == ppointsa->begin())
-                ipoint = ppointsa->end();
-            ipoint += direction;
-            if (ipoint == ppointsa->end())
-                ipoint = ppointsa->begin();
-            numintersections = polygonlineintersection(*ppointsb, *iprevpoint, *ipoint, t1, t2, intersectionside);
-            if (numintersections < 2) {
-                /*
-                 * this is a special case. We are here e.g. if the two polygons have a
-                 * common vertex
-                 * We treat this case in a tricky way :-(
-                 * Still, if the two polygons have some common vertices the
-                 * result is sometimes unpredictable :-(
-                 */
-                point = 1e-10 * (*iprevprevpoint) + (1 - 1e-10) * (*iprevpoint);
-                numintersections = polygonlineintersection(*ppointsb, point, *ipoint, t1, t2, intersectionside);
-            } else {
-                if (t1 != 0.0)
-                    return new InvalidImp; /* can this happen? */
-                point = *iprevpoint + t2 * (*ipoint - *iprevpoint);
-                ppointsint.push_back(point);
-            }
-        } else {
-            /*
-             * in this case I must cycle along the other polygon
-             */
-            ppointsc = ppointsa;
-            ppointsa = ppointsb;
-            ppointsb = ppointsc;
-            ipoint = iprevpoint = intersectionside;
-            ipoint++;
-            if (ipoint == ppointsa->end())
-                ipoint = ppointsa->begin();
-            point = ppointsint.back();
-            direction = 1;
-            numintersections = polygonlineintersection(*ppointsb, point, *ipoint, t1, t2, intersectionside);
-            if (numintersections < 2 || t2 < 1e-12) {
-                direction = -1;
-                ipoint = iprevpoint;
-                numintersections = polygonlineintersection(*ppointsb, point, *ipoint, t1, t2, intersectionside);
-                if (numintersections < 2)
-                    return new InvalidImp;
-            }
-            point = point + t2 * (*ipoint - point);
-            ppointsint.push_back(point);
-        }
-    } while ((ppointsstart != ppointsa || istartpoint != ipoint) && ppointsint.size() < 1000);
 
-    if (ppointsint.size() < 2)
-        return new InvalidImp; /* should never happen */
-    ppointsint.pop_back();
-    ppointsint.pop_back();
-    return new FilledPolygonImp(ppointsint);
+    return polygonPolygonOperation(parents, PolygonClipping::Difference);
 }
 
-const ObjectImpType *PolygonPolygonIntersectionType::resultId() const
+const ObjectImpType *PolygonPolygonDifferenceType::resultId() const
 {
     return FilledPolygonImp::stype();
 }
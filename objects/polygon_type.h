@@ -101,13 +101,6 @@ public:
     const Coordinate moveReferencePoint(const ObjectTypeCalcer &o) const override;
 };
 
-int polygonlineintersection(const std::vector<Coordinate> &ppoints,
-                            const Coordinate &a,
-                            const Coordinate &b,
-                            double &t1,
-                            double &t2,
-                            std::vector<Coordinate>::const_iterator &intersectionside);
-
 int polygonlineintersection(const std::vector<Coordinate> &ppoints,
                             const Coordinate &a,
                             const Coordinate &b,
@@ -164,6 +157,35 @@ public:
     const ObjectImpType *resultId() const override;
 };
 
+/**
+ * Union of two polygons
+ */
+class PolygonPolygonUnionType : public ArgsParserObjectType
+{
+    PolygonPolygonUnionType();
+    ~PolygonPolygonUnionType();
+
+public:
+    static const PolygonPolygonUnionType *instance();
+    ObjectImp *calc(const Args &parents, const KigDocument &) const override;
+    const ObjectImpType *resultId() const override;
+};
+
+/**
+ * Difference of two polygons: the part of the first one which is not
+ * inside the second one
+ */
+class PolygonPolygonDifferenceType : public ArgsParserObjectType
+{
+    PolygonPolygonDifferenceType();
+    ~PolygonPolygonDifferenceType();
+
+public:
+    static const PolygonPolygonDifferenceType *instance();
+    ObjectImp *calc(const Args &parents, const KigDocument &) const override;
+    const ObjectImpType *resultId() const override;
+};
+
 class PolygonVertexType : public ArgsParserObjectType
 {
     PolygonVertexType();
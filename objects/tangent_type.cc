@@ -15,8 +15,6 @@
 #include "../misc/common.h"
 #include "../misc/conic-common.h"
 //#include "../misc/calcpaths.h"
-#include "../kig/kig_part.h"
-#include "../kig/kig_view.h"
 
 static const KLazyLocalizedString constructlinetangentpoint = {};
 static const KLazyLocalizedString selecttangent1 = kli18n("Select the curve...");
@@ -12,6 +12,7 @@ TextImp::TextImp(const QString &text, const Coordinate &loc, bool frame)
     , mloc(loc)
     , mframe(frame)
     , mboundrect(Rect::invalidRect())
+    , mlayout(text)
 {
 }
 
@@ -37,16 +38,16 @@ ObjectImp *TextImp::transform(const Transformation &t) const
 
 void TextImp::draw(KigPainter &p) const
 {
-    mboundrect = p.simpleBoundingRect(mloc, mtext);
-    p.drawTextFrame(mboundrect, mtext, mframe);
+    mboundrect = p.simpleBoundingRect(mloc, mlayout);
+    p.drawTextFrame(mboundrect, mlayout, mframe);
 }
 
-bool TextImp::contains(const Coordinate &p, int, const KigWidget &) const
+bool TextImp::contains(const Coordinate &p, int, const ScreenInfo &, const KigDocument &) const
 {
     return mboundrect.contains(p);
 }
 
-bool TextImp::inRect(const Rect &r, int, const KigWidget &) const
+bool TextImp::inRect(const Rect &r, int, const ScreenInfo &, const KigDocument &) const
 {
     return mboundrect.intersects(r);
 }
@@ -104,6 +105,19 @@ ObjectImp *TextImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *TextImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return StringImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 QString TextImp::text() const
 {
     return mtext;
@@ -250,6 +264,19 @@ ObjectImp *NumericTextImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *NumericTextImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 bool NumericTextImp::isPropertyDefinedOnOrThroughThisImp(int which) const
 {
     return Parent::isPropertyDefinedOnOrThroughThisImp(which);
@@ -344,6 +371,19 @@ ObjectImp *BoolTextImp::property(int which, const KigDocument &w) const
     return new InvalidImp;
 }
 
+const ObjectImpType *BoolTextImp::propertyResultType(int which) const
+{
+    int pnum = 0;
+
+    if (which < Parent::numberOfProperties())
+        return Parent::propertyResultType(which);
+    else if (which == Parent::numberOfProperties() + pnum++)
+        return DoubleImp::stype();
+    else
+        assert(false);
+    return InvalidImp::stype();
+}
+
 bool BoolTextImp::isPropertyDefinedOnOrThroughThisImp(int which) const
 {
     return Parent::isPropertyDefinedOnOrThroughThisImp(which);
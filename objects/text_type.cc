@@ -6,23 +6,18 @@
 
 #include "bogus_imp.h"
 #include "line_imp.h"
+#include "object_calcer.h"
 #include "object_drawer.h"
 #include "point_imp.h"
 #include "text_imp.h"
 
-#include "../kig/kig_commands.h"
-#include "../kig/kig_part.h"
-#include "../kig/kig_view.h"
 #include "../misc/coordinate_system.h"
-#include "../modes/label.h"
 
 #include <algorithm>
 #include <cmath>
 #include <iterator>
 
-#include <QApplication>
-#include <QClipboard>
-#include <QFontDialog>
+#include <QCache>
 #include <QStringList>
 
 static const ArgsParser::spec arggspeccs[] = {{IntImp::stype(), "UNUSED", {}, false},
@@ -56,6 +51,115 @@ const ObjectImpType *GenericTextType::impRequirement(const ObjectImp *o, const A
         return ObjectImp::stype();
 }
 
+namespace
+{
+/**
+ * A label's text, split up once into the literal parts and the escapes
+ * ( "%1", "%L2", ... ) in between, so that filling in the values is a
+ * simple concatenation.  Calling fillInNextEscape() on the text for
+ * every argument, as we used to, scans and copies all of it every time.
+ * The values are still formatted by fillInNextEscape(), on a string
+ * holding nothing but the escape, so they look exactly like they did.
+ */
+class LabelTemplate
+{
+    struct Segment {
+        // the literal text, or the escape itself if this is an escape
+        QString text;
+        // the index of the argument filling in this escape, or -1 if
+        // this is literal text, or an escape without an argument
+        int arg;
+        bool localized;
+    };
+    std::vector<Segment> msegments;
+    uint mnargs;
+
+public:
+    LabelTemplate(const QString &s, uint nargs);
+    uint nargs() const
+    {
+        return mnargs;
+    }
+    QString fill(const Args &args, const KigDocument &doc) const;
+};
+}
+
+LabelTemplate::LabelTemplate(const QString &s, uint nargs)
+    : mnargs(nargs)
+{
+    // QString::arg() replaces the lowest numbered escape with its
+    // argument, so the n-th argument goes to the n-th lowest number.
+    std::vector<int> numbers;
+    QString literal;
+    const int n = s.length();
+    for (int i = 0; i < n; ++i) {
+        int j = i + 1;
+        const bool localized = j < n && s[j] == QLatin1Char('L');
+        if (localized)
+            ++j;
+        if (s[i] != QLatin1Char('%') || j >= n || !s[j].isDigit()) {
+            literal.append(s[i]);
+            continue;
+        }
+        int number = s[j++].digitValue();
+        if (j < n && s[j].isDigit())
+            number = 10 * number + s[j++].digitValue();
+        if (!literal.isEmpty())
+            msegments.push_back({literal, -1, false});
+        literal.clear();
+        msegments.push_back({s.mid(i, j - i), number, localized});
+        numbers.push_back(number);
+        i = j - 1;
+    }
+    if (!literal.isEmpty())
+        msegments.push_back({literal, -1, false});
+
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+    for (Segment &seg : msegments) {
+        if (seg.arg == -1)
+            continue;
+        const uint index = std::lower_bound(numbers.begin(), numbers.end(), seg.arg) - numbers.begin();
+        seg.arg = index < nargs ? static_cast<int>(index) : -1;
+    }
+}
+
+QString LabelTemplate::fill(const Args &args, const KigDocument &doc) const
+{
+    QString ret;
+    for (const Segment &seg : msegments) {
+        if (seg.arg == -1) {
+            ret += seg.text;
+            continue;
+        }
+        QString value = seg.localized ? QStringLiteral("%L1") : QStringLiteral("%1");
+        args[seg.arg]->fillInNextEscape(value, doc);
+        ret += value;
+    }
+    return ret;
+}
+
+/**
+ * The compiled template of the label text s.  The templates are keyed
+ * on the text itself rather than on the StringImp holding it, since
+ * labels built by macros and loci get a new StringImp, with a new
+ * serial, every time their hierarchy is calculated.
+ */
+static const LabelTemplate &labelTemplate(const StringImp *s, uint nargs)
+{
+    // one cache per thread, so that documents can be calculated in more
+    // than one thread at once.  QCache throws away the templates that
+    // were used least recently, so the labels that are being
+    // recalculated stay in it however many other labels there are.
+    thread_local QCache<QString, LabelTemplate> cache(1024);
+    const LabelTemplate *t = cache.object(s->data());
+    if (t && t->nargs() == nargs)
+        return *t;
+    LabelTemplate *nt = new LabelTemplate(s->data(), nargs);
+    cache.insert(s->data(), nt);
+    return *nt;
+}
+
 ObjectImp *GenericTextType::calc(const Args &parents, const KigDocument &doc) const
 {
     if (parents.size() < 3)
@@ -69,10 +173,7 @@ ObjectImp *GenericTextType::calc(const Args &parents, const KigDocument &doc) co
     int frame = static_cast<const IntImp *>(firstthree[0])->data();
     bool needframe = frame != 0;
     const Coordinate t = static_cast<const PointImp *>(firstthree[1])->coordinate();
-    QString s = static_cast<const StringImp *>(firstthree[2])->data();
-
-    for (Args::iterator i = varargs.begin(); i != varargs.end(); ++i)
-        (*i)->fillInNextEscape(s, doc);
+    const QString s = labelTemplate(static_cast<const StringImp *>(firstthree[2]), varargs.size()).fill(varargs, doc);
 
     if (varargs.size() == 1 && varargs[0]->inherits(DoubleImp::stype())) {
         double value = static_cast<const DoubleImp *>(varargs[0])->data();
@@ -85,6 +186,24 @@ ObjectImp *GenericTextType::calc(const Args &parents, const KigDocument &doc) co
     }
 }
 
+bool GenericTextType::canKeepImp(const ObjectImp &oldimp, const ObjectImp &newimp, bool haschildren) const
+{
+    // while dragging, a label showing e.g. a length is recalculated all
+    // the time, but mostly shows the same text, because the value only
+    // changes below the precision it is shown with.  We keep the old
+    // label then, so it needn't be drawn again.  Its value can be used
+    // by other objects though, and then it has to be exact..
+    if (oldimp.type() != newimp.type() || !oldimp.equals(newimp))
+        return false;
+    if (!haschildren)
+        return true;
+    if (newimp.inherits(NumericTextImp::stype()))
+        return static_cast<const NumericTextImp &>(oldimp).getValue() == static_cast<const NumericTextImp &>(newimp).getValue();
+    if (newimp.inherits(BoolTextImp::stype()))
+        return static_cast<const BoolTextImp &>(oldimp).getValue() == static_cast<const BoolTextImp &>(newimp).getValue();
+    return true;
+}
+
 bool GenericTextType::canMove(const ObjectTypeCalcer &) const
 {
     return true;
@@ -159,43 +278,6 @@ QStringList GenericTextType::specialActions() const
     return ret;
 }
 
-void GenericTextType::executeAction(int i, ObjectHolder &oh, ObjectTypeCalcer &c, KigPart &doc, KigWidget &w, NormalMode &) const
-{
-    std::vector<ObjectCalcer *> parents = c.parents();
-    assert(parents.size() >= 3);
-
-    std::vector<ObjectCalcer *> firstthree(parents.begin(), parents.begin() + 3);
-
-    assert(mparser.checkArgs(firstthree));
-    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[0]));
-    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[2]));
-
-    if (i == 0) {
-        QClipboard *cb = QApplication::clipboard();
-
-        // copy the text into the clipboard
-        const TextImp *ti = static_cast<const TextImp *>(c.imp());
-        cb->setText(ti->text(), QClipboard::Clipboard);
-    } else if (i == 1) {
-        // toggle label frame
-        int n = (static_cast<const IntImp *>(firstthree[0]->imp())->data() + 1) % 2;
-        KigCommand *kc = new KigCommand(doc, i18n("Toggle Label Frame"));
-        kc->addTask(new ChangeObjectConstCalcerTask(static_cast<ObjectConstCalcer *>(firstthree[0]), new IntImp(n)));
-        doc.history()->push(kc);
-    } else if (i == 2) {
-        // change label font
-        QFont f = oh.drawer()->font();
-        bool result;
-        f = QFontDialog::getFont(&result, f, &w);
-        if (!result)
-            return;
-        KigCommand *kc = new KigCommand(doc, i18n("Change Label Font"));
-        kc->addTask(new ChangeObjectDrawerTask(&oh, oh.drawer()->getCopyFont(f)));
-        doc.history()->push(kc);
-    } else
-        assert(false);
-}
-
 KIG_INSTANTIATE_OBJECT_TYPE_INSTANCE(TextType)
 
 TextType::TextType()
@@ -220,29 +302,6 @@ QStringList TextType::specialActions() const
     return ret;
 }
 
-void TextType::executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &doc, KigWidget &w, NormalMode &nm) const
-{
-    std::vector<ObjectCalcer *> parents = c.parents();
-    assert(parents.size() >= 3);
-
-    std::vector<ObjectCalcer *> firstthree(parents.begin(), parents.begin() + 3);
-
-    assert(argParser().checkArgs(firstthree));
-    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[0]));
-    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[2]));
-
-    const int parentactions = GenericTextType::specialActions().count();
-    if (i < parentactions)
-        GenericTextType::executeAction(i, o, c, doc, w, nm);
-    else if (i == parentactions) {
-        assert(dynamic_cast<ObjectTypeCalcer *>(o.calcer()));
-        // redefine..
-        TextLabelRedefineMode m(doc, static_cast<ObjectTypeCalcer *>(o.calcer()));
-        doc.runMode(&m);
-    } else
-        assert(false);
-}
-
 KIG_INSTANTIATE_OBJECT_TYPE_INSTANCE(NumericTextType)
 
 NumericTextType::NumericTextType()
@@ -267,34 +326,3 @@ QStringList NumericTextType::specialActions() const
     return ret;
 }
 
-void NumericTextType::executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &doc, KigWidget &w, NormalMode &nm) const
-{
-    std::vector<ObjectCalcer *> parents = c.parents();
-    assert(parents.size() == 4);
-
-    std::vector<ObjectCalcer *> firstthree(parents.begin(), parents.begin() + 3);
-
-    assert(o.imp()->inherits(NumericTextImp::stype()));
-    assert(argParser().checkArgs(firstthree));
-    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[0]));
-    assert(dynamic_cast<ObjectConstCalcer *>(firstthree[2]));
-
-    const int parentactions = GenericTextType::specialActions().count();
-    if (i < parentactions)
-        GenericTextType::executeAction(i, o, c, doc, w, nm);
-    else if (i == parentactions) {
-        bool ok;
-        ObjectConstCalcer *valuecalcer = dynamic_cast<ObjectConstCalcer *>(parents[3]);
-        assert(valuecalcer);
-        double oldvalue = static_cast<const NumericTextImp *>(o.imp())->getValue();
-        double value = getDoubleFromUser(i18n("Set Value"), i18n("Enter the new value:"), oldvalue, &w, &ok, -2147483647, 2147483647, 7);
-        if (!ok)
-            return;
-        MonitorDataObjects mon(parents);
-        valuecalcer->setImp(new DoubleImp(value));
-        KigCommand *kc = new KigCommand(doc, i18n("Change Displayed Value"));
-        mon.finish(kc);
-        doc.history()->push(kc);
-    } else
-        assert(false);
-}
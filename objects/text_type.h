@@ -20,6 +20,7 @@ public:
     const ObjectImpType *resultId() const override;
 
     ObjectImp *calc(const Args &parents, const KigDocument &d) const override;
+    bool canKeepImp(const ObjectImp &oldimp, const ObjectImp &newimp, bool haschildren) const override;
 
     std::vector<ObjectCalcer *> sortArgs(const std::vector<ObjectCalcer *> &os) const override;
     Args sortArgs(const Args &args) const override;
@@ -31,7 +32,7 @@ public:
     void move(ObjectTypeCalcer &ourobj, const Coordinate &to, const KigDocument &) const override;
 
     QStringList specialActions() const override;
-    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const override;
+    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const;
 
     const ArgsParser &argParser() const;
 };
@@ -45,7 +46,7 @@ public:
     static const TextType *instance();
 
     QStringList specialActions() const override;
-    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const override;
+    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const;
 };
 
 class NumericTextType : public GenericTextType
@@ -57,5 +58,5 @@ public:
     static const NumericTextType *instance();
 
     QStringList specialActions() const override;
-    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const override;
+    void executeAction(int i, ObjectHolder &o, ObjectTypeCalcer &c, KigPart &d, KigWidget &w, NormalMode &m) const;
 };
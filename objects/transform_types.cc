@@ -21,6 +21,14 @@ static const ArgsParser::spec argsspecTranslation[] = {
     {ObjectImp::stype(), kli18n("Translate this object"), kli18n("Select the object to translate..."), false},
     {VectorImp::stype(), kli18n("Translate by this vector"), kli18n("Select the vector to translate by..."), false}};
 
+static ObjectImp *transformFirstArg(const ObjectType *type, const Args &args, const KigDocument &doc)
+{
+    Transformation t = Transformation::identity();
+    if (!type->transformation(args, doc, t))
+        return new InvalidImp;
+    return args[0]->transform(t);
+}
+
 KIG_INSTANTIATE_OBJECT_TYPE_INSTANCE(TranslatedType)
 
 TranslatedType::TranslatedType()
@@ -38,15 +46,20 @@ const TranslatedType *TranslatedType::instance()
     return &t;
 }
 
-ObjectImp *TranslatedType::calc(const Args &args, const KigDocument &) const
+bool TranslatedType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     Coordinate dir = static_cast<const VectorImp *>(args[1])->dir();
-    Transformation t = Transformation::translation(dir);
+    t = Transformation::translation(dir);
 
-    return args[0]->transform(t);
+    return true;
+}
+
+ObjectImp *TranslatedType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecPointReflection[] = {
@@ -70,15 +83,20 @@ const PointReflectionType *PointReflectionType::instance()
     return &t;
 }
 
-ObjectImp *PointReflectionType::calc(const Args &args, const KigDocument &) const
+bool PointReflectionType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     Coordinate center = static_cast<const PointImp *>(args[1])->coordinate();
-    Transformation t = Transformation::pointReflection(center);
+    t = Transformation::pointReflection(center);
 
-    return args[0]->transform(t);
+    return true;
+}
+
+ObjectImp *PointReflectionType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecLineReflection[] = {
@@ -102,15 +120,20 @@ const LineReflectionType *LineReflectionType::instance()
     return &t;
 }
 
-ObjectImp *LineReflectionType::calc(const Args &args, const KigDocument &) const
+bool LineReflectionType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     LineData d = static_cast<const AbstractLineImp *>(args[1])->data();
-    Transformation t = Transformation::lineReflection(d);
+    t = Transformation::lineReflection(d);
 
-    return args[0]->transform(t);
+    return true;
+}
+
+ObjectImp *LineReflectionType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecRotation[] = {
@@ -137,19 +160,25 @@ const RotationType *RotationType::instance()
     return &t;
 }
 
-ObjectImp *RotationType::calc(const Args &args, const KigDocument &) const
+bool RotationType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     Coordinate center = static_cast<const PointImp *>(args[1])->coordinate();
     //  double angle = static_cast<const AngleImp*>( args[2] )->size();
     bool valid;
     double angle = getDoubleFromImp(args[2], valid);
     if (!valid)
-        return new InvalidImp;
+        return false;
+
+    t = Transformation::rotation(angle, center);
+    return true;
+}
 
-    return args[0]->transform(Transformation::rotation(angle, center));
+ObjectImp *RotationType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecScalingOverCenter[] = {
@@ -176,18 +205,24 @@ const ScalingOverCenterType *ScalingOverCenterType::instance()
     return &t;
 }
 
-ObjectImp *ScalingOverCenterType::calc(const Args &args, const KigDocument &) const
+bool ScalingOverCenterType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     Coordinate center = static_cast<const PointImp *>(args[1])->coordinate();
     bool valid;
     double ratio = getDoubleFromImp(args[2], valid);
     if (!valid)
-        return new InvalidImp;
+        return false;
 
-    return args[0]->transform(Transformation::scalingOverPoint(ratio, center));
+    t = Transformation::scalingOverPoint(ratio, center);
+    return true;
+}
+
+ObjectImp *ScalingOverCenterType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecScalingOverCenter2[] = {
@@ -223,10 +258,10 @@ const ScalingOverCenter2Type *ScalingOverCenter2Type::instance()
     return &t;
 }
 
-ObjectImp *ScalingOverCenter2Type::calc(const Args &args, const KigDocument &) const
+bool ScalingOverCenter2Type::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     Coordinate center = static_cast<const PointImp *>(args[1])->coordinate();
     //  double ratio = static_cast<const SegmentImp*>( args[3] )->length()/
@@ -234,12 +269,18 @@ ObjectImp *ScalingOverCenter2Type::calc(const Args &args, const KigDocument &) c
     bool valid;
     double denom = getDoubleFromImp(args[2], valid);
     if (!valid || denom == 0.0)
-        return new InvalidImp;
+        return false;
     double ratio = getDoubleFromImp(args[3], valid) / denom;
     if (!valid)
-        return new InvalidImp;
+        return false;
+
+    t = Transformation::scalingOverPoint(ratio, center);
+    return true;
+}
 
-    return args[0]->transform(Transformation::scalingOverPoint(ratio, center));
+ObjectImp *ScalingOverCenter2Type::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecScalingOverLine[] = {
@@ -266,18 +307,24 @@ const ScalingOverLineType *ScalingOverLineType::instance()
     return &t;
 }
 
-ObjectImp *ScalingOverLineType::calc(const Args &args, const KigDocument &) const
+bool ScalingOverLineType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     LineData line = static_cast<const AbstractLineImp *>(args[1])->data();
     bool valid;
     double ratio = getDoubleFromImp(args[2], valid);
     if (!valid)
-        return new InvalidImp;
+        return false;
 
-    return args[0]->transform(Transformation::scalingOverLine(ratio, line));
+    t = Transformation::scalingOverLine(ratio, line);
+    return true;
+}
+
+ObjectImp *ScalingOverLineType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecScalingOverLine2[] = {
@@ -312,10 +359,10 @@ const ScalingOverLine2Type *ScalingOverLine2Type::instance()
     return &t;
 }
 
-ObjectImp *ScalingOverLine2Type::calc(const Args &args, const KigDocument &) const
+bool ScalingOverLine2Type::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     LineData line = static_cast<const AbstractLineImp *>(args[1])->data();
     //  double ratio = static_cast<const SegmentImp*>( args[3] )->length()/
@@ -323,12 +370,18 @@ ObjectImp *ScalingOverLine2Type::calc(const Args &args, const KigDocument &) con
     bool valid;
     double denom = getDoubleFromImp(args[2], valid);
     if (!valid || denom == 0.0)
-        return new InvalidImp;
+        return false;
     double ratio = getDoubleFromImp(args[3], valid) / denom;
     if (!valid)
-        return new InvalidImp;
+        return false;
+
+    t = Transformation::scalingOverLine(ratio, line);
+    return true;
+}
 
-    return args[0]->transform(Transformation::scalingOverLine(ratio, line));
+ObjectImp *ScalingOverLine2Type::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecProjectiveRotation[] = {
@@ -359,17 +412,23 @@ const ProjectiveRotationType *ProjectiveRotationType::instance()
     return &t;
 }
 
-ObjectImp *ProjectiveRotationType::calc(const Args &args, const KigDocument &) const
+bool ProjectiveRotationType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     const RayImp *ray = static_cast<const RayImp *>(args[1]);
     Coordinate c1 = ray->data().a;
     Coordinate dir = ray->data().dir().normalize();
     double alpha = static_cast<const AngleImp *>(args[2])->size();
 
-    return args[0]->transform(Transformation::projectiveRotation(alpha, dir, c1));
+    t = Transformation::projectiveRotation(alpha, dir, c1);
+    return true;
+}
+
+ObjectImp *ProjectiveRotationType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecHarmonicHomology[] = {
@@ -394,14 +453,20 @@ const HarmonicHomologyType *HarmonicHomologyType::instance()
     return &t;
 }
 
-ObjectImp *HarmonicHomologyType::calc(const Args &args, const KigDocument &) const
+bool HarmonicHomologyType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     Coordinate center = static_cast<const PointImp *>(args[1])->coordinate();
     LineData axis = static_cast<const AbstractLineImp *>(args[2])->data();
-    return args[0]->transform(Transformation::harmonicHomology(center, axis));
+    t = Transformation::harmonicHomology(center, axis);
+    return true;
+}
+
+ObjectImp *HarmonicHomologyType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecAffinityB2Tr[] = {
@@ -429,20 +494,23 @@ const AffinityB2TrType *AffinityB2TrType::instance()
     return &t;
 }
 
-ObjectImp *AffinityB2TrType::calc(const Args &args, const KigDocument &) const
+bool AffinityB2TrType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     std::vector<Coordinate> frompoints = static_cast<const FilledPolygonImp *>(args[1])->points();
     std::vector<Coordinate> topoints = static_cast<const FilledPolygonImp *>(args[2])->points();
 
     bool valid = true;
-    Transformation t = Transformation::affinityGI3P(frompoints, topoints, valid);
+    t = Transformation::affinityGI3P(frompoints, topoints, valid);
 
-    if (valid == false)
-        return new InvalidImp;
-    return args[0]->transform(t);
+    return valid;
+}
+
+ObjectImp *AffinityB2TrType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecAffinityGI3P[] = {
@@ -484,10 +552,10 @@ const AffinityGI3PType *AffinityGI3PType::instance()
     return &t;
 }
 
-ObjectImp *AffinityGI3PType::calc(const Args &args, const KigDocument &) const
+bool AffinityGI3PType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     std::vector<Coordinate> frompoints;
     std::vector<Coordinate> topoints;
@@ -497,11 +565,14 @@ ObjectImp *AffinityGI3PType::calc(const Args &args, const KigDocument &) const
     }
 
     bool valid = true;
-    Transformation t = Transformation::affinityGI3P(frompoints, topoints, valid);
+    t = Transformation::affinityGI3P(frompoints, topoints, valid);
 
-    if (valid == false)
-        return new InvalidImp;
-    return args[0]->transform(t);
+    return valid;
+}
+
+ObjectImp *AffinityGI3PType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecProjectivityB2Qu[] = {
@@ -532,20 +603,23 @@ const ProjectivityB2QuType *ProjectivityB2QuType::instance()
     return &t;
 }
 
-ObjectImp *ProjectivityB2QuType::calc(const Args &args, const KigDocument &) const
+bool ProjectivityB2QuType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     std::vector<Coordinate> frompoints = static_cast<const FilledPolygonImp *>(args[1])->points();
     std::vector<Coordinate> topoints = static_cast<const FilledPolygonImp *>(args[2])->points();
 
     bool valid = true;
-    Transformation t = Transformation::projectivityGI4P(frompoints, topoints, valid);
+    t = Transformation::projectivityGI4P(frompoints, topoints, valid);
 
-    if (valid == false)
-        return new InvalidImp;
-    return args[0]->transform(t);
+    return valid;
+}
+
+ObjectImp *ProjectivityB2QuType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecProjectivityGI4P[] = {
@@ -600,10 +674,10 @@ const ProjectivityGI4PType *ProjectivityGI4PType::instance()
     return &t;
 }
 
-ObjectImp *ProjectivityGI4PType::calc(const Args &args, const KigDocument &) const
+bool ProjectivityGI4PType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     std::vector<Coordinate> frompoints;
     std::vector<Coordinate> topoints;
@@ -613,11 +687,14 @@ ObjectImp *ProjectivityGI4PType::calc(const Args &args, const KigDocument &) con
     }
 
     bool valid = true;
-    Transformation t = Transformation::projectivityGI4P(frompoints, topoints, valid);
+    t = Transformation::projectivityGI4P(frompoints, topoints, valid);
 
-    if (valid == false)
-        return new InvalidImp;
-    return args[0]->transform(t);
+    return valid;
+}
+
+ObjectImp *ProjectivityGI4PType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 static const ArgsParser::spec argsspecCastShadow[] = {
@@ -645,14 +722,20 @@ const CastShadowType *CastShadowType::instance()
     return &t;
 }
 
-ObjectImp *CastShadowType::calc(const Args &args, const KigDocument &) const
+bool CastShadowType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     Coordinate lightsrc = static_cast<const PointImp *>(args[1])->coordinate();
     LineData d = static_cast<const AbstractLineImp *>(args[2])->data();
-    return args[0]->transform(Transformation::castShadow(lightsrc, d));
+    t = Transformation::castShadow(lightsrc, d);
+    return true;
+}
+
+ObjectImp *CastShadowType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 const ObjectImpType *TranslatedType::resultId() const
@@ -826,11 +909,17 @@ const ApplyTransformationObjectType *ApplyTransformationObjectType::instance()
     return &t;
 }
 
-ObjectImp *ApplyTransformationObjectType::calc(const Args &args, const KigDocument &) const
+bool ApplyTransformationObjectType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
-    return args[0]->transform(static_cast<const TransformationImp *>(args[1])->data());
+        return false;
+    t = static_cast<const TransformationImp *>(args[1])->data();
+    return true;
+}
+
+ObjectImp *ApplyTransformationObjectType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 const ObjectImpType *ApplyTransformationObjectType::resultId() const
@@ -859,10 +948,10 @@ const SimilitudeType *SimilitudeType::instance()
     return &t;
 }
 
-ObjectImp *SimilitudeType::calc(const Args &args, const KigDocument &) const
+bool SimilitudeType::transformation(const Args &args, const KigDocument &, Transformation &t) const
 {
     if (!margsparser.checkArgs(args))
-        return new InvalidImp;
+        return false;
 
     Coordinate c = static_cast<const PointImp *>(args[1])->coordinate();
     Coordinate a = static_cast<const PointImp *>(args[2])->coordinate();
@@ -872,7 +961,13 @@ ObjectImp *SimilitudeType::calc(const Args &args, const KigDocument &) const
     double factor = sqrt(b.squareLength() / a.squareLength());
     double theta = atan2(b.y, b.x) - atan2(a.y, a.x);
 
-    return args[0]->transform(Transformation::similitude(c, theta, factor));
+    t = Transformation::similitude(c, theta, factor);
+    return true;
+}
+
+ObjectImp *SimilitudeType::calc(const Args &args, const KigDocument &doc) const
+{
+    return transformFirstArg(this, args, doc);
 }
 
 SimilitudeType::~SimilitudeType()
@@ -16,6 +16,7 @@ class TranslatedType : public ArgsParserObjectType
 public:
     static const TranslatedType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -29,6 +30,7 @@ class PointReflectionType : public ArgsParserObjectType
 public:
     static const PointReflectionType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -42,6 +44,7 @@ class LineReflectionType : public ArgsParserObjectType
 public:
     static const LineReflectionType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -55,6 +58,7 @@ class RotationType : public ArgsParserObjectType
 public:
     static const RotationType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -68,6 +72,7 @@ class ScalingOverCenterType : public ArgsParserObjectType
 public:
     static const ScalingOverCenterType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -81,6 +86,7 @@ class ScalingOverCenter2Type : public ArgsParserObjectType
 public:
     static const ScalingOverCenter2Type *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -94,6 +100,7 @@ class ScalingOverLineType : public ArgsParserObjectType
 public:
     static const ScalingOverLineType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -107,6 +114,7 @@ class ScalingOverLine2Type : public ArgsParserObjectType
 public:
     static const ScalingOverLine2Type *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -120,6 +128,7 @@ class ProjectiveRotationType : public ArgsParserObjectType
 public:
     static const ProjectiveRotationType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -133,6 +142,7 @@ class HarmonicHomologyType : public ArgsParserObjectType
 public:
     static const HarmonicHomologyType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -146,6 +156,7 @@ class AffinityB2TrType : public ArgsParserObjectType
 public:
     static const AffinityB2TrType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -159,6 +170,7 @@ class AffinityGI3PType : public ArgsParserObjectType
 public:
     static const AffinityGI3PType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -172,6 +184,7 @@ class ProjectivityB2QuType : public ArgsParserObjectType
 public:
     static const ProjectivityB2QuType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -185,6 +198,7 @@ class ProjectivityGI4PType : public ArgsParserObjectType
 public:
     static const ProjectivityGI4PType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -198,6 +212,7 @@ class CastShadowType : public ArgsParserObjectType
 public:
     static const CastShadowType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
@@ -211,6 +226,7 @@ class ApplyTransformationObjectType : public ArgsParserObjectType
 public:
     static const ApplyTransformationObjectType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
     bool isTransform() const override;
 };
@@ -223,6 +239,7 @@ class SimilitudeType : public ArgsParserObjectType
 public:
     static const SimilitudeType *instance();
     ObjectImp *calc(const Args &args, const KigDocument &) const override;
+    bool transformation(const Args &args, const KigDocument &, Transformation &t) const override;
     const ObjectImpType *resultId() const override;
 
     bool isTransform() const override;
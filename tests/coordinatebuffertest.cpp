@@ -0,0 +1,224 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "../misc/coordinate.h"
+#include "../misc/coordinate_buffer.h"
+#include "../misc/kigtransform.h"
+#include "../misc/rect.h"
+
+#include <QObject>
+#include <QTest>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class CoordinateBufferTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSimplifyLine();
+    void testSimplifyCorner();
+    void testSimplifyTolerance();
+    void testSimplifyClosed();
+    void testSimplifyKeepsShortInput();
+    void testSimplifyFirstFarthest();
+    void testBoundingRect();
+    void testMinDistance();
+    void testTransform();
+};
+
+// the distance from p to the segment from a to b
+static double segmentDistance(const Coordinate &p, const Coordinate &a, const Coordinate &b)
+{
+    const Coordinate d = b - a;
+    const double lensq = d.squareLength();
+    double t = lensq > 0. ? (p - a) * d / lensq : 0.;
+    t = t < 0. ? 0. : t > 1. ? 1. : t;
+    return (p - (a + d * t)).length();
+}
+
+// whether every point of orig is within tolerance of the polyline
+// through simplified
+static bool withinTolerance(const std::vector<Coordinate> &orig, const CoordinateBuffer &simplified, double tolerance)
+{
+    for (std::vector<Coordinate>::const_iterator p = orig.begin(); p != orig.end(); ++p) {
+        double min = segmentDistance(*p, simplified[0], simplified[0]);
+        for (std::size_t i = 0; i + 1 < simplified.size(); ++i)
+            min = std::min(min, segmentDistance(*p, simplified[i], simplified[i + 1]));
+        if (min > tolerance)
+            return false;
+    }
+    return true;
+}
+
+void CoordinateBufferTest::testSimplifyLine()
+{
+    // points on a straight line: only the end points are needed
+    CoordinateBuffer b;
+    for (int i = 0; i <= 10; ++i)
+        b.push_back(Coordinate(i, 2 * i));
+    b.simplify(1e-6);
+    QCOMPARE(b.size(), std::size_t(2));
+    QVERIFY(b[0] == Coordinate(0, 0));
+    QVERIFY(b[1] == Coordinate(10, 20));
+}
+
+void CoordinateBufferTest::testSimplifyCorner()
+{
+    // two straight pieces, the corner between them must stay
+    CoordinateBuffer b;
+    for (int i = 0; i <= 5; ++i)
+        b.push_back(Coordinate(i, 0));
+    for (int i = 1; i <= 5; ++i)
+        b.push_back(Coordinate(5, i));
+    b.simplify(0.01);
+    QCOMPARE(b.size(), std::size_t(3));
+    QVERIFY(b[0] == Coordinate(0, 0));
+    QVERIFY(b[1] == Coordinate(5, 0));
+    QVERIFY(b[2] == Coordinate(5, 5));
+}
+
+void CoordinateBufferTest::testSimplifyTolerance()
+{
+    // a finely sampled sine curve: the result has fewer points, the
+    // end points are kept, and the curve stays within the tolerance
+    std::vector<Coordinate> pts;
+    for (int i = 0; i <= 1000; ++i)
+        pts.push_back(Coordinate(i * 0.01, std::sin(i * 0.01)));
+    const double tolerances[] = {0.001, 0.01, 0.1};
+    std::size_t previous = pts.size();
+    for (double tolerance : tolerances) {
+        CoordinateBuffer b(pts);
+        b.simplify(tolerance);
+        QVERIFY(b.size() < previous);
+        previous = b.size();
+        QVERIFY(b[0] == pts.front());
+        QVERIFY(b.back() == pts.back());
+        QVERIFY(withinTolerance(pts, b, tolerance));
+    }
+
+    // a tolerance that is not positive leaves everything alone
+    CoordinateBuffer b(pts);
+    b.simplify(0.);
+    QCOMPARE(b.size(), pts.size());
+    b.simplify(-1.);
+    QCOMPARE(b.size(), pts.size());
+}
+
+void CoordinateBufferTest::testSimplifyClosed()
+{
+    // a closed polyline, whose first and last points are the same, so
+    // the first range is a single point
+    std::vector<Coordinate> pts;
+    for (int i = 0; i < 100; ++i)
+        pts.push_back(Coordinate(std::cos(i * 2 * M_PI / 100), std::sin(i * 2 * M_PI / 100)));
+    pts.push_back(pts.front());
+    CoordinateBuffer b(pts);
+    b.simplify(0.05);
+    QVERIFY(b.size() > 3);
+    QVERIFY(b.size() < pts.size());
+    QVERIFY(b[0] == b.back());
+    QVERIFY(withinTolerance(pts, b, 0.05));
+}
+
+void CoordinateBufferTest::testSimplifyKeepsShortInput()
+{
+    CoordinateBuffer empty;
+    empty.simplify(1.);
+    QVERIFY(empty.empty());
+
+    CoordinateBuffer two;
+    two.push_back(Coordinate(0, 0));
+    two.push_back(Coordinate(0, 0));
+    two.simplify(1.);
+    QCOMPARE(two.size(), std::size_t(2));
+}
+
+void CoordinateBufferTest::testSimplifyFirstFarthest()
+{
+    // three points equally far from the segment between the end
+    // points: the first of them splits it, and the middle one ends up
+    // on the line between the other two, so it is dropped.
+    CoordinateBuffer b;
+    b.push_back(Coordinate(0, 0));
+    b.push_back(Coordinate(1, 1));
+    b.push_back(Coordinate(2, 1));
+    b.push_back(Coordinate(3, 1));
+    b.push_back(Coordinate(4, 0));
+    b.simplify(0.5);
+    QCOMPARE(b.size(), std::size_t(4));
+    QVERIFY(b[1] == Coordinate(1, 1));
+    QVERIFY(b[2] == Coordinate(3, 1));
+}
+
+void CoordinateBufferTest::testBoundingRect()
+{
+    QVERIFY(!CoordinateBuffer().boundingRect().valid());
+
+    // invalid points don't count
+    CoordinateBuffer b;
+    b.push_back(Coordinate(1, 2));
+    b.push_back(Coordinate::invalidCoord());
+    b.push_back(Coordinate(-3, 5));
+    b.push_back(Coordinate(2, 4));
+    Rect r = b.boundingRect();
+    QVERIFY(r.valid());
+    QCOMPARE(r.left(), -3.);
+    QCOMPARE(r.right(), 2.);
+    QCOMPARE(r.bottom(), 2.);
+    QCOMPARE(r.top(), 5.);
+
+    CoordinateBuffer invalid;
+    invalid.push_back(Coordinate::invalidCoord());
+    QVERIFY(!invalid.boundingRect().valid());
+}
+
+void CoordinateBufferTest::testMinDistance()
+{
+    CoordinateBuffer b;
+    b.push_back(Coordinate::invalidCoord());
+    b.push_back(Coordinate(0, 0));
+    b.push_back(Coordinate(3, 4));
+    b.push_back(Coordinate(4, 3));
+    std::size_t index = 17;
+    QCOMPARE(b.minDistance(Coordinate(3, 3), &index), 1.);
+    // the first of the nearest points
+    QCOMPARE(index, std::size_t(2));
+    QCOMPARE(b.minDistance(Coordinate(-3, -4), &index), 5.);
+    QCOMPARE(index, std::size_t(1));
+
+    QVERIFY(std::isinf(CoordinateBuffer().minDistance(Coordinate(0, 0))));
+}
+
+void CoordinateBufferTest::testTransform()
+{
+    // the same as transforming the points one by one, also for the
+    // points that are sent to infinity, where w = 1 + x - y
+    double data[3][3] = {{1., 1., -1.}, {0.5, 2., 0.3}, {-1., 0.1, 1.5}};
+    const Transformation t(data, false);
+    std::vector<Coordinate> pts;
+    for (int i = 0; i < 37; ++i)
+        pts.push_back(Coordinate(std::sin(i * 0.9) * 5., std::cos(i * 0.4) * 3.));
+    pts.push_back(Coordinate(0, 1));
+    pts.push_back(Coordinate(2, 3));
+    CoordinateBuffer b(pts);
+    b.transform(t);
+    QCOMPARE(b.size(), pts.size());
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        const Coordinate expected = t.apply(pts[i]);
+        if (expected.valid())
+            QVERIFY(b[i] == expected);
+        else
+            QVERIFY(!b[i].valid());
+    }
+}
+
+QTEST_GUILESS_MAIN(CoordinateBufferTest)
+
+#include "coordinatebuffertest.moc"
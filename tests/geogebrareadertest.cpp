@@ -0,0 +1,137 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "../geogebra/geogebrareader.h"
+#include "../kig/kig_document.h"
+#include "../objects/line_imp.h"
+#include "../objects/object_drawer.h"
+#include "../objects/object_holder.h"
+#include "../objects/point_imp.h"
+
+#include <QBuffer>
+#include <QObject>
+#include <QTest>
+
+#include <cmath>
+
+class GeogebraReaderTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testRead();
+    void benchmarkRead_data();
+    void benchmarkRead();
+};
+
+/**
+ * the geogebra.xml of a worksheet with \p n points on a circle, and the
+ * segment and the line through every point and the next one.
+ */
+static QByteArray worksheet(int n)
+{
+    QByteArray xml =
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<geogebra format=\"5.0\">\n"
+        "<euclidianView><evSettings axes=\"true\" grid=\"false\"/></euclidianView>\n"
+        "<construction>\n";
+    for (int i = 0; i < n; ++i) {
+        const QByteArray p = "P" + QByteArray::number(i);
+        const double angle = 2 * M_PI * i / n;
+        xml += "<element type=\"point\" label=\"" + p + "\"><show object=\"true\"/><objColor r=\"0\" g=\"0\" b=\"255\"/><coords x=\""
+            + QByteArray::number(10 * std::cos(angle)) + "\" y=\"" + QByteArray::number(10 * std::sin(angle))
+            + "\" z=\"1\"/><pointSize val=\"3\"/><pointStyle val=\"0\"/></element>\n";
+        if (i == 0)
+            continue;
+        const QByteArray q = "P" + QByteArray::number(i - 1);
+        const QByteArray s = "s" + QByteArray::number(i);
+        const QByteArray l = "l" + QByteArray::number(i);
+        xml += "<command name=\"Segment\"><input a0=\"" + q + "\" a1=\"" + p + "\"/><output a0=\"" + s + "\"/></command>\n";
+        xml += "<element type=\"segment\" label=\"" + s + "\"><show object=\"true\"/><lineStyle thickness=\"2\" type=\"15\"/></element>\n";
+        xml += "<command name=\"Line\"><input a0=\"" + q + "\" a1=\"" + p + "\"/><output a0=\"" + l + "\"/></command>\n";
+        xml += "<element type=\"line\" label=\"" + l + "\"><show object=\"false\"/><objColor r=\"255\" g=\"0\" b=\"0\"/></element>\n";
+    }
+    xml += "</construction>\n</geogebra>\n";
+    return xml;
+}
+
+// read xml into doc, the way KigFilterGeogebra does, so that doc
+// owns the objects
+static bool read(QByteArray &xml, KigDocument &doc)
+{
+    QBuffer buffer(&xml);
+    buffer.open(QIODevice::ReadOnly);
+    GeogebraReader reader(&doc);
+    if (!reader.read(&buffer) || reader.getNumberOfSections() != 1)
+        return false;
+
+    const GeogebraSection &section = reader.getSection(0);
+    const std::vector<ObjectCalcer *> &calcers = section.getOutputObjects();
+    const std::vector<ObjectDrawer *> &drawers = section.getDrawers();
+    std::vector<ObjectHolder *> holders;
+    for (uint i = 0; i < calcers.size(); ++i)
+        holders.push_back(new ObjectHolder(calcers[i], drawers[i]));
+    doc.addObjects(holders);
+    return true;
+}
+
+void GeogebraReaderTest::testRead()
+{
+    const int n = 100;
+    QByteArray xml = worksheet(n);
+    KigDocument doc;
+    QVERIFY(read(xml, doc));
+
+    const std::vector<ObjectHolder *> objects = doc.objects();
+    QCOMPARE(objects.size(), size_t(3 * n - 2));
+    int points = 0;
+    int segments = 0;
+    int lines = 0;
+    for (std::vector<ObjectHolder *>::const_iterator i = objects.begin(); i != objects.end(); ++i) {
+        const ObjectImp *imp = (*i)->imp();
+        const ObjectDrawer *drawer = (*i)->drawer();
+        if (imp->inherits(PointImp::stype()))
+            ++points;
+        else if (imp->inherits(SegmentImp::stype())) {
+            ++segments;
+            QCOMPARE(drawer->width(), 2);
+            QCOMPARE(drawer->style(), Qt::DashLine);
+        } else if (imp->inherits(LineImp::stype())) {
+            ++lines;
+            QVERIFY(!drawer->shown());
+            QCOMPARE(drawer->color(), QColor(255, 0, 0));
+        }
+    }
+    QCOMPARE(points, n);
+    QCOMPARE(segments, n - 1);
+    QCOMPARE(lines, n - 1);
+    QVERIFY(doc.axes());
+    QVERIFY(!doc.grid());
+}
+
+void GeogebraReaderTest::benchmarkRead_data()
+{
+    QTest::addColumn<int>("points");
+
+    QTest::newRow("1000 points") << 1000;
+    QTest::newRow("10000 points") << 10000;
+}
+
+void GeogebraReaderTest::benchmarkRead()
+{
+    QFETCH(int, points);
+    QByteArray xml = worksheet(points);
+
+    QBENCHMARK {
+        KigDocument doc;
+        QVERIFY(read(xml, doc));
+    }
+}
+
+QTEST_MAIN(GeogebraReaderTest)
+
+#include "geogebrareadertest.moc"
@@ -0,0 +1,204 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "../kig/kig_document.h"
+#include "../kig/kig_journal.h"
+#include "../objects/bogus_imp.h"
+#include "../objects/line_type.h"
+#include "../objects/object_calcer.h"
+#include "../objects/object_factory.h"
+#include "../objects/object_holder.h"
+#include "../objects/object_imp.h"
+#include "../objects/point_imp.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <memory>
+#include <vector>
+
+// a journal is started on a document, some changes are journaled the
+// way the KigCommand's do it, and recovering the journal must give the
+// document as it is after those changes.
+class JournalTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testReplay();
+    void testTruncatedRecord();
+    void testNoJournal();
+};
+
+static ObjectHolder *point(KigDocument &doc, const Coordinate &c)
+{
+    ObjectTypeCalcer *calcer = ObjectFactory::instance()->fixedPointCalcer(c);
+    calcer->calc(doc);
+    return new ObjectHolder(calcer);
+}
+
+static ObjectHolder *segment(KigDocument &doc, ObjectHolder *a, ObjectHolder *b)
+{
+    std::vector<ObjectCalcer *> args;
+    args.push_back(a->calcer());
+    args.push_back(b->calcer());
+    ObjectTypeCalcer *calcer = new ObjectTypeCalcer(SegmentABType::instance(), args);
+    calcer->calc(doc);
+    return new ObjectHolder(calcer);
+}
+
+// whether the objects of a and b have the same imps, in any order
+static bool sameObjects(const KigDocument &a, const KigDocument &b)
+{
+    std::vector<ObjectHolder *> ao = a.objects();
+    std::vector<ObjectHolder *> bo = b.objects();
+    if (ao.size() != bo.size())
+        return false;
+    for (std::vector<ObjectHolder *>::const_iterator i = ao.begin(); i != ao.end(); ++i) {
+        std::vector<ObjectHolder *>::iterator j = bo.begin();
+        while (j != bo.end() && !(*i)->imp()->equals(*(*j)->imp()))
+            ++j;
+        if (j == bo.end())
+            return false;
+        bo.erase(j);
+    }
+    return true;
+}
+
+// where the document of the journal is stored, it needn't exist
+static QString documentPath(const QTemporaryDir &dir)
+{
+    return dir.filePath(QStringLiteral("doc.kig"));
+}
+
+void JournalTest::initTestCase()
+{
+    // keep the journals out of the real data directory
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void JournalTest::testReplay()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = documentPath(dir);
+
+    KigDocument doc;
+    ObjectHolder *a = point(doc, Coordinate(0, 0));
+    ObjectHolder *b = point(doc, Coordinate(3, 0));
+    ObjectHolder *ab = segment(doc, a, b);
+    doc.addObject(a);
+    doc.addObject(b);
+    doc.addObject(ab);
+
+    KigJournal journal;
+    journal.start(&doc, path, true);
+
+    // added objects, one of them depending on an object in the
+    // snapshot
+    std::vector<ObjectHolder *> added;
+    added.push_back(point(doc, Coordinate(3, 4)));
+    added.push_back(segment(doc, b, added[0]));
+    doc.addObjects(added);
+    journal.objectsAdded(added);
+
+    // a moved point
+    ObjectConstCalcer *ax = static_cast<ObjectConstCalcer *>(a->calcer()->parents()[0]);
+    ax->setImp(new DoubleImp(-1.));
+    a->calc(doc);
+    ab->calc(doc);
+    journal.constCalcerChanged(ax);
+
+    // and a removed one
+    doc.delObject(ab);
+    journal.objectsRemoved(std::vector<ObjectHolder *>(1, ab));
+    delete ab;
+
+    journal.flush();
+    std::unique_ptr<KigDocument> recovered(KigJournal::recover(path));
+    QVERIFY(recovered);
+    QCOMPARE(recovered->objects().size(), size_t(4));
+    QVERIFY(sameObjects(doc, *recovered));
+
+    bool moved = false;
+    const std::vector<ObjectHolder *> objects = recovered->objects();
+    for (std::vector<ObjectHolder *>::const_iterator i = objects.begin(); i != objects.end(); ++i)
+        if ((*i)->imp()->inherits(PointImp::stype()))
+            moved |= static_cast<const PointImp *>((*i)->imp())->coordinate() == Coordinate(-1, 0);
+    QVERIFY(moved);
+
+    // stopping the journal removes it
+    journal.stop();
+    QVERIFY(!QFile::exists(KigJournal::journalFile(path)));
+}
+
+void JournalTest::testTruncatedRecord()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = documentPath(dir);
+
+    KigDocument doc;
+    doc.addObject(point(doc, Coordinate(1, 2)));
+    KigJournal journal;
+    journal.start(&doc, path, true);
+
+    std::vector<ObjectHolder *> added(1, point(doc, Coordinate(5, 6)));
+    doc.addObjects(added);
+    journal.objectsAdded(added);
+    journal.flush();
+
+    // Kig crashed while writing a record: its kind and size are there,
+    // but only part of its payload
+    QFile f(KigJournal::journalFile(path));
+    QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Append));
+    const char partial[] = {1, 100, 0, 0, 0, 'x', 'y'};
+    QCOMPARE(f.write(partial, sizeof(partial)), qint64(sizeof(partial)));
+    f.close();
+
+    // everything before it is still recovered
+    std::unique_ptr<KigDocument> recovered(KigJournal::recover(path));
+    QVERIFY(recovered);
+    QVERIFY(sameObjects(doc, *recovered));
+    journal.stop();
+}
+
+void JournalTest::testNoJournal()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = documentPath(dir);
+
+    KigDocument doc;
+    doc.addObject(point(doc, Coordinate(1, 2)));
+
+    // an unmodified document has no journal until it is changed
+    KigJournal journal;
+    journal.start(&doc, path, false);
+    journal.flush();
+    QVERIFY(!KigJournal::recover(path));
+
+    // and a file that is not a journal is not recovered
+    const QString file = KigJournal::journalFile(path);
+    QVERIFY(QDir().mkpath(QFileInfo(file).absolutePath()));
+    QFile f(file);
+    QVERIFY(f.open(QIODevice::WriteOnly));
+    f.write("not a journal");
+    f.close();
+    QVERIFY(!KigJournal::recover(path));
+    journal.stop();
+}
+
+QTEST_MAIN(JournalTest)
+
+#include "journaltest.moc"
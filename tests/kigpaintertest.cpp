@@ -0,0 +1,104 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "../misc/kigpainter.h"
+
+#include <QObject>
+#include <QRect>
+#include <QTest>
+
+#include <vector>
+
+// while moving objects around, only the objects that changed, and the
+// ones that cleaning up after them erases, are drawn again.
+class KigPainterTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testUnchangedNotRedrawn();
+    void testErasedRedrawn();
+    void testErasedTransitively();
+    void testNothingDrawn();
+};
+
+typedef std::vector<std::vector<QRect>> DrawnRects;
+
+void KigPainterTest::testUnchangedNotRedrawn()
+{
+    // a moving point, and a label with the same text as before, away
+    // from it
+    DrawnRects drawn(2);
+    drawn[0].push_back(QRect(10, 10, 8, 8));
+    drawn[1].push_back(QRect(100, 10, 60, 20));
+    std::vector<bool> changed(2, false);
+    changed[0] = true;
+
+    const std::vector<bool> redraw = KigPainter::objectsToRedraw(drawn, changed);
+    QVERIFY(redraw[0]);
+    QVERIFY(!redraw[1]);
+
+    // if nothing changed, nothing is drawn
+    QVERIFY(!KigPainter::objectsToRedraw(drawn, std::vector<bool>(2, false))[0]);
+    QVERIFY(!KigPainter::objectsToRedraw(drawn, std::vector<bool>(2, false))[1]);
+}
+
+void KigPainterTest::testErasedRedrawn()
+{
+    // the label is in one of the rects of a segment that moved, but
+    // the bounding rects of the two are not enough to tell
+    DrawnRects drawn(3);
+    drawn[0].push_back(QRect(0, 0, 32, 32));
+    drawn[0].push_back(QRect(96, 96, 32, 32));
+    drawn[1].push_back(QRect(100, 100, 60, 20));
+    drawn[2].push_back(QRect(40, 40, 20, 20));
+    std::vector<bool> changed(3, false);
+    changed[0] = true;
+
+    const std::vector<bool> redraw = KigPainter::objectsToRedraw(drawn, changed);
+    QVERIFY(redraw[0]);
+    QVERIFY(redraw[1]);
+    // this one is within the bounding rect of the segment, but not in
+    // one of its rects
+    QVERIFY(!redraw[2]);
+}
+
+void KigPainterTest::testErasedTransitively()
+{
+    // cleaning up the second label erases part of the third, which
+    // then has to be drawn again too
+    DrawnRects drawn(4);
+    drawn[0].push_back(QRect(0, 0, 10, 10));
+    drawn[1].push_back(QRect(5, 5, 50, 10));
+    drawn[2].push_back(QRect(50, 10, 50, 10));
+    drawn[3].push_back(QRect(200, 200, 50, 10));
+    std::vector<bool> changed(4, false);
+    changed[0] = true;
+
+    const std::vector<bool> redraw = KigPainter::objectsToRedraw(drawn, changed);
+    QVERIFY(redraw[0]);
+    QVERIFY(redraw[1]);
+    QVERIFY(redraw[2]);
+    QVERIFY(!redraw[3]);
+}
+
+void KigPainterTest::testNothingDrawn()
+{
+    // an invalid object isn't drawn, so it has no rects
+    DrawnRects drawn(2);
+    drawn[1].push_back(QRect(0, 0, 10, 10));
+    std::vector<bool> changed(2, false);
+    changed[0] = true;
+
+    const std::vector<bool> redraw = KigPainter::objectsToRedraw(drawn, changed);
+    QVERIFY(redraw[0]);
+    QVERIFY(!redraw[1]);
+}
+
+QTEST_GUILESS_MAIN(KigPainterTest)
+
+#include "kigpaintertest.moc"
@@ -0,0 +1,245 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "../filters/native-filter.h"
+#include "../kig/kig_document.h"
+#include "../misc/binary_stream.h"
+#include "../misc/coordinate_system.h"
+#include "../objects/bogus_imp.h"
+#include "../objects/locus_imp.h"
+#include "../objects/object_calcer.h"
+#include "../objects/object_drawer.h"
+#include "../objects/object_factory.h"
+#include "../objects/object_holder.h"
+#include "../objects/object_imp.h"
+#include "../objects/object_imp_factory.h"
+#include "../objects/object_type.h"
+#include "../objects/polygon_type.h"
+#include "../objects/text_imp.h"
+
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+#include <qdom.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+
+// the sample documents are saved as .kig and as .kigb, both are loaded
+// again, and the results must be the same: the same calcers, computing
+// the same imps, and the same drawers.  Calcers are compared by what
+// they are, not by their address, since the order of the objects in a
+// document is that of their addresses.
+class NativeFilterTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testRoundTrip_data();
+    void testRoundTrip();
+    void testTextAndLocusConsts();
+    void testManyParents();
+};
+
+static QString calcerSignature(const ObjectCalcer *c, std::map<const ObjectCalcer *, QString> &sigs)
+{
+    std::map<const ObjectCalcer *, QString>::const_iterator s = sigs.find(c);
+    if (s != sigs.end())
+        return s->second;
+
+    QString ret;
+    if (const ObjectTypeCalcer *t = dynamic_cast<const ObjectTypeCalcer *>(c))
+        ret = QStringLiteral("type ") + QString::fromLatin1(t->type()->fullName());
+    else if (const ObjectPropertyCalcer *p = dynamic_cast<const ObjectPropertyCalcer *>(c))
+        ret = QStringLiteral("property ") + QString::fromLatin1(p->parent()->imp()->getPropName(p->propGid()));
+    else {
+        QDomDocument doc;
+        QDomElement e = doc.createElement(QStringLiteral("data"));
+        const QString type = ObjectImpFactory::instance()->serialize(*c->imp(), e, doc);
+        doc.appendChild(e);
+        ret = QStringLiteral("const ") + type + QLatin1Char(' ') + doc.toString(-1);
+    }
+    ret += QLatin1Char('(');
+    const std::vector<ObjectCalcer *> parents = c->parents();
+    for (std::vector<ObjectCalcer *>::const_iterator i = parents.begin(); i != parents.end(); ++i)
+        ret += calcerSignature(*i, sigs) + QLatin1Char(',');
+    ret += QLatin1Char(')');
+    sigs[c] = ret;
+    return ret;
+}
+
+static QString holderSignature(const ObjectHolder *o, std::map<const ObjectCalcer *, QString> &sigs)
+{
+    const ObjectDrawer *d = o->drawer();
+    QString ret = calcerSignature(o->calcer(), sigs);
+    if (o->nameCalcer())
+        ret += QStringLiteral(" named ") + calcerSignature(o->nameCalcer(), sigs);
+    ret += QStringLiteral(" drawn %1 %2 %3 %4 %5 %6")
+               .arg(d->color().name(QColor::HexArgb))
+               .arg(d->shown())
+               .arg(d->width())
+               .arg(static_cast<int>(d->style()))
+               .arg(static_cast<int>(d->pointStyle()))
+               .arg(d->font().toString());
+    return ret;
+}
+
+static std::vector<std::pair<QString, const ObjectHolder *>> sortedObjects(const KigDocument &doc)
+{
+    std::map<const ObjectCalcer *, QString> sigs;
+    std::vector<std::pair<QString, const ObjectHolder *>> ret;
+    const std::vector<ObjectHolder *> objects = doc.objects();
+    for (std::vector<ObjectHolder *>::const_iterator i = objects.begin(); i != objects.end(); ++i)
+        ret.push_back(std::make_pair(holderSignature(*i, sigs), *i));
+    std::stable_sort(ret.begin(), ret.end(), [](const std::pair<QString, const ObjectHolder *> &a, const std::pair<QString, const ObjectHolder *> &b) {
+        return a.first < b.first;
+    });
+    return ret;
+}
+
+static void compareDocuments(const KigDocument &a, const KigDocument &b)
+{
+    QCOMPARE(a.grid(), b.grid());
+    QCOMPARE(a.axes(), b.axes());
+    QCOMPARE(QByteArray(a.coordinateSystem().type()), QByteArray(b.coordinateSystem().type()));
+
+    const std::vector<std::pair<QString, const ObjectHolder *>> ao = sortedObjects(a);
+    const std::vector<std::pair<QString, const ObjectHolder *>> bo = sortedObjects(b);
+    QCOMPARE(ao.size(), bo.size());
+    for (uint i = 0; i < ao.size(); ++i) {
+        QCOMPARE(ao[i].first, bo[i].first);
+        QVERIFY2(ao[i].second->imp()->equals(*bo[i].second->imp()), qPrintable(ao[i].first));
+    }
+}
+
+void NativeFilterTest::testRoundTrip_data()
+{
+    QTest::addColumn<QString>("file");
+
+    const char *files[] = {"../examples/locustest.kig",
+                           "../examples/cubic-locus.kig",
+                           "../examples/trifolium-of-delongchamps.kig",
+                           "../examples/sine-curve.kig",
+                           "../examples/ellipse.kig",
+                           "../filters/tests/testtest.kig",
+                           "../filters/tests/radicallinestest.kig",
+                           "../filters/tests/intersectandasymptotestest.kig",
+                           "../filters/tests/testnames.kig",
+                           "../filters/tests/stylestest.kig"};
+    for (const char *file : files)
+        QTest::newRow(file) << QFINDTESTDATA(file);
+}
+
+void NativeFilterTest::testRoundTrip()
+{
+    QFETCH(QString, file);
+    QVERIFY(!file.isEmpty());
+
+    KigFilterNative *filter = KigFilterNative::instance();
+    std::unique_ptr<KigDocument> orig(filter->load(file));
+    QVERIFY(orig);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString xmlfile = dir.filePath(QStringLiteral("doc.kig"));
+    const QString binfile = dir.filePath(QStringLiteral("doc.kigb"));
+    QVERIFY(filter->save(*orig, xmlfile));
+    QVERIFY(filter->save(*orig, binfile));
+
+    std::unique_ptr<KigDocument> xml(filter->load(xmlfile));
+    QVERIFY(xml);
+    std::unique_ptr<KigDocument> bin(filter->load(binfile));
+    QVERIFY(bin);
+
+    compareDocuments(*xml, *bin);
+    compareDocuments(*orig, *bin);
+}
+
+static ObjectImp *binaryRoundTrip(const ObjectImp &imp)
+{
+    KigBinaryWriter w;
+    if (!ObjectImpFactory::instance()->serialize(imp, w))
+        return nullptr;
+    const QByteArray data = w.finish();
+    KigBinaryReader r(data.constData(), data.size());
+    if (!r.readStringTable())
+        return nullptr;
+    QString error;
+    ObjectImp *ret = ObjectImpFactory::instance()->deserialize(r, error);
+    if (ret && !r.atEnd()) {
+        delete ret;
+        return nullptr;
+    }
+    return ret;
+}
+
+void NativeFilterTest::testTextAndLocusConsts()
+{
+    // new documents never have text labels or loci as data, but old
+    // ones and imported ones can, and those must survive being saved as
+    // .kigb
+    const TextImp text(QStringLiteral("a label"), Coordinate(1.5, -2.), true);
+    std::unique_ptr<ObjectImp> textcopy(binaryRoundTrip(text));
+    QVERIFY(textcopy);
+    QVERIFY(text.equals(*textcopy));
+
+    std::unique_ptr<KigDocument> loci(KigFilterNative::instance()->load(QFINDTESTDATA("../examples/locustest.kig")));
+    QVERIFY(loci);
+    const LocusImp *locus = nullptr;
+    const std::vector<ObjectHolder *> objects = loci->objects();
+    for (std::vector<ObjectHolder *>::const_iterator i = objects.begin(); i != objects.end() && !locus; ++i)
+        if ((*i)->imp()->inherits(LocusImp::stype()))
+            locus = static_cast<const LocusImp *>((*i)->imp());
+    QVERIFY(locus);
+    std::unique_ptr<ObjectImp> locuscopy(binaryRoundTrip(*locus));
+    QVERIFY(locuscopy);
+    QVERIFY(locuscopy->inherits(LocusImp::stype()));
+    QVERIFY(static_cast<const LocusImp &>(*locuscopy).curve()->equals(*locus->curve()));
+    QCOMPARE(static_cast<const LocusImp &>(*locuscopy).hierarchy().numberOfArgs(), locus->hierarchy().numberOfArgs());
+    QCOMPARE(static_cast<const LocusImp &>(*locuscopy).hierarchy().numberOfResults(), locus->hierarchy().numberOfResults());
+
+    // and a whole document with a text label as data
+    KigDocument doc;
+    doc.addObject(new ObjectHolder(new ObjectConstCalcer(text.copy())));
+    const QByteArray data = KigFilterNative::instance()->saveBinary(doc);
+    QVERIFY(!data.isNull());
+    std::unique_ptr<KigDocument> loaded(KigFilterNative::instance()->loadBinary(data.constData(), data.size()));
+    QVERIFY(loaded);
+    compareDocuments(doc, *loaded);
+
+    // an imp that the binary format can't write makes it fail instead
+    // of writing a broken record
+    KigBinaryWriter w;
+    QVERIFY(!ObjectImpFactory::instance()->serialize(InvalidImp(), w));
+}
+
+void NativeFilterTest::testManyParents()
+{
+    // a polygon with more vertices than fit in a byte
+    KigDocument doc;
+    std::vector<ObjectCalcer *> vertices;
+    for (int i = 0; i < 300; ++i) {
+        vertices.push_back(ObjectFactory::instance()->fixedPointCalcer(Coordinate(std::cos(i * 2 * M_PI / 300), std::sin(i * 2 * M_PI / 300))));
+        vertices.back()->calc(doc);
+    }
+    ObjectTypeCalcer *polygon = new ObjectTypeCalcer(PolygonBNPType::instance(), vertices);
+    polygon->calc(doc);
+    doc.addObject(new ObjectHolder(polygon));
+
+    const QByteArray data = KigFilterNative::instance()->saveBinary(doc);
+    QVERIFY(!data.isNull());
+    std::unique_ptr<KigDocument> loaded(KigFilterNative::instance()->loadBinary(data.constData(), data.size()));
+    QVERIFY(loaded);
+    compareDocuments(doc, *loaded);
+    QCOMPARE(loaded->objects()[0]->calcer()->parents().size(), size_t(300));
+}
+
+QTEST_MAIN(NativeFilterTest)
+
+#include "nativefiltertest.moc"
@@ -0,0 +1,237 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "../kig/kig_document.h"
+#include "../misc/calcpaths.h"
+#include "../misc/kigtransform.h"
+#include "../misc/object_hierarchy.h"
+#include "../objects/bogus_imp.h"
+#include "../objects/line_type.h"
+#include "../objects/object_calcer.h"
+#include "../objects/object_factory.h"
+#include "../objects/other_imp.h"
+#include "../objects/point_imp.h"
+#include "../objects/point_type.h"
+#include "../objects/transform_types.h"
+
+#include <QObject>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+// copies of a hierarchy, and the hierarchies that withFixedArgs() and
+// transformFinalObject() derive from it, share its nodes.  They must
+// give the same results as the hierarchy they come from, leave that
+// one alone, and keep working after it is gone.
+class ObjectHierarchyTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testCopy();
+    void testWithFixedArgs();
+    void testTransformFinalObject();
+    void testConcurrentCalc();
+    void testBuildTransformChain();
+};
+
+/**
+ * a hierarchy from two points a and b to the point at parameter 0.25
+ * on the segment from a to the mid point of ab.  It has all kinds of
+ * nodes: a constant, a property and types.
+ */
+static ObjectHierarchy *hierarchy(const KigDocument &doc)
+{
+    std::vector<ObjectCalcer *> from;
+    from.push_back(ObjectFactory::instance()->fixedPointCalcer(Coordinate(0, 0)));
+    from.push_back(ObjectFactory::instance()->fixedPointCalcer(Coordinate(4, 2)));
+    from[0]->calc(doc);
+    from[1]->calc(doc);
+    const ObjectCalcer::shared_ptr ab = new ObjectTypeCalcer(SegmentABType::instance(), from);
+    ab->calc(doc);
+    ObjectCalcer *mid = new ObjectPropertyCalcer(ab.get(), "mid-point");
+    mid->calc(doc);
+    std::vector<ObjectCalcer *> segmentargs;
+    segmentargs.push_back(from[0]);
+    segmentargs.push_back(mid);
+    std::vector<ObjectCalcer *> pointargs;
+    pointargs.push_back(new ObjectConstCalcer(new DoubleImp(0.25)));
+    pointargs.push_back(new ObjectTypeCalcer(SegmentABType::instance(), segmentargs));
+    pointargs[1]->calc(doc);
+    const ObjectCalcer::shared_ptr to = new ObjectTypeCalcer(ConstrainedPointType::instance(), pointargs);
+    to->calc(doc);
+    return new ObjectHierarchy(from, to.get());
+}
+
+/**
+ * the coordinate of the single point that h calculates from \p args ,
+ * or an invalid Coordinate.
+ */
+static Coordinate calcPoint(const ObjectHierarchy &h, const Args &args, const KigDocument &doc)
+{
+    std::vector<ObjectImp *> ret = h.calc(args, doc);
+    Coordinate c = Coordinate::invalidCoord();
+    if (ret.size() == 1 && ret[0]->inherits(PointImp::stype()))
+        c = static_cast<const PointImp *>(ret[0])->coordinate();
+    delete_all(ret.begin(), ret.end());
+    return c;
+}
+
+static Args points(const PointImp &a, const PointImp &b)
+{
+    Args ret;
+    ret.push_back(&a);
+    ret.push_back(&b);
+    return ret;
+}
+
+void ObjectHierarchyTest::testCopy()
+{
+    KigDocument doc;
+    const PointImp a(Coordinate(0, 0));
+    const PointImp b(Coordinate(4, 2));
+    std::unique_ptr<ObjectHierarchy> h(hierarchy(doc));
+    QCOMPARE(h->numberOfArgs(), 2u);
+    QVERIFY(calcPoint(*h, points(a, b), doc) == Coordinate(0.5, 0.25));
+
+    std::unique_ptr<ObjectHierarchy> copy(new ObjectHierarchy(*h));
+    QVERIFY(*copy == *h);
+    h.reset();
+    // the copy doesn't need the hierarchy it was copied from
+    const PointImp c(Coordinate(-8, 4));
+    QVERIFY(calcPoint(*copy, points(a, c), doc) == Coordinate(-1, 0.5));
+}
+
+void ObjectHierarchyTest::testWithFixedArgs()
+{
+    KigDocument doc;
+    const PointImp a(Coordinate(0, 0));
+    const PointImp b(Coordinate(4, 2));
+    std::unique_ptr<ObjectHierarchy> h(hierarchy(doc));
+
+    Args fixed;
+    fixed.push_back(&a);
+    std::unique_ptr<ObjectHierarchy> derived(new ObjectHierarchy(h->withFixedArgs(fixed)));
+    QCOMPARE(derived->numberOfArgs(), 1u);
+    Args rest;
+    rest.push_back(&b);
+    QVERIFY(calcPoint(*derived, rest, doc) == Coordinate(0.5, 0.25));
+
+    // the hierarchy it derives from still takes both points
+    QCOMPARE(h->numberOfArgs(), 2u);
+    const PointImp c(Coordinate(8, 8));
+    QVERIFY(calcPoint(*h, points(c, b), doc) == Coordinate(7.5, 7.25));
+
+    // and each works without the other
+    h.reset();
+    QVERIFY(calcPoint(*derived, rest, doc) == Coordinate(0.5, 0.25));
+}
+
+void ObjectHierarchyTest::testTransformFinalObject()
+{
+    KigDocument doc;
+    const PointImp a(Coordinate(0, 0));
+    const PointImp b(Coordinate(4, 2));
+    std::unique_ptr<ObjectHierarchy> h(hierarchy(doc));
+
+    const Transformation translation = Transformation::translation(Coordinate(1, 1));
+    std::unique_ptr<ObjectHierarchy> translated(new ObjectHierarchy(h->transformFinalObject(translation)));
+    QVERIFY(calcPoint(*translated, points(a, b), doc) == Coordinate(1.5, 1.25));
+    QVERIFY(calcPoint(*h, points(a, b), doc) == Coordinate(0.5, 0.25));
+
+    // a chain of transformations, which is evaluated as one
+    const Transformation scaling = Transformation::scalingOverPoint(2, Coordinate(0, 0));
+    std::unique_ptr<ObjectHierarchy> scaled(new ObjectHierarchy(translated->transformFinalObject(scaling)));
+    h.reset();
+    translated.reset();
+    QVERIFY(calcPoint(*scaled, points(a, b), doc) == Coordinate(3, 2.5));
+}
+
+void ObjectHierarchyTest::testConcurrentCalc()
+{
+    // the copies in the threads share their nodes, and calculate them
+    // at the same time
+    KigDocument doc;
+    std::unique_ptr<ObjectHierarchy> h(hierarchy(doc));
+    std::vector<std::unique_ptr<ObjectHierarchy>> copies;
+    std::vector<QThread *> threads;
+    std::vector<int> failures(4, 0);
+    for (int i = 0; i < 4; ++i) {
+        copies.emplace_back(new ObjectHierarchy(*h));
+        const ObjectHierarchy *copy = copies.back().get();
+        int *failed = &failures[i];
+        threads.push_back(QThread::create([copy, failed]() {
+            // a document per thread, since calc() may write to it
+            KigDocument doc;
+            for (int j = 0; j < 1000; ++j) {
+                const PointImp a(Coordinate(j, 0));
+                const PointImp b(Coordinate(j + 4, 2));
+                if (!(calcPoint(*copy, points(a, b), doc) == Coordinate(j + 0.5, 0.25)))
+                    ++*failed;
+            }
+        }));
+    }
+    for (std::vector<QThread *>::const_iterator i = threads.begin(); i != threads.end(); ++i)
+        (*i)->start();
+    for (std::vector<QThread *>::const_iterator i = threads.begin(); i != threads.end(); ++i) {
+        (*i)->wait();
+        delete *i;
+    }
+    for (int i = 0; i < 4; ++i)
+        QCOMPARE(failures[i], 0);
+}
+
+static Coordinate coordinate(const ObjectCalcer *o)
+{
+    if (!o->imp()->inherits(PointImp::stype()))
+        return Coordinate::invalidCoord();
+    return static_cast<const PointImp *>(o->imp())->coordinate();
+}
+
+void ObjectHierarchyTest::testBuildTransformChain()
+{
+    // a macro that translates a point, and reflects the result in the
+    // origin.  In the document, the translated point is only used by
+    // the reflection, which calculates both at once.  It must still
+    // give the right imp when asked for it.
+    KigDocument doc;
+    std::vector<ObjectCalcer *> from(1, ObjectFactory::instance()->fixedPointCalcer(Coordinate(0, 0)));
+    from[0]->calc(doc);
+    std::vector<ObjectCalcer *> args = from;
+    args.push_back(new ObjectConstCalcer(new VectorImp(Coordinate(0, 0), Coordinate(1, 2))));
+    const ObjectCalcer::shared_ptr translated = new ObjectTypeCalcer(TranslatedType::instance(), args);
+    translated->calc(doc);
+    args.clear();
+    args.push_back(translated.get());
+    args.push_back(ObjectFactory::instance()->fixedPointCalcer(Coordinate(0, 0)));
+    args.back()->calc(doc);
+    const ObjectCalcer::shared_ptr to = new ObjectTypeCalcer(PointReflectionType::instance(), args);
+    to->calc(doc);
+    const ObjectHierarchy h(from, to.get());
+
+    const ObjectCalcer::shared_ptr p = ObjectFactory::instance()->fixedPointCalcer(Coordinate(3, 1));
+    p->calc(doc);
+    const std::vector<ObjectCalcer *> built = h.buildObjects(std::vector<ObjectCalcer *>(1, p.get()), doc);
+    QCOMPARE(built.size(), std::size_t(1));
+    const ObjectCalcer::shared_ptr result = built[0];
+    QVERIFY(coordinate(result.get()) == Coordinate(-4, -3));
+
+    p->move(Coordinate(-1, 5), doc);
+    const std::set<ObjectCalcer *> children = getAllChildren(p.get());
+    const std::vector<ObjectCalcer *> path = calcPath(std::vector<ObjectCalcer *>(children.begin(), children.end()));
+    for (std::vector<ObjectCalcer *>::const_iterator i = path.begin(); i != path.end(); ++i)
+        (*i)->calc(doc);
+    QVERIFY(coordinate(result.get()) == Coordinate(0, -7));
+    QVERIFY(coordinate(result->parents()[0]) == Coordinate(0, 7));
+}
+
+QTEST_GUILESS_MAIN(ObjectHierarchyTest)
+
+#include "objecthierarchytest.moc"
@@ -0,0 +1,269 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "../kig/kig_document.h"
+#include "../misc/coordinate.h"
+#include "../misc/polygon_clipping.h"
+#include "../objects/bogus_imp.h"
+#include "../objects/polygon_imp.h"
+#include "../objects/polygon_type.h"
+
+#include <QObject>
+#include <QTest>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+typedef std::vector<Coordinate> Ring;
+typedef std::vector<Ring> Rings;
+
+class PolygonClippingTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testOverlappingSquares();
+    void testSharedEdge();
+    void testCollinearOverlap();
+    void testTouchingVertices();
+    void testIdentical();
+    void testHole();
+    void testDegenerateInput();
+    void testEnclosedDifference();
+    void testDisjointUnion();
+};
+
+static Ring rect(double x0, double y0, double x1, double y1)
+{
+    Ring ret;
+    ret.push_back(Coordinate(x0, y0));
+    ret.push_back(Coordinate(x1, y0));
+    ret.push_back(Coordinate(x1, y1));
+    ret.push_back(Coordinate(x0, y1));
+    return ret;
+}
+
+static double signedArea(const Ring &ring)
+{
+    double area = 0.;
+    for (uint i = 0; i < ring.size(); ++i) {
+        const Coordinate &a = ring[i];
+        const Coordinate &b = ring[(i + 1) % ring.size()];
+        area += a.x * b.y - a.y * b.x;
+    }
+    return area / 2;
+}
+
+// the area of the result: the holes are clockwise, so they count
+// negatively
+static double area(const Rings &rings)
+{
+    double ret = 0.;
+    for (Rings::const_iterator i = rings.begin(); i != rings.end(); ++i)
+        ret += signedArea(*i);
+    return ret;
+}
+
+static bool fuzzyEqual(double a, double b)
+{
+    return std::fabs(a - b) < 1e-9;
+}
+
+void PolygonClippingTest::testOverlappingSquares()
+{
+    const Ring a = rect(0, 0, 2, 2);
+    const Ring b = rect(1, 1, 3, 3);
+
+    const Rings i = PolygonClipping::compute(a, b, PolygonClipping::Intersection);
+    QCOMPARE(i.size(), size_t(1));
+    QCOMPARE(i[0].size(), size_t(4));
+    QVERIFY(fuzzyEqual(area(i), 1.));
+
+    const Rings u = PolygonClipping::compute(a, b, PolygonClipping::Union);
+    QCOMPARE(u.size(), size_t(1));
+    QCOMPARE(u[0].size(), size_t(8));
+    QVERIFY(fuzzyEqual(area(u), 7.));
+
+    const Rings d = PolygonClipping::compute(a, b, PolygonClipping::Difference);
+    QCOMPARE(d.size(), size_t(1));
+    QCOMPARE(d[0].size(), size_t(6));
+    QVERIFY(fuzzyEqual(area(d), 3.));
+}
+
+void PolygonClippingTest::testSharedEdge()
+{
+    // two squares with a whole side in common
+    const Ring a = rect(0, 0, 1, 1);
+    const Ring b = rect(1, 0, 2, 1);
+
+    QVERIFY(fuzzyEqual(area(PolygonClipping::compute(a, b, PolygonClipping::Intersection)), 0.));
+
+    const Rings u = PolygonClipping::compute(a, b, PolygonClipping::Union);
+    QCOMPARE(u.size(), size_t(1));
+    // the shared side is gone, and so are its end points
+    QCOMPARE(u[0].size(), size_t(4));
+    QVERIFY(fuzzyEqual(area(u), 2.));
+
+    const Rings d = PolygonClipping::compute(a, b, PolygonClipping::Difference);
+    QCOMPARE(d.size(), size_t(1));
+    QVERIFY(fuzzyEqual(area(d), 1.));
+}
+
+void PolygonClippingTest::testCollinearOverlap()
+{
+    // the bottom side of a and the top side of b overlap in part
+    const Ring a = rect(0, 0, 2, 1);
+    const Ring b = rect(1, -1, 3, 0);
+
+    QVERIFY(fuzzyEqual(area(PolygonClipping::compute(a, b, PolygonClipping::Intersection)), 0.));
+
+    const Rings u = PolygonClipping::compute(a, b, PolygonClipping::Union);
+    QCOMPARE(u.size(), size_t(1));
+    QCOMPARE(u[0].size(), size_t(8));
+    QVERIFY(fuzzyEqual(area(u), 4.));
+
+    const Rings d = PolygonClipping::compute(a, b, PolygonClipping::Difference);
+    QCOMPARE(d.size(), size_t(1));
+    QVERIFY(fuzzyEqual(area(d), 2.));
+    QCOMPARE(d[0].size(), size_t(4));
+}
+
+void PolygonClippingTest::testTouchingVertices()
+{
+    // two squares touching in the single point ( 1, 1 )
+    const Ring a = rect(0, 0, 1, 1);
+    const Ring b = rect(1, 1, 2, 2);
+
+    QVERIFY(PolygonClipping::compute(a, b, PolygonClipping::Intersection).empty());
+
+    // the union can't be one ring without passing through ( 1, 1 )
+    // twice, so it's two of them
+    const Rings u = PolygonClipping::compute(a, b, PolygonClipping::Union);
+    QCOMPARE(u.size(), size_t(2));
+    QVERIFY(fuzzyEqual(signedArea(u[0]), 1.));
+    QVERIFY(fuzzyEqual(signedArea(u[1]), 1.));
+    QCOMPARE(u[0].size(), size_t(4));
+    QCOMPARE(u[1].size(), size_t(4));
+
+    const Rings d = PolygonClipping::compute(a, b, PolygonClipping::Difference);
+    QCOMPARE(d.size(), size_t(1));
+    QVERIFY(fuzzyEqual(area(d), 1.));
+}
+
+void PolygonClippingTest::testIdentical()
+{
+    // the same square, once with its vertices in the other direction,
+    // and starting somewhere else
+    const Ring a = rect(0, 0, 1, 1);
+    Ring b;
+    b.push_back(Coordinate(1, 1));
+    b.push_back(Coordinate(1, 0));
+    b.push_back(Coordinate(0, 0));
+    b.push_back(Coordinate(0, 1));
+
+    QVERIFY(fuzzyEqual(area(PolygonClipping::compute(a, b, PolygonClipping::Intersection)), 1.));
+    QVERIFY(fuzzyEqual(area(PolygonClipping::compute(a, b, PolygonClipping::Union)), 1.));
+    QVERIFY(PolygonClipping::compute(a, b, PolygonClipping::Difference).empty());
+}
+
+void PolygonClippingTest::testHole()
+{
+    const Ring a = rect(0, 0, 3, 3);
+    const Ring b = rect(1, 1, 2, 2);
+
+    // the outer boundary is counterclockwise, the hole clockwise
+    const Rings d = PolygonClipping::compute(a, b, PolygonClipping::Difference);
+    QCOMPARE(d.size(), size_t(2));
+    QVERIFY(fuzzyEqual(area(d), 8.));
+    const Ring &outer = signedArea(d[0]) > 0 ? d[0] : d[1];
+    const Ring &hole = signedArea(d[0]) > 0 ? d[1] : d[0];
+    QVERIFY(fuzzyEqual(signedArea(outer), 9.));
+    QVERIFY(fuzzyEqual(signedArea(hole), -1.));
+
+    QVERIFY(fuzzyEqual(area(PolygonClipping::compute(a, b, PolygonClipping::Union)), 9.));
+    QVERIFY(fuzzyEqual(area(PolygonClipping::compute(a, b, PolygonClipping::Intersection)), 1.));
+}
+
+void PolygonClippingTest::testDegenerateInput()
+{
+    const Ring a = rect(0, 0, 1, 1);
+
+    // less than three points
+    Ring two;
+    two.push_back(Coordinate(0, 0));
+    two.push_back(Coordinate(1, 1));
+    QVERIFY(PolygonClipping::compute(a, two, PolygonClipping::Union).empty());
+    QVERIFY(PolygonClipping::compute(two, a, PolygonClipping::Intersection).empty());
+
+    // no area at all: the points are on one line, one of them twice
+    Ring flat;
+    flat.push_back(Coordinate(-1, 0.5));
+    flat.push_back(Coordinate(2, 0.5));
+    flat.push_back(Coordinate(2, 0.5));
+    flat.push_back(Coordinate(0.5, 0.5));
+    QVERIFY(PolygonClipping::compute(a, flat, PolygonClipping::Intersection).empty());
+    QVERIFY(fuzzyEqual(area(PolygonClipping::compute(a, flat, PolygonClipping::Difference)), 1.));
+
+    // all points the same
+    const Ring point(4, Coordinate(0.5, 0.5));
+    QVERIFY(PolygonClipping::compute(point, point, PolygonClipping::Union).empty());
+}
+
+// the result of type on the polygons a and b
+static ObjectImp *calcType(const ObjectType *type, const Ring &a, const Ring &b)
+{
+    const KigDocument doc;
+    const FilledPolygonImp pa(a);
+    const FilledPolygonImp pb(b);
+    Args args;
+    args.push_back(&pa);
+    args.push_back(&pb);
+    return type->calc(args, doc);
+}
+
+void PolygonClippingTest::testEnclosedDifference()
+{
+    // the difference has a hole, which a polygon can't have
+    const Ring a = rect(0, 0, 3, 3);
+    const Ring b = rect(1, 1, 2, 2);
+    std::unique_ptr<ObjectImp> d(calcType(PolygonPolygonDifferenceType::instance(), a, b));
+    QVERIFY(d->inherits(InvalidImp::stype()));
+
+    // the other way round it is empty
+    d.reset(calcType(PolygonPolygonDifferenceType::instance(), b, a));
+    QVERIFY(d->inherits(InvalidImp::stype()));
+
+    // the other operations give a polygon
+    std::unique_ptr<ObjectImp> u(calcType(PolygonPolygonUnionType::instance(), a, b));
+    QVERIFY(u->inherits(FilledPolygonImp::stype()));
+    QVERIFY(fuzzyEqual(static_cast<FilledPolygonImp *>(u.get())->area(), 9.));
+    std::unique_ptr<ObjectImp> i(calcType(PolygonPolygonIntersectionType::instance(), a, b));
+    QVERIFY(i->inherits(FilledPolygonImp::stype()));
+    QVERIFY(fuzzyEqual(static_cast<FilledPolygonImp *>(i.get())->area(), 1.));
+}
+
+void PolygonClippingTest::testDisjointUnion()
+{
+    // the union has two components, which a polygon can't have
+    const Ring a = rect(0, 0, 1, 1);
+    const Ring b = rect(2, 0, 3, 1);
+    std::unique_ptr<ObjectImp> u(calcType(PolygonPolygonUnionType::instance(), a, b));
+    QVERIFY(u->inherits(InvalidImp::stype()));
+
+    // and the intersection is empty
+    std::unique_ptr<ObjectImp> i(calcType(PolygonPolygonIntersectionType::instance(), a, b));
+    QVERIFY(i->inherits(InvalidImp::stype()));
+
+    std::unique_ptr<ObjectImp> d(calcType(PolygonPolygonDifferenceType::instance(), a, b));
+    QVERIFY(d->inherits(FilledPolygonImp::stype()));
+    QVERIFY(fuzzyEqual(static_cast<FilledPolygonImp *>(d.get())->area(), 1.));
+}
+
+QTEST_GUILESS_MAIN(PolygonClippingTest)
+
+#include "polygonclippingtest.moc"
@@ -0,0 +1,155 @@
+/*
+    This file is part of Kig, a KDE program for Interactive Geometry.
+    SPDX-FileCopyrightText: 2026 The Kig Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "../misc/coordinate.h"
+#include "../misc/kigtransform.h"
+
+#include <QObject>
+#include <QTest>
+
+#include <cmath>
+#include <vector>
+
+// the batched Transformation::apply uses SIMD kernels where the CPU
+// has them, and must give bit for bit the same results as applying the
+// transformation to the points one by one.
+class TransformTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testBatchMatchesSingle();
+    void testInPlace();
+    void testSeparateArrays();
+    void testPointsAtInfinity();
+    void testEmpty();
+};
+
+static std::vector<Transformation> transformations()
+{
+    std::vector<Transformation> ret;
+    ret.push_back(Transformation::identity());
+    ret.push_back(Transformation::translation(Coordinate(3.5, -1.25)));
+    ret.push_back(Transformation::rotation(0.7, Coordinate(1, 2)));
+    ret.push_back(Transformation::scalingOverPoint(-2.5, Coordinate(-3, 0.5)));
+    ret.push_back(Transformation::pointReflection(Coordinate(0.1, 0.2)));
+    // a projective transformation, which divides by a different w for
+    // every point
+    double data[3][3] = {{1., 0.05, -0.02}, {0.5, 2., 0.3}, {-1., 0.1, 1.5}};
+    ret.push_back(Transformation(data, false));
+    return ret;
+}
+
+static std::vector<Coordinate> points(std::size_t n)
+{
+    std::vector<Coordinate> ret;
+    for (std::size_t i = 0; i < n; ++i)
+        ret.push_back(Coordinate(std::sin(i * 1.3) * 40. - 3., std::cos(i * 0.7) * 25. + i * 0.01));
+    return ret;
+}
+
+static bool same(const Coordinate &a, const Coordinate &b)
+{
+    if (!a.valid() || !b.valid())
+        return a.valid() == b.valid();
+    return a.x == b.x && a.y == b.y;
+}
+
+void TransformTest::testBatchMatchesSingle()
+{
+    const std::vector<Transformation> ts = transformations();
+    // the AVX kernel does two points at a time, so try odd sizes as
+    // well, to get the points that are left over
+    const std::size_t sizes[] = {1, 2, 3, 4, 7, 64, 101};
+    for (std::vector<Transformation>::const_iterator t = ts.begin(); t != ts.end(); ++t)
+        for (std::size_t n : sizes) {
+            const std::vector<Coordinate> in = points(n);
+            const std::vector<Coordinate> out = t->apply(in);
+            QCOMPARE(out.size(), in.size());
+            for (std::size_t i = 0; i < n; ++i)
+                QVERIFY(same(out[i], t->apply(in[i])));
+        }
+}
+
+void TransformTest::testInPlace()
+{
+    const std::vector<Transformation> ts = transformations();
+    for (std::vector<Transformation>::const_iterator t = ts.begin(); t != ts.end(); ++t) {
+        const std::vector<Coordinate> in = points(33);
+        std::vector<Coordinate> inplace = in;
+        t->apply(inplace.data(), inplace.data(), inplace.size());
+        for (std::size_t i = 0; i < in.size(); ++i)
+            QVERIFY(same(inplace[i], t->apply(in[i])));
+    }
+}
+
+void TransformTest::testSeparateArrays()
+{
+    // the kernels for separate x and y arrays do two or four points at
+    // a time
+    const std::vector<Transformation> ts = transformations();
+    const std::size_t sizes[] = {1, 2, 3, 5, 8, 65};
+    for (std::vector<Transformation>::const_iterator t = ts.begin(); t != ts.end(); ++t)
+        for (std::size_t n : sizes) {
+            const std::vector<Coordinate> in = points(n);
+            std::vector<double> xs(n), ys(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                xs[i] = in[i].x;
+                ys[i] = in[i].y;
+            }
+            std::vector<double> outx(n), outy(n);
+            t->apply(xs.data(), ys.data(), outx.data(), outy.data(), n);
+            for (std::size_t i = 0; i < n; ++i)
+                QVERIFY(same(Coordinate(outx[i], outy[i]), t->apply(in[i])));
+
+            // and in place
+            t->apply(xs.data(), ys.data(), xs.data(), ys.data(), n);
+            QVERIFY(xs == outx);
+            QVERIFY(ys == outy);
+        }
+
+    // points sent to infinity, w = 1 + x - y
+    double data[3][3] = {{1., 1., -1.}, {0., 1., 0.}, {0., 0., 1.}};
+    const Transformation t(data, false);
+    const double xs[] = {0., 2., -1., 3., 1.};
+    const double ys[] = {1., 2., 0., 4., 0.};
+    double outx[5], outy[5];
+    t.apply(xs, ys, outx, outy, 5);
+    for (std::size_t i = 0; i < 5; ++i)
+        QVERIFY(same(Coordinate(outx[i], outy[i]), t.apply(Coordinate(xs[i], ys[i]))));
+}
+
+void TransformTest::testPointsAtInfinity()
+{
+    // w = 1 + x - y, which is zero on the line y = x + 1
+    double data[3][3] = {{1., 1., -1.}, {0., 1., 0.}, {0., 0., 1.}};
+    const Transformation t(data, false);
+
+    std::vector<Coordinate> in;
+    in.push_back(Coordinate(0, 1));
+    in.push_back(Coordinate(2, 2));
+    in.push_back(Coordinate(-1, 0));
+    in.push_back(Coordinate(3, 4));
+    in.push_back(Coordinate(1, 0));
+    const std::vector<Coordinate> out = t.apply(in);
+    QVERIFY(!out[0].valid());
+    QVERIFY(out[1].valid());
+    QVERIFY(!out[2].valid());
+    QVERIFY(!out[3].valid());
+    QVERIFY(out[4].valid());
+    for (std::size_t i = 0; i < in.size(); ++i)
+        QVERIFY(same(out[i], t.apply(in[i])));
+}
+
+void TransformTest::testEmpty()
+{
+    QVERIFY(Transformation::identity().apply(std::vector<Coordinate>()).empty());
+}
+
+QTEST_GUILESS_MAIN(TransformTest)
+
+#include "transformtest.moc"